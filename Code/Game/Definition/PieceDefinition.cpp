@@ -5,21 +5,62 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Definition/PieceDefinition.hpp"
 
+#include <algorithm>
+#include <cmath>
+
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
-#include "Engine/Math/AABB3.hpp"
-#include "Engine/Math/OBB3.hpp"
+#include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
 #include "Game/Framework/GameCommon.hpp"
 
 //----------------------------------------------------------------------------------------------------
 STATIC std::vector<PieceDefinition*> PieceDefinition::s_pieceDefinitions;
 
+//----------------------------------------------------------------------------------------------------
+static void StretchToIncludeBox(AABB3&      bounds,
+                                Vec3 const& center,
+                                Vec3 const& halfExtents)
+{
+    bounds.m_mins = Vec3(std::min(bounds.m_mins.x, center.x - halfExtents.x), std::min(bounds.m_mins.y, center.y - halfExtents.y), std::min(bounds.m_mins.z, center.z - halfExtents.z));
+    bounds.m_maxs = Vec3(std::max(bounds.m_maxs.x, center.x + halfExtents.x), std::max(bounds.m_maxs.y, center.y + halfExtents.y), std::max(bounds.m_maxs.z, center.z + halfExtents.z));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Box around the parts as the mesh bake interprets them; cylinders are bounded by their end caps.
+static AABB3 GetPartListBounds(std::vector<sPiecePart> const& parts)
+{
+    AABB3 bounds(Vec3(FLOAT_MAX, FLOAT_MAX, FLOAT_MAX), Vec3(-FLOAT_MAX, -FLOAT_MAX, -FLOAT_MAX));
+
+    for (auto const& [name, startPosition, endPosition, orientation, halfDimension, radius] : parts)
+    {
+        if (name == "sphere") StretchToIncludeBox(bounds, startPosition, Vec3(radius, radius, radius));
+        else if (name == "aabb3") StretchToIncludeBox(bounds, (startPosition + endPosition) * 0.5f, (endPosition - startPosition) * 0.5f);
+        else if (name == "cylinder")
+        {
+            StretchToIncludeBox(bounds, startPosition, Vec3(radius, radius, radius));
+            StretchToIncludeBox(bounds, endPosition, Vec3(radius, radius, radius));
+        }
+        else if (name == "obb3")
+        {
+            Mat44 const matrix = orientation.GetAsMatrix_IFwd_JLeft_KUp();
+            Vec3 const  i      = matrix.GetIBasis3D() * halfDimension.x;
+            Vec3 const  j      = matrix.GetJBasis3D() * halfDimension.y;
+            Vec3 const  k      = matrix.GetKBasis3D() * halfDimension.z;
+            StretchToIncludeBox(bounds, startPosition, Vec3(fabsf(i.x) + fabsf(j.x) + fabsf(k.x), fabsf(i.y) + fabsf(j.y) + fabsf(k.y), fabsf(i.z) + fabsf(j.z) + fabsf(k.z)));
+        }
+    }
+
+    if (bounds.m_mins.x > bounds.m_maxs.x) return AABB3(Vec3::ZERO, Vec3::ZERO);
+
+    return bounds;
+}
+
 //----------------------------------------------------------------------------------------------------
 PieceDefinition::~PieceDefinition()
 {
-    for (VertexBuffer* buffer : m_vertexBuffer) GAME_SAFE_RELEASE(buffer);
-    for (IndexBuffer* buffer : m_indexBuffer) GAME_SAFE_RELEASE(buffer);
+    for (sPieceMesh const*& mesh : m_meshes) mesh = nullptr;
 }
 
 bool PieceDefinition::LoadFromXmlElement(XmlElement const* element)
@@ -60,37 +101,14 @@ bool PieceDefinition::LoadFromXmlElement(XmlElement const* element)
         }
     }
 
-    return true;
-}
-
-void PieceDefinition::CreateMeshByID(int const id)
-{
-    VertexList_PCUTBN verts;
-    IndexList         indexes;
+    m_localBounds = GetPartListBounds(m_pieceParts);
 
-    for (auto const& [name, startPosition, endPosition,orientation,halfDimension, radius] : m_pieceParts)
+    for (int lodLevel = 0; lodLevel < PIECE_MESH_LOD_COUNT; ++lodLevel)
     {
-        if (name == "sphere") AddVertsForSphere3D(verts, indexes, startPosition, radius);
-        else if (name == "aabb3") AddVertsForAABB3D(verts, indexes, AABB3(startPosition, endPosition));
-        else if (name == "cylinder") AddVertsForCylinder3D(verts, indexes, startPosition, endPosition, radius);
-        else if (name == "obb3")
-        {
-            Mat44 matrix = orientation.GetAsMatrix_IFwd_JLeft_KUp();
-            AddVertsForOBB3D(verts, indexes, OBB3(startPosition, halfDimension, matrix.GetIBasis3D(), matrix.GetJBasis3D(), matrix.GetKBasis3D()));
-        }
+        m_meshes[lodLevel] = PieceMeshCache::GetOrCreateMesh(m_pieceParts, lodLevel);
     }
 
-    m_vertexBuffer[id] = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
-    m_indexBuffer[id]  = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
-
-    g_theRenderer->CopyCPUToGPU(verts.data(), static_cast<int>(verts.size()) * sizeof(Vertex_PCUTBN), m_vertexBuffer[id]);
-    g_theRenderer->CopyCPUToGPU(indexes.data(), static_cast<int>(indexes.size()) * sizeof(unsigned int), m_indexBuffer[id]);
-}
-
-//----------------------------------------------------------------------------------------------------
-unsigned int PieceDefinition::GetIndexCountByID(int const id) const
-{
-    return m_indexBuffer[id]->GetSize() / m_indexBuffer[id]->GetStride();
+    return true;
 }
 
 void PieceDefinition::InitializeDefs(char const* path)
@@ -10,26 +10,17 @@
 #include "Engine/Core/StringUtils.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 #include "Engine/Core/XmlUtils.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/Vec3.hpp"
 #include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Texture.hpp"
 #include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+#include "Game/Framework/MatchCommon.hpp"
 
 class Shader;
 
-//----------------------------------------------------------------------------------------------------
-enum class ePieceType : int8_t
-{
-    NONE = -1,
-    PAWN,
-    BISHOP,
-    KNIGHT,
-    ROOK,
-    QUEEN,
-    KING
-};
-
 //----------------------------------------------------------------------------------------------------
 struct sPiecePart
 {
@@ -47,9 +38,7 @@ struct PieceDefinition
     PieceDefinition() = default;
     ~PieceDefinition();
 
-    bool         LoadFromXmlElement(XmlElement const* element);
-    void         CreateMeshByID(int id);
-    unsigned int GetIndexCountByID(int id) const;
+    bool LoadFromXmlElement(XmlElement const* element);
 
     static void                          InitializeDefs(char const* path);
     static PieceDefinition*              GetDefByName(String const& name);
@@ -63,7 +52,7 @@ struct PieceDefinition
     Texture*                m_normalTexture            = nullptr;
     Texture*                m_specularGlossEmitTexture = nullptr;
     std::vector<sPiecePart> m_pieceParts;
-    char                    m_glyph           = '?';
-    VertexBuffer*           m_vertexBuffer[2] = {};
-    IndexBuffer*            m_indexBuffer[2]  = {};
+    AABB3                   m_localBounds;      // Encloses every part
+    char                    m_glyph                          = '?';
+    sPieceMesh const*       m_meshes[PIECE_MESH_LOD_COUNT] = {};   // Finest first; shared by both sides and owned by PieceMeshCache
 };
@@ -0,0 +1,335 @@
+//----------------------------------------------------------------------------------------------------
+// PieceMeshCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Definition/PieceMeshCache.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/OBB3.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/MappedFile.hpp"
+#include "Game/Framework/MeshOptimizer.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC std::vector<sPieceMesh*> PieceMeshCache::s_meshes;
+STATIC int                      PieceMeshCache::s_bakeCount = 0;
+STATIC bool                     PieceMeshCache::s_isDirty   = false;
+
+//----------------------------------------------------------------------------------------------------
+static void HashBytes(uint64_t&   hash,
+                      void const* data,
+                      size_t const byteCount)
+{
+    uint8_t const* bytes = static_cast<uint8_t const*>(data);
+
+    for (size_t index = 0; index < byteCount; ++index)
+    {
+        hash ^= bytes[index];
+        hash *= 0x100000001B3ull;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int SelectPieceMeshLod(int const   currentLod,
+                       float const screenSize)
+{
+    int lod = currentLod < 0 ? 0 : currentLod >= PIECE_MESH_LOD_COUNT ? PIECE_MESH_LOD_COUNT - 1 : currentLod;
+
+    while (lod > 0 && screenSize > PIECE_MESH_LOD_SCREEN_SIZES[lod - 1] * (1.f + PIECE_MESH_LOD_HYSTERESIS)) --lod;
+    while (lod < PIECE_MESH_LOD_COUNT - 1 && screenSize < PIECE_MESH_LOD_SCREEN_SIZES[lod] * (1.f - PIECE_MESH_LOD_HYSTERESIS)) ++lod;
+
+    return lod;
+}
+
+//----------------------------------------------------------------------------------------------------
+static unsigned char MultiplyColorChannel(unsigned char const a,
+                                          unsigned char const b)
+{
+    return static_cast<unsigned char>((a * b + 127) / 255);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Appends one copy of mesh transformed to world space and tinted with color. Normals and
+/// tangents only take the rotation part, which is exact for the rigid transforms pieces use.
+void AppendPieceMeshInstance(sPieceMesh const&  mesh,
+                             Mat44 const&       modelToWorld,
+                             Rgba8 const&       color,
+                             VertexList_PCUTBN& out_verts,
+                             IndexList&         out_indexes)
+{
+    unsigned int const baseVertex = static_cast<unsigned int>(out_verts.size());
+
+    for (Vertex_PCUTBN vertex : mesh.m_vertexes)
+    {
+        vertex.m_position  = modelToWorld.TransformPosition3D(vertex.m_position);
+        vertex.m_tangent   = modelToWorld.TransformVectorQuantity3D(vertex.m_tangent);
+        vertex.m_bitangent = modelToWorld.TransformVectorQuantity3D(vertex.m_bitangent);
+        vertex.m_normal    = modelToWorld.TransformVectorQuantity3D(vertex.m_normal);
+        vertex.m_color.r   = MultiplyColorChannel(vertex.m_color.r, color.r);
+        vertex.m_color.g   = MultiplyColorChannel(vertex.m_color.g, color.g);
+        vertex.m_color.b   = MultiplyColorChannel(vertex.m_color.b, color.b);
+        vertex.m_color.a   = MultiplyColorChannel(vertex.m_color.a, color.a);
+        out_verts.push_back(vertex);
+    }
+
+    for (unsigned int const index : mesh.m_indexes)
+    {
+        out_indexes.push_back(baseVertex + index);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sPieceMesh const* PieceMeshCache::GetOrCreateMesh(std::vector<sPiecePart> const& parts,
+                                                         int const                      lodLevel)
+{
+    uint64_t const key = GetPartListKey(parts, lodLevel);
+
+    for (sPieceMesh const* mesh : s_meshes)
+    {
+        if (mesh->m_key == key) return mesh;
+    }
+
+    sPieceMesh* mesh = new sPieceMesh();
+    mesh->m_key      = key;
+    BakeMesh(parts, lodLevel, *mesh);
+
+    sMeshOptimizationStats const stats = OptimizeMesh(mesh->m_vertexes, mesh->m_indexes);
+
+    if (g_theDevConsole != nullptr)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("Baked piece mesh %016llx LOD %d: %d triangles, %d -> %d vertexes, ACMR %.3f -> %.3f",
+                                                                 static_cast<unsigned long long>(key), lodLevel, stats.m_triangleCount, stats.m_vertexCountBefore, stats.m_vertexCountAfter, stats.m_acmrBefore, stats.m_acmrAfter));
+    }
+
+    ComputeBounds(*mesh);
+    CreateBuffers(*mesh);
+    s_meshes.push_back(mesh);
+
+    ++s_bakeCount;
+    s_isDirty = true;
+
+    return mesh;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief FNV-1a over every field of every part. The cache version is hashed in first, so changing
+/// how parts are baked invalidates old cache files.
+STATIC uint64_t PieceMeshCache::GetPartListKey(std::vector<sPiecePart> const& parts,
+                                               int const                      lodLevel)
+{
+    uint64_t hash = 0xCBF29CE484222325ull;
+
+    HashBytes(hash, &PIECE_MESH_CACHE_VERSION, sizeof(PIECE_MESH_CACHE_VERSION));
+    HashBytes(hash, &lodLevel, sizeof(lodLevel));
+
+    for (sPiecePart const& part : parts)
+    {
+        HashBytes(hash, part.m_name.data(), part.m_name.size() + 1);
+        HashBytes(hash, &part.m_startPosition, sizeof(part.m_startPosition));
+        HashBytes(hash, &part.m_endPosition, sizeof(part.m_endPosition));
+        HashBytes(hash, &part.m_orientation, sizeof(part.m_orientation));
+        HashBytes(hash, &part.m_halfDimension, sizeof(part.m_halfDimension));
+        HashBytes(hash, &part.m_radius, sizeof(part.m_radius));
+    }
+
+    return hash;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Adds the meshes stored in filePath that are not cached yet. Returns false when the file is
+/// missing, from another version, truncated or holds an index past its mesh's vertexes; meshes read
+/// before the damage are kept.
+STATIC bool PieceMeshCache::LoadFromFile(String const& filePath)
+{
+    if (filePath.empty()) return false;
+
+    MappedFile file;
+    if (!file.Open(filePath.c_str())) return false;
+
+    uint8_t const* cursor = file.GetData();
+    uint8_t const* end    = file.GetData() + file.GetSize();
+
+    auto const read = [&cursor, end](void* out_data, size_t const byteCount)
+    {
+        if (static_cast<size_t>(end - cursor) < byteCount) return false;
+
+        memcpy(out_data, cursor, byteCount);
+        cursor += byteCount;
+
+        return true;
+    };
+
+    uint32_t magic     = 0;
+    uint32_t version   = 0;
+    uint32_t meshCount = 0;
+
+    if (!read(&magic, sizeof(magic)) || !read(&version, sizeof(version)) || !read(&meshCount, sizeof(meshCount))) return false;
+    if (magic != PIECE_MESH_CACHE_MAGIC || version != PIECE_MESH_CACHE_VERSION) return false;
+
+    for (uint32_t meshIndex = 0; meshIndex < meshCount; ++meshIndex)
+    {
+        uint64_t key         = 0;
+        uint32_t vertexCount = 0;
+        uint32_t indexCount  = 0;
+
+        if (!read(&key, sizeof(key)) || !read(&vertexCount, sizeof(vertexCount)) || !read(&indexCount, sizeof(indexCount))) return false;
+
+        sPieceMesh* mesh = new sPieceMesh();
+        mesh->m_key      = key;
+        mesh->m_vertexes.resize(vertexCount);
+        mesh->m_indexes.resize(indexCount);
+
+        if (!read(mesh->m_vertexes.data(), vertexCount * sizeof(Vertex_PCUTBN)) ||
+            !read(mesh->m_indexes.data(), indexCount * sizeof(unsigned int)) ||
+            std::any_of(mesh->m_indexes.begin(), mesh->m_indexes.end(), [vertexCount](unsigned int const index) { return index >= vertexCount; }))
+        {
+            delete mesh;
+            return false;
+        }
+
+        bool isCached = false;
+
+        for (sPieceMesh const* cachedMesh : s_meshes)
+        {
+            if (cachedMesh->m_key == key) isCached = true;
+        }
+
+        if (isCached)
+        {
+            delete mesh;
+            continue;
+        }
+
+        ComputeBounds(*mesh);
+        CreateBuffers(*mesh);
+        s_meshes.push_back(mesh);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Writes every cached mesh to filePath, but only when some were baked since the last save.
+STATIC bool PieceMeshCache::SaveToFile(String const& filePath)
+{
+    if (filePath.empty() || !s_isDirty) return false;
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) return false;
+
+    uint32_t const meshCount = static_cast<uint32_t>(s_meshes.size());
+
+    file.write(reinterpret_cast<char const*>(&PIECE_MESH_CACHE_MAGIC), sizeof(PIECE_MESH_CACHE_MAGIC));
+    file.write(reinterpret_cast<char const*>(&PIECE_MESH_CACHE_VERSION), sizeof(PIECE_MESH_CACHE_VERSION));
+    file.write(reinterpret_cast<char const*>(&meshCount), sizeof(meshCount));
+
+    for (sPieceMesh const* mesh : s_meshes)
+    {
+        uint32_t const vertexCount = static_cast<uint32_t>(mesh->m_vertexes.size());
+        uint32_t const indexCount  = static_cast<uint32_t>(mesh->m_indexes.size());
+
+        file.write(reinterpret_cast<char const*>(&mesh->m_key), sizeof(mesh->m_key));
+        file.write(reinterpret_cast<char const*>(&vertexCount), sizeof(vertexCount));
+        file.write(reinterpret_cast<char const*>(&indexCount), sizeof(indexCount));
+        file.write(reinterpret_cast<char const*>(mesh->m_vertexes.data()), static_cast<std::streamsize>(vertexCount * sizeof(Vertex_PCUTBN)));
+        file.write(reinterpret_cast<char const*>(mesh->m_indexes.data()), static_cast<std::streamsize>(indexCount * sizeof(unsigned int)));
+    }
+
+    s_isDirty = !file.good();
+
+    return !s_isDirty;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Releases every mesh and its GPU buffers. Must run before the Renderer shuts down.
+STATIC void PieceMeshCache::ClearAll()
+{
+    for (sPieceMesh* mesh : s_meshes)
+    {
+        GAME_SAFE_RELEASE(mesh->m_vertexBuffer);
+        GAME_SAFE_RELEASE(mesh->m_indexBuffer);
+        GAME_SAFE_RELEASE(mesh);
+    }
+
+    s_meshes.clear();
+    s_isDirty = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int PieceMeshCache::GetMeshCount()
+{
+    return static_cast<int>(s_meshes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int PieceMeshCache::GetBakeCount()
+{
+    return s_bakeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void PieceMeshCache::BakeMesh(std::vector<sPiecePart> const& parts,
+                                     int const                      lodLevel,
+                                     sPieceMesh&                    out_mesh)
+{
+    int const slices = PIECE_MESH_LOD_SLICES[lodLevel];
+    int const stacks = PIECE_MESH_LOD_STACKS[lodLevel];
+
+    for (auto const& [name, startPosition, endPosition, orientation, halfDimension, radius] : parts)
+    {
+        if (name == "sphere") AddVertsForSphere3D(out_mesh.m_vertexes, out_mesh.m_indexes, startPosition, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, slices, stacks);
+        else if (name == "aabb3") AddVertsForAABB3D(out_mesh.m_vertexes, out_mesh.m_indexes, AABB3(startPosition, endPosition));
+        else if (name == "cylinder") AddVertsForCylinder3D(out_mesh.m_vertexes, out_mesh.m_indexes, startPosition, endPosition, radius, Rgba8::WHITE, AABB2::ZERO_TO_ONE, slices);
+        else if (name == "obb3")
+        {
+            Mat44 matrix = orientation.GetAsMatrix_IFwd_JLeft_KUp();
+            AddVertsForOBB3D(out_mesh.m_vertexes, out_mesh.m_indexes, OBB3(startPosition, halfDimension, matrix.GetIBasis3D(), matrix.GetJBasis3D(), matrix.GetKBasis3D()));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Without a Renderer, as on a headless host, the mesh keeps only its CPU copy.
+STATIC void PieceMeshCache::CreateBuffers(sPieceMesh& mesh)
+{
+    mesh.m_indexCount = static_cast<unsigned int>(mesh.m_indexes.size());
+
+    if (g_theRenderer == nullptr) return;
+
+    size_t const vertexBytes = mesh.m_vertexes.size() * sizeof(Vertex_PCUTBN);
+    size_t const indexBytes  = mesh.m_indexes.size() * sizeof(unsigned int);
+
+    mesh.m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    mesh.m_indexBuffer  = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+
+    g_theRenderer->CopyCPUToGPU(mesh.m_vertexes.data(), static_cast<unsigned int>(vertexBytes), mesh.m_vertexBuffer);
+    g_theRenderer->CopyCPUToGPU(mesh.m_indexes.data(), static_cast<unsigned int>(indexBytes), mesh.m_indexBuffer);
+    RecordRenderUpload(vertexBytes + indexBytes);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void PieceMeshCache::ComputeBounds(sPieceMesh& mesh)
+{
+    float radiusSquared = 0.f;
+
+    for (Vertex_PCUTBN const& vertex : mesh.m_vertexes)
+    {
+        radiusSquared = std::max(radiusSquared, vertex.m_position.GetLengthSquared());
+    }
+
+    mesh.m_boundingRadius = sqrtf(radiusSquared);
+}
@@ -0,0 +1,81 @@
+//----------------------------------------------------------------------------------------------------
+// PieceMeshCache.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IndexBuffer;
+class VertexBuffer;
+struct sPiecePart;
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr PIECE_MESH_CACHE_MAGIC   = 0x484D4350; // "PCMH"
+uint32_t constexpr PIECE_MESH_CACHE_VERSION = 3;
+
+//----------------------------------------------------------------------------------------------------
+// Level 0 is the full tessellation; each further level halves the sphere and cylinder slices.
+// A piece switches to a coarser level when its bounding sphere covers less than the matching
+// fraction of the screen height, and back only once it is PIECE_MESH_LOD_HYSTERESIS larger again,
+// so a piece sitting on a threshold does not flicker between levels.
+//
+int constexpr   PIECE_MESH_LOD_COUNT                                   = 3;
+int constexpr   PIECE_MESH_LOD_SLICES[PIECE_MESH_LOD_COUNT]            = {32, 16, 8};
+int constexpr   PIECE_MESH_LOD_STACKS[PIECE_MESH_LOD_COUNT]            = {16, 8, 4};
+float constexpr PIECE_MESH_LOD_SCREEN_SIZES[PIECE_MESH_LOD_COUNT - 1] = {0.08f, 0.03f};
+float constexpr PIECE_MESH_LOD_HYSTERESIS                              = 0.2f;
+
+int SelectPieceMeshLod(int currentLod, float screenSize);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Baked geometry of one part list. Both sides draw it; their colors come through model constants.
+struct sPieceMesh
+{
+    uint64_t          m_key            = 0;
+    VertexList_PCUTBN m_vertexes;                   // CPU copy, used to build batched draws
+    IndexList         m_indexes;
+    VertexBuffer*     m_vertexBuffer   = nullptr;
+    IndexBuffer*      m_indexBuffer    = nullptr;
+    unsigned int      m_indexCount     = 0;
+    float             m_boundingRadius = 0.f;       // Around the model origin
+};
+
+//----------------------------------------------------------------------------------------------------
+void AppendPieceMeshInstance(sPieceMesh const& mesh, Mat44 const& modelToWorld, Rgba8 const& color, VertexList_PCUTBN& out_verts, IndexList& out_indexes);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Process-wide store of piece meshes keyed by a hash of the XML part list and LOD level. PieceDefinitions are
+/// reloaded on every return to MATCH, but a part list is baked, optimized by OptimizeMesh and
+/// uploaded only the first time it is seen. The baked vertexes and indexes can be saved to and loaded from a binary cache file, so a
+/// later run skips the geometry generation too.
+class PieceMeshCache
+{
+public:
+    static sPieceMesh const* GetOrCreateMesh(std::vector<sPiecePart> const& parts, int lodLevel);
+    static uint64_t          GetPartListKey(std::vector<sPiecePart> const& parts, int lodLevel);
+
+    static bool LoadFromFile(String const& filePath);
+    static bool SaveToFile(String const& filePath);
+    static void ClearAll();
+
+    static int GetMeshCount();
+    static int GetBakeCount();
+
+private:
+    static void BakeMesh(std::vector<sPiecePart> const& parts, int lodLevel, sPieceMesh& out_mesh);
+    static void CreateBuffers(sPieceMesh& mesh);
+    static void ComputeBounds(sPieceMesh& mesh);
+
+    static std::vector<sPieceMesh*> s_meshes;
+    static int                      s_bakeCount;    // Meshes generated from parts rather than loaded
+    static bool                     s_isDirty;      // Holds meshes the cache file does not have yet
+};
@@ -5,8 +5,100 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Framework/AIController.hpp"
 
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/EventSystem.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Match.hpp"
+#include "Game/Subsystem/OpeningBook/OpeningBookSubsystem.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+AIController::AIController(Game*                      owner,
+                           sAIControllerConfig const& config)
+    : Controller(owner),
+      m_config(config),
+      m_random(std::random_device()())
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// On this controller's turn, pick a move and submit it through the same ChessMove event the player
+/// and DevConsole use, so the Match validates it like any other move. The Match handles the event
+/// synchronously, so if it is still this controller's turn afterwards the move was rejected. A rejected
+/// book or tablebase move is retried once with search only; after that, no move is submitted again
+/// until the position changes.
+void AIController::Update(float const deltaSeconds)
+{
+    UNUSED(deltaSeconds)
+
+    Match const* match = g_theGame->m_match;
+
+    if (match == nullptr || g_theGame->GetCurrentGameState() != eGameState::MATCH || g_theGame->GetCurrentPlayerControllerId() != m_index)
+    {
+        m_rejectedMoveCount = 0;
+        return;
+    }
+
+    sChessPosition const position = match->GetChessPosition();
+    uint64_t const       key      = position.GetZobristKey();
+
+    if (m_rejectedMoveCount > 0 && key != m_rejectedKey) m_rejectedMoveCount = 0;
+    if (m_rejectedMoveCount >= 2) return;
+
+    sAIControllerConfig config = m_config;
+
+    if (m_rejectedMoveCount == 1)
+    {
+        config.m_useOpeningBook = false;
+        config.m_useTablebase   = false;
+    }
+
+    sChessMove move;
+    if (!ChooseMove(config, position, move, &m_random)) return;
+
+    EventArgs args;
+    args.SetValue("from", GetSquareNameFromIndex(move.m_fromSquare));
+    args.SetValue("to", GetSquareNameFromIndex(move.m_toSquare));
+    args.SetValue("promoteTo", GetPieceNameFromType(move.m_promoteTo));
+    args.SetValue("teleport", "false");
+
+    g_theEventSystem->FireEvent("ChessMove", args);
+
+    if (g_theGame->GetCurrentPlayerControllerId() == m_index)
+    {
+        ++m_rejectedMoveCount;
+        m_rejectedKey = key;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The opening book is consulted first, then the endgame tablebases; either hit is answered without
+/// any search. Otherwise SearchBestMove picks the move. random picks between weighted book moves and
+/// between equally good searched moves; with nullptr the first of each is played. Safe to call from
+/// several threads at once, given separate random engines.
+STATIC bool AIController::ChooseMove(sAIControllerConfig const& config,
+                                     sChessPosition const&      position,
+                                     sChessMove&                out_move,
+                                     std::mt19937*              random)
+{
+    if (config.m_useOpeningBook && g_theOpeningBookSubsystem != nullptr && g_theOpeningBookSubsystem->ProbeMove(position, out_move, random))
+    {
+        return true;
+    }
+
+    if (config.m_useTablebase && g_theTablebaseSubsystem != nullptr && g_theTablebaseSubsystem->ChooseMove(position, out_move))
+    {
+        return true;
+    }
+
+    return SearchBestMove(config, position, out_move, random);
+}
+
 //----------------------------------------------------------------------------------------------------
-AIController::AIController(Game* owner)
-    : Controller(owner)
+sAIControllerConfig const& AIController::GetConfig() const
 {
+    return m_config;
 }
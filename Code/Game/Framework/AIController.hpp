@@ -4,11 +4,27 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <random>
+
 #include "Controller.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/MoveSearch.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class AIController : public Controller
 {
 public:
-    explicit AIController(Game* owner);
+    explicit AIController(Game* owner, sAIControllerConfig const& config = sAIControllerConfig());
+
+    void Update(float deltaSeconds) override;
+
+    sAIControllerConfig const& GetConfig() const;
+
+    static bool ChooseMove(sAIControllerConfig const& config, sChessPosition const& position, sChessMove& out_move, std::mt19937* random);
+
+private:
+    sAIControllerConfig m_config;
+    std::mt19937        m_random;                      // Varies book and tied search moves between games
+    int                 m_rejectedMoveCount = 0;       // Moves the Match refused at m_rejectedKey
+    uint64_t            m_rejectedKey       = 0;
 };
@@ -0,0 +1,276 @@
+//----------------------------------------------------------------------------------------------------
+// AllocationTracker.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/AllocationTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sAllocationCounters
+{
+    std::atomic<uint64_t> m_allocationCount = 0;
+    std::atomic<uint64_t> m_byteCount       = 0;
+    std::atomic<uint64_t> m_freeCount       = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Everything the hooks touch is constant-initialized, so allocations made before main are safe.
+static std::atomic<bool>     s_isTracking                         = false;
+static sAllocationCounters   s_tagCounters[ALLOCATION_TAG_MAX_COUNT];
+static thread_local int      s_currentTagId                       = 0;
+static char const*           s_tagNames[ALLOCATION_TAG_MAX_COUNT] = {"Untagged"};
+static std::atomic<int>      s_tagCount                           = 1;
+static std::mutex            s_tagMutex;
+static sAllocationStatistics s_lastFrameStatistics;
+static sAllocationStatistics s_lastFrameTagStatistics[ALLOCATION_TAG_MAX_COUNT];
+static bool                  s_isFrameTracked                     = false;     // Tracking was on when the current frame began
+static bool                  s_isZeroAllocationRequested          = false;
+static bool                  s_isZeroAllocationArmed              = false;     // Requested when the current frame began
+static uint64_t              s_frameIndex                         = 0;
+
+//----------------------------------------------------------------------------------------------------
+static void RecordAllocation(size_t const size)
+{
+    if (!s_isTracking.load(std::memory_order_relaxed)) return;
+
+    sAllocationCounters& counters = s_tagCounters[s_currentTagId];
+    counters.m_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    counters.m_byteCount.fetch_add(size, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The block's size is not known here, so frees only count, charged to the freeing scope.
+static void RecordFree()
+{
+    if (!s_isTracking.load(std::memory_order_relaxed)) return;
+
+    s_tagCounters[s_currentTagId].m_freeCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+static void* AllocateAligned(size_t const size,
+                             size_t const alignment)
+{
+#if defined(_WIN32)
+    return _aligned_malloc(size, alignment);
+#else
+    return std::aligned_alloc(alignment, (size + alignment - 1) & ~(alignment - 1));
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+static void FreeAligned(void* block)
+{
+#if defined(_WIN32)
+    _aligned_free(block);
+#else
+    std::free(block);
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+// Global replacements. The array, nothrow and sized forms are left to the standard library, whose
+// defaults forward to these four, so every form is counted once.
+void* operator new(size_t const size)
+{
+    RecordAllocation(size);
+
+    void* const block = std::malloc(size == 0 ? 1 : size);
+
+    if (block == nullptr) throw std::bad_alloc();
+
+    return block;
+}
+
+//----------------------------------------------------------------------------------------------------
+void* operator new(size_t const          size,
+                   std::align_val_t const alignment)
+{
+    RecordAllocation(size);
+
+    void* const block = AllocateAligned(size == 0 ? 1 : size, static_cast<size_t>(alignment));
+
+    if (block == nullptr) throw std::bad_alloc();
+
+    return block;
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void* block) noexcept
+{
+    if (block == nullptr) return;
+
+    RecordFree();
+    std::free(block);
+}
+
+//----------------------------------------------------------------------------------------------------
+void operator delete(void*                  block,
+                     std::align_val_t const alignment) noexcept
+{
+    UNUSED(alignment)
+
+    if (block == nullptr) return;
+
+    RecordFree();
+    FreeAligned(block);
+}
+
+//----------------------------------------------------------------------------------------------------
+AllocationScope::AllocationScope(int const tagId)
+    : m_previousTagId(s_currentTagId)
+{
+    s_currentTagId = tagId;
+}
+
+//----------------------------------------------------------------------------------------------------
+AllocationScope::~AllocationScope()
+{
+    s_currentTagId = m_previousTagId;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns the id of the tag called name, adding it on first use. Registering never allocates,
+/// so it is safe whether or not tracking is on.
+int RegisterAllocationTag(char const* name)
+{
+    std::lock_guard const lock(s_tagMutex);
+
+    int const tagCount = s_tagCount.load(std::memory_order_relaxed);
+
+    for (int tagId = 0; tagId < tagCount; ++tagId)
+    {
+        if (std::strcmp(s_tagNames[tagId], name) == 0) return tagId;
+    }
+
+    if (tagCount >= ALLOCATION_TAG_MAX_COUNT)
+    {
+        ERROR_AND_DIE(Stringf("Too many allocation tags; raise ALLOCATION_TAG_MAX_COUNT to add \"%s\"", name))
+    }
+
+    s_tagNames[tagCount] = name;
+    s_tagCount.store(tagCount + 1, std::memory_order_release);
+
+    return tagCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Publishes the frame that just ended and starts counting a new one. With the zero-allocation assert
+/// on, dies listing the offending tags if that frame allocated; a frame is only checked when tracking
+/// and the assert were both on from its start, so the frame that turns them on is never blamed.
+void AllocationTrackerBeginFrame()
+{
+    int const tagCount = s_tagCount.load(std::memory_order_acquire);
+
+    s_lastFrameStatistics = sAllocationStatistics();
+
+    for (int tagId = 0; tagId < tagCount; ++tagId)
+    {
+        sAllocationCounters&   counters   = s_tagCounters[tagId];
+        sAllocationStatistics& statistics = s_lastFrameTagStatistics[tagId];
+
+        statistics.m_allocationCount = counters.m_allocationCount.exchange(0, std::memory_order_relaxed);
+        statistics.m_byteCount       = counters.m_byteCount.exchange(0, std::memory_order_relaxed);
+        statistics.m_freeCount       = counters.m_freeCount.exchange(0, std::memory_order_relaxed);
+
+        s_lastFrameStatistics.m_allocationCount += statistics.m_allocationCount;
+        s_lastFrameStatistics.m_byteCount += statistics.m_byteCount;
+        s_lastFrameStatistics.m_freeCount += statistics.m_freeCount;
+    }
+
+    bool const isFrameChecked = s_isZeroAllocationArmed && s_isFrameTracked && s_isTracking.load(std::memory_order_relaxed);
+
+    if (isFrameChecked && s_lastFrameStatistics.m_allocationCount > 0)
+    {
+        ERROR_AND_DIE(Stringf("Frame %llu was meant to allocate nothing. %s", static_cast<unsigned long long>(s_frameIndex), GetLastFrameAllocationReport().c_str()))
+    }
+
+    s_isFrameTracked        = s_isTracking.load(std::memory_order_relaxed);
+    s_isZeroAllocationArmed = s_isZeroAllocationRequested;
+    ++s_frameIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SetAllocationTrackingEnabled(bool const isEnabled)
+{
+    s_isTracking.store(isEnabled, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsAllocationTrackingEnabled()
+{
+    return s_isTracking.load(std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SetZeroAllocationAssertEnabled(bool const isEnabled)
+{
+    s_isZeroAllocationRequested = isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsZeroAllocationAssertEnabled()
+{
+    return s_isZeroAllocationRequested;
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetAllocationTagCount()
+{
+    return s_tagCount.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetAllocationTagName(int const tagId)
+{
+    return s_tagNames[tagId];
+}
+
+//----------------------------------------------------------------------------------------------------
+sAllocationStatistics const& GetLastFrameAllocationStatistics()
+{
+    return s_lastFrameStatistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+sAllocationStatistics const& GetLastFrameAllocationStatistics(int const tagId)
+{
+    return s_lastFrameTagStatistics[tagId];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief One line: the frame's totals, then every tag that allocated, most allocations first.
+String GetLastFrameAllocationReport()
+{
+    int const tagCount = GetAllocationTagCount();
+    int       tagIds[ALLOCATION_TAG_MAX_COUNT];
+    int       usedTagCount = 0;
+
+    for (int tagId = 0; tagId < tagCount; ++tagId)
+    {
+        if (s_lastFrameTagStatistics[tagId].m_allocationCount > 0) tagIds[usedTagCount++] = tagId;
+    }
+
+    std::sort(tagIds, tagIds + usedTagCount, [](int const a, int const b) { return s_lastFrameTagStatistics[a].m_allocationCount > s_lastFrameTagStatistics[b].m_allocationCount; });
+
+    String report = Stringf("Allocations: %llu (%llu B), frees: %llu", static_cast<unsigned long long>(s_lastFrameStatistics.m_allocationCount), static_cast<unsigned long long>(s_lastFrameStatistics.m_byteCount), static_cast<unsigned long long>(s_lastFrameStatistics.m_freeCount));
+
+    for (int tagIndex = 0; tagIndex < usedTagCount; ++tagIndex)
+    {
+        sAllocationStatistics const& statistics = s_lastFrameTagStatistics[tagIds[tagIndex]];
+        report += Stringf("%s %s %llu (%llu B)", tagIndex == 0 ? " |" : ",", s_tagNames[tagIds[tagIndex]], static_cast<unsigned long long>(statistics.m_allocationCount), static_cast<unsigned long long>(statistics.m_byteCount));
+    }
+
+    return report;
+}
@@ -0,0 +1,61 @@
+//----------------------------------------------------------------------------------------------------
+// AllocationTracker.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr ALLOCATION_TAG_MAX_COUNT = 32;     // Tag 0 is "Untagged"
+
+//----------------------------------------------------------------------------------------------------
+struct sAllocationStatistics
+{
+    uint64_t m_allocationCount = 0;
+    uint64_t m_byteCount       = 0;     // Bytes requested; allocator overhead is not included
+    uint64_t m_freeCount       = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Charges every allocation made on this thread inside the scope to a tag, until the scope ends or a
+/// nested scope names another tag. Use ALLOCATION_SCOPE rather than making one directly.
+class AllocationScope
+{
+public:
+    explicit AllocationScope(int tagId);
+    ~AllocationScope();
+
+    AllocationScope(AllocationScope const&)            = delete;
+    AllocationScope& operator=(AllocationScope const&) = delete;
+
+private:
+    int m_previousTagId = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+#define ALLOCATION_CONCAT_INNER(a, b) a##b
+#define ALLOCATION_CONCAT(a, b)       ALLOCATION_CONCAT_INNER(a, b)
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Tags the rest of the enclosing scope. name must be a string literal; the tracker keeps the
+/// pointer, so registering never allocates.
+#define ALLOCATION_SCOPE(name)                                                                         \
+    static int const      ALLOCATION_CONCAT(allocationTagId_, __LINE__) = RegisterAllocationTag(name); \
+    AllocationScope const ALLOCATION_CONCAT(allocationScope_, __LINE__)(ALLOCATION_CONCAT(allocationTagId_, __LINE__))
+
+//----------------------------------------------------------------------------------------------------
+int                          RegisterAllocationTag(char const* name);
+void                         AllocationTrackerBeginFrame();
+void                         SetAllocationTrackingEnabled(bool isEnabled);
+bool                         IsAllocationTrackingEnabled();
+void                         SetZeroAllocationAssertEnabled(bool isEnabled);
+bool                         IsZeroAllocationAssertEnabled();
+int                          GetAllocationTagCount();
+char const*                  GetAllocationTagName(int tagId);
+sAllocationStatistics const& GetLastFrameAllocationStatistics();
+sAllocationStatistics const& GetLastFrameAllocationStatistics(int tagId);
+String                       GetLastFrameAllocationReport();
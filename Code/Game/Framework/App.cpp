@@ -18,22 +18,32 @@
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Engine/Resource/ResourceSubsystem.hpp"
+#include "Game/Framework/AllocationTracker.hpp"
+#include "Game/Framework/CounterRegistry.hpp"
+#include "Game/Framework/FramePacer.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/InputRecorder.hpp"
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Gameplay/Match.hpp"
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Game/Subsystem/OpeningBook/OpeningBookSubsystem.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
 
 //----------------------------------------------------------------------------------------------------
-App*                   g_theApp               = nullptr;       // Created and owned by Main_Windows.cpp
-AudioSystem*           g_theAudio             = nullptr;       // Created and owned by the App
-BitmapFont*            g_theBitmapFont        = nullptr;       // Created and owned by the App
-Game*                  g_theGame              = nullptr;       // Created and owned by the App
-Renderer*              g_theRenderer          = nullptr;       // Created and owned by the App
-RandomNumberGenerator* g_theRNG               = nullptr;       // Created and owned by the App
-Window*                g_theWindow            = nullptr;       // Created and owned by the App
-LightSubsystem*        g_theLightSubsystem    = nullptr;       // Created and owned by the App
-// NetworkSubsystem*      g_theNetworkSubsystem  = nullptr;       // Created and owned by the App
-ResourceSubsystem*     g_theResourceSubsystem = nullptr;       // Created and owned by the App
+App*                   g_theApp                  = nullptr;       // Created and owned by Main_Windows.cpp
+AudioSystem*           g_theAudio                = nullptr;       // Created and owned by the App
+BitmapFont*            g_theBitmapFont           = nullptr;       // Created and owned by the App
+Game*                  g_theGame                 = nullptr;       // Created and owned by the App
+Renderer*              g_theRenderer             = nullptr;       // Created and owned by the App
+RandomNumberGenerator* g_theRNG                  = nullptr;       // Created and owned by the App
+Window*                g_theWindow               = nullptr;       // Created and owned by the App
+LightSubsystem*        g_theLightSubsystem       = nullptr;       // Created and owned by the App
+OpeningBookSubsystem*  g_theOpeningBookSubsystem = nullptr;       // Created and owned by the App
+TablebaseSubsystem*    g_theTablebaseSubsystem   = nullptr;       // Created and owned by the App
+// NetworkSubsystem*      g_theNetworkSubsystem     = nullptr;       // Created and owned by the App
+ResourceSubsystem*     g_theResourceSubsystem    = nullptr;       // Created and owned by the App
 
 //----------------------------------------------------------------------------------------------------
 STATIC bool App::m_isQuitting = false;
@@ -45,12 +55,23 @@ void App::Startup()
 {
     LoadGameConfig("Data/GameConfig.xml");
 
+    SetAllocationTrackingEnabled(g_gameConfigBlackboard.GetValue("trackAllocations", false));
+    SetZeroAllocationAssertEnabled(g_gameConfigBlackboard.GetValue("assertZeroAllocationFrames", false));
+    CountersStartUp();
+
     //-Start-of-EventSystem---------------------------------------------------------------------------
 
     sEventSystemConfig constexpr eventSystemConfig;
     g_theEventSystem = new EventSystem(eventSystemConfig);
     g_theEventSystem->SubscribeEventCallbackFunction("OnCloseButtonClicked", OnCloseButtonClicked);
     g_theEventSystem->SubscribeEventCallbackFunction("quit", OnCloseButtonClicked);
+    g_theEventSystem->SubscribeEventCallbackFunction("frame_limit", OnFrameLimit);
+    g_theEventSystem->SubscribeEventCallbackFunction("profile_capture", OnProfileCapture);
+    g_theEventSystem->SubscribeEventCallbackFunction("profile_overlay", OnProfileOverlay);
+    g_theEventSystem->SubscribeEventCallbackFunction("counter_dump", OnCounterDump);
+    g_theEventSystem->SubscribeEventCallbackFunction("counter_overlay", OnCounterOverlay);
+    g_theEventSystem->SubscribeEventCallbackFunction("alloc_track", OnAllocationTrack);
+    g_theEventSystem->SubscribeEventCallbackFunction("alloc_report", OnAllocationReport);
 
     //-End-of-EventSystem-----------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
@@ -127,6 +148,25 @@ void App::Startup()
 
     //-End-of-LightSubsystem--------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------
+    //-Start-of-OpeningBookSubsystem------------------------------------------------------------------
+
+    sOpeningBookSubsystemConfig openingBookSubsystemConfig;
+    openingBookSubsystemConfig.m_bookFilePath     = g_gameConfigBlackboard.GetValue("openingBookPath", openingBookSubsystemConfig.m_bookFilePath);
+    openingBookSubsystemConfig.m_gameDatabasePath = g_gameConfigBlackboard.GetValue("openingBookGameDatabasePath", openingBookSubsystemConfig.m_gameDatabasePath);
+    openingBookSubsystemConfig.m_maxBookPly       = g_gameConfigBlackboard.GetValue("openingBookMaxPly", openingBookSubsystemConfig.m_maxBookPly);
+    g_theOpeningBookSubsystem                     = new OpeningBookSubsystem(openingBookSubsystemConfig);
+
+    //-End-of-OpeningBookSubsystem--------------------------------------------------------------------
+    //------------------------------------------------------------------------------------------------
+    //-Start-of-TablebaseSubsystem--------------------------------------------------------------------
+
+    sTablebaseSubsystemConfig tablebaseSubsystemConfig;
+    tablebaseSubsystemConfig.m_tablebaseDirectory   = g_gameConfigBlackboard.GetValue("tablebaseDirectory", tablebaseSubsystemConfig.m_tablebaseDirectory);
+    tablebaseSubsystemConfig.m_generatorThreadCount = g_gameConfigBlackboard.GetValue("tablebaseThreadCount", tablebaseSubsystemConfig.m_generatorThreadCount);
+    g_theTablebaseSubsystem                         = new TablebaseSubsystem(tablebaseSubsystemConfig);
+
+    //-End-of-TablebaseSubsystem----------------------------------------------------------------------
+    //------------------------------------------------------------------------------------------------
     //-Start-of-NetworkSubsystem----------------------------------------------------------------------
 
     // sNetworkSubsystemConfig networkSubsystemConfig;
@@ -153,9 +193,17 @@ void App::Startup()
     g_theInput->Startup();
     g_theAudio->Startup();
     g_theLightSubsystem->StartUp();
+    g_theOpeningBookSubsystem->StartUp();
+    g_theTablebaseSubsystem->StartUp();
     // g_theNetworkSubsystem->StartUp();
     g_theResourceSubsystem->Startup();
 
+    sFramePacerConfig framePacerConfig;
+    framePacerConfig.m_maxFrameRate        = g_gameConfigBlackboard.GetValue("maxFrameRate", framePacerConfig.m_maxFrameRate);
+    framePacerConfig.m_backgroundFrameRate = g_gameConfigBlackboard.GetValue("backgroundFrameRate", framePacerConfig.m_backgroundFrameRate);
+    framePacerConfig.m_mode                = FramePacer::GetModeByName(g_gameConfigBlackboard.GetValue("framePacingMode", "spin").c_str(), framePacerConfig.m_mode);
+    m_framePacer                           = new FramePacer(framePacerConfig);
+
     g_theBitmapFont = g_theRenderer->CreateOrGetBitmapFontFromFile("Data/Fonts/SquirrelFixedFont"); // DO NOT SPECIFY FILE .EXTENSION!!  (Important later on.)
     g_theRNG        = new RandomNumberGenerator();
     g_theGame       = new Game();
@@ -168,11 +216,14 @@ void App::Shutdown()
 {
     // Destroy all Engine Subsystem
     GAME_SAFE_RELEASE(g_theGame);
+    GAME_SAFE_RELEASE(m_framePacer);
     GAME_SAFE_RELEASE(g_theRNG);
     GAME_SAFE_RELEASE(g_theBitmapFont);
 
     // g_theResourceSubsystem->Shutdown();
     // g_theNetworkSubsystem->ShutDown();
+    g_theTablebaseSubsystem->ShutDown();
+    g_theOpeningBookSubsystem->ShutDown();
     g_theLightSubsystem->ShutDown();
     g_theAudio->Shutdown();
     g_theInput->Shutdown();
@@ -186,6 +237,8 @@ void App::Shutdown()
     g_theEventSystem->Shutdown();
 
     // GAME_SAFE_RELEASE(g_theResourceSubsystem);
+    GAME_SAFE_RELEASE(g_theTablebaseSubsystem);
+    GAME_SAFE_RELEASE(g_theOpeningBookSubsystem);
     GAME_SAFE_RELEASE(g_theAudio);
     GAME_SAFE_RELEASE(g_theRenderer);
     GAME_SAFE_RELEASE(g_theWindow);
@@ -197,10 +250,14 @@ void App::Shutdown()
 //
 void App::RunFrame()
 {
+    ProfilerBeginFrame();
+
     BeginFrame();   // Engine pre-frame stuff
     Update();       // Game updates / moves / spawns / hurts / kills stuff
     Render();       // Game draws current state of things
     EndFrame();     // Engine post-frame stuff
+
+    ProfilerEndFrame();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -209,8 +266,10 @@ void App::RunMainLoop()
     // Program main loop; keep running frames until it's time to quit
     while (!m_isQuitting)
     {
-        // Sleep(16); // Temporary code to "slow down" our app to ~60Hz until we have proper frame timing in
         RunFrame();
+
+        // Idle boards no longer spin the CPU at whatever rate the GPU allows.
+        m_framePacer->WaitForNextFrame(GetActiveWindow() != g_theWindow->GetWindowHandle());
     }
 }
 
@@ -224,6 +283,121 @@ STATIC bool App::OnCloseButtonClicked(EventArgs& args)
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief frame_limit fps=60 background=15 mode=spin
+/// Changes the frame cap; mode is off, sleep or spin. Arguments left out keep their current values.
+STATIC bool App::OnFrameLimit(EventArgs& args)
+{
+    FramePacer* const framePacer = g_theApp->m_framePacer;
+    sFramePacerConfig config     = framePacer->GetConfig();
+
+    config.m_maxFrameRate        = args.GetValue("fps", config.m_maxFrameRate);
+    config.m_backgroundFrameRate = args.GetValue("background", config.m_backgroundFrameRate);
+    config.m_mode                = FramePacer::GetModeByName(args.GetValue("mode", FramePacer::GetModeName(config.m_mode)).c_str(), config.m_mode);
+    framePacer->SetConfig(config);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[FramePacer] %.0f fps, %.0f fps in background, mode %s", config.m_maxFrameRate, config.m_backgroundFrameRate, FramePacer::GetModeName(config.m_mode)));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief profile_capture frames=120 file=ProfileCapture.json
+/// Records the next frames with the profiler and writes them as Chrome trace JSON, which
+/// chrome://tracing and ui.perfetto.dev open.
+STATIC bool App::OnProfileCapture(EventArgs& args)
+{
+    int const    frameCount = args.GetValue("frames", 120);
+    String const filePath   = args.GetValue("file", "ProfileCapture.json");
+
+    StartProfilerCapture(frameCount, filePath);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Profiler] Capturing %d frames to %s", frameCount, filePath.c_str()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief profile_overlay visible=true
+/// Shows or hides the profiler's flame graph of the last frame; without arguments it toggles, as F9 does.
+STATIC bool App::OnProfileOverlay(EventArgs& args)
+{
+    SetProfilerOverlayVisible(args.GetValue("visible", !IsProfilerOverlayVisible()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief counter_dump file=Counters.csv
+/// Writes every counter's per-frame values for the last COUNTER_SESSION_FRAME_COUNT frames as CSV.
+STATIC bool App::OnCounterDump(EventArgs& args)
+{
+    String const filePath = args.GetValue("file", "Counters.csv");
+
+    if (WriteCountersCsv(filePath))
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Counters] Wrote %d counters to %s", GetCounterCount(), filePath.c_str()));
+    }
+    else
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Counters] Could not write %s", filePath.c_str()));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief counter_overlay visible=true
+/// Shows or hides the counter table; without arguments it toggles, as F8 does.
+STATIC bool App::OnCounterOverlay(EventArgs& args)
+{
+    SetCounterOverlayVisible(args.GetValue("visible", !IsCounterOverlayVisible()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief alloc_track enabled=true assert_zero=false
+/// Turns allocation tracking and the zero-allocation frame assert on or off. Arguments left out keep
+/// their current values; the assert only checks frames while tracking is on.
+STATIC bool App::OnAllocationTrack(EventArgs& args)
+{
+    SetAllocationTrackingEnabled(args.GetValue("enabled", IsAllocationTrackingEnabled()));
+    SetZeroAllocationAssertEnabled(args.GetValue("assert_zero", IsZeroAllocationAssertEnabled()));
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[AllocationTracker] Tracking %s, zero-allocation assert %s", IsAllocationTrackingEnabled() ? "on" : "off", IsZeroAllocationAssertEnabled() ? "on" : "off"));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief alloc_report
+/// Prints the last frame's allocations, one line per tag that allocated.
+STATIC bool App::OnAllocationReport(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (!IsAllocationTrackingEnabled())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[AllocationTracker] Tracking is off; enable it with alloc_track enabled=true");
+        return true;
+    }
+
+    sAllocationStatistics const& total = GetLastFrameAllocationStatistics();
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[AllocationTracker] Last frame: %llu allocations, %llu B, %llu frees", static_cast<unsigned long long>(total.m_allocationCount), static_cast<unsigned long long>(total.m_byteCount), static_cast<unsigned long long>(total.m_freeCount)));
+
+    for (int tagId = 0; tagId < GetAllocationTagCount(); ++tagId)
+    {
+        sAllocationStatistics const& statistics = GetLastFrameAllocationStatistics(tagId);
+
+        if (statistics.m_allocationCount == 0 && statistics.m_freeCount == 0) continue;
+
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-28s %6llu allocations %10llu B %6llu frees", GetAllocationTagName(tagId), static_cast<unsigned long long>(statistics.m_allocationCount), static_cast<unsigned long long>(statistics.m_byteCount), static_cast<unsigned long long>(statistics.m_freeCount)));
+    }
+
+    return true;
+}
+
 //----------------------------------------------------------------------------------------------------
 STATIC void App::RequestQuit()
 {
@@ -233,6 +407,9 @@ STATIC void App::RequestQuit()
 //----------------------------------------------------------------------------------------------------
 void App::BeginFrame() const
 {
+    PROFILE_SCOPE("App::BeginFrame");
+    ALLOCATION_SCOPE("App::BeginFrame");
+
     g_theEventSystem->BeginFrame();
     g_theWindow->BeginFrame();
     g_theRenderer->BeginFrame();
@@ -240,14 +417,22 @@ void App::BeginFrame() const
     g_theDevConsole->BeginFrame();
     g_theInput->BeginFrame();
     g_theAudio->BeginFrame();
+    RenderStatisticsBeginFrame();
+    CountersBeginFrame();
+    AllocationTrackerBeginFrame();
     g_theLightSubsystem->BeginFrame();
+    g_theTablebaseSubsystem->BeginFrame();
     // g_theNetworkSubsystem->BeginFrame();
 }
 
 //----------------------------------------------------------------------------------------------------
 void App::Update()
 {
+    PROFILE_SCOPE("App::Update");
+    ALLOCATION_SCOPE("App::Update");
+
     Clock::TickSystemClock();
+    InputRecorderBeginFrame();
 
     UpdateCursorMode();
     g_theGame->Update();
@@ -263,6 +448,9 @@ void App::Update()
 //
 void App::Render() const
 {
+    PROFILE_SCOPE("App::Render");
+    ALLOCATION_SCOPE("App::Render");
+
     Rgba8 const clearColor = Rgba8::BLACK;
 
     g_theRenderer->ClearScreen(clearColor, Rgba8::BLACK);
@@ -276,6 +464,9 @@ void App::Render() const
 //----------------------------------------------------------------------------------------------------
 void App::EndFrame() const
 {
+    PROFILE_SCOPE("App::EndFrame");
+    ALLOCATION_SCOPE("App::EndFrame");
+
     g_theEventSystem->EndFrame();
     g_theWindow->EndFrame();
     g_theRenderer->EndFrame();
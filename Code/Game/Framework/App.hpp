@@ -8,6 +8,7 @@
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Camera;
+class FramePacer;
 
 //----------------------------------------------------------------------------------------------------
 class App
@@ -22,6 +23,13 @@ public:
     void RunMainLoop();
 
     static bool OnCloseButtonClicked(EventArgs& args);
+    static bool OnFrameLimit(EventArgs& args);
+    static bool OnProfileCapture(EventArgs& args);
+    static bool OnProfileOverlay(EventArgs& args);
+    static bool OnCounterDump(EventArgs& args);
+    static bool OnCounterOverlay(EventArgs& args);
+    static bool OnAllocationTrack(EventArgs& args);
+    static bool OnAllocationReport(EventArgs& args);
     static void RequestQuit();
     static bool m_isQuitting;
 
@@ -34,5 +42,6 @@ private:
     void UpdateCursorMode() const;
     void LoadGameConfig(char const* gameConfigXmlFilePath) const;
 
-    Camera* m_devConsoleCamera = nullptr;
+    Camera*     m_devConsoleCamera = nullptr;
+    FramePacer* m_framePacer       = nullptr;
 };
@@ -0,0 +1,572 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPosition.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ChessPosition.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Zobrist keys use the Polyglot layout: 768 piece-square keys, 4 castling keys, 8 en passant file
+// keys and 1 side-to-move key. Keys match third-party Polyglot books only once Polyglot's Random64
+// table is loaded (LoadPolyglotRandom64); until then a fixed-seed generator fills the table, so keys
+// are still stable across runs and machines and books built by book_build stay consistent.
+//
+int constexpr ZOBRIST_PIECE_OFFSET      = 0;
+int constexpr ZOBRIST_CASTLING_OFFSET   = 768;
+int constexpr ZOBRIST_EN_PASSANT_OFFSET = 772;
+int constexpr ZOBRIST_TURN_OFFSET       = 780;
+int constexpr ZOBRIST_KEY_COUNT         = 781;
+
+//----------------------------------------------------------------------------------------------------
+struct sZobristTable
+{
+    sZobristTable()
+    {
+        // SplitMix64
+        uint64_t state = 0x9E3779B97F4A7C15ull;
+
+        for (uint64_t& key : m_keys)
+        {
+            state += 0x9E3779B97F4A7C15ull;
+            uint64_t z = state;
+            z          = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+            z          = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+            key        = z ^ (z >> 31);
+        }
+    }
+
+    uint64_t m_keys[ZOBRIST_KEY_COUNT] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+// Test positions from the Polyglot book format specification, as moves from the starting position,
+// with the key each one must hash to under Random64.
+struct sPolyglotTestPosition
+{
+    char const* m_moves;
+    uint64_t    m_key;
+};
+
+static sPolyglotTestPosition constexpr POLYGLOT_TEST_POSITIONS[] = {
+    {"", 0x463B96181691FC9Cull},
+    {"e2e4", 0x823C9B50FD114196ull},
+    {"e2e4 d7d5", 0x0756B94461C50FB0ull},
+    {"e2e4 d7d5 e4e5", 0x662FAFB965DB29D4ull},
+    {"e2e4 d7d5 e4e5 f7f5", 0x22A48B5A8E47FF78ull},
+    {"e2e4 d7d5 e4e5 f7f5 e1e2", 0x652A607CA3F242C1ull},
+    {"e2e4 d7d5 e4e5 f7f5 e1e2 e8f7", 0x00FDD303C946BDD9ull},
+    {"a2a4 b7b5 h2h4 b5b4 c2c4", 0x3C8123EA7B067637ull},
+    {"a2a4 b7b5 h2h4 b5b4 c2c4 b4c3 a1a3", 0x5C3F9B829B279560ull},
+};
+
+//----------------------------------------------------------------------------------------------------
+static sZobristTable s_zobristTable;     // Written only by LoadPolyglotRandom64, before any search runs
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t const* GetZobristKeys()
+{
+    return s_zobristTable.m_keys;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// Polyglot orders pieces pawn, knight, bishop, rook, queen, king; ePieceType swaps knight and bishop.
+static int GetPolyglotPieceKind(sChessSquare const& square)
+{
+    static int constexpr POLYGLOT_TYPE_INDEX[] = {0, 2, 1, 3, 4, 5};
+
+    int const typeIndex = POLYGLOT_TYPE_INDEX[static_cast<int>(square.m_type)];
+    int const isFirst   = square.m_playerId == 0 ? 1 : 0;
+
+    return typeIndex * 2 + isFirst;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sChessMove::operator==(sChessMove const& compare) const
+{
+    return m_fromSquare == compare.m_fromSquare &&
+        m_toSquare == compare.m_toSquare &&
+        m_promoteTo == compare.m_promoteTo;
+}
+
+//----------------------------------------------------------------------------------------------------
+sChessPosition sChessPosition::GetStartingPosition()
+{
+    static ePieceType constexpr BACK_RANK[CHESS_BOARD_SIZE] = {
+        ePieceType::ROOK, ePieceType::KNIGHT, ePieceType::BISHOP, ePieceType::QUEEN,
+        ePieceType::KING, ePieceType::BISHOP, ePieceType::KNIGHT, ePieceType::ROOK
+    };
+
+    sChessPosition position;
+
+    for (int file = 0; file < CHESS_BOARD_SIZE; ++file)
+    {
+        position.m_squares[file]      = {BACK_RANK[file], 0};
+        position.m_squares[8 + file]  = {ePieceType::PAWN, 0};
+        position.m_squares[48 + file] = {ePieceType::PAWN, 1};
+        position.m_squares[56 + file] = {BACK_RANK[file], 1};
+    }
+
+    return position;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Plays a move without validating it; callers are expected to pass a move the rules allow.
+void sChessPosition::ApplyMove(sChessMove const& move)
+{
+    sChessSquare const moving   = m_squares[move.m_fromSquare];
+    sChessSquare const captured = m_squares[move.m_toSquare];
+
+    int const fromFile = move.m_fromSquare % CHESS_BOARD_SIZE;
+    int const toFile   = move.m_toSquare % CHESS_BOARD_SIZE;
+    int const toRank   = move.m_toSquare / CHESS_BOARD_SIZE;
+
+    bool const isPawn = moving.m_type == ePieceType::PAWN;
+
+    m_halfMoveClock = (isPawn || !captured.IsEmpty()) ? 0 : m_halfMoveClock + 1;
+
+    // En passant removes the pawn that sits beside the capturing pawn.
+    if (isPawn && fromFile != toFile && captured.IsEmpty() && move.m_toSquare == m_enPassantSquare)
+    {
+        int const capturedSquare  = move.m_fromSquare - fromFile + toFile;
+        m_squares[capturedSquare] = sChessSquare();
+    }
+
+    // Castling is recorded as the king's move, so bring the rook along.
+    if (moving.m_type == ePieceType::KING && std::abs(toFile - fromFile) == 2)
+    {
+        bool const isKingSide = toFile > fromFile;
+        int const  rankStart  = move.m_fromSquare - fromFile;
+        int const  rookFrom   = rankStart + (isKingSide ? 7 : 0);
+        int const  rookTo     = rankStart + (isKingSide ? 5 : 3);
+
+        m_squares[rookTo]   = m_squares[rookFrom];
+        m_squares[rookFrom] = sChessSquare();
+    }
+
+    m_squares[move.m_toSquare]   = moving;
+    m_squares[move.m_fromSquare] = sChessSquare();
+
+    if (isPawn && (toRank == 0 || toRank == CHESS_BOARD_SIZE - 1))
+    {
+        m_squares[move.m_toSquare].m_type = move.m_promoteTo != ePieceType::NONE ? move.m_promoteTo : ePieceType::QUEEN;
+    }
+
+    // Any move from or onto a corner or king square forfeits the matching castling rights.
+    auto const clearRightsForSquare = [this](int const square)
+    {
+        switch (square)
+        {
+        case 0: m_castlingRights &= ~CASTLING_FIRST_QUEENSIDE;
+            break;
+        case 4: m_castlingRights &= ~(CASTLING_FIRST_KINGSIDE | CASTLING_FIRST_QUEENSIDE);
+            break;
+        case 7: m_castlingRights &= ~CASTLING_FIRST_KINGSIDE;
+            break;
+        case 56: m_castlingRights &= ~CASTLING_SECOND_QUEENSIDE;
+            break;
+        case 60: m_castlingRights &= ~(CASTLING_SECOND_KINGSIDE | CASTLING_SECOND_QUEENSIDE);
+            break;
+        case 63: m_castlingRights &= ~CASTLING_SECOND_KINGSIDE;
+            break;
+        default: break;
+        }
+    };
+
+    clearRightsForSquare(move.m_fromSquare);
+    clearRightsForSquare(move.m_toSquare);
+
+    m_enPassantSquare = -1;
+
+    if (isPawn && std::abs(move.m_toSquare - move.m_fromSquare) == 2 * CHESS_BOARD_SIZE)
+    {
+        m_enPassantSquare = static_cast<int8_t>((move.m_fromSquare + move.m_toSquare) / 2);
+    }
+
+    if (m_sideToMove == 1) ++m_fullMoveNumber;
+    m_sideToMove = static_cast<int8_t>(1 - m_sideToMove);
+}
+
+//----------------------------------------------------------------------------------------------------
+int sChessPosition::GetPly() const
+{
+    return (m_fullMoveNumber - 1) * 2 + m_sideToMove;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t sChessPosition::GetZobristKey() const
+{
+    uint64_t const* keys = GetZobristKeys();
+    uint64_t        key  = 0;
+
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        sChessSquare const& chessSquare = m_squares[square];
+        if (chessSquare.IsEmpty()) continue;
+
+        key ^= keys[ZOBRIST_PIECE_OFFSET + 64 * GetPolyglotPieceKind(chessSquare) + square];
+    }
+
+    if (m_castlingRights & CASTLING_FIRST_KINGSIDE) key ^= keys[ZOBRIST_CASTLING_OFFSET + 0];
+    if (m_castlingRights & CASTLING_FIRST_QUEENSIDE) key ^= keys[ZOBRIST_CASTLING_OFFSET + 1];
+    if (m_castlingRights & CASTLING_SECOND_KINGSIDE) key ^= keys[ZOBRIST_CASTLING_OFFSET + 2];
+    if (m_castlingRights & CASTLING_SECOND_QUEENSIDE) key ^= keys[ZOBRIST_CASTLING_OFFSET + 3];
+
+    if (CanCaptureEnPassant()) key ^= keys[ZOBRIST_EN_PASSANT_OFFSET + m_enPassantSquare % CHESS_BOARD_SIZE];
+
+    if (m_sideToMove == 0) key ^= keys[ZOBRIST_TURN_OFFSET];
+
+    return key;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Polyglot only hashes the en passant file when a pawn of the side to move can take it.
+bool sChessPosition::CanCaptureEnPassant() const
+{
+    if (m_enPassantSquare < 0) return false;
+
+    int const file        = m_enPassantSquare % CHESS_BOARD_SIZE;
+    int const pawnRank    = m_sideToMove == 0 ? 4 : 3;
+    int const pawnSquares = pawnRank * CHESS_BOARD_SIZE;
+
+    for (int const neighborFile : {file - 1, file + 1})
+    {
+        if (neighborFile < 0 || neighborFile >= CHESS_BOARD_SIZE) continue;
+
+        sChessSquare const& square = m_squares[pawnSquares + neighborFile];
+
+        if (square.m_type == ePieceType::PAWN && square.m_playerId == m_sideToMove) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::string GetSquareNameFromIndex(int const squareIndex)
+{
+    if (squareIndex < 0 || squareIndex >= CHESS_BOARD_SQUARE_COUNT) return std::string("");
+
+    std::string result;
+    result += static_cast<char>('a' + squareIndex % CHESS_BOARD_SIZE);
+    result += static_cast<char>('1' + squareIndex / CHESS_BOARD_SIZE);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetSquareIndexFromName(std::string const& squareName)
+{
+    if (squareName.length() != 2) return -1;
+
+    int const file = tolower(static_cast<unsigned char>(squareName[0])) - 'a';
+    int const rank = squareName[1] - '1';
+
+    if (file < 0 || file >= CHESS_BOARD_SIZE || rank < 0 || rank >= CHESS_BOARD_SIZE) return -1;
+
+    return rank * CHESS_BOARD_SIZE + file;
+}
+
+//----------------------------------------------------------------------------------------------------
+ePieceType GetPieceTypeFromName(std::string const& name)
+{
+    if (name == "pawn") return ePieceType::PAWN;
+    if (name == "bishop") return ePieceType::BISHOP;
+    if (name == "knight") return ePieceType::KNIGHT;
+    if (name == "rook") return ePieceType::ROOK;
+    if (name == "queen") return ePieceType::QUEEN;
+    if (name == "king") return ePieceType::KING;
+
+    return ePieceType::NONE;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetPieceNameFromType(ePieceType const type)
+{
+    switch (type)
+    {
+    case ePieceType::PAWN: return "pawn";
+    case ePieceType::BISHOP: return "bishop";
+    case ePieceType::KNIGHT: return "knight";
+    case ePieceType::ROOK: return "rook";
+    case ePieceType::QUEEN: return "queen";
+    case ePieceType::KING: return "king";
+    case ePieceType::NONE:
+    default: return "";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Formats a move in coordinate notation, e.g. "e2e4" or "e7e8q".
+std::string GetMoveString(sChessMove const& move)
+{
+    std::string result = GetSquareNameFromIndex(move.m_fromSquare) + GetSquareNameFromIndex(move.m_toSquare);
+
+    switch (move.m_promoteTo)
+    {
+    case ePieceType::QUEEN: result += 'q';
+        break;
+    case ePieceType::ROOK: result += 'r';
+        break;
+    case ePieceType::BISHOP: result += 'b';
+        break;
+    case ePieceType::KNIGHT: result += 'n';
+        break;
+    default: break;
+    }
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+sChessMove ParseMoveString(std::string const& moveString)
+{
+    sChessMove move;
+
+    if (moveString.length() < 4) return move;
+
+    int const fromSquare = GetSquareIndexFromName(moveString.substr(0, 2));
+    int const toSquare   = GetSquareIndexFromName(moveString.substr(2, 2));
+
+    if (fromSquare < 0 || toSquare < 0) return move;
+
+    move.m_fromSquare = static_cast<int8_t>(fromSquare);
+    move.m_toSquare   = static_cast<int8_t>(toSquare);
+
+    if (moveString.length() >= 5)
+    {
+        switch (tolower(static_cast<unsigned char>(moveString[4])))
+        {
+        case 'q': move.m_promoteTo = ePieceType::QUEEN;
+            break;
+        case 'r': move.m_promoteTo = ePieceType::ROOK;
+            break;
+        case 'b': move.m_promoteTo = ePieceType::BISHOP;
+            break;
+        case 'n': move.m_promoteTo = ePieceType::KNIGHT;
+            break;
+        default: break;
+        }
+    }
+
+    return move;
+}
+
+//----------------------------------------------------------------------------------------------------
+static char GetFenPieceLetter(sChessSquare const& square)
+{
+    static char constexpr LETTERS[] = "PBNRQK";
+
+    char const letter = LETTERS[static_cast<int>(square.m_type)];
+
+    return square.m_playerId == 0 ? letter : static_cast<char>(tolower(letter));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Formats the position as a six-field FEN string. Player #0 is white.
+std::string GetFenString(sChessPosition const& position)
+{
+    std::string fen;
+
+    for (int rank = CHESS_BOARD_SIZE - 1; rank >= 0; --rank)
+    {
+        int emptyCount = 0;
+
+        for (int file = 0; file < CHESS_BOARD_SIZE; ++file)
+        {
+            sChessSquare const& square = position.m_squares[rank * CHESS_BOARD_SIZE + file];
+
+            if (square.IsEmpty())
+            {
+                ++emptyCount;
+                continue;
+            }
+
+            if (emptyCount > 0) fen += static_cast<char>('0' + emptyCount);
+
+            emptyCount = 0;
+            fen += GetFenPieceLetter(square);
+        }
+
+        if (emptyCount > 0) fen += static_cast<char>('0' + emptyCount);
+        if (rank > 0) fen += '/';
+    }
+
+    fen += position.m_sideToMove == 0 ? " w " : " b ";
+
+    if (position.m_castlingRights & CASTLING_FIRST_KINGSIDE) fen += 'K';
+    if (position.m_castlingRights & CASTLING_FIRST_QUEENSIDE) fen += 'Q';
+    if (position.m_castlingRights & CASTLING_SECOND_KINGSIDE) fen += 'k';
+    if (position.m_castlingRights & CASTLING_SECOND_QUEENSIDE) fen += 'q';
+    if (position.m_castlingRights == CASTLING_NONE) fen += '-';
+
+    fen += ' ';
+    fen += position.m_enPassantSquare >= 0 ? GetSquareNameFromIndex(position.m_enPassantSquare) : std::string("-");
+    fen += ' ' + std::to_string(position.m_halfMoveClock) + ' ' + std::to_string(position.m_fullMoveNumber);
+
+    return fen;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Reads the first four FEN fields, and the move counters when the next two fields are numbers, so
+/// EPD lines (four fields followed by operations) parse too. Counters left out read as 0 and 1.
+/// @return false, leaving out_position untouched, if the placement or side to move is malformed.
+bool ParseFenString(std::string const& fen,
+                    sChessPosition&    out_position)
+{
+    std::istringstream       stream(fen);
+    std::vector<std::string> fields;
+    std::string              field;
+
+    while (fields.size() < 6 && stream >> field)
+    {
+        fields.push_back(field);
+    }
+
+    if (fields.size() < 4) return false;
+
+    sChessPosition position;     // Every square starts empty
+
+    int rank = CHESS_BOARD_SIZE - 1;
+    int file = 0;
+
+    for (char const letter : fields[0])
+    {
+        if (letter == '/')
+        {
+            if (file != CHESS_BOARD_SIZE || rank == 0) return false;
+
+            --rank;
+            file = 0;
+            continue;
+        }
+
+        if (letter >= '1' && letter <= '8')
+        {
+            file += letter - '0';
+            if (file > CHESS_BOARD_SIZE) return false;
+            continue;
+        }
+
+        ePieceType type = ePieceType::NONE;
+
+        switch (toupper(static_cast<unsigned char>(letter)))
+        {
+        case 'P': type = ePieceType::PAWN;
+            break;
+        case 'B': type = ePieceType::BISHOP;
+            break;
+        case 'N': type = ePieceType::KNIGHT;
+            break;
+        case 'R': type = ePieceType::ROOK;
+            break;
+        case 'Q': type = ePieceType::QUEEN;
+            break;
+        case 'K': type = ePieceType::KING;
+            break;
+        default: return false;
+        }
+
+        if (file >= CHESS_BOARD_SIZE) return false;
+
+        position.m_squares[rank * CHESS_BOARD_SIZE + file] = {type, static_cast<int8_t>(isupper(static_cast<unsigned char>(letter)) ? 0 : 1)};
+        ++file;
+    }
+
+    if (rank != 0 || file != CHESS_BOARD_SIZE) return false;
+
+    if (fields[1] == "w") position.m_sideToMove = 0;
+    else if (fields[1] == "b") position.m_sideToMove = 1;
+    else return false;
+
+    position.m_castlingRights = CASTLING_NONE;
+
+    for (char const letter : fields[2])
+    {
+        if (letter == 'K') position.m_castlingRights |= CASTLING_FIRST_KINGSIDE;
+        else if (letter == 'Q') position.m_castlingRights |= CASTLING_FIRST_QUEENSIDE;
+        else if (letter == 'k') position.m_castlingRights |= CASTLING_SECOND_KINGSIDE;
+        else if (letter == 'q') position.m_castlingRights |= CASTLING_SECOND_QUEENSIDE;
+    }
+
+    position.m_enPassantSquare = static_cast<int8_t>(fields[3] == "-" ? -1 : GetSquareIndexFromName(fields[3]));
+    position.m_halfMoveClock   = 0;
+    position.m_fullMoveNumber  = 1;
+
+    if (fields.size() >= 6 && isdigit(static_cast<unsigned char>(fields[4][0])) && isdigit(static_cast<unsigned char>(fields[5][0])))
+    {
+        position.m_halfMoveClock  = atoi(fields[4].c_str());
+        position.m_fullMoveNumber = std::max(1, atoi(fields[5].c_str()));
+    }
+
+    out_position = position;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Replaces the generated Zobrist keys with Polyglot's Random64 table, read from a text file holding
+/// its 781 values in the order the Polyglot specification prints them (hex, with or without 0x, any
+/// separators). The table is checked against the specification's test positions before it is used.
+/// Call at startup, before any thread hashes a position.
+/// @return false, keeping the current keys, if the file is missing, short or fails the test positions.
+bool LoadPolyglotRandom64(std::string const& filePath)
+{
+    std::ifstream file(filePath);
+    if (!file) return false;
+
+    std::ostringstream contents;
+    contents << file.rdbuf();
+
+    std::string text = contents.str();
+    std::replace_if(text.begin(), text.end(), [](char const letter) { return letter == ',' || letter == '{' || letter == '}' || letter == ';'; }, ' ');
+
+    sZobristTable      candidate;
+    int                keyCount = 0;
+    std::istringstream stream(text);
+    std::string        value;
+
+    while (stream >> value)
+    {
+        if (keyCount >= ZOBRIST_KEY_COUNT) return false;
+
+        char*          end = nullptr;
+        uint64_t const key = std::strtoull(value.c_str(), &end, 16);
+
+        if (end == value.c_str()) return false;
+
+        candidate.m_keys[keyCount++] = key;
+    }
+
+    if (keyCount != ZOBRIST_KEY_COUNT) return false;
+
+    sZobristTable const previous = s_zobristTable;
+    s_zobristTable               = candidate;
+
+    for (sPolyglotTestPosition const& testPosition : POLYGLOT_TEST_POSITIONS)
+    {
+        sChessPosition     position = sChessPosition::GetStartingPosition();
+        std::istringstream moveStream(testPosition.m_moves);
+        std::string        moveString;
+
+        while (moveStream >> moveString)
+        {
+            position.ApplyMove(ParseMoveString(moveString));
+        }
+
+        if (position.GetZobristKey() != testPosition.m_key)
+        {
+            s_zobristTable = previous;
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,86 @@
+//----------------------------------------------------------------------------------------------------
+// ChessPosition.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <string>
+
+#include "Game/Framework/MatchCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr CHESS_BOARD_SIZE         = 8;
+int constexpr CHESS_BOARD_SQUARE_COUNT = CHESS_BOARD_SIZE * CHESS_BOARD_SIZE;
+
+//----------------------------------------------------------------------------------------------------
+enum eCastlingRight : uint8_t
+{
+    CASTLING_NONE             = 0,
+    CASTLING_FIRST_KINGSIDE   = 1 << 0,
+    CASTLING_FIRST_QUEENSIDE  = 1 << 1,
+    CASTLING_SECOND_KINGSIDE  = 1 << 2,
+    CASTLING_SECOND_QUEENSIDE = 1 << 3,
+    CASTLING_ALL              = 0x0F
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sChessSquare
+{
+    ePieceType m_type     = ePieceType::NONE;
+    int8_t     m_playerId = -1;
+
+    bool IsEmpty() const { return m_type == ePieceType::NONE; }
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A move expressed in square indexes. Castling is the king's two-square move, en passant is the
+/// pawn's diagonal move onto the en passant square.
+struct sChessMove
+{
+    int8_t     m_fromSquare = -1;
+    int8_t     m_toSquare   = -1;
+    ePieceType m_promoteTo  = ePieceType::NONE;
+
+    bool IsValid() const { return m_fromSquare >= 0 && m_toSquare >= 0; }
+    bool operator==(sChessMove const& compare) const;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Rules-only snapshot of a chess position. It has no Piece, Board or Renderer dependency, so the
+/// opening book, search and any headless tooling can work on it directly.
+/// Square index is (y - 1) * 8 + (x - 1) of the Board coords; player #0 starts on rank 1 and moves up.
+struct sChessPosition
+{
+    sChessSquare m_squares[CHESS_BOARD_SQUARE_COUNT];
+    int8_t       m_sideToMove      = 0;
+    uint8_t      m_castlingRights  = CASTLING_ALL;
+    int8_t       m_enPassantSquare = -1;
+    int          m_halfMoveClock   = 0;
+    int          m_fullMoveNumber  = 1;
+
+    static sChessPosition GetStartingPosition();
+
+    void     ApplyMove(sChessMove const& move);
+    int      GetPly() const;
+    uint64_t GetZobristKey() const;
+    bool     CanCaptureEnPassant() const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Rules-only code uses std::string rather than the Engine's String, so it builds without the Engine.
+std::string GetSquareNameFromIndex(int squareIndex);
+int         GetSquareIndexFromName(std::string const& squareName);
+
+ePieceType  GetPieceTypeFromName(std::string const& name);
+char const* GetPieceNameFromType(ePieceType type);
+
+std::string GetMoveString(sChessMove const& move);
+sChessMove  ParseMoveString(std::string const& moveString);
+
+std::string GetFenString(sChessPosition const& position);
+bool        ParseFenString(std::string const& fen, sChessPosition& out_position);
+
+bool LoadPolyglotRandom64(std::string const& filePath);
@@ -0,0 +1,501 @@
+//----------------------------------------------------------------------------------------------------
+// ChessRules.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ChessRules.hpp"
+
+#include <cstdlib>
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr KNIGHT_OFFSETS[8][2]    = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+static int constexpr KING_OFFSETS[8][2]      = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+static int constexpr ROOK_DIRECTIONS[4][2]   = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+static int constexpr BISHOP_DIRECTIONS[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns the square reached by stepping (fileStep, rankStep), or -1 when it leaves the board.
+static int GetOffsetSquare(int const square,
+                           int const fileStep,
+                           int const rankStep)
+{
+    int const file = square % CHESS_BOARD_SIZE + fileStep;
+    int const rank = square / CHESS_BOARD_SIZE + rankStep;
+
+    if (file < 0 || file >= CHESS_BOARD_SIZE || rank < 0 || rank >= CHESS_BOARD_SIZE) return -1;
+
+    return rank * CHESS_BOARD_SIZE + file;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsPieceAt(sChessPosition const& position,
+                      int const             square,
+                      int const             playerId,
+                      ePieceType const      type)
+{
+    sChessSquare const& chessSquare = position.m_squares[square];
+
+    return chessSquare.m_type == type && chessSquare.m_playerId == playerId;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void AddMove(std::vector<sChessMove>& out_moves,
+                    int const                fromSquare,
+                    int const                toSquare,
+                    ePieceType const         promoteTo = ePieceType::NONE)
+{
+    sChessMove move;
+    move.m_fromSquare = static_cast<int8_t>(fromSquare);
+    move.m_toSquare   = static_cast<int8_t>(toSquare);
+    move.m_promoteTo  = promoteTo;
+
+    out_moves.push_back(move);
+}
+
+//----------------------------------------------------------------------------------------------------
+static void AddPawnMove(std::vector<sChessMove>& out_moves,
+                        int const                fromSquare,
+                        int const                toSquare)
+{
+    int const toRank = toSquare / CHESS_BOARD_SIZE;
+
+    if (toRank == 0 || toRank == CHESS_BOARD_SIZE - 1)
+    {
+        for (ePieceType const promoteTo : {ePieceType::QUEEN, ePieceType::ROOK, ePieceType::BISHOP, ePieceType::KNIGHT})
+        {
+            AddMove(out_moves, fromSquare, toSquare, promoteTo);
+        }
+
+        return;
+    }
+
+    AddMove(out_moves, fromSquare, toSquare);
+}
+
+//----------------------------------------------------------------------------------------------------
+static void GenerateStepMoves(sChessPosition const&    position,
+                              int const                fromSquare,
+                              int const (&             offsets)[8][2],
+                              std::vector<sChessMove>& out_moves)
+{
+    int const playerId = position.m_sideToMove;
+
+    for (auto const& offset : offsets)
+    {
+        int const toSquare = GetOffsetSquare(fromSquare, offset[0], offset[1]);
+        if (toSquare < 0) continue;
+        if (position.m_squares[toSquare].m_playerId == playerId) continue;
+
+        AddMove(out_moves, fromSquare, toSquare);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static void GenerateSlideMoves(sChessPosition const&    position,
+                               int const                fromSquare,
+                               int const (&             directions)[4][2],
+                               std::vector<sChessMove>& out_moves)
+{
+    int const playerId = position.m_sideToMove;
+
+    for (auto const& direction : directions)
+    {
+        int toSquare = GetOffsetSquare(fromSquare, direction[0], direction[1]);
+
+        while (toSquare >= 0)
+        {
+            sChessSquare const& target = position.m_squares[toSquare];
+            if (target.m_playerId == playerId) break;
+
+            AddMove(out_moves, fromSquare, toSquare);
+
+            if (!target.IsEmpty()) break;
+
+            toSquare = GetOffsetSquare(toSquare, direction[0], direction[1]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static void GeneratePawnMoves(sChessPosition const&    position,
+                              int const                fromSquare,
+                              std::vector<sChessMove>& out_moves)
+{
+    int const playerId  = position.m_sideToMove;
+    int const direction = playerId == 0 ? 1 : -1;
+    int const startRank = playerId == 0 ? 1 : CHESS_BOARD_SIZE - 2;
+
+    int const oneStep = GetOffsetSquare(fromSquare, 0, direction);
+
+    if (oneStep >= 0 && position.m_squares[oneStep].IsEmpty())
+    {
+        AddPawnMove(out_moves, fromSquare, oneStep);
+
+        int const twoStep = GetOffsetSquare(fromSquare, 0, 2 * direction);
+
+        if (fromSquare / CHESS_BOARD_SIZE == startRank && position.m_squares[twoStep].IsEmpty())
+        {
+            AddMove(out_moves, fromSquare, twoStep);
+        }
+    }
+
+    for (int const fileStep : {-1, 1})
+    {
+        int const toSquare = GetOffsetSquare(fromSquare, fileStep, direction);
+        if (toSquare < 0) continue;
+
+        sChessSquare const& target = position.m_squares[toSquare];
+
+        if (!target.IsEmpty() && target.m_playerId != playerId)
+        {
+            AddPawnMove(out_moves, fromSquare, toSquare);
+        }
+        else if (toSquare == position.m_enPassantSquare)
+        {
+            AddMove(out_moves, fromSquare, toSquare);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Castling is only offered when the rights are intact, the path is empty and the king does not
+/// start, pass or land on an attacked square.
+static void GenerateCastlingMoves(sChessPosition const&    position,
+                                  int const                kingSquare,
+                                  std::vector<sChessMove>& out_moves)
+{
+    int const playerId      = position.m_sideToMove;
+    int const opponentId    = 1 - playerId;
+    int const rankStart     = playerId == 0 ? 0 : CHESS_BOARD_SQUARE_COUNT - CHESS_BOARD_SIZE;
+    int const kingSideMask  = playerId == 0 ? CASTLING_FIRST_KINGSIDE : CASTLING_SECOND_KINGSIDE;
+    int const queenSideMask = playerId == 0 ? CASTLING_FIRST_QUEENSIDE : CASTLING_SECOND_QUEENSIDE;
+
+    if (kingSquare != rankStart + 4) return;
+    if ((position.m_castlingRights & (kingSideMask | queenSideMask)) == 0) return;
+    if (IsSquareAttacked(position, kingSquare, opponentId)) return;
+
+    auto const isEmpty = [&position, rankStart](int const file)
+    {
+        return position.m_squares[rankStart + file].IsEmpty();
+    };
+
+    auto const isSafe = [&position, rankStart, opponentId](int const file)
+    {
+        return !IsSquareAttacked(position, rankStart + file, opponentId);
+    };
+
+    if ((position.m_castlingRights & kingSideMask) != 0 &&
+        IsPieceAt(position, rankStart + 7, playerId, ePieceType::ROOK) &&
+        isEmpty(5) && isEmpty(6) && isSafe(5) && isSafe(6))
+    {
+        AddMove(out_moves, kingSquare, rankStart + 6);
+    }
+
+    if ((position.m_castlingRights & queenSideMask) != 0 &&
+        IsPieceAt(position, rankStart + 0, playerId, ePieceType::ROOK) &&
+        isEmpty(1) && isEmpty(2) && isEmpty(3) && isSafe(2) && isSafe(3))
+    {
+        AddMove(out_moves, kingSquare, rankStart + 2);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves that obey piece movement but may leave the mover's own king in check.
+void GeneratePseudoLegalMoves(sChessPosition const&    position,
+                              std::vector<sChessMove>& out_moves)
+{
+    out_moves.clear();
+
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        sChessSquare const& chessSquare = position.m_squares[square];
+        if (chessSquare.m_playerId != position.m_sideToMove) continue;
+
+        switch (chessSquare.m_type)
+        {
+        case ePieceType::PAWN: GeneratePawnMoves(position, square, out_moves);
+            break;
+        case ePieceType::KNIGHT: GenerateStepMoves(position, square, KNIGHT_OFFSETS, out_moves);
+            break;
+        case ePieceType::BISHOP: GenerateSlideMoves(position, square, BISHOP_DIRECTIONS, out_moves);
+            break;
+        case ePieceType::ROOK: GenerateSlideMoves(position, square, ROOK_DIRECTIONS, out_moves);
+            break;
+        case ePieceType::QUEEN: GenerateSlideMoves(position, square, ROOK_DIRECTIONS, out_moves);
+            GenerateSlideMoves(position, square, BISHOP_DIRECTIONS, out_moves);
+            break;
+        case ePieceType::KING: GenerateStepMoves(position, square, KING_OFFSETS, out_moves);
+            GenerateCastlingMoves(position, square, out_moves);
+            break;
+        case ePieceType::NONE:
+        default: break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void GenerateLegalMoves(sChessPosition const&    position,
+                        std::vector<sChessMove>& out_moves)
+{
+    GeneratePseudoLegalMoves(position, out_moves);
+
+    size_t legalCount = 0;
+
+    for (sChessMove const& move : out_moves)
+    {
+        if (IsMoveLegal(position, move)) out_moves[legalCount++] = move;
+    }
+
+    out_moves.resize(legalCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Stops at the first legal reply, so the common "game goes on" answer is cheap.
+bool HasAnyLegalMove(sChessPosition const& position)
+{
+    static thread_local std::vector<sChessMove> s_moves;
+
+    GeneratePseudoLegalMoves(position, s_moves);
+
+    for (sChessMove const& move : s_moves)
+    {
+        if (IsMoveLegal(position, move)) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief A pseudo-legal move is legal when it does not leave the mover's king attacked.
+bool IsMoveLegal(sChessPosition const& position,
+                 sChessMove const&     move)
+{
+    sChessPosition next = position;
+    next.ApplyMove(move);
+
+    return !IsInCheck(next, position.m_sideToMove);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsSquareAttacked(sChessPosition const& position,
+                      int const             square,
+                      int const             attackerId)
+{
+    // A pawn attacks diagonally forward, so look one rank behind the square from the attacker's side.
+    int const pawnRankStep = attackerId == 0 ? -1 : 1;
+
+    for (int const fileStep : {-1, 1})
+    {
+        int const fromSquare = GetOffsetSquare(square, fileStep, pawnRankStep);
+        if (fromSquare >= 0 && IsPieceAt(position, fromSquare, attackerId, ePieceType::PAWN)) return true;
+    }
+
+    for (auto const& offset : KNIGHT_OFFSETS)
+    {
+        int const fromSquare = GetOffsetSquare(square, offset[0], offset[1]);
+        if (fromSquare >= 0 && IsPieceAt(position, fromSquare, attackerId, ePieceType::KNIGHT)) return true;
+    }
+
+    for (auto const& offset : KING_OFFSETS)
+    {
+        int const fromSquare = GetOffsetSquare(square, offset[0], offset[1]);
+        if (fromSquare >= 0 && IsPieceAt(position, fromSquare, attackerId, ePieceType::KING)) return true;
+    }
+
+    auto const isSliderAttack = [&](int const (&directions)[4][2], ePieceType const sliderType)
+    {
+        for (auto const& direction : directions)
+        {
+            int fromSquare = GetOffsetSquare(square, direction[0], direction[1]);
+
+            while (fromSquare >= 0)
+            {
+                sChessSquare const& chessSquare = position.m_squares[fromSquare];
+
+                if (!chessSquare.IsEmpty())
+                {
+                    if (chessSquare.m_playerId == attackerId &&
+                        (chessSquare.m_type == sliderType || chessSquare.m_type == ePieceType::QUEEN))
+                    {
+                        return true;
+                    }
+
+                    break;
+                }
+
+                fromSquare = GetOffsetSquare(fromSquare, direction[0], direction[1]);
+            }
+        }
+
+        return false;
+    };
+
+    return isSliderAttack(ROOK_DIRECTIONS, ePieceType::ROOK) || isSliderAttack(BISHOP_DIRECTIONS, ePieceType::BISHOP);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsInCheck(sChessPosition const& position,
+               int const             playerId)
+{
+    int const kingSquare = FindKingSquare(position, playerId);
+    if (kingSquare < 0) return false;
+
+    return IsSquareAttacked(position, kingSquare, 1 - playerId);
+}
+
+//----------------------------------------------------------------------------------------------------
+int FindKingSquare(sChessPosition const& position,
+                   int const             playerId)
+{
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        if (IsPieceAt(position, square, playerId, ePieceType::KING)) return square;
+    }
+
+    return -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsCaptureMove(sChessPosition const& position,
+                   sChessMove const&     move)
+{
+    if (!position.m_squares[move.m_toSquare].IsEmpty()) return true;
+
+    return position.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN &&
+        move.m_toSquare == position.m_enPassantSquare &&
+        move.m_fromSquare % CHESS_BOARD_SIZE != move.m_toSquare % CHESS_BOARD_SIZE;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Captures and pawn moves reset the fifty-move counter and can never be repeated.
+bool IsZeroingMove(sChessPosition const& position,
+                   sChessMove const&     move)
+{
+    return position.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN || IsCaptureMove(position, move);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Neither side can mate with any sequence of legal moves: bare kings, a single minor piece,
+/// or any number of bishops that all stand on the same square color.
+bool IsInsufficientMaterial(sChessPosition const& position)
+{
+    int  knightCount          = 0;
+    int  bishopCount          = 0;
+    bool hasLightSquareBishop = false;
+    bool hasDarkSquareBishop  = false;
+
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        switch (position.m_squares[square].m_type)
+        {
+        case ePieceType::NONE:
+        case ePieceType::KING: break;
+        case ePieceType::KNIGHT: ++knightCount;
+            break;
+        case ePieceType::BISHOP:
+            ++bishopCount;
+            if (((square / CHESS_BOARD_SIZE + square % CHESS_BOARD_SIZE) & 1) != 0) hasLightSquareBishop = true;
+            else hasDarkSquareBishop = true;
+            break;
+        default: return false;
+        }
+    }
+
+    if (knightCount == 0) return !(hasLightSquareBishop && hasDarkSquareBishop);
+
+    return knightCount == 1 && bishopCount == 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Game-end rules for the position just reached; history must already end with its key.
+/// HasAnyLegalMove stops at the first legal reply, so an ongoing game costs only a few move tests.
+/// Mate and stalemate come first: a mate on the hundredth quiet ply still wins.
+eMatchResult EvaluateMatchResult(sChessPosition const& position,
+                                 ZobristHistory const& history)
+{
+    if (!HasAnyLegalMove(position)) return IsInCheck(position, position.m_sideToMove) ? eMatchResult::WIN_CHECKMATE : eMatchResult::DRAW_STALEMATE;
+    if (history.IsThreefoldRepetition()) return eMatchResult::DRAW_THREEFOLD_REPETITION;
+    if (history.IsFiftyMoveRuleReached()) return eMatchResult::DRAW_FIFTY_MOVE_RULE;
+    if (IsInsufficientMaterial(position)) return eMatchResult::DRAW_INSUFFICIENT_MATERIAL;
+
+    return eMatchResult::ONGOING;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Formats a legal move in Standard Algebraic Notation for PGN, e.g. "Nbd7", "exd6", "e8=Q+" or
+/// "O-O#". Adds the file, rank or both only when another piece of the same type could reach the
+/// square too.
+std::string GetSanMoveString(sChessPosition const& position,
+                             sChessMove const&     move)
+{
+    static char constexpr PIECE_LETTERS[] = "PBNRQK";
+
+    ePieceType const type      = position.m_squares[move.m_fromSquare].m_type;
+    int const        fromFile  = move.m_fromSquare % CHESS_BOARD_SIZE;
+    int const        toFile    = move.m_toSquare % CHESS_BOARD_SIZE;
+    bool const       isCapture = IsCaptureMove(position, move);
+    std::string      san;
+
+    if (type == ePieceType::KING && std::abs(toFile - fromFile) == 2)
+    {
+        san = toFile > fromFile ? "O-O" : "O-O-O";
+    }
+    else if (type == ePieceType::PAWN)
+    {
+        if (isCapture)
+        {
+            san += static_cast<char>('a' + fromFile);
+            san += 'x';
+        }
+
+        san += GetSquareNameFromIndex(move.m_toSquare);
+
+        if (move.m_promoteTo != ePieceType::NONE)
+        {
+            san += '=';
+            san += PIECE_LETTERS[static_cast<int>(move.m_promoteTo)];
+        }
+    }
+    else
+    {
+        std::vector<sChessMove> legalMoves;
+        GenerateLegalMoves(position, legalMoves);
+
+        bool isAmbiguous  = false;
+        bool isFileShared = false;
+        bool isRankShared = false;
+
+        for (sChessMove const& other : legalMoves)
+        {
+            if (other.m_toSquare != move.m_toSquare || other.m_fromSquare == move.m_fromSquare) continue;
+            if (position.m_squares[other.m_fromSquare].m_type != type) continue;
+
+            isAmbiguous = true;
+            if (other.m_fromSquare % CHESS_BOARD_SIZE == fromFile) isFileShared = true;
+            if (other.m_fromSquare / CHESS_BOARD_SIZE == move.m_fromSquare / CHESS_BOARD_SIZE) isRankShared = true;
+        }
+
+        san += PIECE_LETTERS[static_cast<int>(type)];
+
+        if (isAmbiguous)
+        {
+            std::string const fromName = GetSquareNameFromIndex(move.m_fromSquare);
+
+            if (!isFileShared) san += fromName[0];
+            else if (!isRankShared) san += fromName[1];
+            else san += fromName;
+        }
+
+        if (isCapture) san += 'x';
+
+        san += GetSquareNameFromIndex(move.m_toSquare);
+    }
+
+    sChessPosition child = position;
+    child.ApplyMove(move);
+
+    if (IsInCheck(child, child.m_sideToMove)) san += HasAnyLegalMove(child) ? "+" : "#";
+
+    return san;
+}
@@ -0,0 +1,31 @@
+//----------------------------------------------------------------------------------------------------
+// ChessRules.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/ZobristHistory.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Move generation on sChessPosition. These mirror the rules Match validates on its Pieces, but work
+// on plain square arrays so search, the tablebase generator and headless tools can run them cheaply.
+//
+void GeneratePseudoLegalMoves(sChessPosition const& position, std::vector<sChessMove>& out_moves);
+void GenerateLegalMoves(sChessPosition const& position, std::vector<sChessMove>& out_moves);
+bool HasAnyLegalMove(sChessPosition const& position);
+bool IsMoveLegal(sChessPosition const& position, sChessMove const& move);
+
+bool IsSquareAttacked(sChessPosition const& position, int square, int attackerId);
+bool IsInCheck(sChessPosition const& position, int playerId);
+int  FindKingSquare(sChessPosition const& position, int playerId);
+
+bool IsCaptureMove(sChessPosition const& position, sChessMove const& move);
+bool IsZeroingMove(sChessPosition const& position, sChessMove const& move);
+bool IsInsufficientMaterial(sChessPosition const& position);
+
+eMatchResult EvaluateMatchResult(sChessPosition const& position, ZobristHistory const& history);
+
+std::string GetSanMoveString(sChessPosition const& position, sChessMove const& move);
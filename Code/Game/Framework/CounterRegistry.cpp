@@ -0,0 +1,198 @@
+//----------------------------------------------------------------------------------------------------
+// CounterRegistry.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/CounterRegistry.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+std::atomic<uint32_t> g_counterValues[COUNTER_MAX_COUNT] = {};
+
+//----------------------------------------------------------------------------------------------------
+struct sCounter
+{
+    String   m_name;
+    uint32_t m_lastFrameValue                       = 0;
+    uint32_t m_history[COUNTER_AVERAGE_FRAME_COUNT] = {};
+    uint64_t m_historySum                           = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+static std::mutex            s_registerMutex;
+static sCounter              s_counters[COUNTER_MAX_COUNT];
+static std::atomic<int>      s_counterCount      = 0;
+static int                   s_historyIndex      = 0;
+static int                   s_historyFrameCount = 0;
+static bool                  s_isOverlayVisible  = false;
+static uint64_t              s_frameIndex        = 0;
+static std::vector<uint32_t> s_sessionValues;     // COUNTER_MAX_COUNT per frame, oldest overwritten first
+static std::vector<double>   s_sessionSeconds;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns the id of the counter called name, adding it on first use. Ids are stable for the
+/// whole session, so call sites cache them.
+int RegisterCounter(char const* name)
+{
+    std::lock_guard const lock(s_registerMutex);
+
+    int const counterCount = s_counterCount.load(std::memory_order_relaxed);
+
+    for (int counterId = 0; counterId < counterCount; ++counterId)
+    {
+        if (s_counters[counterId].m_name == name) return counterId;
+    }
+
+    if (counterCount >= COUNTER_MAX_COUNT)
+    {
+        ERROR_AND_DIE(Stringf("Too many counters; raise COUNTER_MAX_COUNT to add \"%s\"", name))
+    }
+
+    s_counters[counterCount].m_name = name;
+    s_counterCount.store(counterCount + 1, std::memory_order_release);
+
+    return counterCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Allocates the whole session history up front, so counting frames never allocates. Call once
+/// before the first CountersBeginFrame.
+void CountersStartUp()
+{
+    s_sessionValues.assign(static_cast<size_t>(COUNTER_SESSION_FRAME_COUNT) * COUNTER_MAX_COUNT, 0);
+    s_sessionSeconds.assign(COUNTER_SESSION_FRAME_COUNT, 0.0);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Publishes the totals of the frame that just ended, folds them into the rolling averages and
+/// the session history, and starts counting a new frame.
+void CountersBeginFrame()
+{
+    int const    counterCount = s_counterCount.load(std::memory_order_acquire);
+    size_t const sessionSlot  = static_cast<size_t>(s_frameIndex % COUNTER_SESSION_FRAME_COUNT);
+    uint32_t* const sessionValues = &s_sessionValues[sessionSlot * COUNTER_MAX_COUNT];
+
+    for (int counterId = 0; counterId < counterCount; ++counterId)
+    {
+        sCounter&      counter = s_counters[counterId];
+        uint32_t const value   = g_counterValues[counterId].exchange(0, std::memory_order_relaxed);
+
+        counter.m_historySum              = counter.m_historySum - counter.m_history[s_historyIndex] + value;
+        counter.m_history[s_historyIndex] = value;
+        counter.m_lastFrameValue          = value;
+        sessionValues[counterId]          = value;
+    }
+
+    s_sessionSeconds[sessionSlot] = GetCurrentTimeSeconds();
+    s_historyIndex                = (s_historyIndex + 1) % COUNTER_AVERAGE_FRAME_COUNT;
+    s_historyFrameCount           = std::min(s_historyFrameCount + 1, COUNTER_AVERAGE_FRAME_COUNT);
+    ++s_frameIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+int GetCounterCount()
+{
+    return s_counterCount.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------
+String GetCounterName(int const counterId)
+{
+    return s_counters[counterId].m_name;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t GetCounterLastFrameValue(int const counterId)
+{
+    return s_counters[counterId].m_lastFrameValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+float GetCounterAverage(int const counterId)
+{
+    if (s_historyFrameCount == 0) return 0.f;
+
+    return static_cast<float>(static_cast<double>(s_counters[counterId].m_historySum) / s_historyFrameCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SetCounterOverlayVisible(bool const isVisible)
+{
+    s_isOverlayVisible = isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsCounterOverlayVisible()
+{
+    return s_isOverlayVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Lists every counter's last frame and rolling average below topLeft, if the overlay is up.
+void AddCounterOverlayText(Vec2 const& topLeft)
+{
+    if (!s_isOverlayVisible) return;
+
+    int const counterCount = GetCounterCount();
+    String    text         = Stringf("%-28s %8s %10s", "Counter", "Frame", "Average");
+
+    for (int counterId = 0; counterId < counterCount; ++counterId)
+    {
+        text += Stringf("\n%-28s %8u %10.1f", s_counters[counterId].m_name.c_str(), s_counters[counterId].m_lastFrameValue, GetCounterAverage(counterId));
+    }
+
+    float constexpr lineHeight = 16.f;
+
+    DebugAddScreenText(text, topLeft - Vec2(0.f, lineHeight * static_cast<float>(counterCount + 1)), lineHeight, Vec2::ZERO, 0.f, Rgba8::YELLOW, Rgba8::YELLOW);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Writes one row per kept frame, oldest first: frame index, seconds since the first kept frame,
+/// then every counter's value in that frame. Counters added later read 0 in earlier frames.
+bool WriteCountersCsv(String const& filePath)
+{
+    std::ofstream file(filePath, std::ios::trunc);
+
+    if (!file) return false;
+
+    int const      counterCount = GetCounterCount();
+    uint64_t const rowCount     = std::min(s_frameIndex, static_cast<uint64_t>(COUNTER_SESSION_FRAME_COUNT));
+    uint64_t const firstFrame   = s_frameIndex - rowCount;
+    double const   firstSeconds = rowCount > 0 ? s_sessionSeconds[firstFrame % COUNTER_SESSION_FRAME_COUNT] : 0.0;
+
+    file << "frame,seconds";
+
+    for (int counterId = 0; counterId < counterCount; ++counterId)
+    {
+        file << "," << s_counters[counterId].m_name;
+    }
+
+    file << "\n";
+
+    for (uint64_t frame = firstFrame; frame < s_frameIndex; ++frame)
+    {
+        size_t const    slot   = static_cast<size_t>(frame % COUNTER_SESSION_FRAME_COUNT);
+        uint32_t const* values = &s_sessionValues[slot * COUNTER_MAX_COUNT];
+
+        file << frame << Stringf(",%.4f", s_sessionSeconds[slot] - firstSeconds);
+
+        for (int counterId = 0; counterId < counterCount; ++counterId)
+        {
+            file << "," << values[counterId];
+        }
+
+        file << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
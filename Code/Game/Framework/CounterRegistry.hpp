@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// CounterRegistry.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct Vec2;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr COUNTER_MAX_COUNT           = 32;
+int constexpr COUNTER_AVERAGE_FRAME_COUNT = 60;        // Frames in the rolling average
+int constexpr COUNTER_SESSION_FRAME_COUNT = 36000;     // Frames kept for counter_dump; ten minutes at 60 fps
+
+//----------------------------------------------------------------------------------------------------
+/// @brief This frame's running totals, indexed by counter id. Only AddToCounter should touch them.
+extern std::atomic<uint32_t> g_counterValues[COUNTER_MAX_COUNT];
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Any thread may add; the add is a relaxed atomic with no lock and no lookup.
+inline void AddToCounter(int const      counterId,
+                         uint32_t const amount)
+{
+    g_counterValues[counterId].fetch_add(amount, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Looks the counter up once per call site, the first time it runs; later runs only add.
+#define COUNTER_ADD(name, amount)                              \
+    do                                                         \
+    {                                                          \
+        static int const s_counterId = RegisterCounter(name);  \
+        AddToCounter(s_counterId, amount);                     \
+    } while (false)
+
+#define COUNTER_INCREMENT(name) COUNTER_ADD(name, 1)
+
+//----------------------------------------------------------------------------------------------------
+int      RegisterCounter(char const* name);
+void     CountersStartUp();
+void     CountersBeginFrame();
+int      GetCounterCount();
+String   GetCounterName(int counterId);
+uint32_t GetCounterLastFrameValue(int counterId);
+float    GetCounterAverage(int counterId);
+void     SetCounterOverlayVisible(bool isVisible);
+bool     IsCounterOverlayVisible();
+void     AddCounterOverlayText(Vec2 const& topLeft);
+bool     WriteCountersCsv(String const& filePath);
@@ -0,0 +1,68 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestep.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FixedTimestep.hpp"
+
+//----------------------------------------------------------------------------------------------------
+FixedTimestep::FixedTimestep(float const stepSeconds,
+                             int const   maxStepCount)
+    : m_stepSeconds(stepSeconds),
+      m_maxStepCount(maxStepCount)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Adds deltaSeconds, which may be zero while the driving clock is paused, and returns the
+/// number of whole steps now due.
+int FixedTimestep::Accumulate(double const deltaSeconds)
+{
+    if (deltaSeconds > 0.0) m_accumulatedSeconds += deltaSeconds;
+
+    int stepCount = 0;
+
+    while (m_accumulatedSeconds >= m_stepSeconds)
+    {
+        if (stepCount == m_maxStepCount)
+        {
+            uint64_t const droppedCount = static_cast<uint64_t>(m_accumulatedSeconds / m_stepSeconds);
+
+            m_droppedStepCount   += droppedCount;
+            m_accumulatedSeconds -= static_cast<double>(droppedCount) * m_stepSeconds;
+            break;
+        }
+
+        m_accumulatedSeconds -= m_stepSeconds;
+        ++stepCount;
+    }
+
+    m_stepCount += stepCount;
+
+    return stepCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+float FixedTimestep::GetStepSeconds() const
+{
+    return m_stepSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief 0 right after a step, approaching 1 just before the next.
+float FixedTimestep::GetAlpha() const
+{
+    return static_cast<float>(m_accumulatedSeconds / m_stepSeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t FixedTimestep::GetStepCount() const
+{
+    return m_stepCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t FixedTimestep::GetDroppedStepCount() const
+{
+    return m_droppedStepCount;
+}
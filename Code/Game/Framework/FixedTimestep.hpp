@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------------------------------
+// FixedTimestep.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+float constexpr SIMULATION_STEP_SECONDS        = 1.f / 60.f;
+int constexpr   SIMULATION_MAX_STEPS_PER_FRAME = 8;     // Past this a frame drops time instead of catching up
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Accumulator that turns variable frame times into whole simulation steps of a fixed length, so the
+/// simulation advances the same way at any frame rate. Accumulate returns how many steps to run this
+/// frame; GetAlpha is how far the leftover time reaches into the next step, for blending the last two
+/// simulated states when rendering. A frame owing more than maxStepCount steps runs that many and
+/// drops the rest, so a long hitch does not snowball into ever longer frames.
+class FixedTimestep
+{
+public:
+    explicit FixedTimestep(float stepSeconds = SIMULATION_STEP_SECONDS, int maxStepCount = SIMULATION_MAX_STEPS_PER_FRAME);
+
+    int Accumulate(double deltaSeconds);
+
+    float    GetStepSeconds() const;
+    float    GetAlpha() const;
+    uint64_t GetStepCount() const;
+    uint64_t GetDroppedStepCount() const;
+
+private:
+    float    m_stepSeconds        = SIMULATION_STEP_SECONDS;
+    int      m_maxStepCount       = SIMULATION_MAX_STEPS_PER_FRAME;
+    double   m_accumulatedSeconds = 0.0;    // Less than one step between calls
+    uint64_t m_stepCount          = 0;
+    uint64_t m_droppedStepCount   = 0;
+};
@@ -0,0 +1,119 @@
+//----------------------------------------------------------------------------------------------------
+// FramePacer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FramePacer.hpp"
+
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <cstring>
+#include <thread>
+#include <windows.h>
+#include <timeapi.h>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+
+#pragma comment(lib, "winmm.lib")
+
+//----------------------------------------------------------------------------------------------------
+FramePacer::FramePacer(sFramePacerConfig const& config)
+    : m_config(config)
+{
+    timeBeginPeriod(1);
+}
+
+//----------------------------------------------------------------------------------------------------
+FramePacer::~FramePacer()
+{
+    timeEndPeriod(1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Call once per frame, after the frame is presented.
+void FramePacer::WaitForNextFrame(bool const isInBackground)
+{
+    float const frameRate = isInBackground ? m_config.m_backgroundFrameRate : m_config.m_maxFrameRate;
+
+    m_lastWaitSeconds = 0.0;
+
+    if (m_config.m_mode == eFramePacingMode::UNLIMITED || frameRate <= 0.f)
+    {
+        m_nextFrameSeconds = 0.0;
+        return;
+    }
+
+    double const frameSeconds = 1.0 / frameRate;
+    double const startSeconds = GetCurrentTimeSeconds();
+
+    if (m_nextFrameSeconds == 0.0 || startSeconds - m_nextFrameSeconds > frameSeconds)
+    {
+        m_nextFrameSeconds = startSeconds + frameSeconds;
+    }
+
+    double const spinSeconds = m_config.m_mode == eFramePacingMode::SLEEP_AND_SPIN ? FRAME_PACER_SPIN_SECONDS : 0.0;
+    double       nowSeconds  = startSeconds;
+
+    if (m_nextFrameSeconds - nowSeconds > spinSeconds)
+    {
+        DWORD const sleepMilliseconds = static_cast<DWORD>((m_nextFrameSeconds - nowSeconds - spinSeconds) * 1000.0);
+
+        if (sleepMilliseconds > 0) Sleep(sleepMilliseconds);
+
+        nowSeconds = GetCurrentTimeSeconds();
+    }
+
+    while (spinSeconds > 0.0 && nowSeconds < m_nextFrameSeconds)
+    {
+        std::this_thread::yield();
+        nowSeconds = GetCurrentTimeSeconds();
+    }
+
+    m_lastWaitSeconds  = nowSeconds - startSeconds;
+    m_nextFrameSeconds += frameSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FramePacer::SetConfig(sFramePacerConfig const& config)
+{
+    m_config           = config;
+    m_nextFrameSeconds = 0.0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sFramePacerConfig const& FramePacer::GetConfig() const
+{
+    return m_config;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Time the last WaitForNextFrame spent sleeping or spinning.
+double FramePacer::GetLastWaitSeconds() const
+{
+    return m_lastWaitSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC char const* FramePacer::GetModeName(eFramePacingMode const mode)
+{
+    switch (mode)
+    {
+    case eFramePacingMode::UNLIMITED: return "off";
+    case eFramePacingMode::SLEEP: return "sleep";
+    case eFramePacingMode::SLEEP_AND_SPIN: return "spin";
+    }
+
+    return "off";
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Accepts the names GetModeName returns.
+STATIC eFramePacingMode FramePacer::GetModeByName(char const*            name,
+                                                  eFramePacingMode const defaultMode)
+{
+    if (std::strcmp(name, "off") == 0) return eFramePacingMode::UNLIMITED;
+    if (std::strcmp(name, "sleep") == 0) return eFramePacingMode::SLEEP;
+    if (std::strcmp(name, "spin") == 0) return eFramePacingMode::SLEEP_AND_SPIN;
+
+    return defaultMode;
+}
@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------------------------------------
+// FramePacer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+enum class eFramePacingMode : uint8_t
+{
+    UNLIMITED,          // Run frames back to back
+    SLEEP,              // Sleep out the whole remainder; least CPU, may overshoot by a scheduler tick
+    SLEEP_AND_SPIN      // Sleep until FRAME_PACER_SPIN_SECONDS before the deadline, then spin
+};
+
+//----------------------------------------------------------------------------------------------------
+double constexpr FRAME_PACER_SPIN_SECONDS = 0.002;
+
+//----------------------------------------------------------------------------------------------------
+struct sFramePacerConfig
+{
+    float            m_maxFrameRate        = 60.f;      // 0 for no limit
+    float            m_backgroundFrameRate = 15.f;      // While the window is not focused; 0 for no limit
+    eFramePacingMode m_mode                = eFramePacingMode::SLEEP_AND_SPIN;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Caps the frame rate by waiting at the end of each frame until the next frame is due. Deadlines
+/// advance by whole frame periods, so the cadence stays steady; a frame that overruns its deadline by
+/// more than a period resets the cadence rather than running later frames early to catch up.
+/// Raises the OS timer resolution to 1 ms while alive, so sleeps wake close to when asked.
+class FramePacer
+{
+public:
+    explicit FramePacer(sFramePacerConfig const& config);
+    ~FramePacer();
+
+    void WaitForNextFrame(bool isInBackground);
+
+    void                     SetConfig(sFramePacerConfig const& config);
+    sFramePacerConfig const& GetConfig() const;
+    double                   GetLastWaitSeconds() const;
+
+    static char const*      GetModeName(eFramePacingMode mode);
+    static eFramePacingMode GetModeByName(char const* name, eFramePacingMode defaultMode);
+
+private:
+    sFramePacerConfig m_config;
+    double            m_nextFrameSeconds = 0.0;     // 0 until the first paced frame
+    double            m_lastWaitSeconds  = 0.0;
+};
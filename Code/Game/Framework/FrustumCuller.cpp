@@ -0,0 +1,211 @@
+//----------------------------------------------------------------------------------------------------
+// FrustumCuller.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/FrustumCuller.hpp"
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <xmmintrin.h>
+#define FRUSTUM_CULLER_USE_SSE
+#endif
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief World-space box enclosing localBounds after modelToWorld. Each world half extent is the
+/// local one projected through the absolute values of the basis vectors.
+AABB3 TransformBounds(AABB3 const& localBounds,
+                      Mat44 const& modelToWorld)
+{
+    Vec3 const localCenter  = (localBounds.m_mins + localBounds.m_maxs) * 0.5f;
+    Vec3 const localExtents = (localBounds.m_maxs - localBounds.m_mins) * 0.5f;
+    Vec3 const iBasis       = modelToWorld.GetIBasis3D();
+    Vec3 const jBasis       = modelToWorld.GetJBasis3D();
+    Vec3 const kBasis       = modelToWorld.GetKBasis3D();
+
+    Vec3 const worldCenter = modelToWorld.TransformPosition3D(localCenter);
+    Vec3 const worldExtents(fabsf(iBasis.x) * localExtents.x + fabsf(jBasis.x) * localExtents.y + fabsf(kBasis.x) * localExtents.z,
+                            fabsf(iBasis.y) * localExtents.x + fabsf(jBasis.y) * localExtents.y + fabsf(kBasis.y) * localExtents.z,
+                            fabsf(iBasis.z) * localExtents.x + fabsf(jBasis.z) * localExtents.y + fabsf(kBasis.z) * localExtents.z);
+
+    return AABB3(worldCenter - worldExtents, worldCenter + worldExtents);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sFrustum sFrustum::MakePerspective(Vec3 const&        position,
+                                          EulerAngles const& orientation,
+                                          float const        aspect,
+                                          float const        fovDegrees,
+                                          float const        nearDistance,
+                                          float const        farDistance)
+{
+    Vec3 forward;
+    Vec3 left;
+    Vec3 up;
+    orientation.GetAsVectors_IFwd_JLeft_KUp(forward, left, up);
+
+    float const halfHeight = TanDegrees(fovDegrees * 0.5f);
+    float const halfWidth  = halfHeight * aspect;
+
+    sFrustum frustum;
+    frustum.m_normals[0] = forward;
+    frustum.m_normals[1] = -forward;
+    frustum.m_normals[2] = (forward * halfWidth - left).GetNormalized();
+    frustum.m_normals[3] = (forward * halfWidth + left).GetNormalized();
+    frustum.m_normals[4] = (forward * halfHeight - up).GetNormalized();
+    frustum.m_normals[5] = (forward * halfHeight + up).GetNormalized();
+
+    // The four side planes pass through the eye; near and far are offset along the view direction.
+    for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+    {
+        frustum.m_distances[plane] = -DotProduct3D(frustum.m_normals[plane], position);
+    }
+
+    frustum.m_distances[0] -= nearDistance;
+    frustum.m_distances[1] += farDistance;
+
+    return frustum;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrustumCuller::Clear()
+{
+    m_centerX.clear();
+    m_centerY.clear();
+    m_centerZ.clear();
+    m_extentX.clear();
+    m_extentY.clear();
+    m_extentZ.clear();
+    m_isVisible.clear();
+    m_visibleCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Adds the world-space box enclosing localBounds after modelToWorld.
+int FrustumCuller::AddBounds(AABB3 const& localBounds,
+                             Mat44 const& modelToWorld)
+{
+    AABB3 const worldBounds = TransformBounds(localBounds, modelToWorld);
+
+    return AddBounds((worldBounds.m_mins + worldBounds.m_maxs) * 0.5f, (worldBounds.m_maxs - worldBounds.m_mins) * 0.5f);
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrustumCuller::AddBounds(Vec3 const& center,
+                             Vec3 const& halfExtents)
+{
+    m_centerX.push_back(center.x);
+    m_centerY.push_back(center.y);
+    m_centerZ.push_back(center.z);
+    m_extentX.push_back(halfExtents.x);
+    m_extentY.push_back(halfExtents.y);
+    m_extentZ.push_back(halfExtents.z);
+    m_isVisible.push_back(1);
+
+    return static_cast<int>(m_centerX.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void FrustumCuller::Cull(sFrustum const& frustum)
+{
+    int const boundsCount = GetBoundsCount();
+    int       boundsIndex = 0;
+
+    m_visibleCount = 0;
+
+#if defined(FRUSTUM_CULLER_USE_SSE)
+    __m128 const signMask = _mm_set1_ps(-0.f);
+    __m128       planeNormalX[FRUSTUM_PLANE_COUNT];
+    __m128       planeNormalY[FRUSTUM_PLANE_COUNT];
+    __m128       planeNormalZ[FRUSTUM_PLANE_COUNT];
+    __m128       planeDistance[FRUSTUM_PLANE_COUNT];
+
+    for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+    {
+        planeNormalX[plane]  = _mm_set1_ps(frustum.m_normals[plane].x);
+        planeNormalY[plane]  = _mm_set1_ps(frustum.m_normals[plane].y);
+        planeNormalZ[plane]  = _mm_set1_ps(frustum.m_normals[plane].z);
+        planeDistance[plane] = _mm_set1_ps(frustum.m_distances[plane]);
+    }
+
+    for (; boundsIndex + 4 <= boundsCount; boundsIndex += 4)
+    {
+        __m128 const centerX = _mm_loadu_ps(&m_centerX[boundsIndex]);
+        __m128 const centerY = _mm_loadu_ps(&m_centerY[boundsIndex]);
+        __m128 const centerZ = _mm_loadu_ps(&m_centerZ[boundsIndex]);
+        __m128 const extentX = _mm_loadu_ps(&m_extentX[boundsIndex]);
+        __m128 const extentY = _mm_loadu_ps(&m_extentY[boundsIndex]);
+        __m128 const extentZ = _mm_loadu_ps(&m_extentZ[boundsIndex]);
+        __m128       outside = _mm_setzero_ps();
+
+        for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+        {
+            __m128 const distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeNormalX[plane], centerX), _mm_mul_ps(planeNormalY[plane], centerY)),
+                                               _mm_add_ps(_mm_mul_ps(planeNormalZ[plane], centerZ), planeDistance[plane]));
+            __m128 const radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, planeNormalX[plane]), extentX),
+                                                        _mm_mul_ps(_mm_andnot_ps(signMask, planeNormalY[plane]), extentY)),
+                                             _mm_mul_ps(_mm_andnot_ps(signMask, planeNormalZ[plane]), extentZ));
+
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, radius), _mm_setzero_ps()));
+        }
+
+        int const outsideBits = _mm_movemask_ps(outside);
+
+        for (int lane = 0; lane < 4; ++lane)
+        {
+            uint8_t const isVisible = (outsideBits & (1 << lane)) == 0 ? 1 : 0;
+
+            m_isVisible[boundsIndex + lane] = isVisible;
+            m_visibleCount += isVisible;
+        }
+    }
+#endif
+
+    // Scalar path for the remainder, and for every box on builds without SSE2.
+    for (; boundsIndex < boundsCount; ++boundsIndex)
+    {
+        bool isOutside = false;
+
+        for (int plane = 0; plane < FRUSTUM_PLANE_COUNT && !isOutside; ++plane)
+        {
+            Vec3 const& normal   = frustum.m_normals[plane];
+            float const distance = normal.x * m_centerX[boundsIndex] + normal.y * m_centerY[boundsIndex] + normal.z * m_centerZ[boundsIndex] + frustum.m_distances[plane];
+            float const radius   = fabsf(normal.x) * m_extentX[boundsIndex] + fabsf(normal.y) * m_extentY[boundsIndex] + fabsf(normal.z) * m_extentZ[boundsIndex];
+
+            isOutside = distance + radius < 0.f;
+        }
+
+        m_isVisible[boundsIndex] = isOutside ? 0 : 1;
+        m_visibleCount += isOutside ? 0 : 1;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool FrustumCuller::IsVisible(int const boundsIndex) const
+{
+    return m_isVisible[boundsIndex] != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrustumCuller::GetBoundsCount() const
+{
+    return static_cast<int>(m_centerX.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrustumCuller::GetVisibleCount() const
+{
+    return m_visibleCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int FrustumCuller::GetCulledCount() const
+{
+    return GetBoundsCount() - m_visibleCount;
+}
@@ -0,0 +1,61 @@
+//----------------------------------------------------------------------------------------------------
+// FrustumCuller.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct AABB3;
+struct Mat44;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr FRUSTUM_PLANE_COUNT = 6;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Six planes with inward normals; a point X is inside a plane when dot(normal, X) + distance >= 0.
+struct sFrustum
+{
+    Vec3  m_normals[FRUSTUM_PLANE_COUNT];
+    float m_distances[FRUSTUM_PLANE_COUNT] = {};
+
+    static sFrustum MakePerspective(Vec3 const& position, EulerAngles const& orientation, float aspect, float fovDegrees, float nearDistance, float farDistance);
+};
+
+//----------------------------------------------------------------------------------------------------
+AABB3 TransformBounds(AABB3 const& localBounds, Mat44 const& modelToWorld);
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Tests many world-space boxes against one frustum per frame. Boxes are kept as center and half-extent
+/// arrays (structure of arrays), so Cull tests four boxes per SSE instruction against each plane; builds
+/// without SSE2 run the same test one box at a time. A box is culled only when it lies fully outside
+/// some plane, so the test is conservative near the frustum's corners.
+class FrustumCuller
+{
+public:
+    void Clear();
+    int  AddBounds(AABB3 const& localBounds, Mat44 const& modelToWorld);
+    int  AddBounds(Vec3 const& center, Vec3 const& halfExtents);
+    void Cull(sFrustum const& frustum);
+
+    bool IsVisible(int boundsIndex) const;
+    int  GetBoundsCount() const;
+    int  GetVisibleCount() const;
+    int  GetCulledCount() const;
+
+private:
+    std::vector<float>   m_centerX;
+    std::vector<float>   m_centerY;
+    std::vector<float>   m_centerZ;
+    std::vector<float>   m_extentX;
+    std::vector<float>   m_extentY;
+    std::vector<float>   m_extentZ;
+    std::vector<uint8_t> m_isVisible;
+    int                  m_visibleCount = 0;
+};
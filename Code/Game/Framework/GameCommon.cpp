@@ -10,6 +10,7 @@
 #include "Engine/Renderer/Vertex_PCU.hpp"
 #include "Engine/Math/MathUtils.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
 
 //-----------------------------------------------------------------------------------------------
 // DebugRender color-related
@@ -78,6 +79,8 @@ void DebugDrawRing(Vec2 const& center, float radius, float thickness, Rgba8 cons
 
     g_theRenderer->BindTexture(nullptr);
     g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    RecordRenderUpload(NUM_VERTS * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -111,6 +114,8 @@ void DebugDrawLine(Vec2 const& start, Vec2 const& end, float thickness, Rgba8 co
 
     g_theRenderer->BindTexture(nullptr);
     g_theRenderer->DrawVertexArray(6, &verts[0]);
+    RecordRenderUpload(6 * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 }
 
 //------------------------------------------------------------------------------------------------
@@ -160,6 +165,8 @@ void DebugDrawGlowCircle(Vec2 const& center, float radius, Rgba8 const& color, f
     }
 
     g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    RecordRenderUpload(NUM_VERTS * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 }
 
 void DebugDrawGlowBox(Vec2 const& center, Vec2 const& dimensions, Rgba8 const& color, float glowIntensity)
@@ -207,6 +214,8 @@ void DebugDrawGlowBox(Vec2 const& center, Vec2 const& dimensions, Rgba8 const& c
 
     // Draw the vertex array
     g_theRenderer->DrawVertexArray(NUM_VERTS, &verts[0]);
+    RecordRenderUpload(NUM_VERTS * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 }
 
 
@@ -273,6 +282,8 @@ void DebugDrawBoxRing(Vec2 const& center, float radius, float thickness, Rgba8 c
     }
 
     g_theRenderer->DrawVertexArray(24, &verts[0]);
+    RecordRenderUpload(24 * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 }
 
 char const* GetDebugIntString(int const debugInt)
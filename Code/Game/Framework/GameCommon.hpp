@@ -26,9 +26,11 @@ class BitmapFont;
 class NetworkSubsystem;
 class Game;
 class LightSubsystem;
+class OpeningBookSubsystem;
 class Renderer;
 class RandomNumberGenerator;
 class ResourceSubsystem;
+class TablebaseSubsystem;
 
 // one-time declaration
 extern App*                   g_theApp;
@@ -38,8 +40,10 @@ extern Game*                  g_theGame;
 extern Renderer*              g_theRenderer;
 extern RandomNumberGenerator* g_theRNG;
 extern LightSubsystem*        g_theLightSubsystem;
+extern OpeningBookSubsystem*  g_theOpeningBookSubsystem;
 // extern NetworkSubsystem*      g_theNetworkSubsystem;
 extern ResourceSubsystem*     g_theResourceSubsystem;
+extern TablebaseSubsystem*    g_theTablebaseSubsystem;
 
 //-----------------------------------------------------------------------------------------------
 // DebugRender-related
@@ -0,0 +1,96 @@
+//----------------------------------------------------------------------------------------------------
+// HeadlessMatch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/HeadlessMatch.hpp"
+
+#include <algorithm>
+
+#include "Game/Framework/ChessRules.hpp"
+
+//----------------------------------------------------------------------------------------------------
+HeadlessMatch::HeadlessMatch(sChessPosition const& startPosition)
+{
+    Reset(startPosition);
+}
+
+//----------------------------------------------------------------------------------------------------
+void HeadlessMatch::Reset(sChessPosition const& startPosition)
+{
+    m_position = startPosition;
+    m_history.Reset(m_position.GetZobristKey(), m_position.m_halfMoveClock);
+    m_moveList.clear();
+    m_result = EvaluateMatchResult(m_position, m_history);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Applies move if it is legal and the match is still going. A pawn reaching the last rank
+/// without a promotion type promotes to a queen. Match is stricter: its ValidatePawnMove rejects a
+/// promotion that names no piece.
+bool HeadlessMatch::SubmitMove(sChessMove const& move)
+{
+    if (m_result != eMatchResult::ONGOING || !move.IsValid()) return false;
+
+    sChessMove legalMove = move;
+
+    int const  toRank          = move.m_toSquare / CHESS_BOARD_SIZE;
+    bool const isPromotionRank = toRank == 0 || toRank == CHESS_BOARD_SIZE - 1;
+
+    if (legalMove.m_promoteTo == ePieceType::NONE && isPromotionRank && m_position.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN)
+    {
+        legalMove.m_promoteTo = ePieceType::QUEEN;
+    }
+
+    GenerateLegalMoves(m_position, m_legalMoves);
+
+    if (std::find(m_legalMoves.begin(), m_legalMoves.end(), legalMove) == m_legalMoves.end()) return false;
+
+    bool const isIrreversible = IsZeroingMove(m_position, legalMove);
+
+    m_position.ApplyMove(legalMove);
+    m_history.Push(m_position.GetZobristKey(), isIrreversible);
+    m_moveList.push_back(legalMove);
+    m_result = EvaluateMatchResult(m_position, m_history);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+sChessPosition const& HeadlessMatch::GetPosition() const
+{
+    return m_position;
+}
+
+//----------------------------------------------------------------------------------------------------
+ZobristHistory const& HeadlessMatch::GetHistory() const
+{
+    return m_history;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sChessMove> const& HeadlessMatch::GetMoveList() const
+{
+    return m_moveList;
+}
+
+//----------------------------------------------------------------------------------------------------
+eMatchResult HeadlessMatch::GetResult() const
+{
+    return m_result;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The player who delivered mate, or -1 while the match goes on or ended in a draw.
+int HeadlessMatch::GetWinnerId() const
+{
+    if (m_result != eMatchResult::WIN_CHECKMATE) return -1;
+
+    return 1 - m_position.m_sideToMove;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool HeadlessMatch::IsFinished() const
+{
+    return m_result != eMatchResult::ONGOING;
+}
@@ -0,0 +1,39 @@
+//----------------------------------------------------------------------------------------------------
+// HeadlessMatch.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/MatchCommon.hpp"
+#include "Game/Framework/ZobristHistory.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Rules-only match: a position, its Zobrist history and the move list, with the same game-end rules
+/// Match applies. It has no Board, Piece, Camera, Clock or Renderer, so self-play and tournament tools
+/// can run thousands of games without a window or a GPU.
+class HeadlessMatch
+{
+public:
+    explicit HeadlessMatch(sChessPosition const& startPosition = sChessPosition::GetStartingPosition());
+
+    void Reset(sChessPosition const& startPosition);
+    bool SubmitMove(sChessMove const& move);
+
+    sChessPosition const&          GetPosition() const;
+    ZobristHistory const&          GetHistory() const;
+    std::vector<sChessMove> const& GetMoveList() const;
+    eMatchResult                   GetResult() const;
+    int                            GetWinnerId() const;
+    bool                           IsFinished() const;
+
+private:
+    sChessPosition          m_position;
+    ZobristHistory          m_history;
+    std::vector<sChessMove> m_moveList;
+    std::vector<sChessMove> m_legalMoves; // Scratch buffer reused by SubmitMove
+    eMatchResult            m_result = eMatchResult::ONGOING;
+};
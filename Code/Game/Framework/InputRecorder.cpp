@@ -0,0 +1,269 @@
+//----------------------------------------------------------------------------------------------------
+// InputRecorder.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/InputRecorder.hpp"
+
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Input/InputSystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr INPUT_RECORDING_MAGIC   = 0x52494344;     // "DCIR"
+uint32_t constexpr INPUT_RECORDING_VERSION = 1;
+
+//----------------------------------------------------------------------------------------------------
+struct sInputRecordingHeader
+{
+    uint32_t m_magic           = INPUT_RECORDING_MAGIC;
+    uint32_t m_version         = INPUT_RECORDING_VERSION;
+    uint32_t m_frameSize       = sizeof(sInputFrame);     // Rejects files written by a build with another layout
+    uint32_t m_frameCount      = 0;
+    uint64_t m_finalZobristKey = 0;                       // Position the recorded match ended in
+};
+
+//----------------------------------------------------------------------------------------------------
+static eInputRecorderMode       s_mode            = eInputRecorderMode::LIVE;
+static std::vector<sInputFrame> s_frames;
+static int                      s_replayIndex     = -1;     // Frame being replayed; -1 before the first
+static uint64_t                 s_finalZobristKey = 0;
+
+//----------------------------------------------------------------------------------------------------
+static bool IsBitSet(uint64_t const* bits, unsigned char const keyCode)
+{
+    return (bits[keyCode >> 6] >> (keyCode & 63) & 1) != 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void SetBit(uint64_t* bits, unsigned char const keyCode)
+{
+    bits[keyCode >> 6] |= uint64_t{1} << (keyCode & 63);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The frame a replay is on, or nullptr when not replaying or before the first frame.
+static sInputFrame const* GetReplayFrame()
+{
+    if (s_mode != eInputRecorderMode::REPLAYING || s_replayIndex < 0 || s_replayIndex >= static_cast<int>(s_frames.size())) return nullptr;
+
+    return &s_frames[s_replayIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The frame being recorded, or nullptr when not recording or before the first frame.
+static sInputFrame* GetRecordingFrame()
+{
+    if (s_mode != eInputRecorderMode::RECORDING || s_frames.empty()) return nullptr;
+
+    return &s_frames.back();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Call once per frame, after the input system has seen the frame's messages and before gameplay
+/// reads any input. Recording snapshots every key and the cursor; replaying moves to the next frame.
+void InputRecorderBeginFrame()
+{
+    if (s_mode == eInputRecorderMode::REPLAYING)
+    {
+        ++s_replayIndex;
+        return;
+    }
+
+    if (s_mode != eInputRecorderMode::RECORDING) return;
+
+    sInputFrame& frame = s_frames.emplace_back();
+
+    for (int keyIndex = 0; keyIndex < 256; ++keyIndex)
+    {
+        unsigned char const keyCode = static_cast<unsigned char>(keyIndex);
+
+        if (g_theInput->IsKeyDown(keyCode)) SetBit(frame.m_keyDownBits, keyCode);
+        if (g_theInput->WasKeyJustPressed(keyCode)) SetBit(frame.m_justPressedBits, keyCode);
+        if (g_theInput->WasKeyJustReleased(keyCode)) SetBit(frame.m_justReleasedBits, keyCode);
+    }
+
+    frame.m_cursorClientDelta = g_theInput->GetCursorClientDelta();
+}
+
+//----------------------------------------------------------------------------------------------------
+eInputRecorderMode GetInputRecorderMode()
+{
+    return s_mode;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Drops any earlier recording or replay; the first frame is captured at the next
+/// InputRecorderBeginFrame.
+void StartInputRecording()
+{
+    s_frames.clear();
+    s_replayIndex     = -1;
+    s_finalZobristKey = 0;
+    s_mode            = eInputRecorderMode::RECORDING;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Writes the frames recorded so far and goes back to live input. finalZobristKey is the position
+/// the match is in now, so a replay can tell whether it ended up in the same place.
+bool StopInputRecording(String const& filePath,
+                        uint64_t const finalZobristKey)
+{
+    if (s_mode != eInputRecorderMode::RECORDING) return false;
+
+    s_mode            = eInputRecorderMode::LIVE;
+    s_finalZobristKey = finalZobristKey;
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+
+    if (!file) return false;
+
+    sInputRecordingHeader header;
+    header.m_frameCount      = static_cast<uint32_t>(s_frames.size());
+    header.m_finalZobristKey = finalZobristKey;
+
+    file.write(reinterpret_cast<char const*>(&header), sizeof(header));
+    file.write(reinterpret_cast<char const*>(s_frames.data()), static_cast<std::streamsize>(s_frames.size() * sizeof(sInputFrame)));
+
+    return static_cast<bool>(file);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Loads a recording and starts replaying it; the first frame plays at the next
+/// InputRecorderBeginFrame. Returns false, staying live, if the file is missing or from another build.
+bool StartInputReplay(String const& filePath)
+{
+    std::ifstream file(filePath, std::ios::binary);
+
+    if (!file) return false;
+
+    sInputRecordingHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+    if (!file || header.m_magic != INPUT_RECORDING_MAGIC || header.m_version != INPUT_RECORDING_VERSION || header.m_frameSize != sizeof(sInputFrame)) return false;
+
+    std::vector<sInputFrame> frames(header.m_frameCount);
+    file.read(reinterpret_cast<char*>(frames.data()), static_cast<std::streamsize>(frames.size() * sizeof(sInputFrame)));
+
+    if (!file) return false;
+
+    s_frames          = std::move(frames);
+    s_replayIndex     = -1;
+    s_finalZobristKey = header.m_finalZobristKey;
+    s_mode            = eInputRecorderMode::REPLAYING;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void StopInputReplay()
+{
+    if (s_mode == eInputRecorderMode::REPLAYING) s_mode = eInputRecorderMode::LIVE;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief True once the last recorded frame has been played.
+bool IsInputReplayFinished()
+{
+    return s_replayIndex + 1 >= static_cast<int>(s_frames.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Frames in the current or most recent recording or replay.
+int GetInputFrameCount()
+{
+    return static_cast<int>(s_frames.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t GetInputReplayFinalZobristKey()
+{
+    return s_finalZobristKey;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsRecordedKeyDown(unsigned char const keyCode)
+{
+    if (s_mode != eInputRecorderMode::REPLAYING) return g_theInput->IsKeyDown(keyCode);
+
+    sInputFrame const* frame = GetReplayFrame();
+
+    return frame != nullptr && IsBitSet(frame->m_keyDownBits, keyCode);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WasRecordedKeyJustPressed(unsigned char const keyCode)
+{
+    if (s_mode != eInputRecorderMode::REPLAYING) return g_theInput->WasKeyJustPressed(keyCode);
+
+    sInputFrame const* frame = GetReplayFrame();
+
+    return frame != nullptr && IsBitSet(frame->m_justPressedBits, keyCode);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WasRecordedKeyJustReleased(unsigned char const keyCode)
+{
+    if (s_mode != eInputRecorderMode::REPLAYING) return g_theInput->WasKeyJustReleased(keyCode);
+
+    sInputFrame const* frame = GetReplayFrame();
+
+    return frame != nullptr && IsBitSet(frame->m_justReleasedBits, keyCode);
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec2 GetRecordedCursorClientDelta()
+{
+    if (s_mode != eInputRecorderMode::REPLAYING) return g_theInput->GetCursorClientDelta();
+
+    sInputFrame const* frame = GetReplayFrame();
+
+    return frame != nullptr ? frame->m_cursorClientDelta : Vec2::ZERO;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Records the game clock's delta for this frame, or returns the recorded one when replaying,
+/// so the replay advances the simulation by the same steps however fast it runs.
+double GetRecordedGameDeltaSeconds(double const liveDeltaSeconds)
+{
+    if (sInputFrame* frame = GetRecordingFrame()) frame->m_gameDeltaSeconds = liveDeltaSeconds;
+
+    sInputFrame const* replayFrame = GetReplayFrame();
+
+    return replayFrame != nullptr ? replayFrame->m_gameDeltaSeconds : liveDeltaSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief GetRecordedGameDeltaSeconds for the system clock, which drives the free camera.
+double GetRecordedSystemDeltaSeconds(double const liveDeltaSeconds)
+{
+    if (sInputFrame* frame = GetRecordingFrame()) frame->m_systemDeltaSeconds = liveDeltaSeconds;
+
+    sInputFrame const* replayFrame = GetReplayFrame();
+
+    return replayFrame != nullptr ? replayFrame->m_systemDeltaSeconds : liveDeltaSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Records the camera pose the player ended the frame with, or overwrites it with the recorded
+/// one when replaying. The replayed input should land on the same pose anyway; this keeps picking and
+/// culling on the recorded view even if float results drift between builds.
+void SyncRecordedCameraPose(Vec3&        position,
+                            EulerAngles& orientation)
+{
+    if (sInputFrame* frame = GetRecordingFrame())
+    {
+        frame->m_cameraPosition    = position;
+        frame->m_cameraOrientation = orientation;
+    }
+
+    if (sInputFrame const* replayFrame = GetReplayFrame())
+    {
+        position    = replayFrame->m_cameraPosition;
+        orientation = replayFrame->m_cameraOrientation;
+    }
+}
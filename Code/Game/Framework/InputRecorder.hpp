@@ -0,0 +1,60 @@
+//----------------------------------------------------------------------------------------------------
+// InputRecorder.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr INPUT_RECORDER_KEY_WORD_COUNT = 4;     // 256 key codes, one bit each
+
+//----------------------------------------------------------------------------------------------------
+enum class eInputRecorderMode : uint8_t
+{
+    LIVE,
+    RECORDING,
+    REPLAYING
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Everything one frame of gameplay reads from outside the simulation. Plain data, written to
+/// the recording file as is.
+struct sInputFrame
+{
+    uint64_t    m_keyDownBits[INPUT_RECORDER_KEY_WORD_COUNT]      = {};
+    uint64_t    m_justPressedBits[INPUT_RECORDER_KEY_WORD_COUNT]  = {};
+    uint64_t    m_justReleasedBits[INPUT_RECORDER_KEY_WORD_COUNT] = {};
+    Vec2        m_cursorClientDelta;
+    double      m_gameDeltaSeconds   = 0.0;
+    double      m_systemDeltaSeconds = 0.0;
+    Vec3        m_cameraPosition;
+    EulerAngles m_cameraOrientation;
+};
+
+//----------------------------------------------------------------------------------------------------
+void               InputRecorderBeginFrame();
+eInputRecorderMode GetInputRecorderMode();
+void               StartInputRecording();
+bool               StopInputRecording(String const& filePath, uint64_t finalZobristKey);
+bool               StartInputReplay(String const& filePath);
+void               StopInputReplay();
+bool               IsInputReplayFinished();
+int                GetInputFrameCount();
+uint64_t           GetInputReplayFinalZobristKey();
+
+//----------------------------------------------------------------------------------------------------
+// Gameplay reads input through these rather than g_theInput, so a replay sees exactly what the
+// recorded session saw.
+bool   IsRecordedKeyDown(unsigned char keyCode);
+bool   WasRecordedKeyJustPressed(unsigned char keyCode);
+bool   WasRecordedKeyJustReleased(unsigned char keyCode);
+Vec2   GetRecordedCursorClientDelta();
+double GetRecordedGameDeltaSeconds(double liveDeltaSeconds);
+double GetRecordedSystemDeltaSeconds(double liveDeltaSeconds);
+void   SyncRecordedCameraPose(Vec3& position, EulerAngles& orientation);
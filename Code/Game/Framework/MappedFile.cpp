@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MappedFile.hpp"
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN		// Always #define this before #including <windows.h>
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+//----------------------------------------------------------------------------------------------------
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MappedFile::Open(char const* filePath)
+{
+    Close();
+
+#if defined(_WIN32)
+    HANDLE const fileHandle = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    HANDLE const mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle == nullptr)
+    {
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    void const* view = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (view == nullptr)
+    {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    m_fileHandle    = fileHandle;
+    m_mappingHandle = mappingHandle;
+    m_data          = static_cast<uint8_t const*>(view);
+    m_size          = static_cast<size_t>(fileSize.QuadPart);
+#else
+    int const fileDescriptor = open(filePath, O_RDONLY);
+    if (fileDescriptor < 0) return false;
+
+    struct stat fileStat;
+    if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    void* view = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileDescriptor, 0);
+    if (view == MAP_FAILED)
+    {
+        close(fileDescriptor);
+        return false;
+    }
+
+    m_fileDescriptor = fileDescriptor;
+    m_data           = static_cast<uint8_t const*>(view);
+    m_size           = static_cast<size_t>(fileStat.st_size);
+#endif
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MappedFile::Close()
+{
+#if defined(_WIN32)
+    if (m_data != nullptr) UnmapViewOfFile(m_data);
+    if (m_mappingHandle != nullptr) CloseHandle(m_mappingHandle);
+    if (m_fileHandle != nullptr) CloseHandle(m_fileHandle);
+
+    m_mappingHandle = nullptr;
+    m_fileHandle    = nullptr;
+#else
+    if (m_data != nullptr) munmap(const_cast<uint8_t*>(m_data), m_size);
+    if (m_fileDescriptor >= 0) close(m_fileDescriptor);
+
+    m_fileDescriptor = -1;
+#endif
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MappedFile::IsOpen() const
+{
+    return m_data != nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t const* MappedFile::GetData() const
+{
+    return m_data;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t MappedFile::GetSize() const
+{
+    return m_size;
+}
@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// MappedFile.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Read-only memory mapping of a whole file. Pages are faulted in on first touch, so opening a large
+/// data file costs nothing until it is actually read.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const& copy)            = delete;
+    MappedFile& operator=(MappedFile const& copy) = delete;
+
+    bool Open(char const* filePath);
+    void Close();
+
+    bool           IsOpen() const;
+    uint8_t const* GetData() const;
+    size_t         GetSize() const;
+
+private:
+    uint8_t const* m_data = nullptr;
+    size_t         m_size = 0;
+
+#if defined(_WIN32)
+    void* m_fileHandle    = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fileDescriptor = -1;
+#endif
+};
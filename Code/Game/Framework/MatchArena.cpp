@@ -0,0 +1,76 @@
+//----------------------------------------------------------------------------------------------------
+// MatchArena.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MatchArena.hpp"
+
+//----------------------------------------------------------------------------------------------------
+MatchArena::MatchArena(size_t const blockSize)
+    : m_blockSize(blockSize)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+MatchArena::~MatchArena()
+{
+    Reset();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Bumps the cursor of the current block, starting a new block when the request does not fit.
+/// Requests larger than a block get a block of their own.
+void* MatchArena::Allocate(size_t const size,
+                           size_t const alignment)
+{
+    uintptr_t alignedAddress = (reinterpret_cast<uintptr_t>(m_cursor) + alignment - 1) & ~(alignment - 1);
+
+    if (m_cursor == nullptr || alignedAddress + size > reinterpret_cast<uintptr_t>(m_blockEnd))
+    {
+        size_t const   blockSize = size + alignment > m_blockSize ? size + alignment : m_blockSize;
+        uint8_t* const block     = new uint8_t[blockSize];
+
+        m_blocks.push_back(block);
+        m_cursor       = block;
+        m_blockEnd     = block + blockSize;
+        alignedAddress = (reinterpret_cast<uintptr_t>(m_cursor) + alignment - 1) & ~(alignment - 1);
+    }
+
+    m_cursor         = reinterpret_cast<uint8_t*>(alignedAddress + size);
+    m_bytesAllocated += size;
+
+    return reinterpret_cast<void*>(alignedAddress);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Destroys every object made with New, newest first, then frees all blocks.
+void MatchArena::Reset()
+{
+    for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it)
+    {
+        it->m_destroy(it->m_object);
+    }
+
+    for (uint8_t* block : m_blocks)
+    {
+        delete[] block;
+    }
+
+    m_destructors.clear();
+    m_blocks.clear();
+    m_cursor         = nullptr;
+    m_blockEnd       = nullptr;
+    m_bytesAllocated = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t MatchArena::GetBytesAllocated() const
+{
+    return m_bytesAllocated;
+}
+
+//----------------------------------------------------------------------------------------------------
+int MatchArena::GetBlockCount() const
+{
+    return static_cast<int>(m_blocks.size());
+}
@@ -0,0 +1,146 @@
+//----------------------------------------------------------------------------------------------------
+// MatchArena.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+size_t constexpr MATCH_ARENA_BLOCK_SIZE = 64 * 1024;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Bump allocator for objects that live exactly as long as one match. Allocations are carved from
+/// MATCH_ARENA_BLOCK_SIZE blocks and are never freed one at a time; Reset runs the destructors of
+/// everything made with New, newest first, and releases every block at once.
+class MatchArena
+{
+public:
+    explicit MatchArena(size_t blockSize = MATCH_ARENA_BLOCK_SIZE);
+    ~MatchArena();
+
+    MatchArena(MatchArena const&)            = delete;
+    MatchArena& operator=(MatchArena const&) = delete;
+
+    void* Allocate(size_t size, size_t alignment);
+    void  Reset();
+
+    template <typename T, typename... Args>
+    T* New(Args&&... args);
+
+    size_t GetBytesAllocated() const;
+    int    GetBlockCount() const;
+
+private:
+    struct sDestructor
+    {
+        void* m_object = nullptr;
+        void  (*m_destroy)(void* object) = nullptr;
+    };
+
+    std::vector<uint8_t*>    m_blocks;
+    uint8_t*                 m_cursor         = nullptr;
+    uint8_t*                 m_blockEnd       = nullptr;
+    size_t                   m_blockSize      = MATCH_ARENA_BLOCK_SIZE;
+    size_t                   m_bytesAllocated = 0;
+    std::vector<sDestructor> m_destructors;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Constructs a T in the arena. Its destructor runs on Reset, unless T is trivially destructible.
+template <typename T, typename... Args>
+T* MatchArena::New(Args&&... args)
+{
+    T* object = new (Allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+
+    if constexpr (!std::is_trivially_destructible_v<T>)
+    {
+        m_destructors.push_back({object, [](void* destroyed) { static_cast<T*>(destroyed)->~T(); }});
+    }
+
+    return object;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Fixed-type object pool on top of a MatchArena. Released objects are destroyed and their slots kept
+/// on a free list for the next Acquire, so the arena only grows to the most objects alive at once.
+/// The pool never frees memory itself; every live object must be released before the arena resets.
+template <typename T>
+class ArenaPool
+{
+public:
+    explicit ArenaPool(MatchArena& arena);
+
+    template <typename... Args>
+    T* Acquire(Args&&... args);
+    void Release(T* object);
+
+    int GetLiveCount() const;
+    int GetFreeCount() const;
+
+private:
+    MatchArena&     m_arena;
+    std::vector<T*> m_freeSlots;
+    int             m_liveCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+ArenaPool<T>::ArenaPool(MatchArena& arena)
+    : m_arena(arena)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+template <typename... Args>
+T* ArenaPool<T>::Acquire(Args&&... args)
+{
+    void* slot = nullptr;
+
+    if (m_freeSlots.empty())
+    {
+        slot = m_arena.Allocate(sizeof(T), alignof(T));
+    }
+    else
+    {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+
+    ++m_liveCount;
+
+    return new (slot) T(std::forward<Args>(args)...);
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+void ArenaPool<T>::Release(T* object)
+{
+    if (object == nullptr) return;
+
+    object->~T();
+    m_freeSlots.push_back(object);
+    --m_liveCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+int ArenaPool<T>::GetLiveCount() const
+{
+    return m_liveCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+int ArenaPool<T>::GetFreeCount() const
+{
+    return static_cast<int>(m_freeSlots.size());
+}
@@ -69,3 +69,17 @@ bool IsMoveValid(eMoveResult const& result)
     default: ERROR_AND_DIE(Stringf("Unhandled MoveResult enum value #%d", result))
     }
 }
+
+char const* GetMatchResultString(eMatchResult const& result)
+{
+    switch (result)
+    {
+    case eMatchResult::ONGOING: return "Match is ongoing";
+    case eMatchResult::WIN_CHECKMATE: return "Checkmate";
+    case eMatchResult::DRAW_STALEMATE: return "Draw by stalemate";
+    case eMatchResult::DRAW_THREEFOLD_REPETITION: return "Draw by threefold repetition";
+    case eMatchResult::DRAW_FIFTY_MOVE_RULE: return "Draw by the fifty-move rule";
+    case eMatchResult::DRAW_INSUFFICIENT_MATERIAL: return "Draw by insufficient material";
+    default: ERROR_AND_DIE(Stringf("Unhandled MatchResult enum value #%d", result))
+    }
+}
@@ -6,9 +6,17 @@
 #pragma once
 #include <cstdint>
 
-#include "Engine/Math/IntVec2.hpp"
-
-class Piece;
+//----------------------------------------------------------------------------------------------------
+enum class ePieceType : int8_t
+{
+    NONE = -1,
+    PAWN,
+    BISHOP,
+    KNIGHT,
+    ROOK,
+    QUEEN,
+    KING
+};
 
 //----------------------------------------------------------------------------------------------------
 enum class eMoveResult : uint8_t
@@ -36,19 +44,24 @@ enum class eMoveResult : uint8_t
     INVALID_CASTLE_OUT_OF_CHECK
 };
 
-struct sMatchRaycastResult
+//----------------------------------------------------------------------------------------------------
+enum class eMatchResult : uint8_t
 {
-    Piece*  m_hitPiece      = nullptr;
-    IntVec2 m_currentCoords = IntVec2::ZERO;
-    IntVec2 m_targetCoords  = IntVec2::ZERO;
+    ONGOING,
+    WIN_CHECKMATE,
+    DRAW_STALEMATE,
+    DRAW_THREEFOLD_REPETITION,
+    DRAW_FIFTY_MOVE_RULE,
+    DRAW_INSUFFICIENT_MATERIAL
 };
 
-struct sPieceMove
-{
-    Piece const* piece      = nullptr;
-    IntVec2      fromCoords = IntVec2::ZERO;
-    IntVec2      toCoords   = IntVec2::ZERO;
-};
+int constexpr MATCH_RESULT_COUNT = static_cast<int>(eMatchResult::DRAW_INSUFFICIENT_MATERIAL) + 1;
+
+//----------------------------------------------------------------------------------------------------
+float constexpr PIECE_MOVE_SECONDS       = 2.f;
+float constexpr PIECE_CAPTURE_SECONDS    = 2.f;     // Sink time; the captured piece is removed after it
+float constexpr PIECE_CAPTURE_SINK_DEPTH = 0.5f;
 
 char const* GetMoveResultString(eMoveResult const& result);
 bool        IsMoveValid(eMoveResult const& result);
+char const* GetMatchResultString(eMatchResult const& result);
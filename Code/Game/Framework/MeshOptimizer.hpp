@@ -0,0 +1,155 @@
+//----------------------------------------------------------------------------------------------------
+// MeshOptimizer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr MESH_OPTIMIZER_CACHE_SIZE = 16;
+
+//----------------------------------------------------------------------------------------------------
+struct sMeshOptimizationStats
+{
+    int   m_vertexCountBefore = 0;
+    int   m_vertexCountAfter  = 0;
+    int   m_triangleCount     = 0;
+    float m_acmrBefore        = 0.f;  // Average cache misses per triangle
+    float m_acmrAfter         = 0.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+// CPU-only optimization of indexed triangle lists, run once when a mesh is baked.
+// OptimizeMesh welds bit-identical vertexes, orders triangles for the post-transform vertex cache
+// with Tipsify (Sander, Nehab and Barczak 2007), then renumbers vertexes in first-use order so
+// vertex fetches walk memory forward. The result draws exactly the same triangles.
+// Vertexes are only compared and moved as bytes, so any trivially copyable vertex type works and
+// the optimizer needs no Engine.
+//
+template <typename Vertex>
+sMeshOptimizationStats OptimizeMesh(std::vector<Vertex>& verts, std::vector<unsigned int>& indexes, int cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+
+template <typename Vertex>
+int   WeldVertexes(std::vector<Vertex>& verts, std::vector<unsigned int>& indexes);
+void  OptimizeVertexCache(std::vector<unsigned int>& indexes, int vertexCount, int cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+template <typename Vertex>
+void  OptimizeVertexFetch(std::vector<Vertex>& verts, std::vector<unsigned int>& indexes);
+float ComputeACMR(std::vector<unsigned int> const& indexes, int cacheSize = MESH_OPTIMIZER_CACHE_SIZE);
+
+//----------------------------------------------------------------------------------------------------
+// Vertexes are welded only when every byte matches, so seams with split normals or UVs stay split.
+//
+template <typename Vertex>
+struct sVertexBytesHash
+{
+    size_t operator()(Vertex const& vertex) const
+    {
+        uint8_t const* bytes = reinterpret_cast<uint8_t const*>(&vertex);
+        uint64_t       hash  = 0xCBF29CE484222325ull;
+
+        for (size_t index = 0; index < sizeof(Vertex); ++index)
+        {
+            hash ^= bytes[index];
+            hash *= 0x100000001B3ull;
+        }
+
+        return static_cast<size_t>(hash);
+    }
+};
+
+template <typename Vertex>
+struct sVertexBytesEqual
+{
+    bool operator()(Vertex const& a, Vertex const& b) const
+    {
+        return std::memcmp(&a, &b, sizeof(Vertex)) == 0;
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename Vertex>
+sMeshOptimizationStats OptimizeMesh(std::vector<Vertex>&       verts,
+                                    std::vector<unsigned int>& indexes,
+                                    int const                  cacheSize)
+{
+    sMeshOptimizationStats stats;
+    stats.m_vertexCountBefore = static_cast<int>(verts.size());
+    stats.m_triangleCount     = static_cast<int>(indexes.size() / 3);
+    stats.m_acmrBefore        = ComputeACMR(indexes, cacheSize);
+
+    WeldVertexes(verts, indexes);
+    OptimizeVertexCache(indexes, static_cast<int>(verts.size()), cacheSize);
+    OptimizeVertexFetch(verts, indexes);
+
+    stats.m_vertexCountAfter = static_cast<int>(verts.size());
+    stats.m_acmrAfter        = ComputeACMR(indexes, cacheSize);
+
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Merges bit-identical vertexes and rewrites indexes to the survivors. Returns how many
+/// vertexes were removed.
+template <typename Vertex>
+int WeldVertexes(std::vector<Vertex>&       verts,
+                 std::vector<unsigned int>& indexes)
+{
+    static_assert(std::is_trivially_copyable_v<Vertex>, "Vertexes are welded by their bytes");
+
+    std::unordered_map<Vertex, unsigned int, sVertexBytesHash<Vertex>, sVertexBytesEqual<Vertex>> firstIndexByVertex;
+    firstIndexByVertex.reserve(verts.size());
+
+    std::vector<unsigned int> remap(verts.size());
+    std::vector<Vertex>       weldedVerts;
+    weldedVerts.reserve(verts.size());
+
+    for (size_t vertexIndex = 0; vertexIndex < verts.size(); ++vertexIndex)
+    {
+        auto const [iterator, isInserted] = firstIndexByVertex.emplace(verts[vertexIndex], static_cast<unsigned int>(weldedVerts.size()));
+
+        if (isInserted) weldedVerts.push_back(verts[vertexIndex]);
+
+        remap[vertexIndex] = iterator->second;
+    }
+
+    for (unsigned int& index : indexes)
+    {
+        index = remap[index];
+    }
+
+    int const removedCount = static_cast<int>(verts.size() - weldedVerts.size());
+    verts.swap(weldedVerts);
+
+    return removedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Renumbers vertexes in the order the index list first touches them and drops unreferenced ones.
+template <typename Vertex>
+void OptimizeVertexFetch(std::vector<Vertex>&       verts,
+                         std::vector<unsigned int>& indexes)
+{
+    unsigned int constexpr UNASSIGNED = 0xFFFFFFFFu;
+
+    std::vector<unsigned int> remap(verts.size(), UNASSIGNED);
+    std::vector<Vertex>       orderedVerts;
+    orderedVerts.reserve(verts.size());
+
+    for (unsigned int& index : indexes)
+    {
+        if (remap[index] == UNASSIGNED)
+        {
+            remap[index] = static_cast<unsigned int>(orderedVerts.size());
+            orderedVerts.push_back(verts[index]);
+        }
+
+        index = remap[index];
+    }
+
+    verts.swap(orderedVerts);
+}
@@ -0,0 +1,153 @@
+//----------------------------------------------------------------------------------------------------
+// MoveSearch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/MoveSearch.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+
+#include "Game/Framework/ChessRules.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr AI_MATE_SCORE = 1000000;
+
+//----------------------------------------------------------------------------------------------------
+// Indexed by ePieceType; the king is never captured, so its value only orders moves.
+static int constexpr PIECE_VALUES[] = {100, 330, 320, 500, 900, 0};
+
+//----------------------------------------------------------------------------------------------------
+// One move list per ply, kept per thread so a search allocates nothing once its lists have grown.
+static thread_local std::vector<sChessMove> s_moveLists[AI_MAX_SEARCH_DEPTH + 1];
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Material balance from the side to move's point of view.
+static int EvaluateMaterial(sChessPosition const& position)
+{
+    int score = 0;
+
+    for (sChessSquare const& square : position.m_squares)
+    {
+        if (square.IsEmpty()) continue;
+
+        int const value = PIECE_VALUES[static_cast<int>(square.m_type)];
+        score += square.m_playerId == position.m_sideToMove ? value : -value;
+    }
+
+    return score;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Most valuable victim first, then promotions, so alpha-beta cuts early. Quiet moves keep
+/// generation order, so the search is deterministic unless SearchBestMove is given a random engine.
+static void OrderMoves(sChessPosition const&    position,
+                       std::vector<sChessMove>& moves)
+{
+    auto const getMoveOrderScore = [&position](sChessMove const& move)
+    {
+        sChessSquare const& victim = position.m_squares[move.m_toSquare];
+        int                 score  = victim.IsEmpty() ? 0 : PIECE_VALUES[static_cast<int>(victim.m_type)] * 10;
+
+        if (move.m_promoteTo != ePieceType::NONE) score += PIECE_VALUES[static_cast<int>(move.m_promoteTo)];
+
+        return score;
+    };
+
+    std::stable_sort(moves.begin(), moves.end(), [&getMoveOrderScore](sChessMove const& a, sChessMove const& b) { return getMoveOrderScore(a) > getMoveOrderScore(b); });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Negamax alpha-beta on material. Mates score by distance so the nearest one wins; repetitions
+/// and the fifty-move rule are left to the match.
+static int SearchMaterial(sChessPosition const& position,
+                          int const             depth,
+                          int const             ply,
+                          int                   alpha,
+                          int const             beta)
+{
+    // Leaves only need to know whether a move exists, which HasAnyLegalMove answers without a full list.
+    if (depth == 0)
+    {
+        if (!HasAnyLegalMove(position)) return IsInCheck(position, position.m_sideToMove) ? -AI_MATE_SCORE + ply : 0;
+
+        return EvaluateMaterial(position);
+    }
+
+    std::vector<sChessMove>& moves = s_moveLists[ply];
+    GenerateLegalMoves(position, moves);
+
+    if (moves.empty()) return IsInCheck(position, position.m_sideToMove) ? -AI_MATE_SCORE + ply : 0;
+
+    OrderMoves(position, moves);
+
+    for (sChessMove const& move : moves)
+    {
+        sChessPosition child = position;
+        child.ApplyMove(move);
+
+        int const score = -SearchMaterial(child, depth - 1, ply + 1, -beta, -alpha);
+
+        if (score >= beta) return score;
+        alpha = std::max(alpha, score);
+    }
+
+    return alpha;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Searches the configured depth and plays the best-scoring root move. With random, moves that tie
+/// for the best score are chosen between uniformly, so engine-vs-engine games do not repeat move for
+/// move; without it the first of them in search order is played. Each root move after the first is
+/// then searched with alpha one below the best score, so a tie scores exactly rather than failing
+/// low. Safe to call from several threads at once, given separate random engines.
+bool SearchBestMove(sAIControllerConfig const& config,
+                    sChessPosition const&      position,
+                    sChessMove&                out_move,
+                    std::mt19937*              random)
+{
+    std::vector<sChessMove>& moves = s_moveLists[0];
+    GenerateLegalMoves(position, moves);
+
+    if (moves.empty()) return false;
+
+    out_move = moves.front();
+
+    int const depth = std::clamp(config.m_searchDepth, 0, AI_MAX_SEARCH_DEPTH);
+
+    if (depth == 0) return true;
+
+    OrderMoves(position, moves);
+
+    // The root list is searched by copy, since the children reuse the per-ply lists.
+    std::vector<sChessMove> const rootMoves = moves;
+    int                           bestScore = -INT_MAX;
+    int                           tieCount  = 0;
+
+    for (sChessMove const& move : rootMoves)
+    {
+        sChessPosition child = position;
+        child.ApplyMove(move);
+
+        int const alpha = random != nullptr && bestScore > -INT_MAX ? bestScore - 1 : bestScore;
+        int const score = -SearchMaterial(child, depth - 1, 1, -INT_MAX, -alpha);
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            out_move  = move;
+            tieCount  = 1;
+        }
+        else if (score == bestScore && random != nullptr)
+        {
+            // Reservoir sampling: the n-th tied move replaces the choice with probability 1 / n.
+            ++tieCount;
+
+            if (std::uniform_int_distribution<int>(0, tieCount - 1)(*random) == 0) out_move = move;
+        }
+    }
+
+    return true;
+}
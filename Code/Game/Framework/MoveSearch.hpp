@@ -0,0 +1,29 @@
+//----------------------------------------------------------------------------------------------------
+// MoveSearch.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <random>
+#include <string>
+
+#include "Game/Framework/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr AI_MAX_SEARCH_DEPTH = 8;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief What an AIController may use to pick a move. The tournament plays two of these against
+/// each other, so an engine change is tried by describing it here.
+struct sAIControllerConfig
+{
+    std::string m_name           = "AI";
+    bool        m_useOpeningBook = true;
+    bool        m_useTablebase   = true;
+    int         m_searchDepth    = 2;     // Plies of material search when neither answers; 0 plays the first legal move
+};
+
+//----------------------------------------------------------------------------------------------------
+// Material search only; the opening book and tablebases are the AIController's to consult. Needs no
+// Engine, so the headless tournament can run it.
+bool SearchBestMove(sAIControllerConfig const& config, sChessPosition const& position, sChessMove& out_move, std::mt19937* random);
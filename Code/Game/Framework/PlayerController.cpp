@@ -13,6 +13,7 @@
 #include "Engine/Renderer/Camera.hpp"
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/InputRecorder.hpp"
 #include "Game/Gameplay/Game.hpp"
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
 
@@ -21,7 +22,7 @@ PlayerController::PlayerController(Game* owner)
     : Controller(owner)
 {
     m_worldCamera = new Camera();
-    m_worldCamera->SetPerspectiveGraphicView(2.f, 60.f, 0.1f, 100.f);
+    m_worldCamera->SetPerspectiveGraphicView(PLAYER_CAMERA_ASPECT, PLAYER_CAMERA_FOV_DEGREES, PLAYER_CAMERA_NEAR, PLAYER_CAMERA_FAR);
     m_worldCamera->SetNormalizedViewport(AABB2::ZERO_TO_ONE);
 
     Mat44 c2r;
@@ -48,29 +49,30 @@ void PlayerController::Update(float deltaSeconds)
     m_velocity                = Vec3::ZERO;
     float constexpr moveSpeed = 2.f;
 
-    if (g_theInput->IsKeyDown(KEYCODE_W)) m_velocity += forward * moveSpeed;
-    if (g_theInput->IsKeyDown(KEYCODE_S)) m_velocity -= forward * moveSpeed;
-    if (g_theInput->IsKeyDown(KEYCODE_A)) m_velocity += left * moveSpeed;
-    if (g_theInput->IsKeyDown(KEYCODE_D)) m_velocity -= left * moveSpeed;
-    if (g_theInput->IsKeyDown(KEYCODE_Z)) m_velocity -= Vec3(0.f, 0.f, 1.f) * moveSpeed;
-    if (g_theInput->IsKeyDown(KEYCODE_C)) m_velocity += Vec3(0.f, 0.f, 1.f) * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_W)) m_velocity += forward * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_S)) m_velocity -= forward * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_A)) m_velocity += left * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_D)) m_velocity -= left * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_Z)) m_velocity -= Vec3(0.f, 0.f, 1.f) * moveSpeed;
+    if (IsRecordedKeyDown(KEYCODE_C)) m_velocity += Vec3(0.f, 0.f, 1.f) * moveSpeed;
 
-    if (g_theInput->IsKeyDown(KEYCODE_SHIFT)) deltaSeconds *= 10.f;
+    if (IsRecordedKeyDown(KEYCODE_SHIFT)) deltaSeconds *= 10.f;
 
     m_position += m_velocity * deltaSeconds;
 
-    m_orientation.m_yawDegrees -= g_theInput->GetCursorClientDelta().x * 0.125f;
-    m_orientation.m_pitchDegrees += g_theInput->GetCursorClientDelta().y * 0.125f;
+    m_orientation.m_yawDegrees -= GetRecordedCursorClientDelta().x * 0.125f;
+    m_orientation.m_pitchDegrees += GetRecordedCursorClientDelta().y * 0.125f;
     m_orientation.m_pitchDegrees = GetClamped(m_orientation.m_pitchDegrees, -85.f, 85.f);
 
     m_angularVelocity.m_rollDegrees = 0.f;
 
-    if (g_theInput->IsKeyDown(KEYCODE_Q)) m_angularVelocity.m_rollDegrees = 90.f;
-    if (g_theInput->IsKeyDown(KEYCODE_E)) m_angularVelocity.m_rollDegrees = -90.f;
+    if (IsRecordedKeyDown(KEYCODE_Q)) m_angularVelocity.m_rollDegrees = 90.f;
+    if (IsRecordedKeyDown(KEYCODE_E)) m_angularVelocity.m_rollDegrees = -90.f;
 
     m_orientation.m_rollDegrees += m_angularVelocity.m_rollDegrees * deltaSeconds;
     m_orientation.m_rollDegrees = GetClamped(m_orientation.m_rollDegrees, -45.f, 45.f);
 
+    SyncRecordedCameraPose(m_position, m_orientation);
     m_worldCamera->SetPositionAndOrientation(m_position, m_orientation);
 }
 
@@ -10,6 +10,12 @@
 //----------------------------------------------------------------------------------------------------
 class Camera;
 
+//----------------------------------------------------------------------------------------------------
+float constexpr PLAYER_CAMERA_ASPECT      = 2.f;
+float constexpr PLAYER_CAMERA_FOV_DEGREES = 60.f;
+float constexpr PLAYER_CAMERA_NEAR        = 0.1f;
+float constexpr PLAYER_CAMERA_FAR         = 100.f;
+
 //----------------------------------------------------------------------------------------------------
 class PlayerController final : public Controller
 {
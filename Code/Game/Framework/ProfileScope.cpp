@@ -0,0 +1,150 @@
+//----------------------------------------------------------------------------------------------------
+// ProfileScope.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ProfileScope.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+
+//----------------------------------------------------------------------------------------------------
+std::atomic<bool> g_isProfilerRecording = false;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Single producer, single consumer ring. The owning thread only moves m_writeCount and the draining
+/// main thread only moves m_readCount, so neither side ever waits on the other; a full ring drops the
+/// new event instead.
+struct sProfilerThreadBuffer
+{
+    sProfileEvent         m_events[PROFILER_RING_CAPACITY];
+    std::atomic<uint64_t> m_writeCount   = 0;
+    std::atomic<uint64_t> m_readCount    = 0;
+    std::atomic<uint64_t> m_droppedCount = 0;
+    std::atomic<bool>     m_isRetired    = false;     // Its thread has exited; reused once drained
+    int                   m_threadIndex  = 0;
+    int                   m_depth        = 0;         // Open scopes, owning thread only
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Retires the thread's buffer when the thread exits, so pools created and destroyed by
+/// benchmarks do not grow the buffer list.
+struct sProfilerThreadSlot
+{
+    ~sProfilerThreadSlot()
+    {
+        if (m_buffer != nullptr) m_buffer->m_isRetired.store(true, std::memory_order_release);
+    }
+
+    sProfilerThreadBuffer* m_buffer = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+static std::mutex                                          s_threadBufferMutex;     // Guards registration and draining, never recording
+static std::vector<std::unique_ptr<sProfilerThreadBuffer>> s_threadBuffers;
+static thread_local sProfilerThreadSlot                    s_threadSlot;
+
+//----------------------------------------------------------------------------------------------------
+int64_t GetProfilerTicks()
+{
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+//----------------------------------------------------------------------------------------------------
+double GetProfilerTicksToSeconds()
+{
+    return static_cast<double>(std::chrono::steady_clock::period::num) / static_cast<double>(std::chrono::steady_clock::period::den);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Takes the lock only the first time a thread records.
+static sProfilerThreadBuffer* GetThreadBuffer()
+{
+    if (s_threadSlot.m_buffer != nullptr) return s_threadSlot.m_buffer;
+
+    std::lock_guard const lock(s_threadBufferMutex);
+
+    for (std::unique_ptr<sProfilerThreadBuffer> const& buffer : s_threadBuffers)
+    {
+        if (!buffer->m_isRetired.load(std::memory_order_acquire)) continue;
+        if (buffer->m_readCount.load(std::memory_order_relaxed) != buffer->m_writeCount.load(std::memory_order_relaxed)) continue;
+
+        buffer->m_isRetired.store(false, std::memory_order_relaxed);
+        buffer->m_depth       = 0;
+        s_threadSlot.m_buffer = buffer.get();
+
+        return s_threadSlot.m_buffer;
+    }
+
+    s_threadBuffers.push_back(std::make_unique<sProfilerThreadBuffer>());
+    s_threadBuffers.back()->m_threadIndex = static_cast<int>(s_threadBuffers.size()) - 1;
+    s_threadSlot.m_buffer                 = s_threadBuffers.back().get();
+
+    return s_threadSlot.m_buffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The calling thread's index in trace output; registers its ring on first use.
+int GetProfilerThreadIndex()
+{
+    return GetThreadBuffer()->m_threadIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Moves every finished event out of every ring into out_events. Main thread only.
+void DrainProfilerThreadBuffers(std::vector<sProfileEvent>& out_events,
+                                uint64_t&                   out_droppedCount)
+{
+    std::lock_guard const lock(s_threadBufferMutex);
+
+    for (std::unique_ptr<sProfilerThreadBuffer> const& buffer : s_threadBuffers)
+    {
+        uint64_t const writeCount = buffer->m_writeCount.load(std::memory_order_acquire);
+        uint64_t       readCount  = buffer->m_readCount.load(std::memory_order_relaxed);
+
+        for (; readCount < writeCount; ++readCount)
+        {
+            out_events.push_back(buffer->m_events[readCount & (PROFILER_RING_CAPACITY - 1)]);
+        }
+
+        buffer->m_readCount.store(readCount, std::memory_order_release);
+        out_droppedCount += buffer->m_droppedCount.exchange(0, std::memory_order_relaxed);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProfileScope::Begin(char const* name)
+{
+    sProfilerThreadBuffer* const buffer = GetThreadBuffer();
+
+    m_name       = name;
+    m_depth      = buffer->m_depth++;
+    m_startTicks = GetProfilerTicks();
+}
+
+//----------------------------------------------------------------------------------------------------
+void ProfileScope::End()
+{
+    int64_t const                endTicks   = GetProfilerTicks();
+    sProfilerThreadBuffer* const buffer     = s_threadSlot.m_buffer;
+    uint64_t const               writeCount = buffer->m_writeCount.load(std::memory_order_relaxed);
+
+    --buffer->m_depth;
+
+    if (writeCount - buffer->m_readCount.load(std::memory_order_acquire) >= PROFILER_RING_CAPACITY)
+    {
+        buffer->m_droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    sProfileEvent& event = buffer->m_events[writeCount & (PROFILER_RING_CAPACITY - 1)];
+    event.m_name         = m_name;
+    event.m_startTicks   = m_startTicks;
+    event.m_endTicks     = endTicks;
+    event.m_depth        = m_depth;
+    event.m_threadIndex  = buffer->m_threadIndex;
+
+    buffer->m_writeCount.store(writeCount + 1, std::memory_order_release);
+}
@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------------------------------------
+// ProfileScope.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr PROFILER_RING_CAPACITY = 4096;     // Events per thread between two frame ends; a power of two
+
+//----------------------------------------------------------------------------------------------------
+/// @brief One timed scope. m_name must outlive the profiler, so scopes only take string literals.
+struct sProfileEvent
+{
+    char const* m_name        = nullptr;
+    int64_t     m_startTicks  = 0;
+    int64_t     m_endTicks    = 0;
+    int         m_depth       = 0;
+    int         m_threadIndex = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Set at frame boundaries only, so a frame is either recorded whole or not at all.
+extern std::atomic<bool> g_isProfilerRecording;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Times the enclosing scope while the profiler is recording. Each thread writes finished scopes into
+/// its own ring buffer with no locks; ProfilerEndFrame drains every ring on the main thread. When
+/// recording is off, a scope costs one relaxed atomic load.
+class ProfileScope
+{
+public:
+    explicit ProfileScope(char const* name)
+    {
+        if (g_isProfilerRecording.load(std::memory_order_relaxed)) Begin(name);
+    }
+
+    ~ProfileScope()
+    {
+        if (m_name != nullptr) End();
+    }
+
+    ProfileScope(ProfileScope const&)            = delete;
+    ProfileScope& operator=(ProfileScope const&) = delete;
+
+private:
+    void Begin(char const* name);
+    void End();
+
+    char const* m_name       = nullptr;
+    int64_t     m_startTicks = 0;
+    int         m_depth      = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b)       PROFILE_CONCAT_INNER(a, b)
+#define PROFILE_SCOPE(name)        ProfileScope const PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+//----------------------------------------------------------------------------------------------------
+// Recording half of the profiler. It needs nothing from the Engine, so code that only marks scopes,
+// like WorkerThreadPool, also builds into the headless tools; Profiler drains and draws the events.
+int64_t GetProfilerTicks();
+double  GetProfilerTicksToSeconds();
+int     GetProfilerThreadIndex();
+void    DrainProfilerThreadBuffers(std::vector<sProfileEvent>& out_events, uint64_t& out_droppedCount);
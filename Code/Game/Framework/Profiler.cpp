@@ -0,0 +1,255 @@
+//----------------------------------------------------------------------------------------------------
+// Profiler.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <vector>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Renderer/DebugRenderSystem.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int                        s_mainThreadIndex        = 0;
+static bool                       s_isFrameRecorded        = false;
+static bool                       s_isOverlayVisible       = false;
+static int64_t                    s_frameStartTicks        = 0;
+static std::vector<sProfileEvent> s_frameEvents;                // Last recorded frame, for the overlay
+static int64_t                    s_lastFrameStartTicks    = 0;
+static int64_t                    s_lastFrameEndTicks      = 0;
+static uint64_t                   s_lastFrameDroppedCount  = 0;
+static int                        s_captureFramesRemaining = 0;
+static int                        s_captureFrameCount      = 0;
+static String                     s_captureFilePath;
+static std::vector<sProfileEvent> s_captureEvents;
+static uint64_t                   s_captureDroppedCount    = 0;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Writes the Chrome trace event format that chrome://tracing and ui.perfetto.dev load: one complete
+/// ("X") event per scope, timestamps in microseconds from the first captured frame, and a name per
+/// thread. Scope names are string literals from the code, so they are written unescaped.
+static bool WriteChromeTrace(String const&                     filePath,
+                             std::vector<sProfileEvent> const& events)
+{
+    std::ofstream file(filePath, std::ios::trunc);
+
+    if (!file) return false;
+
+    double const ticksToMicroseconds = GetProfilerTicksToSeconds() * 1000000.0;
+    int64_t      originTicks         = INT64_MAX;
+    int          threadCount         = 0;
+
+    for (sProfileEvent const& event : events)
+    {
+        originTicks = std::min(originTicks, event.m_startTicks);
+        threadCount = std::max(threadCount, event.m_threadIndex + 1);
+    }
+
+    file << "{\"traceEvents\":[\n";
+
+    for (int threadIndex = 0; threadIndex < threadCount; ++threadIndex)
+    {
+        String const threadName = threadIndex == s_mainThreadIndex ? String("Main") : Stringf("Worker %d", threadIndex);
+        file << Stringf("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":%d,\"args\":{\"name\":\"%s\"}},\n", threadIndex, threadName.c_str());
+    }
+
+    for (size_t eventIndex = 0; eventIndex < events.size(); ++eventIndex)
+    {
+        sProfileEvent const& event = events[eventIndex];
+        double const         start = static_cast<double>(event.m_startTicks - originTicks) * ticksToMicroseconds;
+        double const         dur   = static_cast<double>(event.m_endTicks - event.m_startTicks) * ticksToMicroseconds;
+
+        file << Stringf("{\"name\":\"%s\",\"cat\":\"cpu\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":%d}", event.m_name, start, dur, event.m_threadIndex);
+        file << (eventIndex + 1 < events.size() ? ",\n" : "\n");
+    }
+
+    file << "],\"displayTimeUnit\":\"ms\"}\n";
+
+    return static_cast<bool>(file);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Turns recording on for this frame if the overlay is up or a capture is running. Called by
+/// the App on the main thread before anything else in the frame.
+void ProfilerBeginFrame()
+{
+    s_isFrameRecorded = s_isOverlayVisible || s_captureFramesRemaining > 0;
+    g_isProfilerRecording.store(s_isFrameRecorded, std::memory_order_relaxed);
+
+    if (!s_isFrameRecorded) return;
+
+    s_mainThreadIndex = GetProfilerThreadIndex();
+    s_frameStartTicks = GetProfilerTicks();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Collects the frame's scopes from every thread for the overlay and, while capturing, appends
+/// them to the capture; writes the capture out after its last frame.
+void ProfilerEndFrame()
+{
+    if (!s_isFrameRecorded) return;
+
+    int64_t const frameEndTicks = GetProfilerTicks();
+    uint64_t      droppedCount  = 0;
+
+    s_frameEvents.clear();
+    DrainProfilerThreadBuffers(s_frameEvents, droppedCount);
+
+    s_lastFrameStartTicks   = s_frameStartTicks;
+    s_lastFrameEndTicks     = frameEndTicks;
+    s_lastFrameDroppedCount = droppedCount;
+
+    if (s_captureFramesRemaining <= 0) return;
+
+    // Frames sit one level above everything else on the main thread.
+    s_captureEvents.push_back(sProfileEvent{"Frame", s_frameStartTicks, frameEndTicks, -1, s_mainThreadIndex});
+    s_captureEvents.insert(s_captureEvents.end(), s_frameEvents.begin(), s_frameEvents.end());
+    s_captureDroppedCount += droppedCount;
+    --s_captureFramesRemaining;
+
+    if (s_captureFramesRemaining > 0) return;
+
+    if (WriteChromeTrace(s_captureFilePath, s_captureEvents))
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Profiler] Wrote %d frames, %d scopes (%llu dropped) to %s", s_captureFrameCount, static_cast<int>(s_captureEvents.size()) - s_captureFrameCount, static_cast<unsigned long long>(s_captureDroppedCount), s_captureFilePath.c_str()));
+    }
+    else
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Profiler] Could not write %s", s_captureFilePath.c_str()));
+    }
+
+    s_captureEvents.clear();
+    s_captureEvents.shrink_to_fit();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Records the next frameCount frames, starting with the next ProfilerBeginFrame. Restarts a
+/// capture already running.
+void StartProfilerCapture(int const     frameCount,
+                          String const& filePath)
+{
+    s_captureFramesRemaining = std::max(frameCount, 1);
+    s_captureFrameCount      = s_captureFramesRemaining;
+    s_captureFilePath        = filePath;
+    s_captureDroppedCount    = 0;
+    s_captureEvents.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsProfilerCapturing()
+{
+    return s_captureFramesRemaining > 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+void SetProfilerOverlayVisible(bool const isVisible)
+{
+    s_isOverlayVisible = isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool IsProfilerOverlayVisible()
+{
+    return s_isOverlayVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Draws the last recorded frame as a flame graph inside bounds: one band per thread, main thread on
+/// top, one row per nesting depth, and time running left to right across at least one frame budget,
+/// which is marked in red. Bars wide enough get their name and milliseconds. Call inside a screen
+/// camera.
+void RenderProfilerOverlay(AABB2 const& bounds)
+{
+    if (!s_isOverlayVisible || s_lastFrameEndTicks <= s_lastFrameStartTicks) return;
+
+    static Rgba8 const s_barColors[] = {Rgba8(230, 120, 60), Rgba8(70, 160, 220), Rgba8(110, 190, 90), Rgba8(200, 90, 170), Rgba8(220, 190, 70), Rgba8(90, 200, 190), Rgba8(160, 120, 230), Rgba8(230, 100, 110)};
+
+    double const ticksToSeconds = GetProfilerTicksToSeconds();
+    double const frameSeconds   = static_cast<double>(s_lastFrameEndTicks - s_lastFrameStartTicks) * ticksToSeconds;
+    double const spanSeconds    = std::max(frameSeconds, PROFILER_FRAME_BUDGET);
+    float const  width          = bounds.m_maxs.x - bounds.m_mins.x;
+
+    // Main thread first, then the others by index; each gets as many rows as its deepest scope.
+    std::vector<int> threadDepths;
+
+    for (sProfileEvent const& event : s_frameEvents)
+    {
+        if (event.m_threadIndex >= static_cast<int>(threadDepths.size())) threadDepths.resize(event.m_threadIndex + 1, 0);
+        threadDepths[event.m_threadIndex] = std::max(threadDepths[event.m_threadIndex], std::min(event.m_depth + 1, PROFILER_OVERLAY_MAX_DEPTH));
+    }
+
+    std::vector<int> threadFirstRows(threadDepths.size(), 0);
+    int              rowCount = 0;
+
+    if (s_mainThreadIndex < static_cast<int>(threadDepths.size()))
+    {
+        threadFirstRows[s_mainThreadIndex] = 0;
+        rowCount                           = threadDepths[s_mainThreadIndex];
+    }
+
+    for (int threadIndex = 0; threadIndex < static_cast<int>(threadDepths.size()); ++threadIndex)
+    {
+        if (threadIndex == s_mainThreadIndex) continue;
+
+        threadFirstRows[threadIndex] = rowCount;
+        rowCount                     += threadDepths[threadIndex];
+    }
+
+    VertexList_PCU verts;
+    AddVertsForAABB2D(verts, bounds, Rgba8(0, 0, 0, 160));
+
+    for (sProfileEvent const& event : s_frameEvents)
+    {
+        if (event.m_depth >= PROFILER_OVERLAY_MAX_DEPTH) continue;
+
+        float const row    = static_cast<float>(threadFirstRows[event.m_threadIndex] + event.m_depth);
+        float const top    = bounds.m_maxs.y - row * PROFILER_OVERLAY_ROW_HEIGHT;
+        float const bottom = top - PROFILER_OVERLAY_ROW_HEIGHT + 1.f;
+
+        if (bottom < bounds.m_mins.y) continue;
+
+        double const startSeconds = static_cast<double>(event.m_startTicks - s_lastFrameStartTicks) * ticksToSeconds;
+        double const endSeconds   = static_cast<double>(event.m_endTicks - s_lastFrameStartTicks) * ticksToSeconds;
+        float const  left         = bounds.m_mins.x + width * static_cast<float>(std::clamp(startSeconds / spanSeconds, 0.0, 1.0));
+        float const  right        = bounds.m_mins.x + width * static_cast<float>(std::clamp(endSeconds / spanSeconds, 0.0, 1.0));
+        size_t const colorIndex   = (reinterpret_cast<uintptr_t>(event.m_name) >> 3) % (sizeof(s_barColors) / sizeof(s_barColors[0]));
+
+        AddVertsForAABB2D(verts, AABB2(Vec2(left, bottom), Vec2(std::max(right, left + 1.f), top)), s_barColors[colorIndex]);
+
+        String const label = Stringf("%s %.2f", event.m_name, (endSeconds - startSeconds) * 1000.0);
+
+        if (right - left > static_cast<float>(label.size()) * 6.f + 4.f)
+        {
+            DebugAddScreenText(label, Vec2(left + 2.f, bottom + 2.f), 10.f, Vec2::ZERO, 0.f, Rgba8::BLACK, Rgba8::BLACK);
+        }
+    }
+
+    float const budgetX = bounds.m_mins.x + width * static_cast<float>(PROFILER_FRAME_BUDGET / spanSeconds);
+    AddVertsForAABB2D(verts, AABB2(Vec2(budgetX - 1.f, bounds.m_mins.y), Vec2(budgetX + 1.f, bounds.m_maxs.y)), Rgba8::RED);
+
+    int const threadCount = static_cast<int>(std::count_if(threadDepths.begin(), threadDepths.end(), [](int const depth) { return depth > 0; }));
+
+    DebugAddScreenText(Stringf("Frame %.2f ms | %d scopes | %d threads | %llu dropped", frameSeconds * 1000.0, static_cast<int>(s_frameEvents.size()), threadCount, static_cast<unsigned long long>(s_lastFrameDroppedCount)), Vec2(bounds.m_mins.x, bounds.m_maxs.y + 4.f), 12.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    g_theRenderer->SetModelConstants();
+    g_theRenderer->SetBlendMode(eBlendMode::ALPHA);
+    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
+    g_theRenderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
+    g_theRenderer->SetDepthMode(eDepthMode::DISABLED);
+    g_theRenderer->BindTexture(nullptr);
+    g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
+    g_theRenderer->DrawVertexArray(verts);
+    RecordRenderUpload(verts.size() * sizeof(Vertex_PCU));
+    RecordRenderDraw();
+}
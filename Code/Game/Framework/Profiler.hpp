@@ -0,0 +1,25 @@
+//----------------------------------------------------------------------------------------------------
+// Profiler.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/ProfileScope.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+struct AABB2;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr    PROFILER_OVERLAY_MAX_DEPTH  = 6;              // Deeper scopes are captured but not drawn
+float constexpr  PROFILER_OVERLAY_ROW_HEIGHT = 14.f;
+double constexpr PROFILER_FRAME_BUDGET       = 1.0 / 60.0;     // Marked on the overlay; also its shortest span
+
+//----------------------------------------------------------------------------------------------------
+void ProfilerBeginFrame();
+void ProfilerEndFrame();
+void StartProfilerCapture(int frameCount, String const& filePath);
+bool IsProfilerCapturing();
+void SetProfilerOverlayVisible(bool isVisible);
+bool IsProfilerOverlayVisible();
+void RenderProfilerOverlay(AABB2 const& bounds);
@@ -0,0 +1,314 @@
+//----------------------------------------------------------------------------------------------------
+// RenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RenderBackend.hpp"
+
+#include "Engine/Renderer/Renderer.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::SetModelConstants(Mat44 const& modelToWorld,
+                                               Rgba8 const& modelColor)
+{
+    g_theRenderer->SetModelConstants(modelToWorld, modelColor);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::SetBlendMode(eBlendMode const blendMode)
+{
+    g_theRenderer->SetBlendMode(blendMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::SetRasterizerMode(eRasterizerMode const rasterizerMode)
+{
+    g_theRenderer->SetRasterizerMode(rasterizerMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::SetSamplerMode(eSamplerMode const samplerMode)
+{
+    g_theRenderer->SetSamplerMode(samplerMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::SetDepthMode(eDepthMode const depthMode)
+{
+    g_theRenderer->SetDepthMode(depthMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::BindTexture(Texture const* texture,
+                                         int const      slot)
+{
+    g_theRenderer->BindTexture(texture, slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::BindShader(Shader const* shader)
+{
+    g_theRenderer->BindShader(shader);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::BindLightSet(int const lightSetId)
+{
+    g_theLightSubsystem->BindLightSet(lightSetId);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::DrawVertexArray(int const         vertexCount,
+                                             Vertex_PCU const* verts)
+{
+    g_theRenderer->DrawVertexArray(vertexCount, verts);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::DrawIndexedVertexBuffer(VertexBuffer*      vertexBuffer,
+                                                     IndexBuffer*       indexBuffer,
+                                                     unsigned int const indexCount)
+{
+    g_theRenderer->DrawIndexedVertexBuffer(vertexBuffer, indexBuffer, indexCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+VertexBuffer* ImmediateRenderBackend::CreateVertexBuffer(unsigned int const byteCount,
+                                                         unsigned int const byteStride)
+{
+    return g_theRenderer->CreateVertexBuffer(byteCount, byteStride);
+}
+
+//----------------------------------------------------------------------------------------------------
+IndexBuffer* ImmediateRenderBackend::CreateIndexBuffer(unsigned int const byteCount,
+                                                       unsigned int const byteStride)
+{
+    return g_theRenderer->CreateIndexBuffer(byteCount, byteStride);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          VertexBuffer*      vertexBuffer)
+{
+    g_theRenderer->CopyCPUToGPU(data, byteCount, vertexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          IndexBuffer*       indexBuffer)
+{
+    g_theRenderer->CopyCPUToGPU(data, byteCount, indexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          ConstantBuffer*    constantBuffer)
+{
+    g_theRenderer->CopyCPUToGPU(data, byteCount, constantBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ImmediateRenderBackend::BindConstantBuffer(int const             slot,
+                                                ConstantBuffer const* constantBuffer)
+{
+    g_theRenderer->BindConstantBuffer(slot, constantBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+RecordingRenderBackend::RecordingRenderBackend(RenderBackend* forwardTarget)
+    : m_forwardTarget(forwardTarget)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::SetModelConstants(Mat44 const& modelToWorld,
+                                               Rgba8 const& modelColor)
+{
+    Record(eRenderCall::SET_MODEL_CONSTANTS, nullptr, 0);
+    if (m_forwardTarget != nullptr) m_forwardTarget->SetModelConstants(modelToWorld, modelColor);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::SetBlendMode(eBlendMode const blendMode)
+{
+    Record(eRenderCall::SET_BLEND_MODE, nullptr, static_cast<int>(blendMode));
+    if (m_forwardTarget != nullptr) m_forwardTarget->SetBlendMode(blendMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::SetRasterizerMode(eRasterizerMode const rasterizerMode)
+{
+    Record(eRenderCall::SET_RASTERIZER_MODE, nullptr, static_cast<int>(rasterizerMode));
+    if (m_forwardTarget != nullptr) m_forwardTarget->SetRasterizerMode(rasterizerMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::SetSamplerMode(eSamplerMode const samplerMode)
+{
+    Record(eRenderCall::SET_SAMPLER_MODE, nullptr, static_cast<int>(samplerMode));
+    if (m_forwardTarget != nullptr) m_forwardTarget->SetSamplerMode(samplerMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::SetDepthMode(eDepthMode const depthMode)
+{
+    Record(eRenderCall::SET_DEPTH_MODE, nullptr, static_cast<int>(depthMode));
+    if (m_forwardTarget != nullptr) m_forwardTarget->SetDepthMode(depthMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::BindTexture(Texture const* texture,
+                                         int const      slot)
+{
+    Record(eRenderCall::BIND_TEXTURE, texture, slot);
+    if (m_forwardTarget != nullptr) m_forwardTarget->BindTexture(texture, slot);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::BindShader(Shader const* shader)
+{
+    Record(eRenderCall::BIND_SHADER, shader, 0);
+    if (m_forwardTarget != nullptr) m_forwardTarget->BindShader(shader);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::BindLightSet(int const lightSetId)
+{
+    Record(eRenderCall::BIND_LIGHT_SET, nullptr, lightSetId);
+    if (m_forwardTarget != nullptr) m_forwardTarget->BindLightSet(lightSetId);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::DrawVertexArray(int const         vertexCount,
+                                             Vertex_PCU const* verts)
+{
+    Record(eRenderCall::DRAW_VERTEX_ARRAY, nullptr, vertexCount);
+    if (m_forwardTarget != nullptr) m_forwardTarget->DrawVertexArray(vertexCount, verts);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::DrawIndexedVertexBuffer(VertexBuffer*      vertexBuffer,
+                                                     IndexBuffer*       indexBuffer,
+                                                     unsigned int const indexCount)
+{
+    Record(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER, vertexBuffer, static_cast<int>(indexCount));
+    if (m_forwardTarget != nullptr) m_forwardTarget->DrawIndexedVertexBuffer(vertexBuffer, indexBuffer, indexCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+VertexBuffer* RecordingRenderBackend::CreateVertexBuffer(unsigned int const byteCount,
+                                                         unsigned int const byteStride)
+{
+    VertexBuffer* vertexBuffer = m_forwardTarget != nullptr ? m_forwardTarget->CreateVertexBuffer(byteCount, byteStride) : nullptr;
+    Record(eRenderCall::CREATE_VERTEX_BUFFER, vertexBuffer, static_cast<int>(byteCount));
+    return vertexBuffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+IndexBuffer* RecordingRenderBackend::CreateIndexBuffer(unsigned int const byteCount,
+                                                       unsigned int const byteStride)
+{
+    IndexBuffer* indexBuffer = m_forwardTarget != nullptr ? m_forwardTarget->CreateIndexBuffer(byteCount, byteStride) : nullptr;
+    Record(eRenderCall::CREATE_INDEX_BUFFER, indexBuffer, static_cast<int>(byteCount));
+    return indexBuffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          VertexBuffer*      vertexBuffer)
+{
+    Record(eRenderCall::COPY_VERTEX_BUFFER, vertexBuffer, static_cast<int>(byteCount));
+    if (m_forwardTarget != nullptr) m_forwardTarget->CopyCPUToGPU(data, byteCount, vertexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          IndexBuffer*       indexBuffer)
+{
+    Record(eRenderCall::COPY_INDEX_BUFFER, indexBuffer, static_cast<int>(byteCount));
+    if (m_forwardTarget != nullptr) m_forwardTarget->CopyCPUToGPU(data, byteCount, indexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::CopyCPUToGPU(void const*        data,
+                                          unsigned int const byteCount,
+                                          ConstantBuffer*    constantBuffer)
+{
+    Record(eRenderCall::COPY_CONSTANT_BUFFER, constantBuffer, static_cast<int>(byteCount));
+    if (m_forwardTarget != nullptr) m_forwardTarget->CopyCPUToGPU(data, byteCount, constantBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::BindConstantBuffer(int const             slot,
+                                                ConstantBuffer const* constantBuffer)
+{
+    Record(eRenderCall::BIND_CONSTANT_BUFFER, constantBuffer, slot);
+    if (m_forwardTarget != nullptr) m_forwardTarget->BindConstantBuffer(slot, constantBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sRecordedRenderCall> const& RecordingRenderBackend::GetCalls() const
+{
+    return m_calls;
+}
+
+//----------------------------------------------------------------------------------------------------
+int RecordingRenderBackend::GetCallCount(eRenderCall const call) const
+{
+    int count = 0;
+
+    for (sRecordedRenderCall const& recordedCall : m_calls)
+    {
+        if (recordedCall.m_call == call) ++count;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+String RecordingRenderBackend::GetCallString(int const index) const
+{
+    sRecordedRenderCall const& call = m_calls[index];
+
+    switch (call.m_call)
+    {
+    case eRenderCall::SET_MODEL_CONSTANTS: return "SetModelConstants";
+    case eRenderCall::SET_BLEND_MODE: return Stringf("SetBlendMode %d", call.m_value);
+    case eRenderCall::SET_RASTERIZER_MODE: return Stringf("SetRasterizerMode %d", call.m_value);
+    case eRenderCall::SET_SAMPLER_MODE: return Stringf("SetSamplerMode %d", call.m_value);
+    case eRenderCall::SET_DEPTH_MODE: return Stringf("SetDepthMode %d", call.m_value);
+    case eRenderCall::BIND_TEXTURE: return Stringf("BindTexture slot %d <- %p", call.m_value, call.m_resource);
+    case eRenderCall::BIND_SHADER: return Stringf("BindShader %p", call.m_resource);
+    case eRenderCall::BIND_LIGHT_SET: return Stringf("BindLightSet %d", call.m_value);
+    case eRenderCall::DRAW_VERTEX_ARRAY: return Stringf("DrawVertexArray %d verts", call.m_value);
+    case eRenderCall::DRAW_INDEXED_VERTEX_BUFFER: return Stringf("DrawIndexedVertexBuffer %p, %d indexes", call.m_resource, call.m_value);
+    case eRenderCall::CREATE_VERTEX_BUFFER: return Stringf("CreateVertexBuffer %p, %d B", call.m_resource, call.m_value);
+    case eRenderCall::CREATE_INDEX_BUFFER: return Stringf("CreateIndexBuffer %p, %d B", call.m_resource, call.m_value);
+    case eRenderCall::COPY_VERTEX_BUFFER: return Stringf("CopyCPUToGPU vertexes %p, %d B", call.m_resource, call.m_value);
+    case eRenderCall::COPY_INDEX_BUFFER: return Stringf("CopyCPUToGPU indexes %p, %d B", call.m_resource, call.m_value);
+    case eRenderCall::COPY_CONSTANT_BUFFER: return Stringf("CopyCPUToGPU constants %p, %d B", call.m_resource, call.m_value);
+    case eRenderCall::BIND_CONSTANT_BUFFER: return Stringf("BindConstantBuffer slot %d <- %p", call.m_value, call.m_resource);
+    default: return "Unknown";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::Clear()
+{
+    m_calls.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingRenderBackend::Record(eRenderCall const call,
+                                    void const*       resource,
+                                    int const         value)
+{
+    m_calls.push_back({call, resource, value});
+}
@@ -0,0 +1,139 @@
+//----------------------------------------------------------------------------------------------------
+// RenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/RenderCommon.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class ConstantBuffer;
+class IndexBuffer;
+class Shader;
+class Texture;
+class VertexBuffer;
+struct Vertex_PCU;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The Renderer calls a RenderCommandList issues, plus the buffer creation and per-frame uploads that
+/// feed them. ImmediateRenderBackend forwards them to g_theRenderer, RecordingRenderBackend logs them so
+/// a frame's command stream can be inspected without a GPU.
+class RenderBackend
+{
+public:
+    virtual ~RenderBackend() = default;
+
+    virtual void SetModelConstants(Mat44 const& modelToWorld, Rgba8 const& modelColor) = 0;
+    virtual void SetBlendMode(eBlendMode blendMode) = 0;
+    virtual void SetRasterizerMode(eRasterizerMode rasterizerMode) = 0;
+    virtual void SetSamplerMode(eSamplerMode samplerMode) = 0;
+    virtual void SetDepthMode(eDepthMode depthMode) = 0;
+    virtual void BindTexture(Texture const* texture, int slot) = 0;
+    virtual void BindShader(Shader const* shader) = 0;
+    virtual void BindLightSet(int lightSetId) = 0;
+    virtual void DrawVertexArray(int vertexCount, Vertex_PCU const* verts) = 0;
+    virtual void DrawIndexedVertexBuffer(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned int indexCount) = 0;
+    virtual VertexBuffer* CreateVertexBuffer(unsigned int byteCount, unsigned int byteStride) = 0;
+    virtual IndexBuffer*  CreateIndexBuffer(unsigned int byteCount, unsigned int byteStride) = 0;
+    virtual void CopyCPUToGPU(void const* data, unsigned int byteCount, VertexBuffer* vertexBuffer) = 0;
+    virtual void CopyCPUToGPU(void const* data, unsigned int byteCount, IndexBuffer* indexBuffer) = 0;
+    virtual void CopyCPUToGPU(void const* data, unsigned int byteCount, ConstantBuffer* constantBuffer) = 0;
+    virtual void BindConstantBuffer(int slot, ConstantBuffer const* constantBuffer) = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+class ImmediateRenderBackend final : public RenderBackend
+{
+public:
+    void SetModelConstants(Mat44 const& modelToWorld, Rgba8 const& modelColor) override;
+    void SetBlendMode(eBlendMode blendMode) override;
+    void SetRasterizerMode(eRasterizerMode rasterizerMode) override;
+    void SetSamplerMode(eSamplerMode samplerMode) override;
+    void SetDepthMode(eDepthMode depthMode) override;
+    void BindTexture(Texture const* texture, int slot) override;
+    void BindShader(Shader const* shader) override;
+    void BindLightSet(int lightSetId) override;
+    void DrawVertexArray(int vertexCount, Vertex_PCU const* verts) override;
+    void DrawIndexedVertexBuffer(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned int indexCount) override;
+    VertexBuffer* CreateVertexBuffer(unsigned int byteCount, unsigned int byteStride) override;
+    IndexBuffer*  CreateIndexBuffer(unsigned int byteCount, unsigned int byteStride) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, VertexBuffer* vertexBuffer) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, IndexBuffer* indexBuffer) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, ConstantBuffer* constantBuffer) override;
+    void BindConstantBuffer(int slot, ConstantBuffer const* constantBuffer) override;
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eRenderCall : uint8_t
+{
+    SET_MODEL_CONSTANTS,
+    SET_BLEND_MODE,
+    SET_RASTERIZER_MODE,
+    SET_SAMPLER_MODE,
+    SET_DEPTH_MODE,
+    BIND_TEXTURE,
+    BIND_SHADER,
+    BIND_LIGHT_SET,
+    DRAW_VERTEX_ARRAY,
+    DRAW_INDEXED_VERTEX_BUFFER,
+    CREATE_VERTEX_BUFFER,
+    CREATE_INDEX_BUFFER,
+    COPY_VERTEX_BUFFER,
+    COPY_INDEX_BUFFER,
+    COPY_CONSTANT_BUFFER,
+    BIND_CONSTANT_BUFFER
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sRecordedRenderCall
+{
+    eRenderCall m_call     = eRenderCall::DRAW_VERTEX_ARRAY;
+    void const* m_resource = nullptr; // Texture, Shader or buffer, when the call takes one
+    int         m_value    = 0;       // Mode, slot, element count, or bytes created or copied
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Mock backend: records every call, and forwards it when given another backend so a captured frame
+/// still draws. With no forward target it needs no Renderer at all; the buffers it is asked to create
+/// come back null, so uploads to them are only logged and draws from them are dropped.
+class RecordingRenderBackend final : public RenderBackend
+{
+public:
+    explicit RecordingRenderBackend(RenderBackend* forwardTarget = nullptr);
+
+    void SetModelConstants(Mat44 const& modelToWorld, Rgba8 const& modelColor) override;
+    void SetBlendMode(eBlendMode blendMode) override;
+    void SetRasterizerMode(eRasterizerMode rasterizerMode) override;
+    void SetSamplerMode(eSamplerMode samplerMode) override;
+    void SetDepthMode(eDepthMode depthMode) override;
+    void BindTexture(Texture const* texture, int slot) override;
+    void BindShader(Shader const* shader) override;
+    void BindLightSet(int lightSetId) override;
+    void DrawVertexArray(int vertexCount, Vertex_PCU const* verts) override;
+    void DrawIndexedVertexBuffer(VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned int indexCount) override;
+    VertexBuffer* CreateVertexBuffer(unsigned int byteCount, unsigned int byteStride) override;
+    IndexBuffer*  CreateIndexBuffer(unsigned int byteCount, unsigned int byteStride) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, VertexBuffer* vertexBuffer) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, IndexBuffer* indexBuffer) override;
+    void CopyCPUToGPU(void const* data, unsigned int byteCount, ConstantBuffer* constantBuffer) override;
+    void BindConstantBuffer(int slot, ConstantBuffer const* constantBuffer) override;
+
+    std::vector<sRecordedRenderCall> const& GetCalls() const;
+    int                                     GetCallCount(eRenderCall call) const;
+    String                                  GetCallString(int index) const;
+    void                                    Clear();
+
+private:
+    void Record(eRenderCall call, void const* resource, int value);
+
+    RenderBackend*                   m_forwardTarget = nullptr;
+    std::vector<sRecordedRenderCall> m_calls;
+};
@@ -0,0 +1,240 @@
+//----------------------------------------------------------------------------------------------------
+// RenderCommandList.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RenderCommandList.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void RenderCommandList::SubmitIndexedVertexBuffer(eRenderLayer const  layer,
+                                                  sRenderState const& state,
+                                                  Mat44 const&        modelToWorld,
+                                                  Rgba8 const&        modelColor,
+                                                  VertexBuffer*       vertexBuffer,
+                                                  IndexBuffer*        indexBuffer,
+                                                  unsigned int const  indexCount)
+{
+    if (vertexBuffer == nullptr || indexBuffer == nullptr || indexCount == 0) return;
+
+    sRenderCommand command;
+    command.m_layer        = layer;
+    command.m_state        = state;
+    command.m_modelToWorld = modelToWorld;
+    command.m_modelColor   = modelColor;
+    command.m_vertexBuffer = vertexBuffer;
+    command.m_indexBuffer  = indexBuffer;
+    command.m_elementCount = indexCount;
+    m_commands.push_back(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Copies verts into the list's arena, so callers can submit a temporary vertex list.
+void RenderCommandList::SubmitVertexArray(eRenderLayer const    layer,
+                                          sRenderState const&   state,
+                                          Mat44 const&          modelToWorld,
+                                          Rgba8 const&          modelColor,
+                                          VertexList_PCU const& verts)
+{
+    if (verts.empty()) return;
+
+    sRenderCommand command;
+    command.m_layer        = layer;
+    command.m_state        = state;
+    command.m_modelToWorld = modelToWorld;
+    command.m_modelColor   = modelColor;
+    command.m_elementCount = static_cast<unsigned int>(verts.size());
+    command.m_firstVertex  = static_cast<unsigned int>(m_vertexArena.size());
+    m_commands.push_back(command);
+
+    m_vertexArena.insert(m_vertexArena.end(), verts.begin(), verts.end());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Replays the sorted list through backend and clears it. The cache starts empty every call,
+/// because code outside the list may have changed the Renderer's state in between.
+void RenderCommandList::Execute(RenderBackend& backend)
+{
+    PROFILE_SCOPE("RenderCommandList::Execute");
+
+    SortCommands();
+
+    sRenderState currentState;
+    Mat44        currentModelToWorld;
+    Rgba8        currentModelColor = Rgba8::WHITE;
+    bool         isShaderSet       = false;
+    bool         isBlendModeSet    = false;
+    bool         isRasterizerSet   = false;
+    bool         isSamplerSet      = false;
+    bool         isDepthModeSet    = false;
+    bool         isModelSet        = false;
+    bool         isLightSetSet     = false;
+
+    bool isTextureSet[RENDER_TEXTURE_SLOT_COUNT] = {};
+
+    for (int const commandIndex : m_order)
+    {
+        sRenderCommand const& command = m_commands[commandIndex];
+        sRenderState const&   state   = command.m_state;
+
+        if (!isShaderSet || currentState.m_shader != state.m_shader)
+        {
+            backend.BindShader(state.m_shader);
+            currentState.m_shader = state.m_shader;
+            isShaderSet           = true;
+            RecordRenderBind();
+        }
+        else RecordRenderSkippedBind();
+
+        for (int slot = 0; slot < state.m_textureSlotCount && slot < RENDER_TEXTURE_SLOT_COUNT; ++slot)
+        {
+            if (!isTextureSet[slot] || currentState.m_textures[slot] != state.m_textures[slot])
+            {
+                backend.BindTexture(state.m_textures[slot], slot);
+                currentState.m_textures[slot] = state.m_textures[slot];
+                isTextureSet[slot]            = true;
+                RecordRenderBind();
+            }
+            else RecordRenderSkippedBind();
+        }
+
+        if (!isBlendModeSet || currentState.m_blendMode != state.m_blendMode)
+        {
+            backend.SetBlendMode(state.m_blendMode);
+            currentState.m_blendMode = state.m_blendMode;
+            isBlendModeSet           = true;
+            RecordRenderStateChange();
+        }
+        else RecordRenderSkippedBind();
+
+        if (!isRasterizerSet || currentState.m_rasterizerMode != state.m_rasterizerMode)
+        {
+            backend.SetRasterizerMode(state.m_rasterizerMode);
+            currentState.m_rasterizerMode = state.m_rasterizerMode;
+            isRasterizerSet               = true;
+            RecordRenderStateChange();
+        }
+        else RecordRenderSkippedBind();
+
+        if (!isSamplerSet || currentState.m_samplerMode != state.m_samplerMode)
+        {
+            backend.SetSamplerMode(state.m_samplerMode);
+            currentState.m_samplerMode = state.m_samplerMode;
+            isSamplerSet               = true;
+            RecordRenderStateChange();
+        }
+        else RecordRenderSkippedBind();
+
+        if (!isDepthModeSet || currentState.m_depthMode != state.m_depthMode)
+        {
+            backend.SetDepthMode(state.m_depthMode);
+            currentState.m_depthMode = state.m_depthMode;
+            isDepthModeSet           = true;
+            RecordRenderStateChange();
+        }
+        else RecordRenderSkippedBind();
+
+        if (!isLightSetSet || currentState.m_lightSetId != state.m_lightSetId)
+        {
+            backend.BindLightSet(state.m_lightSetId);
+            currentState.m_lightSetId = state.m_lightSetId;
+            isLightSetSet             = true;
+            RecordRenderBind();
+        }
+        else RecordRenderSkippedBind();
+
+        bool const isSameModel = isModelSet &&
+            std::memcmp(currentModelToWorld.m_values, command.m_modelToWorld.m_values, sizeof(currentModelToWorld.m_values)) == 0 &&
+            currentModelColor.r == command.m_modelColor.r &&
+            currentModelColor.g == command.m_modelColor.g &&
+            currentModelColor.b == command.m_modelColor.b &&
+            currentModelColor.a == command.m_modelColor.a;
+
+        if (!isSameModel)
+        {
+            backend.SetModelConstants(command.m_modelToWorld, command.m_modelColor);
+            currentModelToWorld = command.m_modelToWorld;
+            currentModelColor   = command.m_modelColor;
+            isModelSet          = true;
+            RecordRenderStateChange();
+        }
+        else RecordRenderSkippedBind();
+
+        if (command.m_vertexBuffer != nullptr)
+        {
+            backend.DrawIndexedVertexBuffer(command.m_vertexBuffer, command.m_indexBuffer, command.m_elementCount);
+        }
+        else
+        {
+            backend.DrawVertexArray(static_cast<int>(command.m_elementCount), m_vertexArena.data() + command.m_firstVertex);
+            RecordRenderUpload(command.m_elementCount * sizeof(Vertex_PCU));
+        }
+
+        RecordRenderDraw();
+    }
+
+    Clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RenderCommandList::Clear()
+{
+    m_commands.clear();
+    m_order.clear();
+    m_vertexArena.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+int RenderCommandList::GetCommandCount() const
+{
+    return static_cast<int>(m_commands.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Layers draw in order. Inside the opaque layer commands group by shader, then textures, then
+/// light set, then fixed-function state; equal states keep their submission order.
+void RenderCommandList::SortCommands()
+{
+    m_order.resize(m_commands.size());
+
+    for (int index = 0; index < static_cast<int>(m_order.size()); ++index)
+    {
+        m_order[index] = index;
+    }
+
+    // Translucent and overlay commands get an all-zero state key, so only their layer orders them.
+    auto const getSortKey = [this](int const index)
+    {
+        sRenderCommand const& command  = m_commands[index];
+        sRenderState const&   state    = command.m_state;
+        bool const            isOpaque = command.m_layer == eRenderLayer::OPAQUE;
+
+        return std::make_tuple(static_cast<int>(command.m_layer),
+                               isOpaque ? reinterpret_cast<uintptr_t>(state.m_shader) : 0,
+                               isOpaque ? reinterpret_cast<uintptr_t>(state.m_textures[0]) : 0,
+                               isOpaque ? reinterpret_cast<uintptr_t>(state.m_textures[1]) : 0,
+                               isOpaque ? reinterpret_cast<uintptr_t>(state.m_textures[2]) : 0,
+                               isOpaque ? state.m_lightSetId : 0,
+                               isOpaque ? static_cast<int>(state.m_blendMode) : 0,
+                               isOpaque ? static_cast<int>(state.m_rasterizerMode) : 0,
+                               isOpaque ? static_cast<int>(state.m_samplerMode) : 0,
+                               isOpaque ? static_cast<int>(state.m_depthMode) : 0);
+    };
+
+    // Ties fall back to submission order. std::stable_sort would do the same, but it allocates a buffer
+    // on every call.
+    std::sort(m_order.begin(), m_order.end(), [&getSortKey](int const a, int const b)
+    {
+        auto const keyA = getSortKey(a);
+        auto const keyB = getSortKey(b);
+
+        return keyA != keyB ? keyA < keyB : a < b;
+    });
+}
@@ -0,0 +1,84 @@
+//----------------------------------------------------------------------------------------------------
+// RenderCommandList.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/RenderCommon.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IndexBuffer;
+class RenderBackend;
+class Shader;
+class Texture;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+int constexpr RENDER_TEXTURE_SLOT_COUNT = 3;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Opaque commands are sorted by state; the later layers keep submission order and draw after.
+enum class eRenderLayer : uint8_t
+{
+    OPAQUE,
+    TRANSLUCENT,
+    OVERLAY
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Full pipeline state of one draw. Only the first m_textureSlotCount slots are bound; shaders that
+/// sample fewer textures leave the other slots alone. m_lightSetId comes from
+/// LightSubsystem::GetLightSetForBounds; 0 is the frame's default light set.
+struct sRenderState
+{
+    Shader const*   m_shader                              = nullptr;
+    Texture const*  m_textures[RENDER_TEXTURE_SLOT_COUNT] = {};
+    int             m_textureSlotCount                    = 1;
+    eBlendMode      m_blendMode                           = eBlendMode::OPAQUE;
+    eRasterizerMode m_rasterizerMode                      = eRasterizerMode::SOLID_CULL_BACK;
+    eSamplerMode    m_samplerMode                         = eSamplerMode::POINT_CLAMP;
+    eDepthMode      m_depthMode                           = eDepthMode::READ_WRITE_LESS_EQUAL;
+    int             m_lightSetId                          = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Per-frame list of draws that game code submits instead of calling g_theRenderer directly.
+/// Execute sorts the opaque layer by shader, textures and fixed-function state, then replays the list
+/// through a RenderBackend with a state cache, so a bind or state change is only issued when it differs
+/// from what is already set. Draws, binds, state changes and skipped binds go to RenderStatistics.
+class RenderCommandList
+{
+public:
+    void SubmitIndexedVertexBuffer(eRenderLayer layer, sRenderState const& state, Mat44 const& modelToWorld, Rgba8 const& modelColor, VertexBuffer* vertexBuffer, IndexBuffer* indexBuffer, unsigned int indexCount);
+    void SubmitVertexArray(eRenderLayer layer, sRenderState const& state, Mat44 const& modelToWorld, Rgba8 const& modelColor, VertexList_PCU const& verts);
+    void Execute(RenderBackend& backend);
+    void Clear();
+    int  GetCommandCount() const;
+
+private:
+    struct sRenderCommand
+    {
+        eRenderLayer  m_layer        = eRenderLayer::OPAQUE;
+        sRenderState  m_state;
+        Mat44         m_modelToWorld;
+        Rgba8         m_modelColor   = Rgba8::WHITE;
+        VertexBuffer* m_vertexBuffer = nullptr; // Null for vertex-array commands
+        IndexBuffer*  m_indexBuffer  = nullptr;
+        unsigned int  m_elementCount = 0;       // Index count, or vertex count for vertex arrays
+        unsigned int  m_firstVertex  = 0;       // Offset into m_vertexArena for vertex arrays
+    };
+
+    void SortCommands();
+
+    std::vector<sRenderCommand> m_commands;
+    std::vector<int>            m_order;
+    VertexList_PCU              m_vertexArena;
+};
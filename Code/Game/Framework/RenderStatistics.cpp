@@ -0,0 +1,70 @@
+//----------------------------------------------------------------------------------------------------
+// RenderStatistics.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/RenderStatistics.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static sRenderStatistics s_currentFrameStatistics;
+static sRenderStatistics s_lastFrameStatistics;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Publishes the totals of the frame that just ended and starts counting a new one.
+void RenderStatisticsBeginFrame()
+{
+    s_lastFrameStatistics    = s_currentFrameStatistics;
+    s_currentFrameStatistics = sRenderStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderUpload(size_t const byteCount)
+{
+    s_currentFrameStatistics.m_bytesUploaded += byteCount;
+    ++s_currentFrameStatistics.m_uploadCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderDraw()
+{
+    ++s_currentFrameStatistics.m_drawCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderBind()
+{
+    ++s_currentFrameStatistics.m_bindCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderStateChange()
+{
+    ++s_currentFrameStatistics.m_stateChangeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderSkippedBind()
+{
+    ++s_currentFrameStatistics.m_skippedBindCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderCulling(int const visibleCount,
+                         int const culledCount)
+{
+    s_currentFrameStatistics.m_visibleCount += visibleCount;
+    s_currentFrameStatistics.m_culledCount += culledCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordRenderLightUpload(bool const isUploaded)
+{
+    if (isUploaded) ++s_currentFrameStatistics.m_lightUploadCount;
+    else ++s_currentFrameStatistics.m_lightSkipCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+sRenderStatistics const& GetLastFrameRenderStatistics()
+{
+    return s_lastFrameStatistics;
+}
@@ -0,0 +1,37 @@
+//----------------------------------------------------------------------------------------------------
+// RenderStatistics.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Per-frame totals of what game code hands to the Renderer. Every DrawVertexArray copies its vertexes
+/// into a dynamic buffer, so it counts as an upload; draws from persistent buffers upload nothing.
+struct sRenderStatistics
+{
+    uint64_t m_bytesUploaded    = 0;
+    int      m_uploadCount      = 0;
+    int      m_drawCount        = 0;
+    int      m_bindCount        = 0; // Shader and texture binds issued
+    int      m_stateChangeCount = 0; // Blend, rasterizer, sampler, depth and model constant changes issued
+    int      m_skippedBindCount = 0; // Binds and state changes dropped because the state was already set
+    int      m_visibleCount     = 0; // Bounds that passed frustum culling
+    int      m_culledCount      = 0;
+    int      m_lightUploadCount = 0; // Light constant buffer uploads issued
+    int      m_lightSkipCount   = 0; // Light binds dropped because the buffer already held those lights
+};
+
+//----------------------------------------------------------------------------------------------------
+void                     RenderStatisticsBeginFrame();
+void                     RecordRenderUpload(size_t byteCount);
+void                     RecordRenderDraw();
+void                     RecordRenderBind();
+void                     RecordRenderStateChange();
+void                     RecordRenderSkippedBind();
+void                     RecordRenderCulling(int visibleCount, int culledCount);
+void                     RecordRenderLightUpload(bool isUploaded);
+sRenderStatistics const& GetLastFrameRenderStatistics();
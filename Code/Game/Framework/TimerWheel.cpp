@@ -0,0 +1,238 @@
+//----------------------------------------------------------------------------------------------------
+// TimerWheel.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TimerWheel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+//----------------------------------------------------------------------------------------------------
+TimerWheel::TimerWheel()
+{
+    std::fill(&m_slotHeads[0][0], &m_slotHeads[0][0] + TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_COUNT, -1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Runs callback once delaySeconds of the driving clock have passed, rounded up to whole ticks
+/// and at least one tick away, so a callback never runs inside the Advance that scheduled it.
+sTimerHandle TimerWheel::Schedule(float const           delaySeconds,
+                                  std::function<void()> callback)
+{
+    int timerIndex;
+
+    if (m_freeIndexes.empty())
+    {
+        timerIndex = static_cast<int>(m_timers.size());
+        m_timers.emplace_back();
+    }
+    else
+    {
+        timerIndex = m_freeIndexes.back();
+        m_freeIndexes.pop_back();
+    }
+
+    double const   delayTicks = std::ceil(static_cast<double>(std::max(delaySeconds, 0.f)) * TIMER_WHEEL_TICKS_PER_SECOND);
+    uint64_t const tickCount  = std::clamp(static_cast<uint64_t>(delayTicks), static_cast<uint64_t>(1), TIMER_WHEEL_MAX_DELAY_TICKS);
+    sTimer&        timer      = m_timers[timerIndex];
+
+    timer.m_callback = std::move(callback);
+    timer.m_dueTick  = m_currentTick + tickCount;
+    ++m_scheduledCount;
+
+    Insert(timerIndex);
+
+    return sTimerHandle{timerIndex, timer.m_generation};
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns false if the timer has already fired or been cancelled.
+bool TimerWheel::Cancel(sTimerHandle const& handle)
+{
+    if (!IsScheduled(handle)) return false;
+
+    if (m_timers[handle.m_index].m_level >= 0) Unlink(handle.m_index);
+
+    FreeTimer(handle.m_index);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TimerWheel::Advance(float const deltaSeconds)
+{
+    if (deltaSeconds <= 0.f) return;
+
+    m_pendingSeconds += deltaSeconds;
+
+    uint64_t const tickCount = static_cast<uint64_t>(m_pendingSeconds * TIMER_WHEEL_TICKS_PER_SECOND);
+    m_pendingSeconds -= static_cast<double>(tickCount) / TIMER_WHEEL_TICKS_PER_SECOND;
+
+    for (uint64_t tickIndex = 0; tickIndex < tickCount; ++tickIndex)
+    {
+        // Nothing left to fire or cascade; skip the rest of the ticks in one step.
+        if (m_scheduledCount == 0)
+        {
+            m_currentTick += tickCount - tickIndex;
+            return;
+        }
+
+        ++m_currentTick;
+
+        int const slot = static_cast<int>(m_currentTick & (TIMER_WHEEL_SLOT_COUNT - 1));
+
+        // When level 0 wraps, the next slot of level 1 comes down; when that wraps too, level 2's, and so on.
+        for (int level = 1; level < TIMER_WHEEL_LEVEL_COUNT; ++level)
+        {
+            if (((m_currentTick >> ((level - 1) * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOT_COUNT - 1)) != 0) break;
+
+            Cascade(level, static_cast<int>((m_currentTick >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOT_COUNT - 1)));
+        }
+
+        if ((m_occupiedSlots[0] & (1ull << slot)) != 0) FireSlot(slot);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Drops every timer without running it; outstanding handles become stale.
+void TimerWheel::Clear()
+{
+    for (int timerIndex = 0; timerIndex < static_cast<int>(m_timers.size()); ++timerIndex)
+    {
+        if (m_timers[timerIndex].m_level != TIMER_FREE) FreeTimer(timerIndex);
+    }
+
+    std::fill(&m_slotHeads[0][0], &m_slotHeads[0][0] + TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_COUNT, -1);
+    std::fill(std::begin(m_occupiedSlots), std::end(m_occupiedSlots), 0ull);
+    m_firingIndexes.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TimerWheel::IsScheduled(sTimerHandle const& handle) const
+{
+    if (handle.m_index < 0 || handle.m_index >= static_cast<int>(m_timers.size())) return false;
+
+    sTimer const& timer = m_timers[handle.m_index];
+
+    return timer.m_generation == handle.m_generation && timer.m_level != TIMER_FREE;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TimerWheel::GetScheduledCount() const
+{
+    return m_scheduledCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t TimerWheel::GetCurrentTick() const
+{
+    return m_currentTick;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Pushes the timer onto the head of the slot its due tick maps to, on the lowest level whose
+/// span reaches it.
+void TimerWheel::Insert(int const timerIndex)
+{
+    sTimer&        timer      = m_timers[timerIndex];
+    uint64_t const delayTicks = timer.m_dueTick - m_currentTick;
+    int            level      = 0;
+
+    while (level < TIMER_WHEEL_LEVEL_COUNT - 1 && delayTicks >= (1ull << ((level + 1) * TIMER_WHEEL_SLOT_BITS)))
+    {
+        ++level;
+    }
+
+    int const slot = static_cast<int>((timer.m_dueTick >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOT_COUNT - 1));
+    int&      head = m_slotHeads[level][slot];
+
+    timer.m_level = level;
+    timer.m_slot  = slot;
+    timer.m_prev  = -1;
+    timer.m_next  = head;
+
+    if (head >= 0) m_timers[head].m_prev = timerIndex;
+
+    head                   = timerIndex;
+    m_occupiedSlots[level] |= 1ull << slot;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TimerWheel::Unlink(int const timerIndex)
+{
+    sTimer& timer = m_timers[timerIndex];
+
+    if (timer.m_prev >= 0) m_timers[timer.m_prev].m_next = timer.m_next;
+    else m_slotHeads[timer.m_level][timer.m_slot] = timer.m_next;
+
+    if (timer.m_next >= 0) m_timers[timer.m_next].m_prev = timer.m_prev;
+
+    if (m_slotHeads[timer.m_level][timer.m_slot] < 0) m_occupiedSlots[timer.m_level] &= ~(1ull << timer.m_slot);
+
+    timer.m_prev = -1;
+    timer.m_next = -1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TimerWheel::FreeTimer(int const timerIndex)
+{
+    sTimer& timer = m_timers[timerIndex];
+
+    timer.m_callback = nullptr;
+    timer.m_level    = TIMER_FREE;
+    timer.m_slot     = -1;
+    ++timer.m_generation;
+    --m_scheduledCount;
+
+    m_freeIndexes.push_back(timerIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Re-inserts every timer of one slot; each lands on a lower level, since its due tick is now
+/// within that slot's span of the current tick.
+void TimerWheel::Cascade(int const level,
+                         int const slot)
+{
+    int timerIndex = m_slotHeads[level][slot];
+
+    m_slotHeads[level][slot] = -1;
+    m_occupiedSlots[level]   &= ~(1ull << slot);
+
+    while (timerIndex >= 0)
+    {
+        int const nextIndex = m_timers[timerIndex].m_next;
+        Insert(timerIndex);
+        timerIndex = nextIndex;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Takes the whole level-0 slot off the wheel first, so callbacks can freely schedule and cancel.
+/// A timer cancelled by an earlier callback in the same slot is no longer TIMER_FIRING and is skipped.
+void TimerWheel::FireSlot(int const slot)
+{
+    m_firingIndexes.clear();
+
+    for (int timerIndex = m_slotHeads[0][slot]; timerIndex >= 0; timerIndex = m_timers[timerIndex].m_next)
+    {
+        m_firingIndexes.push_back(timerIndex);
+    }
+
+    m_slotHeads[0][slot] = -1;
+    m_occupiedSlots[0]   &= ~(1ull << slot);
+
+    for (int const timerIndex : m_firingIndexes)
+    {
+        m_timers[timerIndex].m_level = TIMER_FIRING;
+    }
+
+    for (int const timerIndex : m_firingIndexes)
+    {
+        if (m_timers[timerIndex].m_level != TIMER_FIRING) continue;
+
+        std::function<void()> const callback = std::move(m_timers[timerIndex].m_callback);
+        FreeTimer(timerIndex);
+        callback();
+    }
+}
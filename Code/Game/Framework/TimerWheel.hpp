@@ -0,0 +1,82 @@
+//----------------------------------------------------------------------------------------------------
+// TimerWheel.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr      TIMER_WHEEL_LEVEL_COUNT      = 4;
+int constexpr      TIMER_WHEEL_SLOT_BITS        = 6;
+int constexpr      TIMER_WHEEL_SLOT_COUNT       = 1 << TIMER_WHEEL_SLOT_BITS;
+uint64_t constexpr TIMER_WHEEL_MAX_DELAY_TICKS  = (1ull << (TIMER_WHEEL_LEVEL_COUNT * TIMER_WHEEL_SLOT_BITS)) - 1;
+double constexpr   TIMER_WHEEL_TICKS_PER_SECOND = 120.0;     // About 39 hours of reach at 24 bits of ticks
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Names one scheduled action; stale once it fires or is cancelled, even if its slot is reused.
+struct sTimerHandle
+{
+    int      m_index      = -1;
+    uint32_t m_generation = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Hierarchical timer wheel for deferred gameplay actions. Time is counted in ticks of
+/// 1 / TIMER_WHEEL_TICKS_PER_SECOND; each level has TIMER_WHEEL_SLOT_COUNT slots, and level L holds
+/// timers due within 64^(L+1) ticks. A timer sits in a level-0 slot until it fires; whenever level 0
+/// wraps, the matching slot of the next level is cascaded down, and so on up. Scheduling, cancelling
+/// and firing are O(1) per timer, and a tick with nothing due only tests one occupancy bit; with
+/// nothing scheduled, Advance just moves the tick counter.
+///
+/// The wheel knows nothing of clocks or rendering. Its owner passes in the delta seconds of whatever
+/// clock should drive it; a paused or scaled clock pauses or scales the timers with it.
+/// Callbacks run inside Advance, earliest tick first, and may schedule or cancel timers but must not
+/// call Advance or Clear. Callbacks due on the same tick run in no particular order.
+class TimerWheel
+{
+public:
+    TimerWheel();
+
+    sTimerHandle Schedule(float delaySeconds, std::function<void()> callback);
+    bool         Cancel(sTimerHandle const& handle);
+    void         Advance(float deltaSeconds);
+    void         Clear();
+
+    bool     IsScheduled(sTimerHandle const& handle) const;
+    int      GetScheduledCount() const;
+    uint64_t GetCurrentTick() const;
+
+private:
+    static int constexpr TIMER_FREE   = -1;
+    static int constexpr TIMER_FIRING = -2;     // Due this tick and taken off its slot
+
+    struct sTimer
+    {
+        std::function<void()> m_callback;
+        uint64_t              m_dueTick    = 0;
+        int                   m_next       = -1;
+        int                   m_prev       = -1;
+        int                   m_level      = TIMER_FREE;
+        int                   m_slot       = -1;
+        uint32_t              m_generation = 0;
+    };
+
+    void Insert(int timerIndex);
+    void Unlink(int timerIndex);
+    void FreeTimer(int timerIndex);
+    void Cascade(int level, int slot);
+    void FireSlot(int slot);
+
+    std::vector<sTimer> m_timers;
+    std::vector<int>    m_freeIndexes;
+    std::vector<int>    m_firingIndexes;
+    int                 m_slotHeads[TIMER_WHEEL_LEVEL_COUNT][TIMER_WHEEL_SLOT_COUNT];
+    uint64_t            m_occupiedSlots[TIMER_WHEEL_LEVEL_COUNT] = {};     // Bit per non-empty slot
+    uint64_t            m_currentTick                            = 0;
+    double              m_pendingSeconds                         = 0.0;    // Less than one tick
+    int                 m_scheduledCount                         = 0;
+};
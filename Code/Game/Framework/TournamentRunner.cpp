@@ -0,0 +1,333 @@
+//----------------------------------------------------------------------------------------------------
+// TournamentRunner.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TournamentRunner.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <fstream>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr TOURNAMENT_GAMES_PER_THREAD = 2;     // Games per thread in a batch; the SPRT is checked between batches
+int constexpr PGN_LINE_LENGTH             = 80;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Steady time in seconds; the runner times its clocks itself so it needs no Engine.
+static double GetTournamentSeconds()
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief printf onto the end of out_string; PGN tags and move numbers are all short.
+static void AppendFormat(std::string& out_string,
+                         char const*  format,
+                         ...)
+{
+    char buffer[256];
+
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    out_string += buffer;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Expected score of the stronger side for an Elo difference, by the logistic model.
+static double GetExpectedScore(double const elo)
+{
+    return 1.0 / (1.0 + std::pow(10.0, -elo / 400.0));
+}
+
+//----------------------------------------------------------------------------------------------------
+static double GetEloFromScore(double const score)
+{
+    double const clampedScore = std::clamp(score, 1e-6, 1.0 - 1e-6);
+
+    return -400.0 * std::log10(1.0 / clampedScore - 1.0);
+}
+
+//----------------------------------------------------------------------------------------------------
+static char const* GetPgnResultString(int const winnerId)
+{
+    if (winnerId == 0) return "1-0";
+    if (winnerId == 1) return "0-1";
+
+    return "1/2-1/2";
+}
+
+//----------------------------------------------------------------------------------------------------
+TournamentRunner::TournamentRunner(sTournamentConfig const& config)
+    : m_config(config)
+{
+    // Without an opening there is nothing to play; otherwise the suite is cycled until m_maxGameCount.
+    if (m_config.m_openings.empty()) m_config.m_maxGameCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Plays batches of games until the SPRT accepts either hypothesis, m_maxGameCount games are done or
+/// RequestStop is called, appending each batch to the PGN file as it finishes. Blocks the calling
+/// thread, which plays games too. Plays nothing without an opening suite.
+sTournamentResult TournamentRunner::Run()
+{
+    WorkerThreadPool  workerThreadPool(m_config.m_threadCount);
+    sTournamentResult result;
+
+    result.m_threadCount = workerThreadPool.GetThreadCount();
+
+    int const batchSize = result.m_threadCount * TOURNAMENT_GAMES_PER_THREAD;
+
+    m_batchGames.resize(batchSize);
+    m_slotMatches.resize(batchSize);
+
+    std::ofstream pgnFile;
+
+    if (!m_config.m_pgnPath.empty()) pgnFile.open(m_config.m_pgnPath, std::ios::trunc);
+
+    double const startTime = GetTournamentSeconds();
+
+    while (result.m_gameCount < m_config.m_maxGameCount && result.m_decision == eSprtDecision::CONTINUE && !m_isStopRequested.load(std::memory_order_relaxed))
+    {
+        int const firstGameIndex = result.m_gameCount;
+        int const gameCount      = std::min(batchSize, m_config.m_maxGameCount - firstGameIndex);
+
+        workerThreadPool.ParallelFor(gameCount, [this, firstGameIndex](int const slotIndex) { PlayGame(firstGameIndex + slotIndex, slotIndex); });
+
+        for (int slotIndex = 0; slotIndex < gameCount; ++slotIndex)
+        {
+            sTournamentGame const& game        = m_batchGames[slotIndex];
+            int const              candidateId = game.m_isCandidateWhite ? 0 : 1;
+
+            if (game.m_winnerId < 0) ++result.m_drawCount;
+            else if (game.m_winnerId == candidateId) ++result.m_winCount;
+            else ++result.m_lossCount;
+
+            ++result.m_terminationCounts[static_cast<int>(game.m_termination)];
+            result.m_totalPly += static_cast<int>(game.m_moveList.size());
+
+            if (pgnFile) pgnFile << GetPgnGameString(game, firstGameIndex + slotIndex + 1);
+        }
+
+        result.m_gameCount += gameCount;
+        UpdateStatistics(result);
+    }
+
+    result.m_elapsedSeconds = GetTournamentSeconds() - startTime;
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Safe from any thread; Run returns after the batch being played.
+void TournamentRunner::RequestStop()
+{
+    m_isStopRequested.store(true, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Reads one position per line, as FEN or EPD; EPD operations after the fourth field are ignored.
+/// Blank lines and lines starting with '#' are skipped, and so are lines that do not parse.
+/// @return false if the file could not be opened.
+bool TournamentRunner::LoadOpeningSuite(std::string const&           filePath,
+                                        std::vector<sChessPosition>& out_openings)
+{
+    std::ifstream file(filePath);
+
+    if (!file) return false;
+
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+        if (line.empty() || line[0] == '#') continue;
+
+        sChessPosition position;
+
+        if (ParseFenString(line, position)) out_openings.push_back(position);
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The PGN Termination tag value for each way a game can end.
+char const* TournamentRunner::GetTerminationString(eTournamentTermination const termination)
+{
+    switch (termination)
+    {
+    case eTournamentTermination::RULES: return "normal";
+    case eTournamentTermination::TIME_FORFEIT: return "time forfeit";
+    case eTournamentTermination::MAX_PLY: return "adjudication";
+    case eTournamentTermination::NO_MOVE: return "rules infraction";
+    default: return "unterminated";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Game pairs share an opening and swap colors, so neither engine gains from a lopsided opening. The
+/// suite is cycled once every opening has had its pair; each game's own seed keeps a repeat distinct.
+/// Each move is charged to its side's clock; running out loses, as does failing to produce a legal
+/// move. Reaching m_maxPly is adjudicated a draw.
+void TournamentRunner::PlayGame(int const gameIndex,
+                                int const slotIndex)
+{
+    sTournamentGame& game  = m_batchGames[slotIndex];
+    HeadlessMatch&   match = m_slotMatches[slotIndex];
+
+    game.m_openingIndex     = (gameIndex / 2) % static_cast<int>(m_config.m_openings.size());
+    game.m_isCandidateWhite = gameIndex % 2 == 0;
+    game.m_termination      = eTournamentTermination::RULES;
+    game.m_winnerId         = -1;
+
+    match.Reset(GetOpening(game.m_openingIndex));
+
+    double       clockSeconds[2] = {m_config.m_baseSeconds, m_config.m_baseSeconds};
+    std::mt19937 random(m_config.m_seed + static_cast<unsigned>(gameIndex));
+
+    while (!match.IsFinished())
+    {
+        if (static_cast<int>(match.GetMoveList().size()) >= m_config.m_maxPly)
+        {
+            game.m_termination = eTournamentTermination::MAX_PLY;
+            break;
+        }
+
+        int const                  sideToMove = match.GetPosition().m_sideToMove;
+        sAIControllerConfig const& engine     = (sideToMove == 0) == game.m_isCandidateWhite ? m_config.m_candidate : m_config.m_baseline;
+        sChessMove                 move;
+
+        double const moveStartTime = GetTournamentSeconds();
+        bool const   hasMove       = m_config.m_chooseMove(engine, match.GetPosition(), move, &random);
+
+        clockSeconds[sideToMove] -= GetTournamentSeconds() - moveStartTime;
+
+        if (clockSeconds[sideToMove] < 0.0)
+        {
+            game.m_termination = eTournamentTermination::TIME_FORFEIT;
+            game.m_winnerId    = 1 - sideToMove;
+            break;
+        }
+
+        clockSeconds[sideToMove] += m_config.m_incrementSeconds;
+
+        if (!hasMove || !match.SubmitMove(move))
+        {
+            game.m_termination = eTournamentTermination::NO_MOVE;
+            game.m_winnerId    = 1 - sideToMove;
+            break;
+        }
+    }
+
+    game.m_matchResult = match.GetResult();
+    game.m_moveList    = match.GetMoveList();
+
+    if (game.m_termination == eTournamentTermination::RULES) game.m_winnerId = match.GetWinnerId();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Elo with a 95% interval from the candidate's mean score, and the log-likelihood ratio of elo1
+/// against elo0 by the normal approximation to the trinomial win/draw/loss model. The SPRT accepts
+/// a hypothesis once the ratio leaves [log(beta / (1 - alpha)), log((1 - beta) / alpha)].
+void TournamentRunner::UpdateStatistics(sTournamentResult& result) const
+{
+    result.m_lowerBound = std::log(m_config.m_beta / (1.0 - m_config.m_alpha));
+    result.m_upperBound = std::log((1.0 - m_config.m_beta) / m_config.m_alpha);
+
+    if (result.m_gameCount == 0) return;
+
+    double const gameCount = static_cast<double>(result.m_gameCount);
+    double const meanScore = (result.m_winCount + 0.5 * result.m_drawCount) / gameCount;
+    double const variance  = (result.m_winCount * (1.0 - meanScore) * (1.0 - meanScore) +
+                              result.m_drawCount * (0.5 - meanScore) * (0.5 - meanScore) +
+                              result.m_lossCount * meanScore * meanScore) / gameCount;
+
+    double const scoreError = 1.96 * std::sqrt(variance / gameCount);
+
+    result.m_elo      = GetEloFromScore(meanScore);
+    result.m_eloError = (GetEloFromScore(meanScore + scoreError) - GetEloFromScore(meanScore - scoreError)) * 0.5;
+
+    // Every game drawn, or every game won by the same side, leaves no variance to test against.
+    if (variance <= 0.0) return;
+
+    double const score0 = GetExpectedScore(m_config.m_elo0);
+    double const score1 = GetExpectedScore(m_config.m_elo1);
+
+    result.m_llr = gameCount * (score1 - score0) * (2.0 * meanScore - score0 - score1) / (2.0 * variance);
+
+    if (result.m_llr >= result.m_upperBound) result.m_decision = eSprtDecision::ACCEPT_H1;
+    else if (result.m_llr <= result.m_lowerBound) result.m_decision = eSprtDecision::ACCEPT_H0;
+}
+
+//----------------------------------------------------------------------------------------------------
+sChessPosition const& TournamentRunner::GetOpening(int const openingIndex) const
+{
+    return m_config.m_openings[openingIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief One PGN game: the seven-tag roster, the opening's FEN, then the moves in SAN wrapped at
+/// PGN_LINE_LENGTH columns.
+std::string TournamentRunner::GetPgnGameString(sTournamentGame const& game,
+                                               int const              round) const
+{
+    std::string const&    candidateName = m_config.m_candidate.m_name;
+    std::string const&    baselineName  = m_config.m_baseline.m_name;
+    char const*           resultString  = GetPgnResultString(game.m_winnerId);
+    sChessPosition const& opening       = GetOpening(game.m_openingIndex);
+
+    std::string pgn;
+    pgn += "[Event \"DaemonChess tournament\"]\n[Site \"?\"]\n[Date \"????.??.??\"]\n";
+    AppendFormat(pgn, "[Round \"%d\"]\n", round);
+    AppendFormat(pgn, "[White \"%s\"]\n", (game.m_isCandidateWhite ? candidateName : baselineName).c_str());
+    AppendFormat(pgn, "[Black \"%s\"]\n", (game.m_isCandidateWhite ? baselineName : candidateName).c_str());
+    AppendFormat(pgn, "[Result \"%s\"]\n", resultString);
+    AppendFormat(pgn, "[SetUp \"1\"]\n[FEN \"%s\"]\n", GetFenString(opening).c_str());
+    AppendFormat(pgn, "[Termination \"%s\"]\n", GetTerminationString(game.m_termination));
+    AppendFormat(pgn, "[PlyCount \"%d\"]\n\n", static_cast<int>(game.m_moveList.size()));
+
+    sChessPosition position    = opening;
+    std::string    line;
+    bool           isFirstMove = true;
+
+    auto const appendToken = [&pgn, &line](std::string const& token)
+    {
+        if (!line.empty() && static_cast<int>(line.size() + 1 + token.size()) > PGN_LINE_LENGTH)
+        {
+            pgn += line + "\n";
+            line.clear();
+        }
+
+        if (!line.empty()) line += ' ';
+        line += token;
+    };
+
+    for (sChessMove const& move : game.m_moveList)
+    {
+        if (position.m_sideToMove == 0) appendToken(std::to_string(position.m_fullMoveNumber) + ".");
+        else if (isFirstMove) appendToken(std::to_string(position.m_fullMoveNumber) + "...");
+
+        appendToken(GetSanMoveString(position, move));
+        position.ApplyMove(move);
+        isFirstMove = false;
+    }
+
+    appendToken(resultString);
+    pgn += line + "\n\n";
+
+    return pgn;
+}
@@ -0,0 +1,124 @@
+//----------------------------------------------------------------------------------------------------
+// TournamentRunner.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/HeadlessMatch.hpp"
+#include "Game/Framework/MatchCommon.hpp"
+#include "Game/Framework/MoveSearch.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class eTournamentTermination : uint8_t
+{
+    RULES,          // Checkmate or a drawing rule, as HeadlessMatch decides them
+    TIME_FORFEIT,   // The side to move ran out of clock
+    MAX_PLY,        // Adjudicated a draw at m_maxPly
+    NO_MOVE         // The engine returned no move; scored as a loss for it
+};
+
+int constexpr TOURNAMENT_TERMINATION_COUNT = static_cast<int>(eTournamentTermination::NO_MOVE) + 1;
+
+//----------------------------------------------------------------------------------------------------
+enum class eSprtDecision : uint8_t
+{
+    CONTINUE,
+    ACCEPT_H0,      // The candidate is no better than elo0
+    ACCEPT_H1       // The candidate is at least elo1 better
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Picks a move for one side, varying its choice with random. The default searches only; the
+/// game passes AIController::ChooseMove so its tournaments also consult the book and tablebases.
+typedef bool (*TournamentMoveChooser)(sAIControllerConfig const& config, sChessPosition const& position, sChessMove& out_move, std::mt19937* random);
+
+//----------------------------------------------------------------------------------------------------
+struct sTournamentConfig
+{
+    sAIControllerConfig         m_candidate;
+    sAIControllerConfig         m_baseline;
+    TournamentMoveChooser       m_chooseMove       = &SearchBestMove;
+    std::vector<sChessPosition> m_openings;                        // Required; played in pairs, once per color, and cycled
+    int                         m_maxGameCount     = 1000;
+    int                         m_threadCount      = 0;            // Concurrent games; 0 uses every hardware thread
+    int                         m_maxPly           = 400;
+    double                      m_baseSeconds      = 10.0;         // Clock per side at the start of a game
+    double                      m_incrementSeconds = 0.1;          // Added after each move
+    double                      m_elo0             = 0.0;
+    double                      m_elo1             = 5.0;
+    double                      m_alpha            = 0.05;
+    double                      m_beta             = 0.05;
+    unsigned                    m_seed             = 0;            // Game n draws its moves' random choices from m_seed + n
+    std::string                 m_pgnPath          = "Tournament.pgn";     // Empty writes no PGN
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sTournamentGame
+{
+    int                     m_openingIndex     = 0;
+    bool                    m_isCandidateWhite = true;
+    std::vector<sChessMove> m_moveList;
+    eMatchResult            m_matchResult      = eMatchResult::ONGOING;
+    eTournamentTermination  m_termination      = eTournamentTermination::RULES;
+    int                     m_winnerId         = -1;     // 0 white, 1 black, -1 draw
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sTournamentResult
+{
+    int           m_gameCount                                       = 0;
+    int           m_winCount                                        = 0;     // Wins, draws and losses are the candidate's
+    int           m_drawCount                                       = 0;
+    int           m_lossCount                                       = 0;
+    int           m_terminationCounts[TOURNAMENT_TERMINATION_COUNT] = {};
+    int           m_totalPly                                        = 0;
+    double        m_elo                                             = 0.0;
+    double        m_eloError                                        = 0.0;   // 95% confidence half-width
+    double        m_llr                                             = 0.0;
+    double        m_lowerBound                                      = 0.0;
+    double        m_upperBound                                      = 0.0;
+    eSprtDecision m_decision                                        = eSprtDecision::CONTINUE;
+    int           m_threadCount                                     = 0;
+    double        m_elapsedSeconds                                  = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Plays the candidate AIController configuration against the baseline on a WorkerThreadPool until
+/// the SPRT decides, m_maxGameCount games are played or a stop is requested. Games run in pairs, each
+/// opening once with either side as white, the suite starting over once it runs out, and every
+/// game is a HeadlessMatch, so a new game only resets buffers that are already allocated. Each game
+/// seeds its own random engine from its index, so a run is repeatable for a given seed but the games
+/// differ from each other. The SPRT is checked after each batch of concurrent games.
+///
+/// Needs no Engine: the game runs it on a background thread, and the Tournament console app runs it
+/// on a server without a window or a GPU.
+class TournamentRunner
+{
+public:
+    explicit TournamentRunner(sTournamentConfig const& config);
+
+    sTournamentResult Run();
+    void              RequestStop();
+    void              UpdateStatistics(sTournamentResult& result) const;
+
+    static bool        LoadOpeningSuite(std::string const& filePath, std::vector<sChessPosition>& out_openings);
+    static char const* GetTerminationString(eTournamentTermination termination);
+
+private:
+    void                  PlayGame(int gameIndex, int slotIndex);
+    sChessPosition const& GetOpening(int openingIndex) const;
+    std::string           GetPgnGameString(sTournamentGame const& game, int round) const;
+
+    sTournamentConfig            m_config;
+    std::vector<sTournamentGame> m_batchGames;                  // One per game in a batch; kept between batches so
+    std::vector<HeadlessMatch>   m_slotMatches;                 // their move lists and rule buffers are reused
+    std::atomic<bool>            m_isStopRequested = false;     // Checked between batches
+};
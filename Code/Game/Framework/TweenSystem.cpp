@@ -0,0 +1,227 @@
+//----------------------------------------------------------------------------------------------------
+// TweenSystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/TweenSystem.hpp"
+
+#include <algorithm>
+#include <cfloat>
+
+#include "Game/Gameplay/Actor.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void TweenSystem::Start(Actor* const      actor,
+                        Vec3 const&       startPosition,
+                        Vec3 const&       endPosition,
+                        float const       durationSeconds,
+                        eTweenCurve const curve)
+{
+    Stop(actor);
+
+    Vec3 const delta = endPosition - startPosition;
+    bool const isHop = curve == eTweenCurve::HOP;
+
+    actor->m_tweenIndex = static_cast<int>(m_actors.size());
+
+    m_startX.push_back(startPosition.x);
+    m_startY.push_back(startPosition.y);
+    m_startZ.push_back(startPosition.z);
+    m_deltaX.push_back(delta.x);
+    m_deltaY.push_back(delta.y);
+    m_deltaZ.push_back(delta.z);
+    m_arcX.push_back(isHop ? -delta.y * TWEEN_HOP_ARC_SCALE : 0.f);
+    m_arcY.push_back(isHop ? delta.x * TWEEN_HOP_ARC_SCALE : 0.f);
+    m_hopHeight.push_back(isHop ? delta.GetLength() * TWEEN_HOP_HEIGHT_SCALE : 0.f);
+    m_progress.push_back(0.f);
+    m_progressRate.push_back(durationSeconds > 0.f ? 1.f / durationSeconds : FLT_MAX);
+    m_curves.push_back(static_cast<uint8_t>(curve));
+    m_actors.push_back(actor);
+    m_positionX.push_back(startPosition.x);
+    m_positionY.push_back(startPosition.y);
+    m_positionZ.push_back(startPosition.z);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Leaves the actor wherever its tween last put it.
+void TweenSystem::Stop(Actor* const actor)
+{
+    if (actor->m_tweenIndex >= 0)
+    {
+        RemoveAt(actor->m_tweenIndex);
+        return;
+    }
+
+    auto const it = std::find(m_settlingActors.begin(), m_settlingActors.end(), actor);
+
+    if (it == m_settlingActors.end()) return;
+
+    *it = m_settlingActors.back();
+    m_settlingActors.pop_back();
+}
+
+//----------------------------------------------------------------------------------------------------
+void TweenSystem::Clear()
+{
+    for (Actor* actor : m_actors)
+    {
+        actor->m_tweenIndex = -1;
+    }
+
+    m_startX.clear();
+    m_startY.clear();
+    m_startZ.clear();
+    m_deltaX.clear();
+    m_deltaY.clear();
+    m_deltaZ.clear();
+    m_arcX.clear();
+    m_arcY.clear();
+    m_hopHeight.clear();
+    m_progress.clear();
+    m_progressRate.clear();
+    m_curves.clear();
+    m_actors.clear();
+    m_positionX.clear();
+    m_positionY.clear();
+    m_positionZ.clear();
+    m_finishedActors.clear();
+    m_settlingActors.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Every curve is a weighted sum: start + delta * ease + arc * bow + up * hopHeight * lift. The hop's
+/// cubic Bezier has guides a quarter and three quarters along the way, both pushed sideways by arc, so
+/// its ground position expands to that sum with ease 0.75t + 0.75t^2 - 0.5t^3 and bow 3t(1 - t); its
+/// height eases linearly. Arc and hop height are zero for the other curves, so their terms drop out.
+void TweenSystem::Update(float const deltaSeconds)
+{
+    for (Actor* actor : m_settlingActors)
+    {
+        actor->m_previousPosition = actor->m_position;
+    }
+
+    m_settlingActors.clear();
+    m_finishedActors.clear();
+
+    int const      tweenCount   = static_cast<int>(m_actors.size());
+    float const*   startX       = m_startX.data();
+    float const*   startY       = m_startY.data();
+    float const*   startZ       = m_startZ.data();
+    float const*   deltaX       = m_deltaX.data();
+    float const*   deltaY       = m_deltaY.data();
+    float const*   deltaZ       = m_deltaZ.data();
+    float const*   arcX         = m_arcX.data();
+    float const*   arcY         = m_arcY.data();
+    float const*   hopHeight    = m_hopHeight.data();
+    float const*   progressRate = m_progressRate.data();
+    uint8_t const* curves       = m_curves.data();
+    float*         progress     = m_progress.data();
+    float*         positionX    = m_positionX.data();
+    float*         positionY    = m_positionY.data();
+    float*         positionZ    = m_positionZ.data();
+    uint8_t const  smoothStep3  = static_cast<uint8_t>(eTweenCurve::SMOOTH_STEP_3);
+    uint8_t const  hop          = static_cast<uint8_t>(eTweenCurve::HOP);
+
+    for (int tweenIndex = 0; tweenIndex < tweenCount; ++tweenIndex)
+    {
+        float const t  = std::min(progress[tweenIndex] + deltaSeconds * progressRate[tweenIndex], 1.f);
+        float const t2 = t * t;
+        float const t3 = t2 * t;
+
+        float const smooth3 = 3.f * t2 - 2.f * t3;
+        float const smooth5 = t3 * (t * (6.f * t - 15.f) + 10.f);
+        float const hopEase = 0.75f * t + 0.75f * t2 - 0.5f * t3;
+        float const bow     = 3.f * (t - t2);
+        float const lift    = 4.f * smooth3 * (1.f - smooth3);
+        bool const  isHop   = curves[tweenIndex] == hop;
+        float const ease    = isHop ? hopEase : (curves[tweenIndex] == smoothStep3 ? smooth3 : smooth5);
+        float const zEase   = isHop ? t : ease;
+
+        progress[tweenIndex]  = t;
+        positionX[tweenIndex] = startX[tweenIndex] + deltaX[tweenIndex] * ease + arcX[tweenIndex] * bow;
+        positionY[tweenIndex] = startY[tweenIndex] + deltaY[tweenIndex] * ease + arcY[tweenIndex] * bow;
+        positionZ[tweenIndex] = startZ[tweenIndex] + deltaZ[tweenIndex] * zEase + hopHeight[tweenIndex] * lift;
+    }
+
+    // Backwards, so a finished tween is swapped out for one already copied.
+    for (int tweenIndex = tweenCount - 1; tweenIndex >= 0; --tweenIndex)
+    {
+        Actor* const actor = m_actors[tweenIndex];
+
+        actor->m_previousPosition = actor->m_position;
+        actor->m_position         = Vec3(positionX[tweenIndex], positionY[tweenIndex], positionZ[tweenIndex]);
+
+        if (progress[tweenIndex] < 1.f) continue;
+
+        m_finishedActors.push_back(actor);
+        m_settlingActors.push_back(actor);
+        RemoveAt(tweenIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenSystem::IsTweening(Actor const* actor) const
+{
+    return actor->m_tweenIndex >= 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TweenSystem::GetActiveCount() const
+{
+    return static_cast<int>(m_actors.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Actor*> const& TweenSystem::GetFinishedActors() const
+{
+    return m_finishedActors;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Swaps the last tween into tweenIndex and pops it.
+void TweenSystem::RemoveAt(int const tweenIndex)
+{
+    int const lastIndex = static_cast<int>(m_actors.size()) - 1;
+
+    m_actors[tweenIndex]->m_tweenIndex = -1;
+
+    if (tweenIndex != lastIndex)
+    {
+        m_startX[tweenIndex]       = m_startX[lastIndex];
+        m_startY[tweenIndex]       = m_startY[lastIndex];
+        m_startZ[tweenIndex]       = m_startZ[lastIndex];
+        m_deltaX[tweenIndex]       = m_deltaX[lastIndex];
+        m_deltaY[tweenIndex]       = m_deltaY[lastIndex];
+        m_deltaZ[tweenIndex]       = m_deltaZ[lastIndex];
+        m_arcX[tweenIndex]         = m_arcX[lastIndex];
+        m_arcY[tweenIndex]         = m_arcY[lastIndex];
+        m_hopHeight[tweenIndex]    = m_hopHeight[lastIndex];
+        m_progress[tweenIndex]     = m_progress[lastIndex];
+        m_progressRate[tweenIndex] = m_progressRate[lastIndex];
+        m_curves[tweenIndex]       = m_curves[lastIndex];
+        m_actors[tweenIndex]       = m_actors[lastIndex];
+        m_positionX[tweenIndex]    = m_positionX[lastIndex];
+        m_positionY[tweenIndex]    = m_positionY[lastIndex];
+        m_positionZ[tweenIndex]    = m_positionZ[lastIndex];
+
+        m_actors[tweenIndex]->m_tweenIndex = tweenIndex;
+    }
+
+    m_startX.pop_back();
+    m_startY.pop_back();
+    m_startZ.pop_back();
+    m_deltaX.pop_back();
+    m_deltaY.pop_back();
+    m_deltaZ.pop_back();
+    m_arcX.pop_back();
+    m_arcY.pop_back();
+    m_hopHeight.pop_back();
+    m_progress.pop_back();
+    m_progressRate.pop_back();
+    m_curves.pop_back();
+    m_actors.pop_back();
+    m_positionX.pop_back();
+    m_positionY.pop_back();
+    m_positionZ.pop_back();
+}
@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------------------------------
+// TweenSystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Actor;
+
+//----------------------------------------------------------------------------------------------------
+enum class eTweenCurve : uint8_t
+{
+    SMOOTH_STEP_3,
+    SMOOTH_STEP_5,
+    HOP                 // Bows sideways along a cubic Bezier and lifts along a parabola
+};
+
+//----------------------------------------------------------------------------------------------------
+float constexpr TWEEN_HOP_ARC_SCALE    = 0.1f;     // Sideways bow of a hop, per unit of ground distance
+float constexpr TWEEN_HOP_HEIGHT_SCALE = 0.6f;     // Peak height of a hop, per unit of distance
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Moves actors from a start to an end position over a duration. Active tweens are kept as structure
+/// of arrays and advanced in one branch-free loop over them, which the compiler can vectorize; curves
+/// are picked per tween with selects rather than branches. Idle actors are never visited, so Update
+/// costs O(active tweens) however many actors exist. Everything a curve needs from the board is
+/// computed once in Start.
+///
+/// An actor has at most one tween; starting another replaces it. Finished tweens leave the actor
+/// exactly at the end position and are reported by GetFinishedActors until the next Update.
+///
+/// Update is meant to run once per fixed simulation step. Each step also moves the tweened actors'
+/// m_previousPosition up to where they were, so rendering can blend between the last two steps; a
+/// finished actor has it caught up one step later, after which it stays equal to m_position.
+class TweenSystem
+{
+public:
+    void Start(Actor* actor, Vec3 const& startPosition, Vec3 const& endPosition, float durationSeconds, eTweenCurve curve);
+    void Stop(Actor* actor);
+    void Clear();
+    void Update(float deltaSeconds);
+
+    bool                       IsTweening(Actor const* actor) const;
+    int                        GetActiveCount() const;
+    std::vector<Actor*> const& GetFinishedActors() const;
+
+private:
+    void RemoveAt(int tweenIndex);
+
+    std::vector<float>   m_startX;
+    std::vector<float>   m_startY;
+    std::vector<float>   m_startZ;
+    std::vector<float>   m_deltaX;          // End minus start
+    std::vector<float>   m_deltaY;
+    std::vector<float>   m_deltaZ;
+    std::vector<float>   m_arcX;            // Sideways bow at the hop's Bezier guides; zero for other curves
+    std::vector<float>   m_arcY;
+    std::vector<float>   m_hopHeight;       // Zero for other curves
+    std::vector<float>   m_progress;        // 0 to 1
+    std::vector<float>   m_progressRate;    // 1 / duration
+    std::vector<uint8_t> m_curves;
+    std::vector<Actor*>  m_actors;
+
+    std::vector<float>   m_positionX;       // Written by the tween loop, then copied to the actors
+    std::vector<float>   m_positionY;
+    std::vector<float>   m_positionZ;
+    std::vector<Actor*>  m_finishedActors;
+    std::vector<Actor*>  m_settlingActors;  // Finished last step; m_previousPosition still lags
+};
@@ -0,0 +1,121 @@
+//----------------------------------------------------------------------------------------------------
+// WorkerThreadPool.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/WorkerThreadPool.hpp"
+
+#include <algorithm>
+
+#include "Game/Framework/ProfileScope.hpp"
+
+//----------------------------------------------------------------------------------------------------
+WorkerThreadPool::WorkerThreadPool(int const threadCount)
+{
+    int const totalCount = threadCount > 0 ? threadCount : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+
+    // The thread calling ParallelFor is one of the totalCount.
+    for (int workerIndex = 1; workerIndex < totalCount; ++workerIndex)
+    {
+        m_workers.emplace_back(&WorkerThreadPool::WorkerMain, this);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+WorkerThreadPool::~WorkerThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_isStopping = true;
+    }
+
+    m_wakeCondition.notify_all();
+
+    for (std::thread& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Runs task(0) .. task(taskCount - 1) across the pool and the calling thread. Tasks may run in
+/// any order and on any thread, so each must write only to its own outputs.
+void WorkerThreadPool::ParallelFor(int const                                 taskCount,
+                                   std::function<void(int taskIndex)> const& task)
+{
+    if (taskCount <= 0) return;
+
+    if (m_workers.empty() || taskCount == 1)
+    {
+        for (int taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+        {
+            task(taskIndex);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task            = &task;
+        m_taskCount       = taskCount;
+        m_nextTaskIndex   = 0;
+        m_busyWorkerCount = static_cast<int>(m_workers.size());
+        ++m_generation;
+    }
+
+    m_wakeCondition.notify_all();
+    RunTasks();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_doneCondition.wait(lock, [this] { return m_busyWorkerCount == 0; });
+    m_task      = nullptr;
+    m_taskCount = 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+int WorkerThreadPool::GetThreadCount() const
+{
+    return static_cast<int>(m_workers.size()) + 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+void WorkerThreadPool::WorkerMain()
+{
+    uint64_t seenGeneration = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeCondition.wait(lock, [this, seenGeneration] { return m_isStopping || m_generation != seenGeneration; });
+
+            if (m_isStopping) return;
+
+            seenGeneration = m_generation;
+        }
+
+        RunTasks();
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_busyWorkerCount;
+        }
+
+        m_doneCondition.notify_one();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void WorkerThreadPool::RunTasks()
+{
+    PROFILE_SCOPE("WorkerThreadPool::RunTasks");
+
+    while (true)
+    {
+        int const taskIndex = m_nextTaskIndex.fetch_add(1);
+
+        if (taskIndex >= m_taskCount) return;
+
+        (*m_task)(taskIndex);
+    }
+}
@@ -0,0 +1,46 @@
+//----------------------------------------------------------------------------------------------------
+// WorkerThreadPool.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// A fixed set of threads that stay parked between frames, for work split into many small tasks each
+/// frame. ParallelFor hands out task indexes from one atomic counter, runs tasks on the calling thread
+/// as well, and returns once every task has finished. Only one ParallelFor may run at a time.
+class WorkerThreadPool
+{
+public:
+    explicit WorkerThreadPool(int threadCount = 0);     // 0 uses every hardware thread
+    ~WorkerThreadPool();
+
+    WorkerThreadPool(WorkerThreadPool const&)            = delete;
+    WorkerThreadPool& operator=(WorkerThreadPool const&) = delete;
+
+    void ParallelFor(int taskCount, std::function<void(int taskIndex)> const& task);
+    int  GetThreadCount() const;                        // Including the calling thread
+
+private:
+    void WorkerMain();
+    void RunTasks();
+
+    std::vector<std::thread>                  m_workers;
+    std::mutex                                m_mutex;
+    std::condition_variable                   m_wakeCondition;
+    std::condition_variable                   m_doneCondition;
+    std::function<void(int taskIndex)> const* m_task             = nullptr;
+    int                                       m_taskCount        = 0;
+    std::atomic<int>                          m_nextTaskIndex    = 0;
+    int                                       m_busyWorkerCount  = 0;
+    uint64_t                                  m_generation       = 0;     // Bumped by every ParallelFor
+    bool                                      m_isStopping       = false;
+};
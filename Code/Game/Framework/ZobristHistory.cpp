@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------------------------------
+// ZobristHistory.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Framework/ZobristHistory.hpp"
+
+#include <algorithm>
+
+//----------------------------------------------------------------------------------------------------
+int constexpr FIFTY_MOVE_RULE_PLY_COUNT = 100;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Starts a new history at rootKey. halfMoveClock carries the plies already played since the
+/// last irreversible move, e.g. from a FEN.
+void ZobristHistory::Reset(uint64_t const rootKey,
+                           int const      halfMoveClock)
+{
+    m_entries.clear();
+    m_entries.push_back({rootKey, -halfMoveClock});
+}
+
+//----------------------------------------------------------------------------------------------------
+void ZobristHistory::Push(uint64_t const key,
+                          bool const     isIrreversible)
+{
+    int const index             = static_cast<int>(m_entries.size());
+    int const irreversibleIndex = isIrreversible || m_entries.empty() ? index : m_entries.back().m_irreversibleIndex;
+
+    m_entries.push_back({key, irreversibleIndex});
+}
+
+//----------------------------------------------------------------------------------------------------
+void ZobristHistory::Pop()
+{
+    if (m_entries.size() > 1) m_entries.pop_back();
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t ZobristHistory::GetCurrentKey() const
+{
+    return m_entries.empty() ? 0 : m_entries.back().m_key;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ZobristHistory::GetPly() const
+{
+    return static_cast<int>(m_entries.size()) - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+int ZobristHistory::GetHalfMoveClock() const
+{
+    if (m_entries.empty()) return 0;
+
+    return GetPly() - m_entries.back().m_irreversibleIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Occurrences of the current position, itself included. A position cannot recur two plies
+/// later, so the scan starts four plies back.
+int ZobristHistory::GetRepetitionCount() const
+{
+    if (m_entries.empty()) return 0;
+
+    sEntry const& current = m_entries.back();
+    int const     first   = std::max(current.m_irreversibleIndex, 0);
+    int           count   = 1;
+
+    for (int index = GetPly() - 4; index >= first; index -= 2)
+    {
+        if (m_entries[index].m_key == current.m_key) ++count;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Search treats the first recurrence as a draw; stops at the first match instead of counting.
+bool ZobristHistory::IsRepetition() const
+{
+    if (m_entries.empty()) return false;
+
+    sEntry const& current = m_entries.back();
+    int const     first   = std::max(current.m_irreversibleIndex, 0);
+
+    for (int index = GetPly() - 4; index >= first; index -= 2)
+    {
+        if (m_entries[index].m_key == current.m_key) return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ZobristHistory::IsThreefoldRepetition() const
+{
+    return GetRepetitionCount() >= 3;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ZobristHistory::IsFiftyMoveRuleReached() const
+{
+    return GetHalfMoveClock() >= FIFTY_MOVE_RULE_PLY_COUNT;
+}
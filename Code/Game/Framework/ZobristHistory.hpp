@@ -0,0 +1,40 @@
+//----------------------------------------------------------------------------------------------------
+// ZobristHistory.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Stack of position keys, one per ply, from the match start (or search root) to the current position.
+/// Every entry remembers the index of the most recent irreversible move (capture or pawn move). No
+/// earlier position can recur, so the repetition check only scans back to that boundary, and only
+/// every second entry, because the side to move must also match.
+/// Push/Pop are O(1), so search can make and unmake moves on the same stack the Match records into.
+class ZobristHistory
+{
+public:
+    void Reset(uint64_t rootKey, int halfMoveClock = 0);
+    void Push(uint64_t key, bool isIrreversible);
+    void Pop();
+
+    uint64_t GetCurrentKey() const;
+    int      GetPly() const;
+    int      GetHalfMoveClock() const;
+    int      GetRepetitionCount() const;
+    bool     IsRepetition() const;
+    bool     IsThreefoldRepetition() const;
+    bool     IsFiftyMoveRuleReached() const;
+
+private:
+    struct sEntry
+    {
+        uint64_t m_key               = 0;
+        int      m_irreversibleIndex = 0; // May be negative when the root carried a half-move clock
+    };
+
+    std::vector<sEntry> m_entries;
+};
@@ -5,6 +5,9 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Actor.hpp"
 
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Gameplay/Match.hpp"
+
 //----------------------------------------------------------------------------------------------------
 Actor::Actor(Match* owner)
     : m_match(owner)
@@ -21,12 +24,22 @@ Mat44 Actor::GetModelToWorldTransform() const
 {
     Mat44 m2w;
 
-    m2w.SetTranslation3D(m_position);
+    m2w.SetTranslation3D(GetRenderPosition());
     m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
 
     return m2w;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Where to draw the actor between simulation steps: m_previousPosition blended towards
+/// m_position by the owning match's render alpha. Still actors keep both equal, so they draw in place.
+Vec3 Actor::GetRenderPosition() const
+{
+    if (m_match == nullptr) return m_position;
+
+    return Interpolate(m_previousPosition, m_position, m_match->GetRenderAlpha());
+}
+
 //----------------------------------------------------------------------------------------------------
 void Actor::SetOrientation(EulerAngles const& newOrientation)
 {
@@ -5,6 +5,7 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 #include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/EulerAngles.hpp"
 #include "Engine/Math/IntVec2.hpp"
 #include "Engine/Math/Vec3.hpp"
@@ -23,12 +24,17 @@ public:
     virtual void  Render() const = 0;
     virtual Mat44 GetModelToWorldTransform() const;
     virtual void  SetOrientation(EulerAngles const& newOrientation);
+    Vec3          GetRenderPosition() const;
 
-    Match*      m_match           = nullptr;
-    IntVec2     m_coords          = IntVec2::ZERO;
-    Vec3        m_position        = Vec3::ZERO;
-    Vec3        m_velocity        = Vec3::ZERO;
-    EulerAngles m_orientation     = EulerAngles::ZERO;
-    EulerAngles m_angularVelocity = EulerAngles::ZERO;
-    Rgba8       m_color           = Rgba8::WHITE;
+    Match*      m_match            = nullptr;
+    IntVec2     m_coords           = IntVec2::ZERO;
+    Vec3        m_position         = Vec3::ZERO;
+    Vec3        m_previousPosition = Vec3::ZERO;            // m_position before the last simulation step; rendering blends from it
+    Vec3        m_velocity         = Vec3::ZERO;
+    EulerAngles m_orientation      = EulerAngles::ZERO;
+    EulerAngles m_angularVelocity  = EulerAngles::ZERO;
+    Rgba8       m_color            = Rgba8::WHITE;
+    AABB3       m_localBounds;                              // Model space; culled through GetModelToWorldTransform
+    bool        m_isVisible        = true;                  // Written by Match's frustum culling each frame
+    int         m_tweenIndex       = -1;                    // Slot in a TweenSystem; -1 while idle
 };
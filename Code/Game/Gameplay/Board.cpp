@@ -5,45 +5,105 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Board.hpp"
 
+#include <algorithm>
+
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Renderer/VertexUtils.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Math/AABB3.hpp"
 #include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
 #include "Engine/Resource/Resource/ModelResource.hpp"
 #include "Engine/Resource/ResourceLoader/ObjModelLoader.hpp"
 #include "Engine/Resource/ResourceHandle.hpp"
 #include "Engine/Resource/ResourceSubsystem.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
+#include "Game/Framework/CounterRegistry.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/InputRecorder.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
 #include "Game/Gameplay/Match.hpp"
 #include "Game/Gameplay/Piece.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static AABB3 GetVertexBounds(VertexList_PCUTBN const& verts)
+{
+    if (verts.empty()) return AABB3(Vec3::ZERO, Vec3::ZERO);
+
+    AABB3 bounds(verts[0].m_position, verts[0].m_position);
+
+    for (Vertex_PCUTBN const& vertex : verts)
+    {
+        Vec3 const& position = vertex.m_position;
+        bounds.m_mins        = Vec3(std::min(bounds.m_mins.x, position.x), std::min(bounds.m_mins.y, position.y), std::min(bounds.m_mins.z, position.z));
+        bounds.m_maxs        = Vec3(std::max(bounds.m_maxs.x, position.x), std::max(bounds.m_maxs.y, position.y), std::max(bounds.m_maxs.z, position.z));
+    }
+
+    return bounds;
+}
 
 //----------------------------------------------------------------------------------------------------
-Board::Board(Match* owner)
+/// @brief Creates and uploads the board's buffers through backend. Without a Renderer the board is drawn
+/// untextured, and without a resource subsystem the test model is left out, as on a headless host.
+Board::Board(Match*         owner,
+             RenderBackend& backend)
     : Actor(owner)
 
 {
-    m_shader                   = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Bloom", eVertexType::VERTEX_PCU);
-    m_diffuseTexture           = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_d.png");
-    m_normalTexture            = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_n.png");
-    m_specularGlossEmitTexture = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_sge.png");
-    CreateLocalVertsForAABB3s();
-    CreateLocalVertsForBoardFrame();
+    if (g_theRenderer != nullptr)
+    {
+        m_shader                   = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Bloom", eVertexType::VERTEX_PCU);
+        m_diffuseTexture           = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_d.png");
+        m_normalTexture            = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_n.png");
+        m_specularGlossEmitTexture = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_sge.png");
+    }
+
+    // The squares and frame never change, so they live in GPU buffers and Render only binds them.
+    VertexList_PCUTBN verts;
+    IndexList         indexes;
+    CreateLocalVertsForAABB3s(verts, indexes);
+    CreateLocalVertsForBoardFrame(verts, indexes);
+    CreateBuffers(verts, indexes, backend, m_vertexBuffer, m_indexBuffer);
+    m_indexCount  = static_cast<unsigned int>(indexes.size());
+    m_localBounds = GetVertexBounds(verts);
+
+    if (g_theResourceSubsystem == nullptr) return;
 
     m_resourceHandle = g_theResourceSubsystem->LoadResource<ModelResource>("Data/Models/TutorialBox_Phong/Tutorial_Box.obj");
 
     ModelResource const* modelResource = m_resourceHandle.Get();
 
     // 取得頂點和索引資料
-    m_vertexWoman = modelResource->GetVertices();
-    m_indexWoman  = modelResource->GetIndices();
+    CreateBuffers(modelResource->GetVertices(), modelResource->GetIndices(), backend, m_modelVertexBuffer, m_modelIndexBuffer);
+    m_modelIndexCount      = static_cast<unsigned int>(modelResource->GetIndices().size());
+    m_testModelLocalBounds = GetVertexBounds(modelResource->GetVertices());
 }
 
 Board::~Board()
 {
+    GAME_SAFE_RELEASE(m_vertexBuffer);
+    GAME_SAFE_RELEASE(m_indexBuffer);
+    GAME_SAFE_RELEASE(m_modelVertexBuffer);
+    GAME_SAFE_RELEASE(m_modelIndexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Board::CreateBuffers(VertexList_PCUTBN const& verts,
+                          IndexList const&         indexes,
+                          RenderBackend&           backend,
+                          VertexBuffer*&           out_vertexBuffer,
+                          IndexBuffer*&            out_indexBuffer) const
+{
+    out_vertexBuffer = backend.CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    out_indexBuffer  = backend.CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+
+    backend.CopyCPUToGPU(verts.data(), static_cast<unsigned int>(verts.size() * sizeof(Vertex_PCUTBN)), out_vertexBuffer);
+    backend.CopyCPUToGPU(indexes.data(), static_cast<unsigned int>(indexes.size() * sizeof(unsigned int)), out_indexBuffer);
 }
 
 
@@ -54,10 +114,23 @@ void Board::Update(float const deltaSeconds)
     m_orientation.m_pitchDegrees += m_angularVelocity.m_pitchDegrees * deltaSeconds;
     m_orientation.m_rollDegrees += m_angularVelocity.m_rollDegrees * deltaSeconds;
 
-    if (g_theInput->IsKeyDown(KEYCODE_I)) m_testPos.y++;
-    if (g_theInput->IsKeyDown(KEYCODE_J)) m_testPos.x--;
-    if (g_theInput->IsKeyDown(KEYCODE_K)) m_testPos.y--;
-    if (g_theInput->IsKeyDown(KEYCODE_L)) m_testPos.x++;
+    if (IsRecordedKeyDown(KEYCODE_I)) m_testPos.y++;
+    if (IsRecordedKeyDown(KEYCODE_J)) m_testPos.x--;
+    if (IsRecordedKeyDown(KEYCODE_K)) m_testPos.y--;
+    if (IsRecordedKeyDown(KEYCODE_L)) m_testPos.x++;
+}
+
+//----------------------------------------------------------------------------------------------------
+Mat44 Board::GetTestModelToWorldTransform() const
+{
+    Mat44 m2w;
+    m2w.SetTranslation3D(m_testPos);
+    m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
+    m2w.AppendXRotation(90.f);
+    m2w.AppendYRotation(45.f);
+    m2w.AppendScaleUniform3D(0.01f);
+
+    return m2w;
 }
 
 AABB3 Board::GetAABB3FromCoords(IntVec2 const& coords,
@@ -76,38 +149,26 @@ AABB3 Board::GetAABB3FromCoords(IntVec2 const& coords,
     return AABB3(mins, maxs);
 }
 
-void Board::RenderSelectedBox() const
+void Board::Render() const
 {
-    VertexList_PCU verts;
-
-    for (sSquareInfo const& info : m_squareInfoList)
-    {
-        if (info.m_isSelected || info.m_isHighlighted)
-        {
-            AddVertsForWireframeAABB3D(verts, GetAABB3FromCoords(info.m_coords, 0.2f), 0.01f);
-        }
-    }
-
-    g_theRenderer->BindTexture(nullptr);
-    g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
-    g_theRenderer->DrawVertexArray(verts);
+    SubmitDraws(m_match->GetRenderCommandList());
 }
 
 //----------------------------------------------------------------------------------------------------
-void Board::Render() const
+/// @brief Submits the board, and the test model when it is loaded, from their persistent buffers;
+/// nothing is uploaded per frame.
+void Board::SubmitDraws(RenderCommandList& commandList) const
 {
-    g_theRenderer->SetModelConstants(GetModelToWorldTransform(), m_color);
-    g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-    g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-    g_theRenderer->BindTexture(m_diffuseTexture, 0);
-    g_theRenderer->BindTexture(m_normalTexture, 1);
-    g_theRenderer->BindTexture(m_specularGlossEmitTexture, 2);
-    g_theRenderer->BindShader(m_shader);
-    g_theRenderer->DrawVertexArray(m_vertexes, m_indexes);
-
-    RenderSelectedBox();
+    sRenderState state;
+    state.m_shader           = m_shader;
+    state.m_textures[0]      = m_diffuseTexture;
+    state.m_textures[1]      = m_normalTexture;
+    state.m_textures[2]      = m_specularGlossEmitTexture;
+    state.m_textureSlotCount = 3;
+
+    if (g_theLightSubsystem != nullptr) state.m_lightSetId = g_theLightSubsystem->GetLightSetForBounds(m_localBounds, GetModelToWorldTransform());
+
+    if (m_isVisible) commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, GetModelToWorldTransform(), m_color, m_vertexBuffer, m_indexBuffer, m_indexCount);
 
     // Mat44 m2w;
     // m2w.SetTranslation3D(m_testPos);
@@ -123,27 +184,15 @@ void Board::Render() const
     // g_theRenderer->DrawVertexArray(m_vertexWoman, m_indexWoman);
 
 
-    if (m_resourceHandle.IsValid())
+    if (m_modelVertexBuffer != nullptr && m_isTestModelVisible)
     {
+        Mat44 const m2w = GetTestModelToWorldTransform();
+        state.m_textures[0] = g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_Diffuse.tga");
+        state.m_textures[1] = g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_Normal.tga");
+        state.m_textures[2] = g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_SpecGlossEmit.tga");
+        state.m_lightSetId  = g_theLightSubsystem->GetLightSetForBounds(m_testModelLocalBounds, m2w);
 
-
-        // 渲染程式碼保持不變
-        Mat44 m2w;
-        m2w.SetTranslation3D(m_testPos);
-        m2w.Append(m_orientation.GetAsMatrix_IFwd_JLeft_KUp());
-        m2w.AppendXRotation(90.f);
-        m2w.AppendYRotation(45.f);
-        m2w.AppendScaleUniform3D(0.01f);
-        g_theRenderer->SetModelConstants(m2w);
-        g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-        g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-        g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-        g_theRenderer->SetDepthMode(eDepthMode::READ_WRITE_LESS_EQUAL);
-        g_theRenderer->BindTexture(g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_Diffuse.tga"), 0);
-        g_theRenderer->BindTexture(g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_Normal.tga"), 1);
-        g_theRenderer->BindTexture(g_theRenderer->CreateOrGetTextureFromFile("Data/Models/TutorialBox_Phong/Tutorial_Box_SpecGlossEmit.tga"), 2);
-        g_theRenderer->BindShader(m_shader);
-        g_theRenderer->DrawVertexArray(m_vertexWoman, m_indexWoman);
+        commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, m2w, Rgba8::WHITE, m_modelVertexBuffer, m_modelIndexBuffer, m_modelIndexCount);
     }
 }
 
@@ -173,8 +222,10 @@ Vec3 Board::GetWorldPositionByCoords(IntVec2 const& coords)
 
 sSquareInfo Board::GetSquareInfoByCoords(IntVec2 const& coords)
 {
+    COUNTER_INCREMENT("Board::GetSquareInfoByCoords");
+
     sSquareInfo returnSquareInfo;
-    for (sSquareInfo squareInfo : m_squareInfoList)
+    for (sSquareInfo const& squareInfo : m_squareInfoList)
     {
         if (squareInfo.m_coords == coords)
         {
@@ -237,7 +288,28 @@ bool Board::IsCoordValid(IntVec2 const& coords) const
     return coords.x >= 1 && coords.x <= 8 && coords.y >= 1 && coords.y <= 8;
 }
 
-void Board::CreateLocalVertsForAABB3s()
+void Board::CreateLocalVertsForAABB3s(VertexList_PCUTBN& out_verts,
+                                      IndexList&         out_indexes)
+{
+    for (int y = 0; y < 8; ++y)
+    {
+        for (int x = 0; x < 8; ++x)
+        {
+            Vec3 mins = Vec3(static_cast<float>(x), static_cast<float>(y), 0.f);
+            m_AABBs.push_back(AABB3(mins, mins + Vec3(1.f, 1.f, 0.2f)));
+        }
+    }
+
+    CreateLocalVertsForSquares(out_verts, out_indexes);
+    // AddVertsForQuad3D(m_vertexes, m_indexes, Vec3(0,0,2), Vec3(1,0,2),Vec3(0,1,2), Vec3(1,1,2));
+    // AddVertsForQuad3D(m_vertexes, m_indexes,  Vec3(0,1,3),Vec3(0,0,3), Vec3(1,1,3),Vec3(1,0,3));
+    // AddVertsForAABB3D(m_vertexes, m_indexes, AABB3::ZERO_TO_ONE, Rgba8(240, 230, 210));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The 64 squares alone. Static, so the spectator scene can share the board mesh without a Board.
+STATIC void Board::CreateLocalVertsForSquares(VertexList_PCUTBN& out_verts,
+                                              IndexList&         out_indexes)
 {
     for (int y = 0; y < 8; ++y)
     {
@@ -249,16 +321,13 @@ void Board::CreateLocalVertsForAABB3s()
 
             bool const isBlack = (x + y) % 2 == 0;
             Rgba8      color   = isBlack ? Rgba8(40, 50, 60) : Rgba8(240, 230, 210);
-            m_AABBs.push_back(box);
-            AddVertsForAABB3D(m_vertexes, m_indexes, box, color);
+            AddVertsForAABB3D(out_verts, out_indexes, box, color);
         }
     }
-    // AddVertsForQuad3D(m_vertexes, m_indexes, Vec3(0,0,2), Vec3(1,0,2),Vec3(0,1,2), Vec3(1,1,2));
-    // AddVertsForQuad3D(m_vertexes, m_indexes,  Vec3(0,1,3),Vec3(0,0,3), Vec3(1,1,3),Vec3(1,0,3));
-    // AddVertsForAABB3D(m_vertexes, m_indexes, AABB3::ZERO_TO_ONE, Rgba8(240, 230, 210));
 }
 
-void Board::CreateLocalVertsForBoardFrame()
+STATIC void Board::CreateLocalVertsForBoardFrame(VertexList_PCUTBN& out_verts,
+                                                 IndexList&         out_indexes)
 {
     float constexpr boardSize      = 8.f;
     float constexpr halfSize       = boardSize * 0.5f; // = 4.0f
@@ -293,10 +362,10 @@ void Board::CreateLocalVertsForBoardFrame()
         Vec3(centerX + halfSize + frameThickness, centerY + halfSize, frameHeight)
     );
 
-    AddVertsForAABB3D(m_vertexes, m_indexes, bottomFrame, Rgba8(40, 50, 60));
-    AddVertsForAABB3D(m_vertexes, m_indexes, topFrame, Rgba8(40, 50, 60));
-    AddVertsForAABB3D(m_vertexes, m_indexes, leftFrame, Rgba8(40, 50, 60));
-    AddVertsForAABB3D(m_vertexes, m_indexes, rightFrame, Rgba8(40, 50, 60));
+    AddVertsForAABB3D(out_verts, out_indexes, bottomFrame, Rgba8(40, 50, 60));
+    AddVertsForAABB3D(out_verts, out_indexes, topFrame, Rgba8(40, 50, 60));
+    AddVertsForAABB3D(out_verts, out_indexes, leftFrame, Rgba8(40, 50, 60));
+    AddVertsForAABB3D(out_verts, out_indexes, rightFrame, Rgba8(40, 50, 60));
 }
 
 void Board::UpdateSquareInfoList(IntVec2 const& toCoords)
@@ -14,22 +14,26 @@
 
 class ModelResource;
 //----------------------------------------------------------------------------------------------------
+class IndexBuffer;
 class Match;
 class Piece;
+class RenderBackend;
+class RenderCommandList;
 class Texture;
+class VertexBuffer;
 struct BoardDefinition;
 
 //----------------------------------------------------------------------------------------------------
 class Board final : public Actor
 {
 public:
-    explicit Board(Match* owner);
+    Board(Match* owner, RenderBackend& backend);
     ~Board() override;
 
     void  Update(float deltaSeconds) override;
     AABB3 GetAABB3FromCoords(IntVec2 const& coords, float aabb3Height) const;
-    void  RenderSelectedBox() const;
     void  Render() const override;
+    void  SubmitDraws(RenderCommandList& commandList) const;
 
     /// Query
     Vec3        GetWorldPositionByCoords(IntVec2 const& coords);
@@ -40,8 +44,9 @@ public:
     bool        IsCoordValid(IntVec2 const& coords) const;
 
     /// Render
-    void CreateLocalVertsForAABB3s();
-    void CreateLocalVertsForBoardFrame();
+    void        CreateLocalVertsForAABB3s(VertexList_PCUTBN& out_verts, IndexList& out_indexes);
+    static void CreateLocalVertsForSquares(VertexList_PCUTBN& out_verts, IndexList& out_indexes);
+    static void CreateLocalVertsForBoardFrame(VertexList_PCUTBN& out_verts, IndexList& out_indexes);
 
     /// Mutators (non-const methods)
     void UpdateSquareInfoList(IntVec2 const& toCoords);
@@ -50,13 +55,21 @@ public:
 
     IntVec2 FindKingCoordsByPlayerId(int playerId) const;
 
+    /// Test
+    Mat44 GetTestModelToWorldTransform() const;
+
     std::vector<sSquareInfo> m_squareInfoList;
     std::vector<AABB3>       m_AABBs;
+    AABB3                    m_testModelLocalBounds;
+    bool                     m_isTestModelVisible = true;   // Written by Match's frustum culling
 
 private:
+    void CreateBuffers(VertexList_PCUTBN const& verts, IndexList const& indexes, RenderBackend& backend, VertexBuffer*& out_vertexBuffer, IndexBuffer*& out_indexBuffer) const;
+
     BoardDefinition*  m_definition = nullptr;
-    VertexList_PCUTBN m_vertexes;
-    IndexList         m_indexes;
+    VertexBuffer*     m_vertexBuffer             = nullptr; // Squares and frame, uploaded once
+    IndexBuffer*      m_indexBuffer              = nullptr;
+    unsigned int      m_indexCount               = 0;
     Texture*          m_diffuseTexture           = nullptr;
     Texture*          m_normalTexture            = nullptr;
     Texture*          m_specularGlossEmitTexture = nullptr;
@@ -64,7 +77,8 @@ private:
 
     /// Test
     Vec3              m_testPos                  = Vec3::ZERO;
-    VertexList_PCUTBN m_vertexWoman;
-    IndexList         m_indexWoman;
+    VertexBuffer*     m_modelVertexBuffer        = nullptr;
+    IndexBuffer*      m_modelIndexBuffer         = nullptr;
+    unsigned int      m_modelIndexCount          = 0;
     ResourceHandle<ModelResource> m_resourceHandle;
 };
@@ -5,10 +5,16 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Game.hpp"
 
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Core/Time.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Engine/Network/NetworkSubsystem.hpp"
 #include "Engine/Renderer/DebugRenderSystem.hpp"
@@ -17,15 +23,42 @@
 #include "Engine/Resource/ResourceLoader/ObjModelLoader.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+#include "Game/Framework/AIController.hpp"
 #include "Game/Framework/App.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/CounterRegistry.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/HeadlessMatch.hpp"
+#include "Game/Framework/InputRecorder.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Framework/TimerWheel.hpp"
+#include "Game/Framework/TournamentRunner.hpp"
+#include "Game/Framework/TweenSystem.hpp"
+#include "Game/Gameplay/Actor.hpp"
 #include "Game/Gameplay/Match.hpp"
+#include "Game/Gameplay/SpectatorScene.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
 
 //----------------------------------------------------------------------------------------------------
 Game::Game()
 {
     g_theEventSystem->SubscribeEventCallbackFunction("OnGameStateChanged", OnGameStateChanged);
+    g_theEventSystem->SubscribeEventCallbackFunction("headless_match", OnHeadlessMatch);
+    g_theEventSystem->SubscribeEventCallbackFunction("tournament", OnTournament);
+    g_theEventSystem->SubscribeEventCallbackFunction("tournament_stop", OnTournamentStop);
+    g_theEventSystem->SubscribeEventCallbackFunction("cull_benchmark", OnCullBenchmark);
+    g_theEventSystem->SubscribeEventCallbackFunction("tween_benchmark", OnTweenBenchmark);
+    g_theEventSystem->SubscribeEventCallbackFunction("timer_wheel_benchmark", OnTimerWheelBenchmark);
+    g_theEventSystem->SubscribeEventCallbackFunction("spectate", OnSpectate);
+    g_theEventSystem->SubscribeEventCallbackFunction("spectator_benchmark", OnSpectatorBenchmark);
+    g_theEventSystem->SubscribeEventCallbackFunction("input_record", OnInputRecord);
+    g_theEventSystem->SubscribeEventCallbackFunction("input_record_stop", OnInputRecordStop);
+    g_theEventSystem->SubscribeEventCallbackFunction("replay_benchmark", OnReplayBenchmark);
 
     m_gameClock                 = new Clock(Clock::GetSystemClock());
     m_screenCamera              = new Camera();
@@ -37,11 +70,22 @@ Game::Game()
     CreateLocalPlayer(0);
     CreateLocalPlayer(1);
     UpdateCurrentControllerId(0);
+
+    // Meshes baked by an earlier run; anything missing is baked when the definitions load.
+    PieceMeshCache::LoadFromFile(g_gameConfigBlackboard.GetValue("pieceMeshCachePath", ""));
 }
 
 //----------------------------------------------------------------------------------------------------
 Game::~Game()
 {
+    if (m_tournamentRunner != nullptr)
+    {
+        m_tournamentRunner->RequestStop();
+        m_tournamentThread.join();
+        GAME_SAFE_RELEASE(m_tournamentRunner);
+    }
+
+    PieceMeshCache::ClearAll();
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -49,11 +93,12 @@ void Game::Update()
 {
     Window::s_mainWindow->UpdateDimension();
     Window::s_mainWindow->UpdatePosition();
-    float const gameDeltaSeconds   = static_cast<float>(m_gameClock->GetDeltaSeconds());
-    float const systemDeltaSeconds = static_cast<float>(Clock::GetSystemClock().GetDeltaSeconds());
+    float const gameDeltaSeconds   = static_cast<float>(GetRecordedGameDeltaSeconds(m_gameClock->GetDeltaSeconds()));
+    float const systemDeltaSeconds = static_cast<float>(GetRecordedSystemDeltaSeconds(Clock::GetSystemClock().GetDeltaSeconds()));
 
     // #TODO: Select keyboard or controller
     UpdateEntities(gameDeltaSeconds, systemDeltaSeconds);
+    UpdateTournament();
 
     UpdateFromInput();
 }
@@ -73,6 +118,11 @@ void Game::Render() const
         RenderEntities();
         g_theRenderer->RenderEmissive();
     }
+    else if (m_gameState == eGameState::SPECTATE && m_spectatorScene != nullptr)
+    {
+        m_spectatorScene->Render(localPlayer->GetCamera()->GetPosition(), localPlayer->GetCamera()->GetOrientation());
+        g_theRenderer->RenderEmissive();
+    }
 
     g_theRenderer->EndCamera(*localPlayer->GetCamera());
 
@@ -96,6 +146,9 @@ void Game::Render() const
         // g_theRenderer->RenderEmissive();
     }
 
+    Vec2 const screenTopRight = m_screenCamera->GetOrthographicTopRight();
+    RenderProfilerOverlay(AABB2(Vec2(10.f, 60.f), Vec2(screenTopRight.x - 10.f, 60.f + PROFILER_OVERLAY_ROW_HEIGHT * 12.f)));
+    AddCounterOverlayText(Vec2(screenTopRight.x * 0.5f - 280.f, screenTopRight.y - 60.f));
 
     g_theRenderer->EndCamera(*m_screenCamera);
 
@@ -119,6 +172,18 @@ STATIC bool Game::OnGameStateChanged(EventArgs& args)
         PieceDefinition::ClearAllDefs();
         BoardDefinition::ClearAllDefs();
         GAME_SAFE_RELEASE(g_theGame->m_match);
+
+        // The spectate overview moved the current player's camera; put it back at its seat.
+        if (g_theGame->m_spectatorScene != nullptr)
+        {
+            PlayerController* player = g_theGame->GetCurrentPlayer();
+            int const         id     = player->GetControllerIndex();
+            player->SetControllerPosition(g_gameConfigBlackboard.GetValue(Stringf("playerControllerPosition%d", id), Vec3::ZERO));
+            player->SetControllerOrientation(g_gameConfigBlackboard.GetValue(Stringf("playerControllerOrientation%d", id), EulerAngles::ZERO));
+            player->m_worldCamera->SetPositionAndOrientation(player->m_position, player->m_orientation);
+        }
+
+        GAME_SAFE_RELEASE(g_theGame->m_spectatorScene);
         g_theGame->m_currentPlayerControllerId = 0;
     }
 
@@ -126,9 +191,23 @@ STATIC bool Game::OnGameStateChanged(EventArgs& args)
     {
         PieceDefinition::InitializeDefs("Data/Definitions/PieceDefinition.xml");
         BoardDefinition::InitializeDefs("Data/Definitions/BoardDefinition.xml");
+        PieceMeshCache::SaveToFile(g_gameConfigBlackboard.GetValue("pieceMeshCachePath", ""));
         g_theGame->m_match = new Match();
         g_theEventSystem->FireEvent("OnMatchInitialized");
     }
+    else if (newGameState == "SPECTATE")
+    {
+        PieceDefinition::InitializeDefs("Data/Definitions/PieceDefinition.xml");
+        BoardDefinition::InitializeDefs("Data/Definitions/BoardDefinition.xml");
+        PieceMeshCache::SaveToFile(g_gameConfigBlackboard.GetValue("pieceMeshCachePath", ""));
+        ImmediateRenderBackend immediateBackend;
+        g_theGame->m_spectatorScene = new SpectatorScene(g_theGame->m_spectatorBoardCount, g_theGame->m_spectatorSeed, immediateBackend);
+
+        PlayerController* player = g_theGame->GetCurrentPlayer();
+        player->SetControllerPosition(g_theGame->m_spectatorScene->GetOverviewCameraPosition());
+        player->SetControllerOrientation(g_theGame->m_spectatorScene->GetOverviewCameraOrientation());
+        player->m_worldCamera->SetPositionAndOrientation(player->m_position, player->m_orientation);
+    }
     else if (newGameState == "FINISHED")
     {
         int const         id     = g_theGame->m_currentPlayerControllerId;
@@ -140,6 +219,590 @@ STATIC bool Game::OnGameStateChanged(EventArgs& args)
     return true;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief headless_match count=100 maxPly=400 seed=0
+/// Plays random legal moves through HeadlessMatch, without touching the visual Match, and reports
+/// how the games ended and how fast the rules run.
+STATIC bool Game::OnHeadlessMatch(EventArgs& args)
+{
+    int const      matchCount = args.GetValue("count", 100);
+    int const      maxPly     = args.GetValue("maxPly", 400);
+    unsigned const seed       = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    std::mt19937            random(seed);
+    std::vector<sChessMove> legalMoves;
+    HeadlessMatch           match;
+    int                     resultCounts[MATCH_RESULT_COUNT] = {};
+    int                     totalPly                         = 0;
+    double const            startTime                        = GetCurrentTimeSeconds();
+
+    for (int matchIndex = 0; matchIndex < matchCount; ++matchIndex)
+    {
+        match.Reset(sChessPosition::GetStartingPosition());
+
+        while (!match.IsFinished() && static_cast<int>(match.GetMoveList().size()) < maxPly)
+        {
+            GenerateLegalMoves(match.GetPosition(), legalMoves);
+            match.SubmitMove(legalMoves[std::uniform_int_distribution<int>(0, static_cast<int>(legalMoves.size()) - 1)(random)]);
+        }
+
+        totalPly += static_cast<int>(match.GetMoveList().size());
+        ++resultCounts[static_cast<int>(match.GetResult())];
+    }
+
+    double const elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[HeadlessMatch] %d matches, %d plies in %.2f s (%.0f plies/s)", matchCount, totalPly, elapsedSeconds, elapsedSeconds > 0.0 ? totalPly / elapsedSeconds : 0.0));
+
+    for (int resultIndex = 0; resultIndex < MATCH_RESULT_COUNT; ++resultIndex)
+    {
+        eMatchResult const result = static_cast<eMatchResult>(resultIndex);
+        char const*        label  = result == eMatchResult::ONGOING ? "Stopped at maxPly" : GetMatchResultString(result);
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-32s %d", label, resultCounts[resultIndex]));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief tournament games=1000 threads=0 openings=Data/Openings/Openings.epd seed=0 candidateDepth=3 baselineDepth=2 base=10 increment=0.1 maxPly=400 elo0=0 elo1=5 alpha=0.05 beta=0.05 pgn=Tournament.pgn
+/// Starts playing the candidate AIController configuration against the baseline through
+/// TournamentRunner on a background thread, so the window keeps running; the score, Elo and
+/// throughput are reported once the SPRT decides, the suite runs out or tournament_stop is typed.
+/// candidateBook, baselineBook, candidateTablebase and baselineTablebase turn the probes off per side.
+/// openings is a FEN or EPD file and is required; it is cycled until games have been played.
+STATIC bool Game::OnTournament(EventArgs& args)
+{
+    if (g_theGame->IsTournamentRunning())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[Tournament] A tournament is already running. Type 'tournament_stop' to end it.");
+        return false;
+    }
+
+    // The tournament probes the tables from its own thread, and a finished generation opens new ones.
+    if (g_theTablebaseSubsystem != nullptr && g_theTablebaseSubsystem->IsGenerating())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[Tournament] Tablebases are still generating; start the tournament once they are done.");
+        return false;
+    }
+
+    sTournamentConfig config;
+    config.m_candidate.m_name           = "Candidate";
+    config.m_candidate.m_searchDepth    = args.GetValue("candidateDepth", 3);
+    config.m_candidate.m_useOpeningBook = args.GetValue("candidateBook", true);
+    config.m_candidate.m_useTablebase   = args.GetValue("candidateTablebase", true);
+    config.m_baseline.m_name            = "Baseline";
+    config.m_baseline.m_searchDepth     = args.GetValue("baselineDepth", 2);
+    config.m_baseline.m_useOpeningBook  = args.GetValue("baselineBook", true);
+    config.m_baseline.m_useTablebase    = args.GetValue("baselineTablebase", true);
+    config.m_chooseMove                 = &AIController::ChooseMove;
+    config.m_maxGameCount               = std::max(2, args.GetValue("games", 1000));
+    config.m_threadCount                = args.GetValue("threads", 0);
+    config.m_maxPly                     = args.GetValue("maxPly", 400);
+    config.m_baseSeconds                = args.GetValue("base", 10.f);
+    config.m_incrementSeconds           = args.GetValue("increment", 0.1f);
+    config.m_elo0                       = args.GetValue("elo0", 0.f);
+    config.m_elo1                       = args.GetValue("elo1", 5.f);
+    config.m_alpha                      = args.GetValue("alpha", 0.05f);
+    config.m_beta                       = args.GetValue("beta", 0.05f);
+    config.m_seed                       = static_cast<unsigned>(args.GetValue("seed", 0));
+    config.m_pgnPath                    = args.GetValue("pgn", "Tournament.pgn");
+
+    String const openingsPath = args.GetValue("openings", "Data/Openings/Openings.epd");
+
+    if (!TournamentRunner::LoadOpeningSuite(openingsPath, config.m_openings))
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Tournament] Could not open %s", openingsPath.c_str()));
+        return false;
+    }
+
+    if (config.m_openings.empty())
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Tournament] %s has no FEN or EPD positions; a tournament needs an opening suite.", openingsPath.c_str()));
+        return false;
+    }
+
+    g_theGame->m_tournamentRunner = new TournamentRunner(config);
+    g_theGame->m_isTournamentFinished.store(false, std::memory_order_relaxed);
+    g_theGame->m_tournamentThread = std::thread([game = g_theGame]()
+    {
+        game->m_tournamentResult = game->m_tournamentRunner->Run();
+        game->m_isTournamentFinished.store(true, std::memory_order_release);
+    });
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[Tournament] Playing up to %d games from %zu openings in the background. Type 'tournament_stop' to end it early.", config.m_maxGameCount, config.m_openings.size()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Ends the running tournament after the batch of games it is playing; the result is reported
+/// as usual.
+STATIC bool Game::OnTournamentStop(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (!g_theGame->IsTournamentRunning()) return false;
+
+    g_theGame->m_tournamentRunner->RequestStop();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Culls count random boxes scattered over a 200 m cube around player 0's starting view, frames
+/// times, and reports the time per frame and per box. Needs no match and draws nothing.
+STATIC bool Game::OnCullBenchmark(EventArgs& args)
+{
+    int const      boundsCount = args.GetValue("count", 10000);
+    int const      frameCount  = args.GetValue("frames", 100);
+    unsigned const seed        = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> positionDistribution(-100.f, 100.f);
+    std::uniform_real_distribution<float> extentDistribution(0.1f, 1.f);
+    FrustumCuller                         culler;
+
+    for (int boundsIndex = 0; boundsIndex < boundsCount; ++boundsIndex)
+    {
+        Vec3 const center(positionDistribution(random), positionDistribution(random), positionDistribution(random) * 0.1f);
+        Vec3 const halfExtents(extentDistribution(random), extentDistribution(random), extentDistribution(random));
+        culler.AddBounds(center, halfExtents);
+    }
+
+    Vec3 const        position    = g_gameConfigBlackboard.GetValue("playerControllerPosition0", Vec3::ZERO);
+    EulerAngles const orientation = g_gameConfigBlackboard.GetValue("playerControllerOrientation0", EulerAngles::ZERO);
+    sFrustum const    frustum     = sFrustum::MakePerspective(position, orientation, PLAYER_CAMERA_ASPECT, PLAYER_CAMERA_FOV_DEGREES, PLAYER_CAMERA_NEAR, PLAYER_CAMERA_FAR);
+    double const      startTime   = GetCurrentTimeSeconds();
+
+    for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+    {
+        culler.Cull(frustum);
+    }
+
+    double const elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+    double const frameSeconds   = frameCount > 0 ? elapsedSeconds / frameCount : 0.0;
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[CullBenchmark] %d bounds x %d frames: %.3f ms/frame, %.2f ns/bounds, %d visible, %d culled",
+                                                             boundsCount, frameCount, frameSeconds * 1000.0, boundsCount > 0 ? frameSeconds * 1e9 / boundsCount : 0.0, culler.GetVisibleCount(), culler.GetCulledCount()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Stand-in for a piece in tween_benchmark; an Actor with no behavior of its own.
+class TweenBenchmarkActor final : public Actor
+{
+public:
+    TweenBenchmarkActor() : Actor(nullptr) {}
+
+    void Update(float const deltaSeconds) override { UNUSED(deltaSeconds) }
+    void Render() const override {}
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief tween_benchmark count=10000 idle=0 frames=300 seed=0
+/// Keeps count tweens running at once between random squares of an 8x8 board, mixing slides, hops and
+/// sinks of 0.5 to 3 seconds, for frames simulated 60 Hz frames; each finished tween is restarted at
+/// once. idle more actors exist but never tween, which should not change the cost. Reports the time per
+/// frame and per tween, restarts included.
+STATIC bool Game::OnTweenBenchmark(EventArgs& args)
+{
+    int const      tweenCount = std::max(0, args.GetValue("count", 10000));
+    int const      idleCount  = std::max(0, args.GetValue("idle", 0));
+    int const      frameCount = args.GetValue("frames", 300);
+    unsigned const seed       = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    std::mt19937                          random(seed);
+    std::uniform_int_distribution<int>    coordsDistribution(0, 7);
+    std::uniform_int_distribution<int>    curveDistribution(0, static_cast<int>(eTweenCurve::HOP));
+    std::uniform_real_distribution<float> durationDistribution(0.5f, 3.f);
+    std::vector<TweenBenchmarkActor>      actors(tweenCount + idleCount);
+    TweenSystem                           tweenSystem;
+
+    auto const startTween = [&](Actor* actor)
+    {
+        Vec3 const startPosition(static_cast<float>(coordsDistribution(random)), static_cast<float>(coordsDistribution(random)), 0.f);
+        Vec3 const endPosition(static_cast<float>(coordsDistribution(random)), static_cast<float>(coordsDistribution(random)), 0.f);
+        tweenSystem.Start(actor, startPosition, endPosition, durationDistribution(random), static_cast<eTweenCurve>(curveDistribution(random)));
+    };
+
+    for (int actorIndex = 0; actorIndex < tweenCount; ++actorIndex)
+    {
+        startTween(&actors[actorIndex]);
+    }
+
+    float const  deltaSeconds  = 1.f / 60.f;
+    int          finishedCount = 0;
+    double const startTime     = GetCurrentTimeSeconds();
+
+    for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+    {
+        tweenSystem.Update(deltaSeconds);
+
+        for (Actor* actor : tweenSystem.GetFinishedActors())
+        {
+            startTween(actor);
+        }
+
+        finishedCount += static_cast<int>(tweenSystem.GetFinishedActors().size());
+    }
+
+    double const elapsedSeconds = GetCurrentTimeSeconds() - startTime;
+    double const frameSeconds   = frameCount > 0 ? elapsedSeconds / frameCount : 0.0;
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[TweenBenchmark] %d tweens (+%d idle actors) x %d frames: %.3f ms/frame, %.2f ns/tween, %d finished and restarted",
+                                                             tweenSystem.GetActiveCount(), idleCount, frameCount, frameSeconds * 1000.0, tweenCount > 0 ? frameSeconds * 1e9 / tweenCount : 0.0, finishedCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief timer_wheel_benchmark count=100000 span=60 seed=0
+/// Schedules count timers with random delays of up to span seconds, one in ten up to a hundred times
+/// that, cancels every thirteenth, and advances a TimerWheel by 60 Hz frames until none are left.
+/// Checks that each timer fired exactly once, on the tick its delay rounds up to, and that cancelled
+/// ones never fired; reports the cost of scheduling, of frames that fired timers, and of frames that
+/// had nothing due. Needs no match and draws nothing.
+STATIC bool Game::OnTimerWheelBenchmark(EventArgs& args)
+{
+    int const      timerCount  = std::max(0, args.GetValue("count", 100000));
+    float const    spanSeconds = args.GetValue("span", 60.f);
+    unsigned const seed        = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> delayDistribution(0.f, spanSeconds);
+    TimerWheel                            timerWheel;
+    std::vector<uint64_t>                 dueTicks(timerCount);
+    std::vector<uint64_t>                 firedTicks(timerCount, 0);
+    std::vector<int>                      fireCounts(timerCount, 0);
+    std::vector<sTimerHandle>             handles(timerCount);
+
+    double const scheduleStartTime = GetCurrentTimeSeconds();
+
+    for (int timerIndex = 0; timerIndex < timerCount; ++timerIndex)
+    {
+        float const  delaySeconds = delayDistribution(random) * (timerIndex % 10 == 0 ? 100.f : 1.f);
+        double const delayTicks   = std::ceil(static_cast<double>(delaySeconds) * TIMER_WHEEL_TICKS_PER_SECOND);
+
+        dueTicks[timerIndex] = timerWheel.GetCurrentTick() + std::max(static_cast<uint64_t>(delayTicks), static_cast<uint64_t>(1));
+        handles[timerIndex]  = timerWheel.Schedule(delaySeconds, [&timerWheel, &firedTicks, &fireCounts, timerIndex]
+        {
+            firedTicks[timerIndex] = timerWheel.GetCurrentTick();
+            ++fireCounts[timerIndex];
+        });
+    }
+
+    double const scheduleSeconds = GetCurrentTimeSeconds() - scheduleStartTime;
+
+    for (int timerIndex = 0; timerIndex < timerCount; timerIndex += 13)
+    {
+        timerWheel.Cancel(handles[timerIndex]);
+    }
+
+    float const deltaSeconds     = 1.f / 60.f;
+    int         firingFrameCount = 0;
+    int         idleFrameCount   = 0;
+    double      firingSeconds    = 0.0;
+    double      idleSeconds      = 0.0;
+
+    while (timerWheel.GetScheduledCount() > 0)
+    {
+        int const    scheduledCount = timerWheel.GetScheduledCount();
+        double const frameStartTime = GetCurrentTimeSeconds();
+
+        timerWheel.Advance(deltaSeconds);
+
+        double const frameSeconds = GetCurrentTimeSeconds() - frameStartTime;
+
+        if (timerWheel.GetScheduledCount() < scheduledCount)
+        {
+            firingSeconds += frameSeconds;
+            ++firingFrameCount;
+        }
+        else
+        {
+            idleSeconds += frameSeconds;
+            ++idleFrameCount;
+        }
+    }
+
+    int mismatchCount = 0;
+
+    for (int timerIndex = 0; timerIndex < timerCount; ++timerIndex)
+    {
+        bool const isCancelled = timerIndex % 13 == 0;
+
+        if (isCancelled ? fireCounts[timerIndex] != 0 : fireCounts[timerIndex] != 1 || firedTicks[timerIndex] != dueTicks[timerIndex]) ++mismatchCount;
+    }
+
+    g_theDevConsole->AddLine(mismatchCount == 0 ? DevConsole::INFO_MAJOR : DevConsole::ERROR, Stringf("[TimerWheelBenchmark] %d timers: %d mismatches, schedule %.1f ns/timer, %d firing frames %.3f us/frame, %d idle frames %.3f us/frame",
+                                                                                                     timerCount, mismatchCount, timerCount > 0 ? scheduleSeconds * 1e9 / timerCount : 0.0,
+                                                                                                     firingFrameCount, firingFrameCount > 0 ? firingSeconds * 1e6 / firingFrameCount : 0.0,
+                                                                                                     idleFrameCount, idleFrameCount > 0 ? idleSeconds * 1e6 / idleFrameCount : 0.0));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief spectate count=256 seed=0
+/// Leaves the current match, if any, and shows count boards playing random games. Esc returns to attract.
+STATIC bool Game::OnSpectate(EventArgs& args)
+{
+    g_theGame->m_spectatorBoardCount = args.GetValue("count", 256);
+    g_theGame->m_spectatorSeed       = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    if (g_theGame->m_gameState != eGameState::ATTRACT) g_theGame->ChangeGameState(eGameState::ATTRACT);
+
+    g_theGame->ChangeGameState(eGameState::SPECTATE);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief spectator_benchmark count=256 frames=300 seed=0
+/// Runs a SpectatorScene of count boards for frames simulated 60 Hz frames from its overview camera and
+/// reports the CPU cost per frame of each stage. Commands go to a RecordingRenderBackend with no
+/// forward target, so nothing is drawn; the piece buffers are still created and uploaded through the
+/// Renderer, since that is part of the cost being measured.
+STATIC bool Game::OnSpectatorBenchmark(EventArgs& args)
+{
+    int const      boardCount = args.GetValue("count", 256);
+    int const      frameCount = std::max(1, args.GetValue("frames", 300));
+    unsigned const seed       = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    // Outside a match or spectate session the definitions are not loaded; load them for the run only.
+    bool const isLoadingDefinitions = PieceDefinition::s_pieceDefinitions.empty();
+
+    if (isLoadingDefinitions)
+    {
+        PieceDefinition::InitializeDefs("Data/Definitions/PieceDefinition.xml");
+        BoardDefinition::InitializeDefs("Data/Definitions/BoardDefinition.xml");
+    }
+
+    double            updateSeconds  = 0.0;
+    double            cullSeconds    = 0.0;
+    double            rebuildSeconds = 0.0;
+    double            submitSeconds  = 0.0;
+    double            executeSeconds = 0.0;
+    double            worstSeconds   = 0.0;
+    int               drawCount      = 0;
+    int               rebuildCount   = 0;
+    int               visibleCount   = 0;
+    RenderCommandList commandList;
+
+    {
+        ImmediateRenderBackend immediateBackend;
+        SpectatorScene         scene(boardCount, seed, immediateBackend);
+        Vec3 const             cameraPosition    = scene.GetOverviewCameraPosition();
+        EulerAngles const      cameraOrientation = scene.GetOverviewCameraOrientation();
+
+        for (int frameIndex = 0; frameIndex < frameCount; ++frameIndex)
+        {
+            double const startTime = GetCurrentTimeSeconds();
+            scene.Update(1.f / 60.f);
+            double const updateEndTime = GetCurrentTimeSeconds();
+
+            scene.SubmitDraws(cameraPosition, cameraOrientation, commandList, immediateBackend);
+            drawCount += commandList.GetCommandCount();
+
+            double const           executeStartTime = GetCurrentTimeSeconds();
+            RecordingRenderBackend recordingBackend;
+            commandList.Execute(recordingBackend);
+            double const endTime = GetCurrentTimeSeconds();
+
+            sSpectatorFrameStatistics const& statistics = scene.GetFrameStatistics();
+            updateSeconds += updateEndTime - startTime;
+            cullSeconds += statistics.m_cullSeconds;
+            rebuildSeconds += statistics.m_rebuildSeconds;
+            submitSeconds += statistics.m_submitSeconds;
+            executeSeconds += endTime - executeStartTime;
+            worstSeconds = std::max(worstSeconds, endTime - startTime);
+            rebuildCount += statistics.m_rebuildCount;
+            visibleCount += statistics.m_visibleCount;
+        }
+    }
+
+    if (isLoadingDefinitions)
+    {
+        PieceDefinition::ClearAllDefs();
+        BoardDefinition::ClearAllDefs();
+    }
+
+    double const totalSeconds = updateSeconds + cullSeconds + rebuildSeconds + submitSeconds + executeSeconds;
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[SpectatorBenchmark] %d boards x %d frames: %.3f ms/frame average, %.3f ms worst (60 FPS budget 16.667 ms)",
+                                                             boardCount, frameCount, totalSeconds * 1000.0 / frameCount, worstSeconds * 1000.0));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Update %.3f | Cull %.3f | Rebuild %.3f | Submit %.3f | Execute %.3f ms/frame",
+                                                             updateSeconds * 1000.0 / frameCount, cullSeconds * 1000.0 / frameCount, rebuildSeconds * 1000.0 / frameCount, submitSeconds * 1000.0 / frameCount, executeSeconds * 1000.0 / frameCount));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %.1f visible boards, %.1f draws, %.2f rebuilds per frame",
+                                                             static_cast<double>(visibleCount) / frameCount, static_cast<double>(drawCount) / frameCount, static_cast<double>(rebuildCount) / frameCount));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief input_record
+/// Restarts the match and records every frame's input, clock deltas and camera pose until
+/// input_record_stop, so replay_benchmark can play the session back.
+STATIC bool Game::OnInputRecord(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (GetInputRecorderMode() == eInputRecorderMode::REPLAYING)
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[InputRecorder] A replay is running");
+        return true;
+    }
+
+    // A replay starts from a fresh match too, so both begin in the same position with the same camera.
+    if (g_theGame->m_gameState != eGameState::ATTRACT) g_theGame->ChangeGameState(eGameState::ATTRACT);
+
+    g_theGame->ChangeGameState(eGameState::MATCH);
+    StartInputRecording();
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, "[InputRecorder] Recording; save with input_record_stop file=InputRecording.bin");
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief input_record_stop file=InputRecording.bin
+/// Stops recording and writes the frames, with the position the match ended in.
+STATIC bool Game::OnInputRecordStop(EventArgs& args)
+{
+    String const filePath = args.GetValue("file", "InputRecording.bin");
+
+    if (GetInputRecorderMode() != eInputRecorderMode::RECORDING)
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[InputRecorder] Not recording; start with input_record");
+        return true;
+    }
+
+    uint64_t const finalZobristKey = g_theGame->m_match != nullptr ? g_theGame->m_match->GetChessPosition().GetZobristKey() : 0;
+
+    if (!StopInputRecording(filePath, finalZobristKey))
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[InputRecorder] Could not write %s", filePath.c_str()));
+        return true;
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[InputRecorder] Wrote %d frames to %s", GetInputFrameCount(), filePath.c_str()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Value below which fraction of the sorted samples fall, taking the nearest sample.
+static double GetPercentile(std::vector<double> const& sortedSamples,
+                            double const               fraction)
+{
+    if (sortedSamples.empty()) return 0.0;
+
+    size_t const index = static_cast<size_t>(fraction * static_cast<double>(sortedSamples.size() - 1) + 0.5);
+
+    return sortedSamples[index];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief replay_benchmark file=InputRecording.bin
+/// Restarts the match and replays a recording made with input_record as fast as it will run, with the
+/// recorded clock deltas, so every run simulates the same frames. Render commands and their buffer
+/// uploads go to a RecordingRenderBackend with no forward target, so nothing is drawn. Reports update
+/// and render submission percentiles per frame, and whether the match ended in the recorded position.
+STATIC bool Game::OnReplayBenchmark(EventArgs& args)
+{
+    String const filePath = args.GetValue("file", "InputRecording.bin");
+
+    if (GetInputRecorderMode() == eInputRecorderMode::RECORDING)
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[ReplayBenchmark] Stop the recording first with input_record_stop");
+        return true;
+    }
+
+    if (!StartInputReplay(filePath))
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[ReplayBenchmark] Could not load %s, or it was recorded by another build", filePath.c_str()));
+        return true;
+    }
+
+    if (g_theGame->m_gameState != eGameState::ATTRACT) g_theGame->ChangeGameState(eGameState::ATTRACT);
+
+    g_theGame->ChangeGameState(eGameState::MATCH);
+
+    int const              frameCount = GetInputFrameCount();
+    std::vector<double>    updateSeconds;
+    std::vector<double>    renderSeconds;
+    std::vector<double>    frameSeconds;
+    int                    callCount = 0;
+    RecordingRenderBackend nullBackend;
+
+    updateSeconds.reserve(frameCount);
+    renderSeconds.reserve(frameCount);
+    frameSeconds.reserve(frameCount);
+
+    while (!IsInputReplayFinished())
+    {
+        InputRecorderBeginFrame();
+
+        double const startTime = GetCurrentTimeSeconds();
+        g_theGame->Update();
+        double const updateEndTime = GetCurrentTimeSeconds();
+
+        if (g_theGame->m_match != nullptr) g_theGame->m_match->RenderHeadless(nullBackend);
+
+        double const endTime = GetCurrentTimeSeconds();
+
+        callCount += static_cast<int>(nullBackend.GetCalls().size());
+        nullBackend.Clear();
+
+        // Expires the frame's debug text, which would otherwise pile up for the whole replay.
+        DebugRenderEndFrame();
+
+        updateSeconds.push_back(updateEndTime - startTime);
+        renderSeconds.push_back(endTime - updateEndTime);
+        frameSeconds.push_back(endTime - startTime);
+    }
+
+    StopInputReplay();
+
+    double totalSeconds = 0.0;
+
+    for (double const seconds : frameSeconds)
+    {
+        totalSeconds += seconds;
+    }
+
+    std::sort(updateSeconds.begin(), updateSeconds.end());
+    std::sort(renderSeconds.begin(), renderSeconds.end());
+    std::sort(frameSeconds.begin(), frameSeconds.end());
+
+    int const divisor = std::max(1, frameCount);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[ReplayBenchmark] %d frames in %.3f s (%.0f frames/s), %.1f backend calls per frame",
+                                                             frameCount, totalSeconds, totalSeconds > 0.0 ? frameCount / totalSeconds : 0.0, static_cast<double>(callCount) / divisor));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Update  p50 %.3f | p95 %.3f | p99 %.3f ms",
+                                                             GetPercentile(updateSeconds, 0.5) * 1000.0, GetPercentile(updateSeconds, 0.95) * 1000.0, GetPercentile(updateSeconds, 0.99) * 1000.0));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Render  p50 %.3f | p95 %.3f | p99 %.3f ms",
+                                                             GetPercentile(renderSeconds, 0.5) * 1000.0, GetPercentile(renderSeconds, 0.95) * 1000.0, GetPercentile(renderSeconds, 0.99) * 1000.0));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Frame   p50 %.3f | p95 %.3f | p99 %.3f ms",
+                                                             GetPercentile(frameSeconds, 0.5) * 1000.0, GetPercentile(frameSeconds, 0.95) * 1000.0, GetPercentile(frameSeconds, 0.99) * 1000.0));
+
+    uint64_t const expectedZobristKey = GetInputReplayFinalZobristKey();
+    uint64_t const finalZobristKey    = g_theGame->m_match != nullptr ? g_theGame->m_match->GetChessPosition().GetZobristKey() : 0;
+
+    if (finalZobristKey == expectedZobristKey)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  Final position matches the recording (%016llx)", static_cast<unsigned long long>(finalZobristKey)));
+    }
+    else
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("  Replay diverged: final position %016llx, recorded %016llx", static_cast<unsigned long long>(finalZobristKey), static_cast<unsigned long long>(expectedZobristKey)));
+    }
+
+    return true;
+}
+
 eGameState Game::GetCurrentGameState() const
 {
     return m_gameState;
@@ -159,6 +822,7 @@ void Game::ChangeGameState(eGameState const newGameState)
     if (newGameState == eGameState::ATTRACT) args.SetValue("OnGameStateChanged", "ATTRACT");
     else if (newGameState == eGameState::MATCH) args.SetValue("OnGameStateChanged", "MATCH");
     else if (newGameState == eGameState::FINISHED) args.SetValue("OnGameStateChanged", "FINISHED");
+    else if (newGameState == eGameState::SPECTATE) args.SetValue("OnGameStateChanged", "SPECTATE");
 
     m_gameState = newGameState;
 
@@ -170,6 +834,13 @@ bool Game::IsFixedCameraMode() const
     return m_isFixedCameraMode;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief True from the tournament command until its result is reported.
+bool Game::IsTournamentRunning() const
+{
+    return m_tournamentRunner != nullptr;
+}
+
 PlayerController* Game::GetCurrentPlayer() const
 {
     for (PlayerController* m_localPlayerController : m_localPlayerControllerList)
@@ -188,60 +859,81 @@ void Game::UpdateFromInput()
 {
     PlayerController const* localPlayer = GetLocalPlayer(m_currentPlayerControllerId);
     UNUSED(localPlayer)
-    if (g_theInput->WasKeyJustPressed(NUMCODE_0))
+    if (WasRecordedKeyJustPressed(NUMCODE_0))
     {
         Window::s_mainWindow->SetWindowType(eWindowType::FULLSCREEN_CROP);
     }
-    if (g_theInput->WasKeyJustPressed(NUMCODE_1))
+    if (WasRecordedKeyJustPressed(NUMCODE_1))
     {
         Window::s_mainWindow->SetWindowType(eWindowType::WINDOWED);
     }
+    if (WasRecordedKeyJustPressed(KEYCODE_F8))
+    {
+        SetCounterOverlayVisible(!IsCounterOverlayVisible());
+    }
+    if (WasRecordedKeyJustPressed(KEYCODE_F9))
+    {
+        SetProfilerOverlayVisible(!IsProfilerOverlayVisible());
+    }
     if (m_gameState == eGameState::ATTRACT)
     {
-        if (g_theInput->WasKeyJustPressed(KEYCODE_ESC))
+        if (WasRecordedKeyJustPressed(KEYCODE_ESC))
         {
             App::RequestQuit();
         }
 
-        if (g_theInput->WasKeyJustPressed(KEYCODE_SPACE))
+        if (WasRecordedKeyJustPressed(KEYCODE_SPACE))
         {
             ChangeGameState(eGameState::MATCH);
         }
     }
 
+    if (m_gameState == eGameState::SPECTATE && m_spectatorScene != nullptr)
+    {
+        if (WasRecordedKeyJustPressed(KEYCODE_ESC))
+        {
+            ChangeGameState(eGameState::ATTRACT);
+            return;
+        }
+
+        sSpectatorFrameStatistics const& statistics = m_spectatorScene->GetFrameStatistics();
+        double const                     cpuSeconds = statistics.m_cullSeconds + statistics.m_rebuildSeconds + statistics.m_submitSeconds;
+        DebugAddMessage(Stringf("Boards=%d|Visible=%d|Rebuilt=%d|Stale=%d|SubmitCPU=%.2fms", m_spectatorScene->GetBoardCount(), statistics.m_visibleCount, statistics.m_rebuildCount, statistics.m_staleCount, cpuSeconds * 1000.0), 0.f, Rgba8::YELLOW);
+    }
+
     if (m_gameState == eGameState::MATCH ||
         m_gameState == eGameState::FINISHED)
     {
-        if (g_theInput->WasKeyJustPressed(KEYCODE_ESC))
+        if (WasRecordedKeyJustPressed(KEYCODE_ESC))
         {
             ChangeGameState(eGameState::ATTRACT);
         }
 
-        if (g_theInput->WasKeyJustPressed(KEYCODE_P))
+        if (WasRecordedKeyJustPressed(KEYCODE_P))
         {
             m_gameClock->TogglePause();
         }
 
-        if (g_theInput->WasKeyJustPressed(KEYCODE_O))
+        if (WasRecordedKeyJustPressed(KEYCODE_O))
         {
             m_gameClock->StepSingleFrame();
         }
 
-        if (g_theInput->IsKeyDown(KEYCODE_T))
+        if (IsRecordedKeyDown(KEYCODE_T))
         {
             m_gameClock->SetTimeScale(0.1f);
         }
 
-        if (g_theInput->WasKeyJustReleased(KEYCODE_T))
+        if (WasRecordedKeyJustReleased(KEYCODE_T))
         {
             m_gameClock->SetTimeScale(1.f);
         }
 
-        if (g_theInput->WasKeyJustPressed(KEYCODE_F6))
+        if (WasRecordedKeyJustPressed(KEYCODE_F6))
         {
             m_currentDebugInt = (m_currentDebugInt + (int)m_currentDebugIntRange.m_max) % (static_cast<int>(m_currentDebugIntRange.GetLength()) + 1);
         }
-        if (g_theInput->WasKeyJustPressed(KEYCODE_F7))
+        if (WasRecordedKeyJustPressed(KEYCODE_F7))
         {
             m_currentDebugInt = (m_currentDebugInt + (int)m_currentDebugIntRange.m_min + 1) % (static_cast<int>(m_currentDebugIntRange.GetLength()) + 1);
         }
@@ -250,7 +942,7 @@ void Game::UpdateFromInput()
 
         DebugAddMessage(Stringf("DebugInt=%d|RenderMode=%s", m_currentDebugInt, GetDebugIntString(m_currentDebugInt)), 0.f, Rgba8::YELLOW);
 
-        if (g_theInput->WasKeyJustPressed(KEYCODE_F4))
+        if (WasRecordedKeyJustPressed(KEYCODE_F4))
         {
             m_isFixedCameraMode = !m_isFixedCameraMode;
 
@@ -276,7 +968,12 @@ void Game::UpdateFromInput()
 //----------------------------------------------------------------------------------------------------
 void Game::UpdateEntities(float const gameDeltaSeconds, float const systemDeltaSeconds) const
 {
-    UNUSED(gameDeltaSeconds)
+    if (m_spectatorScene != nullptr)
+    {
+        m_spectatorScene->Update(gameDeltaSeconds);
+        GetLocalPlayer(m_currentPlayerControllerId)->Update(systemDeltaSeconds);
+    }
+
     if (m_match == nullptr) return;
     m_match->Update();
     GetLocalPlayer(m_currentPlayerControllerId)->Update(systemDeltaSeconds);
@@ -287,6 +984,35 @@ void Game::UpdateCurrentControllerId(int const newID)
     m_currentPlayerControllerId = newID;
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Reports the background tournament once its thread has finished.
+void Game::UpdateTournament()
+{
+    if (m_tournamentRunner == nullptr || !m_isTournamentFinished.load(std::memory_order_acquire)) return;
+
+    m_tournamentThread.join();
+    GAME_SAFE_RELEASE(m_tournamentRunner);
+
+    sTournamentResult const& result = m_tournamentResult;
+
+    char const* decision = "undecided";
+    if (result.m_decision == eSprtDecision::ACCEPT_H1) decision = "H1 accepted";
+    else if (result.m_decision == eSprtDecision::ACCEPT_H0) decision = "H0 accepted";
+
+    double const gamesPerHour = result.m_elapsedSeconds > 0.0 ? result.m_gameCount * 3600.0 / result.m_elapsedSeconds : 0.0;
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Tournament] %d games, +%d =%d -%d, Elo %+.1f +/- %.1f, LLR %.2f [%.2f, %.2f] %s",
+                                                             result.m_gameCount, result.m_winCount, result.m_drawCount, result.m_lossCount, result.m_elo, result.m_eloError, result.m_llr, result.m_lowerBound, result.m_upperBound, decision));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %d threads, %.2f s: %.0f games/h, %.0f games/h per core, %.1f plies/game",
+                                                             result.m_threadCount, result.m_elapsedSeconds, gamesPerHour, gamesPerHour / std::max(1, result.m_threadCount), static_cast<double>(result.m_totalPly) / std::max(1, result.m_gameCount)));
+
+    for (int terminationIndex = 0; terminationIndex < TOURNAMENT_TERMINATION_COUNT; ++terminationIndex)
+    {
+        char const* label = TournamentRunner::GetTerminationString(static_cast<eTournamentTermination>(terminationIndex));
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("  %-32s %d", label, result.m_terminationCounts[terminationIndex]));
+    }
+}
+
 //----------------------------------------------------------------------------------------------------
 void Game::RenderAttractMode() const
 {
@@ -302,6 +1028,8 @@ void Game::RenderAttractMode() const
     g_theRenderer->BindTexture(nullptr);
     g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
     g_theRenderer->DrawVertexArray(verts);
+    RecordRenderUpload(verts.size() * sizeof(Vertex_PCU));
+    RecordRenderDraw();
 
     std::vector<std::string> asciiArt = {
 
@@ -4,17 +4,21 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <atomic>
 #include <cstdint>
+#include <thread>
 
 #include "Engine/Core/EventSystem.hpp"
 #include "Engine/Math/AABB2.hpp"
 #include "Engine/Math/FloatRange.hpp"
+#include "Game/Framework/TournamentRunner.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Camera;
 class Clock;
 class Match;
 class PlayerController;
+class SpectatorScene;
 
 //----------------------------------------------------------------------------------------------------
 enum class eGameState : uint8_t
@@ -23,7 +27,8 @@ enum class eGameState : uint8_t
     LOBBY,
     MATCH,
     FINISHED,
-    PAUSED
+    PAUSED,
+    SPECTATE
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -37,19 +42,33 @@ public:
     void Render() const;
 
     static bool OnGameStateChanged(EventArgs& args);
+    static bool OnHeadlessMatch(EventArgs& args);
+    static bool OnTournament(EventArgs& args);
+    static bool OnTournamentStop(EventArgs& args);
+    static bool OnCullBenchmark(EventArgs& args);
+    static bool OnTweenBenchmark(EventArgs& args);
+    static bool OnTimerWheelBenchmark(EventArgs& args);
+    static bool OnSpectate(EventArgs& args);
+    static bool OnSpectatorBenchmark(EventArgs& args);
+    static bool OnInputRecord(EventArgs& args);
+    static bool OnInputRecordStop(EventArgs& args);
+    static bool OnReplayBenchmark(EventArgs& args);
 
     eGameState        GetCurrentGameState() const;
     int               GetCurrentPlayerControllerId() const;
     void              TogglePlayerControllerId();
     void              ChangeGameState(eGameState newGameState);
     bool              IsFixedCameraMode() const;
+    bool              IsTournamentRunning() const;
     PlayerController* GetCurrentPlayer() const;
-    Match*            m_match = nullptr;
+    Match*            m_match          = nullptr;
+    SpectatorScene*   m_spectatorScene = nullptr;
 
 private:
     void              UpdateFromInput();
     void              UpdateEntities(float gameDeltaSeconds, float systemDeltaSeconds) const;
     void              UpdateCurrentControllerId(int newID);
+    void              UpdateTournament();
     void              RenderAttractMode() const;
     void              RenderEntities() const;
     PlayerController* CreateLocalPlayer(int id);
@@ -62,6 +81,12 @@ private:
     std::vector<PlayerController*> m_localPlayerControllerList;
     int                            m_currentPlayerControllerId = -1;
     bool                           m_isFixedCameraMode         = false;
+    int                            m_spectatorBoardCount       = 256;   // Set by the spectate command
+    unsigned                       m_spectatorSeed             = 0;
+    TournamentRunner*              m_tournamentRunner          = nullptr;
+    std::thread                    m_tournamentThread;
+    std::atomic<bool>              m_isTournamentFinished      = false;
+    sTournamentResult              m_tournamentResult;                      // Written by m_tournamentThread before it sets m_isTournamentFinished
     int                            m_currentDebugInt           = 0;
     FloatRange                     m_currentDebugIntRange      = FloatRange(0.f, 26.f);
     std::string m_playerName = "Player";  // 預設玩家名稱
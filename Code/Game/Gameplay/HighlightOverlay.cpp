@@ -0,0 +1,161 @@
+//----------------------------------------------------------------------------------------------------
+// HighlightOverlay.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/HighlightOverlay.hpp"
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Gameplay/Board.hpp"
+#include "Game/Gameplay/Piece.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Without a Renderer the wireframes are drawn with whatever shader is bound, as on a headless host.
+HighlightOverlay::HighlightOverlay(RenderBackend& backend)
+{
+    if (g_theRenderer != nullptr) m_shader = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default");
+
+    BuildPieceMesh(backend);
+}
+
+//----------------------------------------------------------------------------------------------------
+HighlightOverlay::~HighlightOverlay()
+{
+    GAME_SAFE_RELEASE(m_squareVertexBuffer);
+    GAME_SAFE_RELEASE(m_squareIndexBuffer);
+    GAME_SAFE_RELEASE(m_pieceVertexBuffer);
+    GAME_SAFE_RELEASE(m_pieceIndexBuffer);
+}
+
+//----------------------------------------------------------------------------------------------------
+void HighlightOverlay::Render(Board const&               board,
+                              std::vector<Piece*> const& pieces,
+                              RenderCommandList&         commandList,
+                              RenderBackend&             backend)
+{
+    // Match fills the square list after the Board is constructed, so the boxes are built on first use.
+    int const squareCount = static_cast<int>(board.m_squareInfoList.size());
+
+    if (static_cast<int>(m_squareFirstVertexes.size()) != squareCount + 1) BuildSquareMesh(board, backend);
+
+    m_litSquares.clear();
+
+    for (int squareIndex = 0; squareIndex < squareCount; ++squareIndex)
+    {
+        sSquareInfo const& info = board.m_squareInfoList[squareIndex];
+
+        if (info.m_isSelected || info.m_isHighlighted) m_litSquares.push_back(squareIndex);
+    }
+
+    if (m_litSquares != m_uploadedLitSquares) RebuildSquareIndexes(backend);
+
+    sRenderState state;
+    state.m_shader = m_shader;
+
+    // The boxes are in board space, like the squares themselves.
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, board.GetModelToWorldTransform(), board.m_color, m_squareVertexBuffer, m_squareIndexBuffer, m_squareIndexCount);
+
+    for (Piece const* piece : pieces)
+    {
+        if (piece == nullptr || piece->m_isCaptured || !piece->m_isVisible) continue;
+        if (!piece->m_isHighlighted && !piece->m_isSelected) continue;
+
+        Mat44 modelToWorld;
+        modelToWorld.SetTranslation3D(piece->GetRenderPosition());
+
+        commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, modelToWorld, Rgba8::WHITE, m_pieceVertexBuffer, m_pieceIndexBuffer, m_pieceIndexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void HighlightOverlay::BuildSquareMesh(Board const&   board,
+                                       RenderBackend& backend)
+{
+    VertexList_PCU verts;
+
+    m_squareFirstVertexes.clear();
+
+    for (sSquareInfo const& info : board.m_squareInfoList)
+    {
+        m_squareFirstVertexes.push_back(static_cast<int>(verts.size()));
+        AddVertsForWireframeAABB3D(verts, board.GetAABB3FromCoords(info.m_coords, 0.2f), 0.01f);
+    }
+
+    m_squareFirstVertexes.push_back(static_cast<int>(verts.size()));
+
+    GAME_SAFE_RELEASE(m_squareVertexBuffer);
+
+    if (m_squareIndexBuffer == nullptr) m_squareIndexBuffer = backend.CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+
+    size_t const vertexBytes = verts.size() * sizeof(Vertex_PCU);
+
+    m_squareVertexBuffer = backend.CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
+    backend.CopyCPUToGPU(verts.data(), static_cast<unsigned int>(vertexBytes), m_squareVertexBuffer);
+    RecordRenderUpload(vertexBytes);
+
+    // Force the index list to be rewritten against the new boxes.
+    m_uploadedLitSquares.clear();
+    m_uploadedLitSquares.push_back(-1);
+}
+
+//----------------------------------------------------------------------------------------------------
+void HighlightOverlay::BuildPieceMesh(RenderBackend& backend)
+{
+    VertexList_PCU verts;
+    AddVertsForWireframeCylinder3D(verts, Vec3::ZERO, Vec3::Z_BASIS, 0.25f, 0.005f);
+
+    IndexList indexes;
+    indexes.reserve(verts.size());
+
+    for (unsigned int index = 0; index < static_cast<unsigned int>(verts.size()); ++index)
+    {
+        indexes.push_back(index);
+    }
+
+    size_t const vertexBytes = verts.size() * sizeof(Vertex_PCU);
+    size_t const indexBytes  = indexes.size() * sizeof(unsigned int);
+
+    m_pieceVertexBuffer = backend.CreateVertexBuffer(sizeof(Vertex_PCU), sizeof(Vertex_PCU));
+    m_pieceIndexBuffer  = backend.CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+    backend.CopyCPUToGPU(verts.data(), static_cast<unsigned int>(vertexBytes), m_pieceVertexBuffer);
+    backend.CopyCPUToGPU(indexes.data(), static_cast<unsigned int>(indexBytes), m_pieceIndexBuffer);
+    RecordRenderUpload(vertexBytes + indexBytes);
+
+    m_pieceIndexCount = static_cast<unsigned int>(indexes.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Lists the vertex ranges of the lit squares' boxes. Only indexes are written; the boxes
+/// themselves never move.
+void HighlightOverlay::RebuildSquareIndexes(RenderBackend& backend)
+{
+    m_scratchIndexes.clear();
+
+    for (int const squareIndex : m_litSquares)
+    {
+        int const firstVertex = m_squareFirstVertexes[squareIndex];
+        int const endVertex   = m_squareFirstVertexes[squareIndex + 1];
+
+        for (int vertexIndex = firstVertex; vertexIndex < endVertex; ++vertexIndex)
+        {
+            m_scratchIndexes.push_back(static_cast<unsigned int>(vertexIndex));
+        }
+    }
+
+    m_uploadedLitSquares = m_litSquares;
+    m_squareIndexCount   = static_cast<unsigned int>(m_scratchIndexes.size());
+
+    if (m_squareIndexCount == 0) return;
+
+    size_t const indexBytes = m_scratchIndexes.size() * sizeof(unsigned int);
+
+    backend.CopyCPUToGPU(m_scratchIndexes.data(), static_cast<unsigned int>(indexBytes), m_squareIndexBuffer);
+    RecordRenderUpload(indexBytes);
+}
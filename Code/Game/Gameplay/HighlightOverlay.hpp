@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// HighlightOverlay.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Renderer/VertexUtils.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Board;
+class IndexBuffer;
+class Piece;
+class RenderBackend;
+class RenderCommandList;
+class Shader;
+class VertexBuffer;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Draws the selection and highlight wireframes of squares and pieces from prebuilt GPU meshes.
+/// Every square's wireframe box lives in one static vertex buffer; the index buffer lists the boxes
+/// that are lit and is rewritten only when that set changes, so the squares cost one draw and no
+/// upload per frame however many are highlighted. Pieces share one wireframe cylinder drawn with a
+/// per-piece translation. Buffers are created and uploaded through the RenderBackend handed in, like
+/// Board's.
+class HighlightOverlay
+{
+public:
+    explicit HighlightOverlay(RenderBackend& backend);
+    ~HighlightOverlay();
+
+    void Render(Board const& board, std::vector<Piece*> const& pieces, RenderCommandList& commandList, RenderBackend& backend);
+
+private:
+    void BuildSquareMesh(Board const& board, RenderBackend& backend);
+    void BuildPieceMesh(RenderBackend& backend);
+    void RebuildSquareIndexes(RenderBackend& backend);
+
+    Shader const* m_shader = nullptr; // Looked up once instead of per draw
+
+    VertexBuffer*     m_squareVertexBuffer = nullptr;
+    IndexBuffer*      m_squareIndexBuffer  = nullptr;
+    unsigned int      m_squareIndexCount   = 0;
+    std::vector<int>  m_squareFirstVertexes;      // One entry per square, plus the end of the last box
+    std::vector<int>  m_litSquares;               // Gathered this frame
+    std::vector<int>  m_uploadedLitSquares;       // Listed in m_squareIndexBuffer
+    IndexList         m_scratchIndexes;
+
+    VertexBuffer* m_pieceVertexBuffer = nullptr;
+    IndexBuffer*  m_pieceIndexBuffer  = nullptr;
+    unsigned int  m_pieceIndexCount   = 0;
+};
@@ -5,6 +5,8 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Gameplay/Match.hpp"
 
+#include <algorithm>
+
 #include "Engine/Core/DevConsole.hpp"
 #include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Input/InputSystem.hpp"
@@ -16,13 +18,36 @@
 #include "Engine/Renderer/Renderer.hpp"
 #include "Game/Definition/BoardDefinition.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Framework/AllocationTracker.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/CounterRegistry.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/InputRecorder.hpp"
 #include "Game/Framework/MatchCommon.hpp"
 #include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
 #include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/HighlightOverlay.hpp"
 #include "Game/Gameplay/Piece.hpp"
+#include "Game/Gameplay/PieceBatchRenderer.hpp"
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
 
+//----------------------------------------------------------------------------------------------------
+STATIC bool Match::s_isRenderCaptureRequested = false;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Board coords run from (1, 1) to (8, 8); returns -1 off the board.
+static int GetSquareIndexFromCoords(IntVec2 const& coords)
+{
+    if (coords.x < 1 || coords.x > CHESS_BOARD_SIZE || coords.y < 1 || coords.y > CHESS_BOARD_SIZE) return -1;
+
+    return (coords.y - 1) * CHESS_BOARD_SIZE + (coords.x - 1);
+}
+
 //----------------------------------------------------------------------------------------------------
 Match::Match()
 {
@@ -31,16 +56,18 @@ Match::Match()
     g_theEventSystem->SubscribeEventCallbackFunction("OnEnterMatchTurn", OnEnterMatchTurn);
     g_theEventSystem->SubscribeEventCallbackFunction("OnExitMatchTurn", OnExitMatchTurn);
     g_theEventSystem->SubscribeEventCallbackFunction("OnMatchInitialized", OnMatchInitialized);
+    g_theEventSystem->SubscribeEventCallbackFunction("render_capture", OnRenderCapture);
 
     CreateScreenCamera();
     CreateGameClock();
     CreateBoard();
 
-    for (PieceDefinition* pieceDef : PieceDefinition::s_pieceDefinitions)
-    {
-        pieceDef->CreateMeshByID(0);
-        pieceDef->CreateMeshByID(1);
-    }
+    ImmediateRenderBackend immediateBackend;
+
+    m_pieceBatchRenderer = m_arena.New<PieceBatchRenderer>();
+    m_renderCommandList  = m_arena.New<RenderCommandList>();
+    m_highlightOverlay   = m_arena.New<HighlightOverlay>(immediateBackend);
+    m_frustumCuller      = m_arena.New<FrustumCuller>();
 
     for (BoardDefinition const* boardDef : BoardDefinition::s_boardDefinitions)
     {
@@ -50,13 +77,15 @@ Match::Match()
 
             if (squareInfo.m_name == "DEFAULT") continue;
 
-            Piece* piece         = new Piece(this, squareInfo);
+            Piece* piece         = m_piecePool.Acquire(this, squareInfo);
             piece->m_orientation = boardDef->m_pieceOrientation;
             piece->m_color       = boardDef->m_pieceColor;
             m_pieceList.push_back(piece);
         }
     }
 
+    m_zobristHistory.Reset(GetChessPosition().GetZobristKey());
+
 #if defined DEBUG_MODE
     DebugAddWorldBasis(Mat44(), -1.f);
 
@@ -77,37 +106,53 @@ Match::Match()
 Match::~Match()
 {
     GAME_SAFE_RELEASE(m_screenCamera);
-    GAME_SAFE_RELEASE(m_board);
 
-    m_pendingRemovals.clear();
+    m_timerWheel.Clear();
+    m_tweenSystem.Clear();
 
-    for (int i = 0; i < static_cast<int>(m_pieceList.size()); ++i)
+    for (Piece* piece : m_pieceList)
     {
-        GAME_SAFE_RELEASE(m_pieceList[i]);
+        m_piecePool.Release(piece);
     }
 
     m_pieceList.clear();
+
+    // Everything else came from the arena and goes in one shot.
+    m_arena.Reset();
+    m_board              = nullptr;
+    m_pieceBatchRenderer = nullptr;
+    m_renderCommandList  = nullptr;
+    m_highlightOverlay   = nullptr;
+    m_frustumCuller      = nullptr;
 }
 
 void Match::Update()
 {
-    float const deltaSeconds = static_cast<float>(m_gameClock->GetDeltaSeconds());
+    PROFILE_SCOPE("Match::Update");
+    ALLOCATION_SCOPE("Match::Update");
 
-    DebugAddScreenText(Stringf("Time: %.2f\nFPS: %.2f\nScale: %.1f", m_gameClock->GetTotalSeconds(), 1.f / m_gameClock->GetDeltaSeconds(), m_gameClock->GetTimeScale()), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 60.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+    // The recorder's delta rather than the clock's, so a replay steps the simulation as the recording did.
+    double const frameSeconds = GetRecordedGameDeltaSeconds(m_gameClock->GetDeltaSeconds());
+    float const  deltaSeconds = static_cast<float>(frameSeconds);
 
-    // 更新延遲移除系統
-    UpdatePendingRemovals(deltaSeconds);
+    // Formatting the HUD allocates, and so does handing text to the debug renderer, so it is left off
+    // while frames are asserted to allocate nothing.
+    if (!IsZeroAllocationAssertEnabled()) AddHudText();
 
     UpdateFromInput(deltaSeconds);
 
-    m_board->Update(deltaSeconds);
+    // Game clock time, so pausing or scaling the clock pauses or scales the simulation too.
+    int const stepCount = m_fixedTimestep.Accumulate(frameSeconds);
 
-    for (Piece* piece : m_pieceList)
+    for (int stepIndex = 0; stepIndex < stepCount; ++stepIndex)
     {
-        if (piece == nullptr) continue;
-        piece->Update(deltaSeconds);
+        UpdateSimulation(m_fixedTimestep.GetStepSeconds());
     }
 
+    // Everything below is hover picking: selection lookup, then raycasts against every square and piece.
+    PROFILE_SCOPE("Match::Picking");
+    ALLOCATION_SCOPE("Match::Picking");
+
     // 檢查是否有任何 piece 或 board square 被選中
     bool hasAnySelection = false;
     // Piece*  selectedPiece        = nullptr;
@@ -173,6 +218,8 @@ void Match::Update()
         m_ghostSourcePiece = nullptr;
 
         // Check board AABBs for raycast
+        COUNTER_ADD("RaycastVsAABB3D", static_cast<uint32_t>(m_board->m_squareInfoList.size()));
+
         for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
         {
             RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
@@ -257,6 +304,8 @@ void Match::Update()
         bool   foundImpact      = false;
 
         // Check board AABBs
+        COUNTER_ADD("RaycastVsAABB3D", static_cast<uint32_t>(m_board->m_squareInfoList.size()));
+
         for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
         {
             RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
@@ -278,6 +327,8 @@ void Match::Update()
             // 跳過被捕獲的棋子和正在被捕獲的棋子
             if (piece->m_isCaptured || piece->m_isBeingCaptured) continue;
 
+            COUNTER_INCREMENT("RaycastVsCylinderZ3D");
+
             RaycastResult3D result = RaycastVsCylinderZ3D(
                 currentPlayer->m_position,
                 currentPlayerForwardNormal,
@@ -339,34 +390,90 @@ void Match::Update()
     }
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Clock, render, culling, lighting and LOD counters in the top right, plus the allocation
+/// report while tracking is on. Every line is a fresh string each frame.
+void Match::AddHudText() const
+{
+    DebugAddScreenText(Stringf("Time: %.2f\nFPS: %.2f\nScale: %.1f\nSteps: %llu (%llu dropped)", m_gameClock->GetTotalSeconds(), 1.f / m_gameClock->GetDeltaSeconds(), m_gameClock->GetTimeScale(), static_cast<unsigned long long>(m_fixedTimestep.GetStepCount()), static_cast<unsigned long long>(m_fixedTimestep.GetDroppedStepCount())), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 60.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    sRenderStatistics const&       renderStatistics  = GetLastFrameRenderStatistics();
+    sLightClusterStatistics const& clusterStatistics = g_theLightSubsystem->GetLightClusterGrid().GetStatistics();
+    DebugAddScreenText(Stringf("Draws: %d\nUploaded: %llu B (%d)\nBinds: %d\nState changes: %d\nSkipped: %d\nVisible: %d\nCulled: %d\nLight uploads: %d (%d skipped)\nClustered lights: %d (%.2f ms)", renderStatistics.m_drawCount, static_cast<unsigned long long>(renderStatistics.m_bytesUploaded), renderStatistics.m_uploadCount, renderStatistics.m_bindCount, renderStatistics.m_stateChangeCount, renderStatistics.m_skippedBindCount, renderStatistics.m_visibleCount, renderStatistics.m_culledCount, renderStatistics.m_lightUploadCount, renderStatistics.m_lightSkipCount, clusterStatistics.m_clusteredCount, clusterStatistics.m_buildSeconds * 1000.0), m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 250.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    String lodText;
+
+    for (int lodLevel = 0; lodLevel < PIECE_MESH_LOD_COUNT; ++lodLevel)
+    {
+        if (lodLevel > 0) lodText += "\n";
+        lodText += Stringf("LOD%d: %d pieces, %d tris", lodLevel, m_pieceBatchRenderer->GetLodInstanceCount(lodLevel), m_pieceBatchRenderer->GetLodTriangleCount(lodLevel));
+    }
+
+    DebugAddScreenText(lodText, m_screenCamera->GetOrthographicTopRight() - Vec2(250.f, 310.f), 20.f, Vec2::ZERO, 0.f, Rgba8::WHITE, Rgba8::WHITE);
+
+    if (IsAllocationTrackingEnabled())
+    {
+        DebugAddMessage(GetLastFrameAllocationReport(), 0.f, Rgba8::YELLOW);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief One fixed step of everything that must play out the same at any frame rate. Input, the HUD and
+/// selection still run once per frame in Update.
+void Match::UpdateSimulation(float const stepSeconds)
+{
+    PROFILE_SCOPE("Match::UpdateSimulation");
+    ALLOCATION_SCOPE("Match::UpdateSimulation");
+
+    m_timerWheel.Advance(stepSeconds);
+    m_board->Update(stepSeconds);
+    UpdateTweens(stepSeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Advances only the pieces that are moving or sinking; idle pieces are not visited.
+void Match::UpdateTweens(float const deltaSeconds)
+{
+    m_tweenSystem.Update(deltaSeconds);
+
+    for (Actor* actor : m_tweenSystem.GetFinishedActors())
+    {
+        static_cast<Piece*>(actor)->FinishTween();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
 void Match::UpdateFromInput(float const deltaSeconds)
 {
+    PROFILE_SCOPE("Match::UpdateFromInput");
+    ALLOCATION_SCOPE("Match::UpdateFromInput");
+
     UNUSED(deltaSeconds)
-    if (g_theInput->WasKeyJustPressed(KEYCODE_F2))
+    if (WasRecordedKeyJustPressed(KEYCODE_F2))
     {
         m_sunDirection.x -= 1.f;
-        g_theLightSubsystem->GetLight(2)->SetDirection(m_sunDirection);
+        g_theLightSubsystem->EditLight(2)->SetDirection(m_sunDirection);
         DebugAddMessage(Stringf("Sun Direction: (%.2f, %.2f, %.2f)", m_sunDirection.x, m_sunDirection.y, m_sunDirection.z), 5.f);
     }
 
-    if (g_theInput->WasKeyJustPressed(KEYCODE_F3))
+    if (WasRecordedKeyJustPressed(KEYCODE_F3))
     {
         m_sunDirection.x += 1.f;
-        g_theLightSubsystem->GetLight(2)->SetDirection(m_sunDirection);
+        g_theLightSubsystem->EditLight(2)->SetDirection(m_sunDirection);
         DebugAddMessage(Stringf("Sun Direction: (%.2f, %.2f, %.2f)", m_sunDirection.x, m_sunDirection.y, m_sunDirection.z), 5.f);
     }
 
-    if (g_theInput->WasKeyJustPressed(KEYCODE_CONTROL))
+    if (WasRecordedKeyJustPressed(KEYCODE_CONTROL))
     {
         m_isCheatMode = true;
     }
-    if (g_theInput->WasKeyJustReleased(KEYCODE_CONTROL))
+    if (WasRecordedKeyJustReleased(KEYCODE_CONTROL))
     {
         m_isCheatMode = false;
     }
 
     // 左鍵點擊處理
-    if (g_theInput->WasKeyJustPressed(KEYCODE_LEFT_MOUSE))
+    if (WasRecordedKeyJustPressed(KEYCODE_LEFT_MOUSE))
     {
         // 檢查是否有任何東西已經被選中
         bool    hasAnySelection      = false;
@@ -417,6 +524,8 @@ void Match::UpdateFromInput(float const deltaSeconds)
             bool  foundImpact      = false;
 
             // Check board AABBs for raycast
+            COUNTER_ADD("RaycastVsAABB3D", static_cast<uint32_t>(m_board->m_squareInfoList.size()));
+
             for (int i = 0; i < (int)m_board->m_squareInfoList.size(); ++i)
             {
                 RaycastResult3D const result = RaycastVsAABB3D(ray.m_startPosition, ray.m_forwardNormal, ray.m_maxLength,
@@ -523,7 +632,7 @@ void Match::UpdateFromInput(float const deltaSeconds)
     }
 
     // 右鍵點擊 - 用於取消選擇
-    if (g_theInput->WasKeyJustPressed(KEYCODE_RIGHT_MOUSE))
+    if (WasRecordedKeyJustPressed(KEYCODE_RIGHT_MOUSE))
     {
         // 清除所有選擇和 highlight
         for (sSquareInfo& info : m_board->m_squareInfoList)
@@ -546,22 +655,137 @@ void Match::UpdateFromInput(float const deltaSeconds)
 //----------------------------------------------------------------------------------------------------
 void Match::Render() const
 {
+    PROFILE_SCOPE("Match::Render");
+    ALLOCATION_SCOPE("Match::Render");
+
+    ImmediateRenderBackend immediateBackend;
+
+    SubmitRenderCommands(immediateBackend);
+    ExecuteRenderCommands();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Render with every upload and draw going to backend instead of the GPU; replay_benchmark uses it
+/// with a backend that draws nothing. Buffer creation and the shader and texture lookups still go
+/// through g_theRenderer, so it needs a Renderer, though not a frame's GPU work.
+void Match::RenderHeadless(RenderBackend& backend) const
+{
+    PROFILE_SCOPE("Match::RenderHeadless");
+
+    SubmitRenderCommands(backend);
+    m_renderCommandList->Execute(backend);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Culls, builds the light clusters and submits the whole frame to the RenderCommandList.
+/// backend takes the light cluster, piece batch and highlight uploads the submissions depend on.
+void Match::SubmitRenderCommands(RenderBackend& backend) const
+{
+    bool const    isGhostPieceVisible = CullActors();
+    Camera const* camera              = g_theGame->GetCurrentPlayer()->m_worldCamera;
+
+    g_theLightSubsystem->BuildLightClusters(camera->GetPosition(), camera->GetOrientation(), backend);
+
     m_board->Render();
 
+    // One draw per definition and side, then the selection and highlight wireframes.
+    m_pieceBatchRenderer->Render(m_pieceList, camera->GetPosition(), *m_renderCommandList, backend);
+    m_highlightOverlay->Render(*m_board, m_pieceList, *m_renderCommandList, backend);
+
+    // 渲染 ghost piece（如果需要的話）
+    if (m_showGhostPiece && m_ghostSourcePiece != nullptr && isGhostPieceVisible)
+    {
+        RenderGhostPiece();
+    }
+
+    RenderPlayerBasis();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Tests the board, the test model, every live piece and the ghost piece against the current
+/// player's view frustum and writes the results to their visibility flags. Returns whether the ghost
+/// piece is visible, since it borrows its source piece's Actor.
+bool Match::CullActors() const
+{
+    PROFILE_SCOPE("Match::CullActors");
+
+    Camera const*  camera  = g_theGame->GetCurrentPlayer()->m_worldCamera;
+    sFrustum const frustum = sFrustum::MakePerspective(camera->GetPosition(), camera->GetOrientation(), PLAYER_CAMERA_ASPECT, PLAYER_CAMERA_FOV_DEGREES, PLAYER_CAMERA_NEAR, PLAYER_CAMERA_FAR);
+
+    m_frustumCuller->Clear();
+
+    int const boardIndex     = m_frustumCuller->AddBounds(m_board->m_localBounds, m_board->GetModelToWorldTransform());
+    int const testModelIndex = m_frustumCuller->AddBounds(m_board->m_testModelLocalBounds, m_board->GetTestModelToWorldTransform());
+    int       ghostIndex     = -1;
+
     for (Piece const* piece : m_pieceList)
     {
-        if (piece == nullptr) continue;
+        if (piece == nullptr || piece->m_isCaptured) continue;
 
-        piece->Render();
+        m_frustumCuller->AddBounds(piece->m_localBounds, piece->GetModelToWorldTransform());
     }
 
-    // 渲染 ghost piece（如果需要的話）
     if (m_showGhostPiece && m_ghostSourcePiece != nullptr)
     {
-        RenderGhostPiece();
+        Mat44 ghostToWorld = m_ghostSourcePiece->GetModelToWorldTransform();
+        ghostToWorld.SetTranslation3D(m_ghostPiecePosition);
+        ghostIndex = m_frustumCuller->AddBounds(m_ghostSourcePiece->m_localBounds, ghostToWorld);
     }
 
-    RenderPlayerBasis();
+    m_frustumCuller->Cull(frustum);
+
+    m_board->m_isVisible          = m_frustumCuller->IsVisible(boardIndex);
+    m_board->m_isTestModelVisible = m_frustumCuller->IsVisible(testModelIndex);
+
+    // Pieces were added right after the board and the test model, in list order.
+    int boundsIndex = testModelIndex + 1;
+
+    for (Piece* piece : m_pieceList)
+    {
+        if (piece == nullptr || piece->m_isCaptured) continue;
+
+        piece->m_isVisible = m_frustumCuller->IsVisible(boundsIndex);
+        ++boundsIndex;
+    }
+
+    RecordRenderCulling(m_frustumCuller->GetVisibleCount(), m_frustumCuller->GetCulledCount());
+
+    return ghostIndex >= 0 && m_frustumCuller->IsVisible(ghostIndex);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Replays everything submitted this frame. After render_capture, the calls go through a
+/// RecordingRenderBackend too and the captured stream is printed to the DevConsole.
+void Match::ExecuteRenderCommands() const
+{
+    PROFILE_SCOPE("Match::ExecuteRenderCommands");
+
+    ImmediateRenderBackend immediateBackend;
+
+    if (!s_isRenderCaptureRequested)
+    {
+        m_renderCommandList->Execute(immediateBackend);
+        return;
+    }
+
+    s_isRenderCaptureRequested = false;
+
+    int const              commandCount = m_renderCommandList->GetCommandCount();
+    RecordingRenderBackend recordingBackend(&immediateBackend);
+    m_renderCommandList->Execute(recordingBackend);
+
+    int const callCount = static_cast<int>(recordingBackend.GetCalls().size());
+
+    for (int callIndex = 0; callIndex < callCount; ++callIndex)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, recordingBackend.GetCallString(callIndex));
+    }
+
+    int const drawCount = recordingBackend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) + recordingBackend.GetCallCount(eRenderCall::DRAW_VERTEX_ARRAY);
+    int const bindCount = recordingBackend.GetCallCount(eRenderCall::BIND_SHADER) + recordingBackend.GetCallCount(eRenderCall::BIND_TEXTURE);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("Captured %d commands: %d backend calls, %d draws, %d binds", commandCount, callCount, drawCount, bindCount));
 }
 
 // 新增 RenderGhostPiece 方法
@@ -571,22 +795,76 @@ void Match::RenderGhostPiece() const
 
     // 保存原始位置和渲染狀態
     Vec3 originalPosition      = m_ghostSourcePiece->m_position;
+    Vec3 originalPrevious      = m_ghostSourcePiece->m_previousPosition;
     bool originalIsSelected    = m_ghostSourcePiece->m_isSelected;
     bool originalIsHighlighted = m_ghostSourcePiece->m_isHighlighted;
 
     // 暫時修改棋子的位置和狀態用於 ghost 渲染
-    m_ghostSourcePiece->m_position      = m_ghostPiecePosition;
-    m_ghostSourcePiece->m_isSelected    = false;
-    m_ghostSourcePiece->m_isHighlighted = false;
+    m_ghostSourcePiece->m_position         = m_ghostPiecePosition;
+    m_ghostSourcePiece->m_previousPosition = m_ghostPiecePosition;
+    m_ghostSourcePiece->m_isSelected       = false;
+    m_ghostSourcePiece->m_isHighlighted    = false;
 
     // 渲染 ghost piece
     m_ghostSourcePiece->RenderTargetPiece();
 
 
     // 恢復原始位置和狀態
-    m_ghostSourcePiece->m_position      = originalPosition;
-    m_ghostSourcePiece->m_isSelected    = originalIsSelected;
-    m_ghostSourcePiece->m_isHighlighted = originalIsHighlighted;
+    m_ghostSourcePiece->m_position         = originalPosition;
+    m_ghostSourcePiece->m_previousPosition = originalPrevious;
+    m_ghostSourcePiece->m_isSelected       = originalIsSelected;
+    m_ghostSourcePiece->m_isHighlighted    = originalIsHighlighted;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Snapshots the board into a rules-only position for the opening book and AI.
+sChessPosition Match::GetChessPosition() const
+{
+    sChessPosition position;
+
+    for (sSquareInfo const& squareInfo : m_board->m_squareInfoList)
+    {
+        int const squareIndex = GetSquareIndexFromCoords(squareInfo.m_coords);
+        if (squareIndex < 0) continue;
+
+        ePieceType const type = GetPieceTypeFromName(squareInfo.m_name);
+        if (type == ePieceType::NONE) continue;
+
+        position.m_squares[squareIndex] = {type, static_cast<int8_t>(squareInfo.m_playerControllerId)};
+    }
+
+    position.m_sideToMove     = static_cast<int8_t>(g_theGame->GetCurrentPlayerControllerId());
+    position.m_halfMoveClock  = m_zobristHistory.GetHalfMoveClock();
+    position.m_fullMoveNumber = static_cast<int>(m_pieceMoveList.size()) / 2 + 1;
+    position.m_castlingRights = CASTLING_NONE;
+
+    // A side keeps a castling right while its king and that rook are both unmoved on their home squares.
+    auto const isUnmoved = [this](IntVec2 const& coords, ePieceType const type, int const playerId)
+    {
+        Piece const* piece = GetPieceByCoords(coords);
+        return piece != nullptr && !piece->m_hasMoved && !piece->m_isBeingCaptured && piece->m_id == playerId && piece->m_definition->m_type == type;
+    };
+
+    if (isUnmoved(IntVec2(5, 1), ePieceType::KING, 0))
+    {
+        if (isUnmoved(IntVec2(8, 1), ePieceType::ROOK, 0)) position.m_castlingRights |= CASTLING_FIRST_KINGSIDE;
+        if (isUnmoved(IntVec2(1, 1), ePieceType::ROOK, 0)) position.m_castlingRights |= CASTLING_FIRST_QUEENSIDE;
+    }
+
+    if (isUnmoved(IntVec2(5, 8), ePieceType::KING, 1))
+    {
+        if (isUnmoved(IntVec2(8, 8), ePieceType::ROOK, 1)) position.m_castlingRights |= CASTLING_SECOND_KINGSIDE;
+        if (isUnmoved(IntVec2(1, 8), ePieceType::ROOK, 1)) position.m_castlingRights |= CASTLING_SECOND_QUEENSIDE;
+    }
+
+    sPieceMove const lastMove = GetLastPieceMove();
+
+    if (lastMove.piece != nullptr && lastMove.piece->m_definition->m_type == ePieceType::PAWN && abs(lastMove.toCoords.y - lastMove.fromCoords.y) == 2)
+    {
+        position.m_enPassantSquare = static_cast<int8_t>(GetSquareIndexFromCoords(IntVec2(lastMove.fromCoords.x, (lastMove.fromCoords.y + lastMove.toCoords.y) / 2)));
+    }
+
+    return position;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -608,7 +886,9 @@ void Match::CreateGameClock()
 //----------------------------------------------------------------------------------------------------
 void Match::CreateBoard()
 {
-    m_board = new Board(this);
+    ImmediateRenderBackend immediateBackend;
+
+    m_board = m_arena.New<Board>(this, immediateBackend);
 }
 
 STATIC bool Match::OnEnterMatchState(EventArgs& args)
@@ -670,9 +950,6 @@ void Match::ExecuteCapture(IntVec2 const& fromCoords,
 
     if (toPiece == nullptr) return;
 
-    // 儲存被捕獲棋子的類型
-    ePieceType capturedPieceType = toPiece->m_definition->m_type;
-
     // 1. 立即更新棋盤狀態（將被捕獲棋子從棋盤上移除）
     if (IsValidPromotionType(promoteTo))
     {
@@ -684,86 +961,59 @@ void Match::ExecuteCapture(IntVec2 const& fromCoords,
     }
 
     // 2. 排程在動畫完成後移除被捕獲的棋子
-    SchedulePieceForRemoval(toPiece, 2.f, capturedPieceType);
+    SchedulePieceForRemoval(toPiece, PIECE_CAPTURE_SECONDS);
 
     // 3. 開始攻擊棋子的移動動畫
-    fromPiece->UpdatePositionByCoords(toCoords, 2.f);
+    fromPiece->UpdatePositionByCoords(toCoords, PIECE_MOVE_SECONDS);
     fromPiece->m_hasMoved = true;
 }
 
 void Match::RemovePieceFromPieceList(IntVec2 const& toCoords)
 {
-    for (auto it = m_pieceList.begin(); it != m_pieceList.end();)
+    for (Piece* piece : m_pieceList)
     {
-        Piece* piece = *it;
-
         if (piece->m_coords == toCoords)
         {
-            delete piece;
-
-            it = m_pieceList.erase(it);
-            break;
+            ReleasePiece(piece);
+            return;
         }
-
-        ++it;
     }
 }
 
-void Match::SchedulePieceForRemoval(Piece* piece, float delay, ePieceType capturedType)
+//----------------------------------------------------------------------------------------------------
+/// @brief Takes piece out of m_pieceList by swapping in the last entry, and returns it to the piece
+/// pool. Nothing depends on the list's order.
+void Match::ReleasePiece(Piece* piece)
 {
-    // 開始被捕獲動畫（下沉效果）
-    piece->StartCaptureAnimation(delay);
+    auto const it = std::find(m_pieceList.begin(), m_pieceList.end(), piece);
 
-    PendingRemoval removal;
-    removal.piece             = piece;
-    removal.remainingTime     = delay;
-    removal.capturedPieceType = capturedType;
-    m_pendingRemovals.push_back(removal);
-}
+    if (it == m_pieceList.end()) return;
 
-void Match::UpdatePendingRemovals(float deltaSeconds)
-{
-    for (auto it = m_pendingRemovals.begin(); it != m_pendingRemovals.end();)
-    {
-        it->remainingTime -= deltaSeconds;
+    *it = m_pieceList.back();
+    m_pieceList.pop_back();
 
-        if (it->remainingTime <= 0.f)
-        {
-            // 時間到了，移除棋子
-            Piece*     pieceToRemove = it->piece;
-            ePieceType capturedType  = it->capturedPieceType;
+    if (m_selectedPiece == piece) m_selectedPiece = nullptr;
+    if (m_ghostSourcePiece == piece) m_ghostSourcePiece = nullptr;
 
-            // 現在才標記為被捕獲（這樣它就不會渲染了）
-            pieceToRemove->m_isCaptured = true;
+    m_tweenSystem.Stop(piece);
+    m_piecePool.Release(piece);
+}
 
-            // 從棋子列表中移除
-            for (auto pieceIt = m_pieceList.begin(); pieceIt != m_pieceList.end(); ++pieceIt)
-            {
-                if (*pieceIt == pieceToRemove)
-                {
-                    delete pieceToRemove;
-                    m_pieceList.erase(pieceIt);
-                    break;
-                }
-            }
+//----------------------------------------------------------------------------------------------------
+/// @brief Sinks piece, then takes it off the board once delay seconds of game time have passed.
+void Match::SchedulePieceForRemoval(Piece* piece, float const delay)
+{
+    // 開始被捕獲動畫（下沉效果）
+    piece->StartCaptureAnimation(delay);
 
-            // 檢查是否捕獲了國王
-            if (capturedType == ePieceType::KING)
-            {
-                g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
-                g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[SYSTEM] Player #%d has won the match!", g_theGame->GetCurrentPlayerControllerId()));
-                g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
-                g_theGame->ChangeGameState(eGameState::FINISHED);
-            }
+    m_timerWheel.Schedule(delay, [this, piece]
+    {
+        // 現在才標記為被捕獲（這樣它就不會渲染了）
+        piece->m_isCaptured = true;
 
-            // 從待處理列表中移除
-            it = m_pendingRemovals.erase(it);
-        }
-        else
-        {
-            ++it;
-        }
-    }
+        // 從棋子列表中移除，放回棋子池
+        ReleasePiece(piece);
+    });
 }
 
 
@@ -773,7 +1023,36 @@ void Match::OnChessMove(IntVec2 const& fromCoords,
                         String const&  promoteTo,
                         bool const     isTeleport)
 {
-    if (ExecuteMove(fromCoords, toCoords, promoteTo, isTeleport)) g_theEventSystem->FireEvent("OnExitMatchTurn");
+    sChessMove const move           = {static_cast<int8_t>(GetSquareIndexFromCoords(fromCoords)), static_cast<int8_t>(GetSquareIndexFromCoords(toCoords))};
+    bool const       isIrreversible = move.IsValid() && IsZeroingMove(GetChessPosition(), move);
+
+    if (!ExecuteMove(fromCoords, toCoords, promoteTo, isTeleport)) return;
+
+    g_theEventSystem->FireEvent("OnExitMatchTurn");
+
+    m_zobristHistory.Push(GetChessPosition().GetZobristKey(), isIrreversible);
+
+    eMatchResult const result = EvaluateMatchResult(GetChessPosition(), m_zobristHistory);
+    if (result != eMatchResult::ONGOING) EndMatch(result);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Match::EndMatch(eMatchResult const result)
+{
+    m_result = result;
+
+    g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
+    // The turn has already passed to the side that was mated.
+    if (result == eMatchResult::WIN_CHECKMATE) g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[SYSTEM] Player #%d has won the match by checkmate!", 1 - g_theGame->GetCurrentPlayerControllerId()));
+    else g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[SYSTEM] %s!", GetMatchResultString(result)));
+    g_theDevConsole->AddLine(DevConsole::WARNING, "##################################################");
+    g_theGame->ChangeGameState(eGameState::FINISHED);
+}
+
+//----------------------------------------------------------------------------------------------------
+eMatchResult Match::GetMatchResult() const
+{
+    return m_result;
 }
 
 eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
@@ -781,6 +1060,8 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
                                      String const&  promotionType,
                                      bool const     isTeleport) const
 {
+    COUNTER_INCREMENT("Match::ValidateChessMove");
+
     // 1. Check if coordinates are valid
     if (!m_board->IsCoordValid(fromCoords) || !m_board->IsCoordValid(toCoords))
     {
@@ -841,6 +1122,25 @@ eMoveResult Match::ValidateChessMove(IntVec2 const& fromCoords,
         }
     }
 
+    // 9. The move may not leave the mover's own king in check, and a castling king may not start in or
+    //    pass through check; landing in check is caught by IsMoveLegal like any other king move
+    sChessPosition const position = GetChessPosition();
+    sChessMove const     move     = {static_cast<int8_t>(GetSquareIndexFromCoords(fromCoords)), static_cast<int8_t>(GetSquareIndexFromCoords(toCoords)), GetPieceTypeFromName(promotionType)};
+
+    if (fromPiece->m_definition->m_type == ePieceType::KING && abs(toCoords.x - fromCoords.x) == 2)
+    {
+        if (IsInCheck(position, position.m_sideToMove)) return eMoveResult::INVALID_CASTLE_OUT_OF_CHECK;
+
+        int const passedSquare = (move.m_fromSquare + move.m_toSquare) / 2;
+
+        if (IsSquareAttacked(position, passedSquare, 1 - position.m_sideToMove)) return eMoveResult::INVALID_CASTLE_THROUGH_CHECK;
+    }
+
+    if (!IsMoveLegal(position, move))
+    {
+        return eMoveResult::INVALID_MOVE_ENDS_IN_CHECK;
+    }
+
     // Determine the type of valid move
     return DetermineValidMoveType(fromCoords, toCoords, fromPiece);
 }
@@ -1140,10 +1440,7 @@ eMoveResult Match::ValidateCastling(IntVec2 const& fromCoords, IntVec2 const& to
         }
     }
 
-    // TODO: Add check-related castle validation in future assignments
-    // - King cannot be in check
-    // - King cannot pass through check
-    // - King cannot end in check
+    // Castling out of, through or into check is rejected by ValidateChessMove before this runs
 
     return isKingSide ? eMoveResult::VALID_CASTLE_KINGSIDE : eMoveResult::VALID_CASTLE_QUEENSIDE;
 }
@@ -1216,6 +1513,8 @@ sPieceMove Match::GetLastPieceMove() const
 //----------------------------------------------------------------------------------------------------
 Piece* Match::GetPieceByCoords(IntVec2 const& coords) const
 {
+    COUNTER_INCREMENT("Match::GetPieceByCoords");
+
     for (Piece* piece : m_pieceList)
     {
         if (piece == nullptr)
@@ -1261,7 +1560,7 @@ bool Match::ExecuteMove(IntVec2 const& fromCoords,
         break;
     case eMoveResult::VALID_MOVE_NORMAL:
     default:
-        fromPiece->UpdatePositionByCoords(toCoords, 2.f);
+        fromPiece->UpdatePositionByCoords(toCoords, PIECE_MOVE_SECONDS);
         fromPiece->m_hasMoved = true;
         m_board->UpdateSquareInfoList(fromCoords, toCoords);
 
@@ -1280,7 +1579,7 @@ void Match::ExecuteEnPassantCapture(IntVec2 const& fromCoords, IntVec2 const& to
     // Remove the captured pawn
     IntVec2 capturedPawnPos = IntVec2(toCoords.x, fromCoords.y);
     Piece*  fromPiece       = GetPieceByCoords(fromCoords);
-    fromPiece->UpdatePositionByCoords(toCoords, 2.f);
+    fromPiece->UpdatePositionByCoords(toCoords, PIECE_MOVE_SECONDS);
     m_board->UpdateSquareInfoList(fromCoords, toCoords);
     m_board->UpdateSquareInfoList(capturedPawnPos);
     RemovePieceFromPieceList(capturedPawnPos);
@@ -1295,7 +1594,8 @@ void Match::ExecutePawnPromotion(IntVec2 const& fromCoords,
     // Handle capture if there's a piece at destination
 
     Piece* fromPiece        = GetPieceByCoords(fromCoords);
-    fromPiece->m_definition = PieceDefinition::GetDefByName(promoteTo);
+    fromPiece->m_definition  = PieceDefinition::GetDefByName(promoteTo);
+    fromPiece->m_localBounds = fromPiece->m_definition->m_localBounds;
     // fromPiece->UpdatePositionByCoords(toCoords);
     ExecuteCapture(fromCoords, toCoords, promoteTo);
 
@@ -1354,6 +1654,8 @@ void Match::ExecuteQueensideCastling(IntVec2 const& fromCoords) const
 
 void Match::RenderPlayerBasis() const
 {
+    ALLOCATION_SCOPE("Match::RenderPlayerBasis");
+
     VertexList_PCU verts;
 
     Vec3 const worldCameraPosition = g_theGame->GetCurrentPlayer()->m_worldCamera->GetPosition();
@@ -1364,13 +1666,41 @@ void Match::RenderPlayerBasis() const
     AddVertsForArrow3D(verts, worldCameraPosition + forwardNormal, worldCameraPosition + forwardNormal + Vec3::Y_BASIS * 0.1f, 0.8f, 0.001f, 0.003f, Rgba8::GREEN);
     AddVertsForArrow3D(verts, worldCameraPosition + forwardNormal, worldCameraPosition + forwardNormal + Vec3::Z_BASIS * 0.1f, 0.8f, 0.001f, 0.003f, Rgba8::BLUE);
 
-    g_theRenderer->SetModelConstants();
-    g_theRenderer->SetBlendMode(eBlendMode::OPAQUE);
-    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
-    g_theRenderer->SetSamplerMode(eSamplerMode::POINT_CLAMP);
-    g_theRenderer->SetDepthMode(eDepthMode::DISABLED);
-    g_theRenderer->BindTexture(nullptr);
-    g_theRenderer->DrawVertexArray(static_cast<int>(verts.size()), verts.data());
+    sRenderState state;
+    state.m_shader    = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default");
+    state.m_depthMode = eDepthMode::DISABLED;
+
+    m_renderCommandList->SubmitVertexArray(eRenderLayer::OVERLAY, state, Mat44(), Rgba8::WHITE, verts);
+}
+
+//----------------------------------------------------------------------------------------------------
+RenderCommandList& Match::GetRenderCommandList() const
+{
+    return *m_renderCommandList;
+}
+
+//----------------------------------------------------------------------------------------------------
+TweenSystem& Match::GetTweenSystem()
+{
+    return m_tweenSystem;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief How far rendering is between the last two simulation steps; see Actor::GetRenderPosition.
+float Match::GetRenderAlpha() const
+{
+    return m_fixedTimestep.GetAlpha();
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool Match::OnRenderCapture(EventArgs& args)
+{
+    UNUSED(args)
+
+    s_isRenderCaptureRequested = true;
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "Capturing the render commands of the next frame.");
+
+    return true;
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -1379,6 +1709,12 @@ STATIC bool Match::OnChessMove(EventArgs& args)
     Match* match = g_theGame->m_match;
     if (!match) return false;
 
+    if (match->GetMatchResult() != eMatchResult::ONGOING)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("Match is over: %s", GetMatchResultString(match->GetMatchResult())));
+        return false;
+    }
+
     String const from       = args.GetValue("from", "DEFAULT");
     String const to         = args.GetValue("to", "DEFAULT");
     String const promotion  = args.GetValue("promoteTo", "DEFAULT");
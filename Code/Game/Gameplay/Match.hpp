@@ -6,21 +6,49 @@
 #pragma once
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/IntVec2.hpp"
 #include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/FixedTimestep.hpp"
+#include "Game/Framework/MatchArena.hpp"
 #include "Game/Framework/MatchCommon.hpp"
+#include "Game/Framework/TimerWheel.hpp"
+#include "Game/Framework/TweenSystem.hpp"
+#include "Game/Framework/ZobristHistory.hpp"
 #include "Game/Gameplay/Board.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Camera;
+class FrustumCuller;
+class HighlightOverlay;
 class Piece;
+class PieceBatchRenderer;
 class PlayerController;
+class RenderBackend;
+class RenderCommandList;
+
+//----------------------------------------------------------------------------------------------------
+struct sMatchRaycastResult
+{
+    Piece*  m_hitPiece      = nullptr;
+    IntVec2 m_currentCoords = IntVec2::ZERO;
+    IntVec2 m_targetCoords  = IntVec2::ZERO;
+};
+
+struct sPieceMove
+{
+    Piece const* piece      = nullptr;
+    IntVec2      fromCoords = IntVec2::ZERO;
+    IntVec2      toCoords   = IntVec2::ZERO;
+};
 
 //----------------------------------------------------------------------------------------------------
 typedef std::vector<Piece*>     PieceList;
 typedef std::vector<sPieceMove> PieceMoveList;
 
 /// @brief
-/// Owned by Game, piece, and board
+/// Owned by Game, piece, and board. The board, the pieces and the render helpers live in the match's
+/// arena and are freed together when the match ends; captured pieces go back to the piece pool.
 class Match
 {
 public:
@@ -29,13 +57,26 @@ public:
 
     void Update();
     void Render() const;
+    void RenderHeadless(RenderBackend& backend) const;
     void RenderGhostPiece() const;
 
+    sChessPosition     GetChessPosition() const;
+    eMatchResult       GetMatchResult() const;
+    RenderCommandList& GetRenderCommandList() const;
+    TweenSystem&       GetTweenSystem();
+    float              GetRenderAlpha() const;
+
     Board* m_board = nullptr;
 
 private:
     void UpdateFromInput(float deltaSeconds);
+    void UpdateSimulation(float stepSeconds);
+    void UpdateTweens(float deltaSeconds);
+    void AddHudText() const;
     void RenderPlayerBasis() const;
+    void SubmitRenderCommands(RenderBackend& backend) const;
+    void ExecuteRenderCommands() const;
+    bool CullActors() const;
     void CreateScreenCamera();
     void CreateGameClock();
     void CreateBoard();
@@ -45,10 +86,13 @@ private:
     static bool OnExitMatchTurn(EventArgs& args);
     static bool OnMatchInitialized(EventArgs& args);
     static bool OnChessMove(EventArgs& args);
+    static bool OnRenderCapture(EventArgs& args);
 
     void OnChessMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, bool isTeleport);
     bool ExecuteMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo, bool isTeleport);
 
+    void EndMatch(eMatchResult result);
+
     void ExecuteEnPassantCapture(IntVec2 const& fromCoords, IntVec2 const& toCoords);
     void ExecutePawnPromotion(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promoteTo);
     void ExecuteCastling(IntVec2 const& fromCoords, IntVec2 const& toCoords) const;
@@ -58,8 +102,8 @@ private:
 
 
     void RemovePieceFromPieceList(IntVec2 const& toCoords);
-    void SchedulePieceForRemoval(Piece* piece, float delay, ePieceType capturedType);
-    void UpdatePendingRemovals(float deltaSeconds);
+    void ReleasePiece(Piece* piece);
+    void SchedulePieceForRemoval(Piece* piece, float delay);
 
     eMoveResult ValidateChessMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType, bool isTeleport) const;
     eMoveResult ValidatePieceMove(IntVec2 const& fromCoords, IntVec2 const& toCoords, String const& promotionType) const;
@@ -81,9 +125,23 @@ private:
     sPieceMove GetLastPieceMove() const;
     Piece*     GetPieceByCoords(IntVec2 const& coords) const;
 
-    Camera*   m_screenCamera = nullptr;
-    Clock*    m_gameClock    = nullptr;
-    PieceList m_pieceList;
+    // Declared first, so it outlives everything allocated from it
+    MatchArena       m_arena;
+    ArenaPool<Piece> m_piecePool = ArenaPool<Piece>(m_arena);
+
+    Camera*             m_screenCamera       = nullptr;
+    Clock*              m_gameClock          = nullptr;
+    PieceBatchRenderer* m_pieceBatchRenderer = nullptr;
+    RenderCommandList*  m_renderCommandList  = nullptr;
+    HighlightOverlay*   m_highlightOverlay   = nullptr;
+    FrustumCuller*      m_frustumCuller      = nullptr;
+    PieceList           m_pieceList;
+    TweenSystem         m_tweenSystem;      // Piece moves and capture sinking
+    TimerWheel          m_timerWheel;       // Deferred actions, driven by m_gameClock
+    FixedTimestep       m_fixedTimestep;    // Steps UpdateSimulation on m_gameClock time
+
+    // Set by render_capture; the next Render records its backend calls and prints them
+    static bool s_isRenderCaptureRequested;
 
     // DEBUG LIGHT
     Vec3  m_sunDirection     = Vec3(2.f, 1.f, -1.f).GetNormalized();
@@ -97,13 +155,7 @@ private:
     Piece*        m_ghostSourcePiece   = nullptr;
     bool          m_isCheatMode        = false;
 
-    // 延遲移除系統
-    struct PendingRemoval
-    {
-        Piece*     piece             = nullptr;
-        float      remainingTime     = 0.f;
-        ePieceType capturedPieceType = ePieceType::NONE;
-    };
-
-    std::vector<PendingRemoval> m_pendingRemovals;
+    // Position keys since the match started, for the repetition and fifty-move rules
+    ZobristHistory m_zobristHistory;
+    eMatchResult   m_result = eMatchResult::ONGOING;
 };
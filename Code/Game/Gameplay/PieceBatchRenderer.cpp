@@ -0,0 +1,215 @@
+//----------------------------------------------------------------------------------------------------
+// PieceBatchRenderer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/PieceBatchRenderer.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#include "Engine/Math/MathUtils.hpp"
+
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Gameplay/Piece.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+PieceBatchRenderer::~PieceBatchRenderer()
+{
+    for (sPieceBatch& batch : m_batches)
+    {
+        GAME_SAFE_RELEASE(batch.m_vertexBuffer);
+        GAME_SAFE_RELEASE(batch.m_indexBuffer);
+    }
+
+    m_batches.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void PieceBatchRenderer::Render(std::vector<Piece*> const& pieces,
+                                Vec3 const&                cameraPosition,
+                                RenderCommandList&         commandList,
+                                RenderBackend&             backend)
+{
+    PROFILE_SCOPE("PieceBatchRenderer::Render");
+
+    for (sPieceBatch& batch : m_batches)
+    {
+        batch.m_instances.clear();
+    }
+
+    for (int lodLevel = 0; lodLevel < PIECE_MESH_LOD_COUNT; ++lodLevel)
+    {
+        m_lodInstanceCounts[lodLevel] = 0;
+        m_lodTriangleCounts[lodLevel] = 0;
+    }
+
+    // Fraction of the screen height one unit covers at distance 1.
+    float const screenScale = 1.f / TanDegrees(PLAYER_CAMERA_FOV_DEGREES * 0.5f);
+
+    for (Piece* piece : pieces)
+    {
+        if (piece == nullptr || piece->m_definition == nullptr || piece->m_isCaptured || !piece->m_isVisible) continue;
+
+        float const boundingRadius = piece->m_definition->m_meshes[0]->m_boundingRadius;
+        float const distance       = (piece->m_position - cameraPosition).GetLength();
+        float const screenSize     = distance > boundingRadius ? boundingRadius * screenScale / distance : 1.f;
+        piece->m_lodLevel          = SelectPieceMeshLod(piece->m_lodLevel, screenSize);
+
+        sPieceMesh const* mesh = piece->m_definition->m_meshes[piece->m_lodLevel];
+        ++m_lodInstanceCounts[piece->m_lodLevel];
+        m_lodTriangleCounts[piece->m_lodLevel] += static_cast<int>(mesh->m_indexCount / 3);
+
+        if (piece->m_isMoving || piece->m_isBeingCaptured)
+        {
+            SubmitPiece(*piece, *mesh, commandList);
+            continue;
+        }
+
+        GetOrCreateBatch(piece->m_definition, piece->m_id, piece->m_lodLevel).m_instances.push_back({piece->GetModelToWorldTransform(), piece->m_color});
+    }
+
+    // Instances are baked in world space, so the model constants stay at identity for every batch.
+    for (sPieceBatch& batch : m_batches)
+    {
+        if (batch.m_instances != batch.m_uploadedInstances) RebuildBatch(batch, backend);
+
+        if (batch.m_instances.empty()) continue;
+
+        // The batch's lights are picked for the box around all of its pieces.
+        float const radius = batch.m_definition->m_meshes[0]->m_boundingRadius;
+        AABB3       worldBounds(batch.m_instances[0].m_modelToWorld.GetTranslation3D(), batch.m_instances[0].m_modelToWorld.GetTranslation3D());
+
+        for (sPieceInstance const& instance : batch.m_instances)
+        {
+            Vec3 const position = instance.m_modelToWorld.GetTranslation3D();
+            worldBounds.m_mins  = Vec3(std::min(worldBounds.m_mins.x, position.x), std::min(worldBounds.m_mins.y, position.y), std::min(worldBounds.m_mins.z, position.z));
+            worldBounds.m_maxs  = Vec3(std::max(worldBounds.m_maxs.x, position.x), std::max(worldBounds.m_maxs.y, position.y), std::max(worldBounds.m_maxs.z, position.z));
+        }
+
+        worldBounds.m_mins -= Vec3(radius, radius, radius);
+        worldBounds.m_maxs += Vec3(radius, radius, radius);
+
+        sRenderState state;
+        state.m_shader           = batch.m_definition->m_shader;
+        state.m_textures[0]      = batch.m_definition->m_diffuseTexture;
+        state.m_textures[1]      = batch.m_definition->m_normalTexture;
+        state.m_textures[2]      = batch.m_definition->m_specularGlossEmitTexture;
+        state.m_textureSlotCount = 3;
+        state.m_lightSetId       = g_theLightSubsystem->GetLightSetForBounds(worldBounds);
+
+        commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, Mat44(), Rgba8::WHITE, batch.m_vertexBuffer, batch.m_indexBuffer, batch.m_indexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Draws one piece from its definition's shared mesh, placed and tinted by the model constants.
+void PieceBatchRenderer::SubmitPiece(Piece const&       piece,
+                                     sPieceMesh const&  mesh,
+                                     RenderCommandList& commandList) const
+{
+    Mat44 const modelToWorld = piece.GetModelToWorldTransform();
+
+    sRenderState state;
+    state.m_shader           = piece.m_definition->m_shader;
+    state.m_textures[0]      = piece.m_definition->m_diffuseTexture;
+    state.m_textures[1]      = piece.m_definition->m_normalTexture;
+    state.m_textures[2]      = piece.m_definition->m_specularGlossEmitTexture;
+    state.m_textureSlotCount = 3;
+    state.m_lightSetId       = g_theLightSubsystem->GetLightSetForBounds(piece.m_localBounds, modelToWorld);
+
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, modelToWorld, piece.m_color, mesh.m_vertexBuffer, mesh.m_indexBuffer, mesh.m_indexCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+int PieceBatchRenderer::GetBatchCount() const
+{
+    return static_cast<int>(m_batches.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+int PieceBatchRenderer::GetLodInstanceCount(int const lodLevel) const
+{
+    return m_lodInstanceCounts[lodLevel];
+}
+
+//----------------------------------------------------------------------------------------------------
+int PieceBatchRenderer::GetLodTriangleCount(int const lodLevel) const
+{
+    return m_lodTriangleCounts[lodLevel];
+}
+
+//----------------------------------------------------------------------------------------------------
+bool PieceBatchRenderer::sPieceInstance::operator==(sPieceInstance const& compare) const
+{
+    return std::memcmp(m_modelToWorld.m_values, compare.m_modelToWorld.m_values, sizeof(m_modelToWorld.m_values)) == 0 &&
+        m_color.r == compare.m_color.r &&
+        m_color.g == compare.m_color.g &&
+        m_color.b == compare.m_color.b &&
+        m_color.a == compare.m_color.a;
+}
+
+//----------------------------------------------------------------------------------------------------
+PieceBatchRenderer::sPieceBatch& PieceBatchRenderer::GetOrCreateBatch(PieceDefinition const* definition,
+                                                                      int const              playerId,
+                                                                      int const              lodLevel)
+{
+    for (sPieceBatch& batch : m_batches)
+    {
+        if (batch.m_definition == definition && batch.m_playerId == playerId && batch.m_lodLevel == lodLevel) return batch;
+    }
+
+    sPieceBatch batch;
+    batch.m_definition   = definition;
+    batch.m_playerId     = playerId;
+    batch.m_lodLevel     = lodLevel;
+    batch.m_vertexBuffer = g_theRenderer->CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    batch.m_indexBuffer  = g_theRenderer->CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+    m_batches.push_back(batch);
+
+    return m_batches.back();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Transforms one copy of the definition's mesh per instance into world space and uploads the
+/// result through backend.
+void PieceBatchRenderer::RebuildBatch(sPieceBatch&   batch,
+                                      RenderBackend& backend)
+{
+    sPieceMesh const*        mesh        = batch.m_definition->m_meshes[batch.m_lodLevel];
+    VertexList_PCUTBN const& sourceVerts = mesh->m_vertexes;
+    IndexList const&         sourceIndex = mesh->m_indexes;
+
+    m_scratchVerts.clear();
+    m_scratchIndexes.clear();
+    m_scratchVerts.reserve(sourceVerts.size() * batch.m_instances.size());
+    m_scratchIndexes.reserve(sourceIndex.size() * batch.m_instances.size());
+
+    for (sPieceInstance const& instance : batch.m_instances)
+    {
+        AppendPieceMeshInstance(*mesh, instance.m_modelToWorld, instance.m_color, m_scratchVerts, m_scratchIndexes);
+    }
+
+    batch.m_uploadedInstances = batch.m_instances;
+    batch.m_indexCount        = static_cast<unsigned int>(m_scratchIndexes.size());
+
+    if (batch.m_indexCount == 0) return;
+
+    size_t const vertexBytes = m_scratchVerts.size() * sizeof(Vertex_PCUTBN);
+    size_t const indexBytes  = m_scratchIndexes.size() * sizeof(unsigned int);
+
+    backend.CopyCPUToGPU(m_scratchVerts.data(), static_cast<unsigned int>(vertexBytes), batch.m_vertexBuffer);
+    backend.CopyCPUToGPU(m_scratchIndexes.data(), static_cast<unsigned int>(indexBytes), batch.m_indexBuffer);
+    RecordRenderUpload(vertexBytes + indexBytes);
+}
@@ -0,0 +1,72 @@
+//----------------------------------------------------------------------------------------------------
+// PieceBatchRenderer.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IndexBuffer;
+class Piece;
+class RenderBackend;
+class RenderCommandList;
+class VertexBuffer;
+struct PieceDefinition;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Draws every live piece with one draw per PieceDefinition, side and LOD level; each piece's LOD is
+/// picked from its projected size with SelectPieceMeshLod. Each batch keeps a GPU buffer holding its
+/// pieces' meshes already transformed to world space and tinted with their colors. The buffer is
+/// rebuilt only when a piece in the batch moves, changes color, changes LOD or leaves the board, and
+/// uploaded through the RenderBackend Render is given; otherwise a frame only submits it to the
+/// RenderCommandList. Pieces mid-tween are drawn on their own from the shared mesh and left out of their
+/// batch, so a move rebuilds the batch when the piece lifts off and when it lands, not every frame.
+class PieceBatchRenderer
+{
+public:
+    PieceBatchRenderer() = default;
+    ~PieceBatchRenderer();
+
+    void Render(std::vector<Piece*> const& pieces, Vec3 const& cameraPosition, RenderCommandList& commandList, RenderBackend& backend);
+    int  GetBatchCount() const;
+    int  GetLodInstanceCount(int lodLevel) const;
+    int  GetLodTriangleCount(int lodLevel) const;
+
+private:
+    struct sPieceInstance
+    {
+        Mat44 m_modelToWorld;
+        Rgba8 m_color;
+
+        bool operator==(sPieceInstance const& compare) const;
+    };
+
+    struct sPieceBatch
+    {
+        PieceDefinition const*      m_definition   = nullptr;
+        int                         m_playerId     = -1;
+        int                         m_lodLevel     = 0;
+        std::vector<sPieceInstance> m_instances;              // Gathered this frame
+        std::vector<sPieceInstance> m_uploadedInstances;      // Baked into the buffers
+        VertexBuffer*               m_vertexBuffer = nullptr;
+        IndexBuffer*                m_indexBuffer  = nullptr;
+        unsigned int                m_indexCount   = 0;
+    };
+
+    sPieceBatch& GetOrCreateBatch(PieceDefinition const* definition, int playerId, int lodLevel);
+    void         RebuildBatch(sPieceBatch& batch, RenderBackend& backend);
+    void         SubmitPiece(Piece const& piece, sPieceMesh const& mesh, RenderCommandList& commandList) const;
+
+    std::vector<sPieceBatch> m_batches;
+    int                      m_lodInstanceCounts[PIECE_MESH_LOD_COUNT] = {};   // Last Render
+    int                      m_lodTriangleCounts[PIECE_MESH_LOD_COUNT] = {};
+    VertexList_PCUTBN        m_scratchVerts;
+    IndexList                m_scratchIndexes;
+};
@@ -0,0 +1,397 @@
+//----------------------------------------------------------------------------------------------------
+// SpectatorScene.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Gameplay/SpectatorScene.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/IndexBuffer.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Engine/Renderer/VertexBuffer.hpp"
+#include "Game/Definition/BoardDefinition.hpp"
+#include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Gameplay/Board.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static AABB3 GetVertexBounds(VertexList_PCUTBN const& verts)
+{
+    if (verts.empty()) return AABB3(Vec3::ZERO, Vec3::ZERO);
+
+    AABB3 bounds(verts[0].m_position, verts[0].m_position);
+
+    for (Vertex_PCUTBN const& vertex : verts)
+    {
+        Vec3 const& position = vertex.m_position;
+        bounds.m_mins        = Vec3(std::min(bounds.m_mins.x, position.x), std::min(bounds.m_mins.y, position.y), std::min(bounds.m_mins.z, position.z));
+        bounds.m_maxs        = Vec3(std::max(bounds.m_maxs.x, position.x), std::max(bounds.m_maxs.y, position.y), std::max(bounds.m_maxs.z, position.z));
+    }
+
+    return bounds;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSameRenderState(sRenderState const& a,
+                              sRenderState const& b)
+{
+    return a.m_shader == b.m_shader &&
+        a.m_textures[0] == b.m_textures[0] &&
+        a.m_textures[1] == b.m_textures[1] &&
+        a.m_textures[2] == b.m_textures[2];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Needs PieceDefinition and BoardDefinition loaded; the scene keeps pointers to their meshes.
+/// Without a Renderer, the shared board mesh is drawn untextured.
+SpectatorScene::SpectatorScene(int const      boardCount,
+                               unsigned const seed,
+                               RenderBackend& backend)
+    : m_random(seed)
+{
+    // Pieces of definitions sharing a shader and texture set go into the same buffer.
+    for (PieceDefinition const* definition : PieceDefinition::s_pieceDefinitions)
+    {
+        int const typeIndex = static_cast<int>(definition->m_type);
+
+        if (typeIndex < 0 || typeIndex >= SPECTATOR_PIECE_TYPE_COUNT) continue;
+
+        sRenderState state;
+        state.m_shader           = definition->m_shader;
+        state.m_textures[0]      = definition->m_diffuseTexture;
+        state.m_textures[1]      = definition->m_normalTexture;
+        state.m_textures[2]      = definition->m_specularGlossEmitTexture;
+        state.m_textureSlotCount = 3;
+
+        int materialIndex = 0;
+
+        while (materialIndex < static_cast<int>(m_materials.size()) && !IsSameRenderState(m_materials[materialIndex], state)) ++materialIndex;
+
+        if (materialIndex == static_cast<int>(m_materials.size())) m_materials.push_back(state);
+
+        m_definitions[typeIndex]     = definition;
+        m_materialIndexes[typeIndex] = materialIndex;
+        m_pieceBoundingRadius        = std::max(m_pieceBoundingRadius, definition->m_meshes[0]->m_boundingRadius);
+    }
+
+    for (int playerId = 0; playerId < 2 && playerId < static_cast<int>(BoardDefinition::s_boardDefinitions.size()); ++playerId)
+    {
+        m_playerRotations[playerId] = BoardDefinition::s_boardDefinitions[playerId]->m_pieceOrientation.GetAsMatrix_IFwd_JLeft_KUp();
+        m_playerColors[playerId]    = BoardDefinition::s_boardDefinitions[playerId]->m_pieceColor;
+    }
+
+    // Same mesh and material as Board, uploaded once for every board in the grid.
+    if (g_theRenderer != nullptr)
+    {
+        m_boardState.m_shader      = g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Bloom", eVertexType::VERTEX_PCU);
+        m_boardState.m_textures[0] = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_d.png");
+        m_boardState.m_textures[1] = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_n.png");
+        m_boardState.m_textures[2] = g_theRenderer->CreateOrGetTextureFromFile("Data/Images/PhongTextures/FunkyBricks_sge.png");
+    }
+
+    m_boardState.m_textureSlotCount = 3;
+
+    Board::CreateLocalVertsForSquares(m_scratchVerts, m_scratchIndexes);
+    Board::CreateLocalVertsForBoardFrame(m_scratchVerts, m_scratchIndexes);
+
+    m_boardVertexBuffer = backend.CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+    m_boardIndexBuffer  = backend.CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+    backend.CopyCPUToGPU(m_scratchVerts.data(), static_cast<unsigned int>(m_scratchVerts.size() * sizeof(Vertex_PCUTBN)), m_boardVertexBuffer);
+    backend.CopyCPUToGPU(m_scratchIndexes.data(), static_cast<unsigned int>(m_scratchIndexes.size() * sizeof(unsigned int)), m_boardIndexBuffer);
+    m_boardIndexCount  = static_cast<unsigned int>(m_scratchIndexes.size());
+    m_boardLocalBounds = GetVertexBounds(m_scratchVerts);
+
+    // Pieces stand on the squares' top faces.
+    m_boardLocalBounds.m_maxs.z = std::max(m_boardLocalBounds.m_maxs.z, 0.2f + m_pieceBoundingRadius);
+
+    // Boards never move, so their bounds go into the culler once.
+    m_frustumCuller = new FrustumCuller();
+    m_columnCount   = std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<float>(boardCount)))));
+    m_boards.resize(std::max(0, boardCount));
+    m_feeds.resize(m_boards.size());
+
+    std::uniform_real_distribution<float> delayDistribution(0.f, SPECTATOR_MOVE_INTERVAL_SECONDS);
+
+    for (int boardIndex = 0; boardIndex < static_cast<int>(m_boards.size()); ++boardIndex)
+    {
+        sSpectatorBoard& board = m_boards[boardIndex];
+        board.m_origin         = Vec3(static_cast<float>(boardIndex % m_columnCount), static_cast<float>(boardIndex / m_columnCount), 0.f) * SPECTATOR_BOARD_SPACING;
+        board.m_sections.resize(m_materials.size());
+
+        Mat44 boardToWorld;
+        boardToWorld.SetTranslation3D(board.m_origin);
+        m_frustumCuller->AddBounds(m_boardLocalBounds, boardToWorld);
+
+        // Staggered, so the boards do not all move on the same frame.
+        m_feeds[boardIndex].m_secondsUntilMove = delayDistribution(m_random);
+        SetBoardPosition(boardIndex, m_feeds[boardIndex].m_match.GetPosition());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+SpectatorScene::~SpectatorScene()
+{
+    for (sSpectatorBoard& board : m_boards)
+    {
+        for (sPieceSection& section : board.m_sections)
+        {
+            GAME_SAFE_RELEASE(section.m_vertexBuffer);
+            GAME_SAFE_RELEASE(section.m_indexBuffer);
+        }
+    }
+
+    GAME_SAFE_RELEASE(m_boardVertexBuffer);
+    GAME_SAFE_RELEASE(m_boardIndexBuffer);
+    GAME_SAFE_RELEASE(m_frustumCuller);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpectatorScene::Update(float const deltaSeconds)
+{
+    int const stepCount = m_selfPlayTimestep.Accumulate(deltaSeconds);
+
+    for (int stepIndex = 0; stepIndex < stepCount; ++stepIndex)
+    {
+        UpdateSelfPlay(m_selfPlayTimestep.GetStepSeconds());
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpectatorScene::Render(Vec3 const&        cameraPosition,
+                            EulerAngles const& cameraOrientation)
+{
+    ImmediateRenderBackend immediateBackend;
+
+    g_theLightSubsystem->BuildLightClusters(cameraPosition, cameraOrientation, immediateBackend);
+    SubmitDraws(cameraPosition, cameraOrientation, m_renderCommandList, immediateBackend);
+    m_renderCommandList.Execute(immediateBackend);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Culls the boards, rebakes the visible ones whose snapshot or LOD changed, at most
+/// SPECTATOR_MAX_REBUILDS_PER_FRAME of them, uploading through backend, and submits two draws per visible
+/// board. Boards over the budget keep drawing their previous bake; the budget starts where the last
+/// frame's ran out, so none of them waits more than a few frames.
+void SpectatorScene::SubmitDraws(Vec3 const&        cameraPosition,
+                                 EulerAngles const& cameraOrientation,
+                                 RenderCommandList& commandList,
+                                 RenderBackend&     backend)
+{
+    double const cullStartTime = GetCurrentTimeSeconds();
+
+    sFrustum const frustum = sFrustum::MakePerspective(cameraPosition, cameraOrientation, PLAYER_CAMERA_ASPECT, PLAYER_CAMERA_FOV_DEGREES, PLAYER_CAMERA_NEAR, PLAYER_CAMERA_FAR);
+    m_frustumCuller->Cull(frustum);
+
+    double const rebuildStartTime = GetCurrentTimeSeconds();
+
+    // Fraction of the screen height one unit covers at distance 1.
+    float const screenScale  = 1.f / TanDegrees(PLAYER_CAMERA_FOV_DEGREES * 0.5f);
+    Vec3 const  boardCenter  = (m_boardLocalBounds.m_mins + m_boardLocalBounds.m_maxs) * 0.5f;
+    int const   boardCount   = static_cast<int>(m_boards.size());
+    int         rebuildCount = 0;
+    int         staleCount   = 0;
+    int         firstStale   = -1;
+
+    for (int offset = 0; offset < boardCount; ++offset)
+    {
+        int const boardIndex = (m_nextRebuildIndex + offset) % boardCount;
+
+        if (!m_frustumCuller->IsVisible(boardIndex)) continue;
+
+        sSpectatorBoard& board      = m_boards[boardIndex];
+        float const      distance   = (board.m_origin + boardCenter - cameraPosition).GetLength();
+        float const      screenSize = distance > m_pieceBoundingRadius ? m_pieceBoundingRadius * screenScale / distance : 1.f;
+        board.m_lodLevel            = SelectPieceMeshLod(board.m_lodLevel, screenSize);
+
+        if (board.m_bakedRevision == board.m_revision && board.m_bakedLodLevel == board.m_lodLevel) continue;
+
+        if (rebuildCount < SPECTATOR_MAX_REBUILDS_PER_FRAME)
+        {
+            RebuildBoard(board, backend);
+            ++rebuildCount;
+            continue;
+        }
+
+        if (firstStale < 0) firstStale = boardIndex;
+        ++staleCount;
+    }
+
+    m_nextRebuildIndex = firstStale >= 0 ? firstStale : 0;
+
+    double const submitStartTime = GetCurrentTimeSeconds();
+
+    for (int boardIndex = 0; boardIndex < boardCount; ++boardIndex)
+    {
+        if (!m_frustumCuller->IsVisible(boardIndex)) continue;
+
+        sSpectatorBoard const& board = m_boards[boardIndex];
+
+        Mat44 boardToWorld;
+        boardToWorld.SetTranslation3D(board.m_origin);
+
+        int const lightSetId = g_theLightSubsystem != nullptr ? g_theLightSubsystem->GetLightSetForBounds(m_boardLocalBounds, boardToWorld) : 0;
+
+        sRenderState boardState = m_boardState;
+        boardState.m_lightSetId = lightSetId;
+        commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, boardState, boardToWorld, Rgba8::WHITE, m_boardVertexBuffer, m_boardIndexBuffer, m_boardIndexCount);
+
+        // Pieces are baked in world space, so their model constants stay at identity.
+        for (int materialIndex = 0; materialIndex < static_cast<int>(m_materials.size()); ++materialIndex)
+        {
+            sPieceSection const& section      = board.m_sections[materialIndex];
+            sRenderState         pieceState = m_materials[materialIndex];
+            pieceState.m_lightSetId         = lightSetId;
+            commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, pieceState, Mat44(), Rgba8::WHITE, section.m_vertexBuffer, section.m_indexBuffer, section.m_indexCount);
+        }
+    }
+
+    double const endTime = GetCurrentTimeSeconds();
+
+    m_frameStatistics.m_cullSeconds    = rebuildStartTime - cullStartTime;
+    m_frameStatistics.m_rebuildSeconds = submitStartTime - rebuildStartTime;
+    m_frameStatistics.m_submitSeconds  = endTime - submitStartTime;
+    m_frameStatistics.m_visibleCount   = m_frustumCuller->GetVisibleCount();
+    m_frameStatistics.m_rebuildCount   = rebuildCount;
+    m_frameStatistics.m_staleCount     = staleCount;
+
+    RecordRenderCulling(m_frustumCuller->GetVisibleCount(), m_frustumCuller->GetCulledCount());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Takes a copy of position. The board is rebaked on a later SubmitDraws only if a square changed.
+void SpectatorScene::SetBoardPosition(int const             boardIndex,
+                                      sChessPosition const& position)
+{
+    if (boardIndex < 0 || boardIndex >= static_cast<int>(m_boards.size())) return;
+
+    sSpectatorBoard& board = m_boards[boardIndex];
+
+    if (std::memcmp(board.m_position.m_squares, position.m_squares, sizeof(position.m_squares)) != 0) ++board.m_revision;
+
+    board.m_position = position;
+}
+
+//----------------------------------------------------------------------------------------------------
+int SpectatorScene::GetBoardCount() const
+{
+    return static_cast<int>(m_boards.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+sSpectatorFrameStatistics const& SpectatorScene::GetFrameStatistics() const
+{
+    return m_frameStatistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Behind the grid's first row looking up the grid, close enough that the far plane reaches
+/// across a small grid; larger grids are explored with the free camera.
+Vec3 SpectatorScene::GetOverviewCameraPosition() const
+{
+    int const   rowCount = (static_cast<int>(m_boards.size()) + m_columnCount - 1) / m_columnCount;
+    float const width    = static_cast<float>(m_columnCount) * SPECTATOR_BOARD_SPACING;
+    float const depth    = static_cast<float>(rowCount) * SPECTATOR_BOARD_SPACING;
+    float const extent   = std::min(std::max(width, depth), PLAYER_CAMERA_FAR * 0.5f);
+
+    return Vec3(width * 0.5f, -extent * 0.5f, extent * 0.6f);
+}
+
+//----------------------------------------------------------------------------------------------------
+EulerAngles SpectatorScene::GetOverviewCameraOrientation() const
+{
+    return EulerAngles(90.f, 45.f, 0.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+void SpectatorScene::RebuildBoard(sSpectatorBoard& board,
+                                  RenderBackend&   backend)
+{
+    for (int materialIndex = 0; materialIndex < static_cast<int>(m_materials.size()); ++materialIndex)
+    {
+        m_scratchVerts.clear();
+        m_scratchIndexes.clear();
+
+        for (int squareIndex = 0; squareIndex < CHESS_BOARD_SQUARE_COUNT; ++squareIndex)
+        {
+            sChessSquare const& square    = board.m_position.m_squares[squareIndex];
+            int const           typeIndex = static_cast<int>(square.m_type);
+
+            if (square.IsEmpty() || m_definitions[typeIndex] == nullptr || m_materialIndexes[typeIndex] != materialIndex) continue;
+
+            int const playerId = square.m_playerId == 1 ? 1 : 0;
+            Vec3 const squareCenter(static_cast<float>(squareIndex % CHESS_BOARD_SIZE) + 0.5f, static_cast<float>(squareIndex / CHESS_BOARD_SIZE) + 0.5f, 0.2f);
+
+            Mat44 pieceToWorld;
+            pieceToWorld.SetTranslation3D(board.m_origin + squareCenter);
+            pieceToWorld.Append(m_playerRotations[playerId]);
+
+            AppendPieceMeshInstance(*m_definitions[typeIndex]->m_meshes[board.m_lodLevel], pieceToWorld, m_playerColors[playerId], m_scratchVerts, m_scratchIndexes);
+        }
+
+        sPieceSection& section = board.m_sections[materialIndex];
+        section.m_indexCount   = static_cast<unsigned int>(m_scratchIndexes.size());
+
+        if (section.m_indexCount == 0) continue;
+
+        if (section.m_vertexBuffer == nullptr)
+        {
+            section.m_vertexBuffer = backend.CreateVertexBuffer(sizeof(Vertex_PCUTBN), sizeof(Vertex_PCUTBN));
+            section.m_indexBuffer  = backend.CreateIndexBuffer(sizeof(unsigned int), sizeof(unsigned int));
+        }
+
+        size_t const vertexBytes = m_scratchVerts.size() * sizeof(Vertex_PCUTBN);
+        size_t const indexBytes  = m_scratchIndexes.size() * sizeof(unsigned int);
+
+        backend.CopyCPUToGPU(m_scratchVerts.data(), static_cast<unsigned int>(vertexBytes), section.m_vertexBuffer);
+        backend.CopyCPUToGPU(m_scratchIndexes.data(), static_cast<unsigned int>(indexBytes), section.m_indexBuffer);
+        RecordRenderUpload(vertexBytes + indexBytes);
+    }
+
+    board.m_bakedRevision = board.m_revision;
+    board.m_bakedLodLevel = board.m_lodLevel;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Plays one random legal move per board every SPECTATOR_MOVE_INTERVAL_SECONDS. A finished game,
+/// or one reaching SPECTATOR_MAX_PLY, stays up for SPECTATOR_RESTART_DELAY_SECONDS and then restarts.
+void SpectatorScene::UpdateSelfPlay(float const deltaSeconds)
+{
+    for (int boardIndex = 0; boardIndex < static_cast<int>(m_feeds.size()); ++boardIndex)
+    {
+        sSelfPlayFeed& feed = m_feeds[boardIndex];
+        feed.m_secondsUntilMove -= deltaSeconds;
+
+        if (feed.m_secondsUntilMove > 0.f) continue;
+
+        HeadlessMatch& match  = feed.m_match;
+        bool const     isOver = match.IsFinished() || static_cast<int>(match.GetMoveList().size()) >= SPECTATOR_MAX_PLY;
+
+        if (isOver)
+        {
+            match.Reset(sChessPosition::GetStartingPosition());
+            feed.m_secondsUntilMove = SPECTATOR_MOVE_INTERVAL_SECONDS;
+        }
+        else
+        {
+            GenerateLegalMoves(match.GetPosition(), m_legalMoves);
+            match.SubmitMove(m_legalMoves[std::uniform_int_distribution<int>(0, static_cast<int>(m_legalMoves.size()) - 1)(m_random)]);
+
+            bool const isNowOver    = match.IsFinished() || static_cast<int>(match.GetMoveList().size()) >= SPECTATOR_MAX_PLY;
+            feed.m_secondsUntilMove = isNowOver ? SPECTATOR_RESTART_DELAY_SECONDS : SPECTATOR_MOVE_INTERVAL_SECONDS;
+        }
+
+        SetBoardPosition(boardIndex, match.GetPosition());
+    }
+}
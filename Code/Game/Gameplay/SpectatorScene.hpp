@@ -0,0 +1,131 @@
+//----------------------------------------------------------------------------------------------------
+// SpectatorScene.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/FixedTimestep.hpp"
+#include "Game/Framework/HeadlessMatch.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class FrustumCuller;
+class IndexBuffer;
+class RenderBackend;
+class VertexBuffer;
+struct PieceDefinition;
+
+//----------------------------------------------------------------------------------------------------
+float constexpr SPECTATOR_BOARD_SPACING          = 10.f;   // Board is 8.4 wide with its frame
+float constexpr SPECTATOR_MOVE_INTERVAL_SECONDS  = 1.f;
+float constexpr SPECTATOR_RESTART_DELAY_SECONDS  = 3.f;    // Finished games stay on screen this long
+int constexpr   SPECTATOR_MAX_PLY                = 300;
+int constexpr   SPECTATOR_MAX_REBUILDS_PER_FRAME = 32;
+int constexpr   SPECTATOR_PIECE_TYPE_COUNT       = 6;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief CPU time of the last SubmitDraws, split by stage.
+struct sSpectatorFrameStatistics
+{
+    double m_cullSeconds    = 0.0;
+    double m_rebuildSeconds = 0.0;
+    double m_submitSeconds  = 0.0;
+    int    m_visibleCount   = 0;
+    int    m_rebuildCount   = 0;    // Boards whose piece buffers were rebaked this frame
+    int    m_staleCount     = 0;    // Visible boards left with an older bake by the rebuild budget
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Lobby view of many live games laid out in a grid. Each board is only a position snapshot; there is no
+/// Match, Board or Piece behind it. All boards share one board mesh drawn with a per-board translation,
+/// and each board's pieces are baked into one world-space buffer per material, rebuilt only when its
+/// snapshot or LOD level changes. Boards outside the frustum are neither rebuilt nor submitted.
+/// Until a real feed exists, the scene plays random legal moves on every board through HeadlessMatch
+/// and pushes the results in through SetBoardPosition like any other snapshot source would.
+///
+/// Buffers are created and uploaded through the RenderBackend the constructor and SubmitDraws are
+/// given, so the scene also runs headless, without a Renderer or a light subsystem.
+class SpectatorScene
+{
+public:
+    SpectatorScene(int boardCount, unsigned seed, RenderBackend& backend);
+    ~SpectatorScene();
+
+    void Update(float deltaSeconds);
+    void Render(Vec3 const& cameraPosition, EulerAngles const& cameraOrientation);
+    void SubmitDraws(Vec3 const& cameraPosition, EulerAngles const& cameraOrientation, RenderCommandList& commandList, RenderBackend& backend);
+
+    void SetBoardPosition(int boardIndex, sChessPosition const& position);
+
+    int                              GetBoardCount() const;
+    sSpectatorFrameStatistics const& GetFrameStatistics() const;
+    Vec3                             GetOverviewCameraPosition() const;
+    EulerAngles                      GetOverviewCameraOrientation() const;
+
+private:
+    struct sPieceSection
+    {
+        VertexBuffer* m_vertexBuffer = nullptr;
+        IndexBuffer*  m_indexBuffer  = nullptr;
+        unsigned int  m_indexCount   = 0;
+    };
+
+    struct sSpectatorBoard
+    {
+        sChessPosition             m_position;
+        Vec3                       m_origin;
+        uint32_t                   m_revision      = 0;     // Bumped by SetBoardPosition on change
+        uint32_t                   m_bakedRevision = 0;
+        int                        m_lodLevel      = 0;
+        int                        m_bakedLodLevel = -1;
+        std::vector<sPieceSection> m_sections;              // One per material
+    };
+
+    struct sSelfPlayFeed
+    {
+        HeadlessMatch m_match;
+        float         m_secondsUntilMove = 0.f;
+    };
+
+    void RebuildBoard(sSpectatorBoard& board, RenderBackend& backend);
+    void UpdateSelfPlay(float deltaSeconds);
+
+    std::vector<sSpectatorBoard> m_boards;
+    std::vector<sSelfPlayFeed>   m_feeds;
+    int                          m_columnCount = 1;
+
+    PieceDefinition const*    m_definitions[SPECTATOR_PIECE_TYPE_COUNT]     = {};
+    int                       m_materialIndexes[SPECTATOR_PIECE_TYPE_COUNT] = {};
+    std::vector<sRenderState> m_materials;
+    float                     m_pieceBoundingRadius = 0.f;  // Largest LOD 0 radius of any definition
+    Mat44                     m_playerRotations[2];         // From each side's BoardDefinition
+    Rgba8                     m_playerColors[2]     = {Rgba8::WHITE, Rgba8::WHITE};
+
+    sRenderState  m_boardState;
+    VertexBuffer* m_boardVertexBuffer = nullptr;
+    IndexBuffer*  m_boardIndexBuffer  = nullptr;
+    unsigned int  m_boardIndexCount   = 0;
+    AABB3         m_boardLocalBounds;
+
+    FrustumCuller*            m_frustumCuller     = nullptr;
+    RenderCommandList         m_renderCommandList;
+    sSpectatorFrameStatistics m_frameStatistics;
+    int                       m_nextRebuildIndex  = 0;      // Where the next frame's rebuild budget starts
+    std::mt19937              m_random;
+    FixedTimestep             m_selfPlayTimestep;           // Same games at any frame rate for a given seed
+    std::vector<sChessMove>   m_legalMoves;                 // Scratch buffer reused by UpdateSelfPlay
+    VertexList_PCUTBN         m_scratchVerts;
+    IndexList                 m_scratchIndexes;
+};
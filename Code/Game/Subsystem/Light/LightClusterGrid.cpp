@@ -0,0 +1,389 @@
+//----------------------------------------------------------------------------------------------------
+// LightClusterGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr LIGHT_CLUSTER_TILES_PER_SLICE = LIGHT_CLUSTER_TILE_COUNT_X * LIGHT_CLUSTER_TILE_COUNT_Y;
+int constexpr LIGHT_CLUSTER_LIGHTS_PER_TASK = 256;
+
+//----------------------------------------------------------------------------------------------------
+static void RunTasks(WorkerThreadPool*                         workerThreadPool,
+                     int const                                 taskCount,
+                     std::function<void(int taskIndex)> const& task)
+{
+    if (workerThreadPool != nullptr)
+    {
+        workerThreadPool->ParallelFor(taskCount, task);
+        return;
+    }
+
+    for (int taskIndex = 0; taskIndex < taskCount; ++taskIndex)
+    {
+        task(taskIndex);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Rebuilds every cluster list for view. workerThreadPool may be null to build on this thread.
+void LightClusterGrid::Build(sLightClusterView const&   view,
+                             std::vector<sLight> const& lights,
+                             WorkerThreadPool*          workerThreadPool)
+{
+    double const startTime = GetCurrentTimeSeconds();
+
+    m_view = view;
+    m_view.m_orientation.GetAsVectors_IFwd_JLeft_KUp(m_forward, m_left, m_up);
+    m_tanHalfHeight = TanDegrees(view.m_fovDegrees * 0.5f);
+    m_tanHalfWidth  = m_tanHalfHeight * view.m_aspect;
+    m_firstSliceFar = GetClamped(LIGHT_CLUSTER_FIRST_SLICE_FAR, view.m_nearDistance, view.m_farDistance * 0.5f);
+    m_sliceScale    = static_cast<float>(LIGHT_CLUSTER_SLICE_COUNT - 1) / logf(view.m_farDistance / m_firstSliceFar);
+
+    // Pass 1: each light's view-space sphere and slice range, in chunks of lights.
+    int const lightCount = static_cast<int>(lights.size());
+    int const chunkCount = (lightCount + LIGHT_CLUSTER_LIGHTS_PER_TASK - 1) / LIGHT_CLUSTER_LIGHTS_PER_TASK;
+
+    m_lightRanges.resize(lightCount);
+
+    RunTasks(workerThreadPool, chunkCount, [this, &lights, lightCount](int const chunkIndex)
+    {
+        int const endIndex = std::min(lightCount, (chunkIndex + 1) * LIGHT_CLUSTER_LIGHTS_PER_TASK);
+
+        for (int lightIndex = chunkIndex * LIGHT_CLUSTER_LIGHTS_PER_TASK; lightIndex < endIndex; ++lightIndex)
+        {
+            ComputeLightRange(lights[lightIndex], m_lightRanges[lightIndex]);
+        }
+    });
+
+    // Lights that reach the view get slots in light order, so the grid is the same on any thread count.
+    m_statistics = sLightClusterStatistics();
+    m_slotRanges.clear();
+    m_slotLightIndexes.clear();
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        if (lights[lightIndex].m_type == eLightType::DIRECTIONAL) continue;
+
+        sLightRange const& range = m_lightRanges[lightIndex];
+
+        if (range.m_maxSlice < range.m_minSlice)
+        {
+            ++m_statistics.m_outsideCount;
+            continue;
+        }
+
+        if (static_cast<int>(m_slotLightIndexes.size()) == LIGHT_CLUSTER_MAX_LIGHT_COUNT)
+        {
+            ++m_statistics.m_droppedCount;
+            continue;
+        }
+
+        m_slotRanges.push_back(range);
+        m_slotLightIndexes.push_back(lightIndex);
+    }
+
+    // Pass 2: one task per slice counts and fills that slice's cluster lists.
+    m_sliceBins.resize(LIGHT_CLUSTER_SLICE_COUNT);
+
+    RunTasks(workerThreadPool, LIGHT_CLUSTER_SLICE_COUNT, [this](int const slice)
+    {
+        BinSlice(slice);
+    });
+
+    // Concatenate the slices, cutting off whatever does not fit the index buffer.
+    m_clusterOffsets.resize(LIGHT_CLUSTER_COUNT);
+    m_clusterCounts.resize(LIGHT_CLUSTER_COUNT);
+    m_clusterLightSlots.clear();
+
+    int totalIndexCount = 0;
+
+    for (int slice = 0; slice < LIGHT_CLUSTER_SLICE_COUNT; ++slice)
+    {
+        sSliceBins const& bins      = m_sliceBins[slice];
+        int const         baseIndex = totalIndexCount;
+
+        for (int tileIndex = 0; tileIndex < LIGHT_CLUSTER_TILES_PER_SLICE; ++tileIndex)
+        {
+            int const clusterIndex = slice * LIGHT_CLUSTER_TILES_PER_SLICE + tileIndex;
+            int const offset       = std::min(baseIndex + bins.m_offsets[tileIndex], LIGHT_CLUSTER_MAX_INDEX_COUNT);
+            int const count        = std::min(bins.m_counts[tileIndex], LIGHT_CLUSTER_MAX_INDEX_COUNT - offset);
+
+            m_clusterOffsets[clusterIndex] = offset;
+            m_clusterCounts[clusterIndex]  = count;
+            m_statistics.m_maxClusterCount = std::max(m_statistics.m_maxClusterCount, count);
+        }
+
+        int const sliceIndexCount = static_cast<int>(bins.m_slots.size());
+        int const keptCount       = std::max(0, std::min(sliceIndexCount, LIGHT_CLUSTER_MAX_INDEX_COUNT - baseIndex));
+
+        m_clusterLightSlots.insert(m_clusterLightSlots.end(), bins.m_slots.begin(), bins.m_slots.begin() + keptCount);
+        m_statistics.m_droppedIndexCount += sliceIndexCount - keptCount;
+        totalIndexCount                  += sliceIndexCount;
+    }
+
+    m_statistics.m_clusteredCount = static_cast<int>(m_slotLightIndexes.size());
+    m_statistics.m_indexCount     = static_cast<int>(m_clusterLightSlots.size());
+    m_statistics.m_buildSeconds   = GetCurrentTimeSeconds() - startTime;
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetClusterIndex(int const tileX,
+                                      int const tileY,
+                                      int const slice) const
+{
+    return slice * LIGHT_CLUSTER_TILES_PER_SLICE + tileY * LIGHT_CLUSTER_TILE_COUNT_X + tileX;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The cluster a world position falls in, the same way BlinnPhong.hlsl finds it, or -1 outside
+/// the view.
+int LightClusterGrid::FindClusterIndex(Vec3 const& worldPosition) const
+{
+    Vec3 const  displacement = worldPosition - m_view.m_position;
+    float const depth        = DotProduct3D(displacement, m_forward);
+
+    if (depth < m_view.m_nearDistance || depth > m_view.m_farDistance) return -1;
+
+    float const u = -DotProduct3D(displacement, m_left) / (depth * m_tanHalfWidth);
+    float const v = DotProduct3D(displacement, m_up) / (depth * m_tanHalfHeight);
+
+    if (u < -1.f || u > 1.f || v < -1.f || v > 1.f) return -1;
+
+    int const tileX = std::clamp(static_cast<int>(floorf((u + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_X)), 0, LIGHT_CLUSTER_TILE_COUNT_X - 1);
+    int const tileY = std::clamp(static_cast<int>(floorf((v + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_Y)), 0, LIGHT_CLUSTER_TILE_COUNT_Y - 1);
+
+    return GetClusterIndex(tileX, tileY, GetSliceForDepth(depth));
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetClusterOffset(int const clusterIndex) const
+{
+    return m_clusterOffsets[clusterIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetClusterLightCount(int const clusterIndex) const
+{
+    return m_clusterCounts[clusterIndex];
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<uint16_t> const& LightClusterGrid::GetClusterLightSlots() const
+{
+    return m_clusterLightSlots;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<int> const& LightClusterGrid::GetSlotLightIndexes() const
+{
+    return m_slotLightIndexes;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLightClusterStatistics const& LightClusterGrid::GetStatistics() const
+{
+    return m_statistics;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 LightClusterGrid::GetForward() const
+{
+    return m_forward;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 LightClusterGrid::GetLeft() const
+{
+    return m_left;
+}
+
+//----------------------------------------------------------------------------------------------------
+Vec3 LightClusterGrid::GetUp() const
+{
+    return m_up;
+}
+
+//----------------------------------------------------------------------------------------------------
+float LightClusterGrid::GetTanHalfWidth() const
+{
+    return m_tanHalfWidth;
+}
+
+//----------------------------------------------------------------------------------------------------
+float LightClusterGrid::GetTanHalfHeight() const
+{
+    return m_tanHalfHeight;
+}
+
+//----------------------------------------------------------------------------------------------------
+float LightClusterGrid::GetSliceScale() const
+{
+    return m_sliceScale;
+}
+
+//----------------------------------------------------------------------------------------------------
+float LightClusterGrid::GetFirstSliceFar() const
+{
+    return m_firstSliceFar;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLightClusterView const& LightClusterGrid::GetView() const
+{
+    return m_view;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Point lights are bounded by the sphere of their outer radius. Spot lights get the same
+/// sphere widened by LIGHT_SPOT_ORBIT_RADIUS, since the shader circles them around their position.
+void LightClusterGrid::ComputeLightRange(sLight const& light,
+                                         sLightRange&  out_range) const
+{
+    out_range.m_minSlice = 0;
+    out_range.m_maxSlice = -1;
+
+    if (light.m_type == eLightType::DIRECTIONAL) return;
+
+    Vec3 const displacement = light.m_worldPosition - m_view.m_position;
+
+    out_range.m_viewCenter = Vec3(-DotProduct3D(displacement, m_left), DotProduct3D(displacement, m_up), DotProduct3D(displacement, m_forward));
+    out_range.m_radius     = light.m_type == eLightType::SPOT ? light.m_outerRadius + LIGHT_SPOT_ORBIT_RADIUS : light.m_outerRadius;
+
+    float const minDepth = std::max(out_range.m_viewCenter.z - out_range.m_radius, m_view.m_nearDistance);
+    float const maxDepth = std::min(out_range.m_viewCenter.z + out_range.m_radius, m_view.m_farDistance);
+
+    if (minDepth > maxDepth) return;
+
+    int minX;
+    int maxX;
+    int minY;
+    int maxY;
+
+    if (!ComputeTileRange(out_range, minDepth, maxDepth, minX, maxX, minY, maxY)) return;
+
+    out_range.m_minSlice = GetSliceForDepth(minDepth);
+    out_range.m_maxSlice = GetSliceForDepth(maxDepth);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Screen tiles covered by the part of the light's bounding box between minDepth and maxDepth.
+/// x / depth is monotonic in both, so the extremes come from the box's corners. Returns false when the
+/// box is beside or above the view.
+bool LightClusterGrid::ComputeTileRange(sLightRange const& range,
+                                        float const        minDepth,
+                                        float const        maxDepth,
+                                        int&               out_minX,
+                                        int&               out_maxX,
+                                        int&               out_minY,
+                                        int&               out_maxY) const
+{
+    float const minX = range.m_viewCenter.x - range.m_radius;
+    float const maxX = range.m_viewCenter.x + range.m_radius;
+    float const minY = range.m_viewCenter.y - range.m_radius;
+    float const maxY = range.m_viewCenter.y + range.m_radius;
+
+    float const minU = minX / ((minX < 0.f ? minDepth : maxDepth) * m_tanHalfWidth);
+    float const maxU = maxX / ((maxX > 0.f ? minDepth : maxDepth) * m_tanHalfWidth);
+    float const minV = minY / ((minY < 0.f ? minDepth : maxDepth) * m_tanHalfHeight);
+    float const maxV = maxY / ((maxY > 0.f ? minDepth : maxDepth) * m_tanHalfHeight);
+
+    if (maxU < -1.f || minU > 1.f || maxV < -1.f || minV > 1.f) return false;
+
+    out_minX = std::clamp(static_cast<int>(floorf((minU + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_X)), 0, LIGHT_CLUSTER_TILE_COUNT_X - 1);
+    out_maxX = std::clamp(static_cast<int>(floorf((maxU + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_X)), 0, LIGHT_CLUSTER_TILE_COUNT_X - 1);
+    out_minY = std::clamp(static_cast<int>(floorf((minV + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_Y)), 0, LIGHT_CLUSTER_TILE_COUNT_Y - 1);
+    out_maxY = std::clamp(static_cast<int>(floorf((maxV + 1.f) * 0.5f * LIGHT_CLUSTER_TILE_COUNT_Y)), 0, LIGHT_CLUSTER_TILE_COUNT_Y - 1);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Counts, then fills, every cluster list of one slice. Each light's tile range is narrowed to
+/// the slice's depth interval, so a light only lands in the tiles it covers at that depth.
+void LightClusterGrid::BinSlice(int const slice)
+{
+    sSliceBins& bins = m_sliceBins[slice];
+
+    bins.m_counts.assign(LIGHT_CLUSTER_TILES_PER_SLICE, 0);
+    bins.m_offsets.resize(LIGHT_CLUSTER_TILES_PER_SLICE);
+
+    // Widened slightly so rounding between logf here and powf in GetSliceForDepth cannot drop a light.
+    float const sliceNearDepth = GetSliceNearDepth(slice) * 0.999f;
+    float const sliceFarDepth  = GetSliceNearDepth(slice + 1) * 1.001f;
+    int const   slotCount      = static_cast<int>(m_slotRanges.size());
+
+    for (int pass = 0; pass < 2; ++pass)
+    {
+        if (pass == 1)
+        {
+            int indexCount = 0;
+
+            for (int tileIndex = 0; tileIndex < LIGHT_CLUSTER_TILES_PER_SLICE; ++tileIndex)
+            {
+                bins.m_offsets[tileIndex] = indexCount;
+                indexCount                += bins.m_counts[tileIndex];
+                bins.m_counts[tileIndex]  = 0;      // Refilled below as the write cursor
+            }
+
+            bins.m_slots.resize(indexCount);
+        }
+
+        for (int slot = 0; slot < slotCount; ++slot)
+        {
+            sLightRange const& range = m_slotRanges[slot];
+
+            if (slice < range.m_minSlice || slice > range.m_maxSlice) continue;
+
+            float const minDepth = std::max(range.m_viewCenter.z - range.m_radius, sliceNearDepth);
+            float const maxDepth = std::min(range.m_viewCenter.z + range.m_radius, sliceFarDepth);
+            int         minX;
+            int         maxX;
+            int         minY;
+            int         maxY;
+
+            if (!ComputeTileRange(range, minDepth, maxDepth, minX, maxX, minY, maxY)) continue;
+
+            for (int tileY = minY; tileY <= maxY; ++tileY)
+            {
+                for (int tileX = minX; tileX <= maxX; ++tileX)
+                {
+                    int const tileIndex = tileY * LIGHT_CLUSTER_TILE_COUNT_X + tileX;
+
+                    if (pass == 1) bins.m_slots[bins.m_offsets[tileIndex] + bins.m_counts[tileIndex]] = static_cast<uint16_t>(slot);
+
+                    ++bins.m_counts[tileIndex];
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightClusterGrid::GetSliceForDepth(float const depth) const
+{
+    if (depth < m_firstSliceFar) return 0;
+
+    int const slice = 1 + static_cast<int>(floorf(logf(depth / m_firstSliceFar) * m_sliceScale));
+
+    return std::clamp(slice, 0, LIGHT_CLUSTER_SLICE_COUNT - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Past slice 0, slices are spaced exponentially, so each covers the same ratio of depths.
+float LightClusterGrid::GetSliceNearDepth(int const slice) const
+{
+    if (slice == 0) return m_view.m_nearDistance;
+
+    return m_firstSliceFar * powf(m_view.m_farDistance / m_firstSliceFar, static_cast<float>(slice - 1) / static_cast<float>(LIGHT_CLUSTER_SLICE_COUNT - 1));
+}
@@ -0,0 +1,129 @@
+//----------------------------------------------------------------------------------------------------
+// LightClusterGrid.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Vec3.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class WorkerThreadPool;
+struct sLight;
+
+//----------------------------------------------------------------------------------------------------
+// Must match the LIGHT_CLUSTER_* defines in BlinnPhong.hlsl.
+int constexpr   LIGHT_CLUSTER_TILE_COUNT_X    = 16;
+int constexpr   LIGHT_CLUSTER_TILE_COUNT_Y    = 8;
+int constexpr   LIGHT_CLUSTER_SLICE_COUNT     = 24;
+int constexpr   LIGHT_CLUSTER_COUNT           = LIGHT_CLUSTER_TILE_COUNT_X * LIGHT_CLUSTER_TILE_COUNT_Y * LIGHT_CLUSTER_SLICE_COUNT;
+int constexpr   LIGHT_CLUSTER_MAX_LIGHT_COUNT = 1024;      // 64-byte lights filling one 64 KB constant buffer
+int constexpr   LIGHT_CLUSTER_MAX_INDEX_COUNT = 32768;     // 16-bit indexes filling one 64 KB constant buffer
+float constexpr LIGHT_CLUSTER_FIRST_SLICE_FAR = 1.f;       // Slice 0 spans the near plane to here
+float constexpr LIGHT_SPOT_ORBIT_RADIUS       = 5.f;       // How far the shader swings spot lights around their position
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The camera the grid is built for; the same projection the player camera uses.
+struct sLightClusterView
+{
+    Vec3        m_position;
+    EulerAngles m_orientation;
+    float       m_aspect       = 1.f;
+    float       m_fovDegrees   = 60.f;
+    float       m_nearDistance = 0.1f;
+    float       m_farDistance  = 100.f;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief What the last Build kept and threw away.
+struct sLightClusterStatistics
+{
+    double m_buildSeconds      = 0.0;
+    int    m_clusteredCount    = 0;     // Point and spot lights inside the view, listed in the grid
+    int    m_outsideCount      = 0;     // Point and spot lights that reach no cluster
+    int    m_droppedCount      = 0;     // Inside the view but past LIGHT_CLUSTER_MAX_LIGHT_COUNT
+    int    m_indexCount        = 0;
+    int    m_droppedIndexCount = 0;     // Past LIGHT_CLUSTER_MAX_INDEX_COUNT
+    int    m_maxClusterCount   = 0;     // Longest single cluster list
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Bins point and spot lights into a froxel grid: LIGHT_CLUSTER_TILE_COUNT_X by _Y screen tiles, each
+/// cut into LIGHT_CLUSTER_SLICE_COUNT depth slices. Slice 0 runs from the near plane to
+/// LIGHT_CLUSTER_FIRST_SLICE_FAR, where little is drawn; the rest are spaced exponentially to the far
+/// plane, so a near plane of 0.1 does not squeeze the useful depths into a few deep slices.
+/// Lights are treated as spheres of their outer radius, widened by LIGHT_SPOT_ORBIT_RADIUS for spot
+/// lights, and projected conservatively, so a cluster may list a light that misses it but never misses
+/// one that reaches it. Directional lights reach every pixel and are left to the global light constants.
+///
+/// Build runs in two parallel passes: one over chunks of lights to find each light's slice range, then
+/// one per slice to count and fill that slice's cluster lists. Lights inside the view are renumbered
+/// into slots 0..N-1 in light order, and cluster lists hold slots, in ascending order.
+/// Everything here is CPU-side; the LightSubsystem packs the results into constant buffers.
+class LightClusterGrid
+{
+public:
+    void Build(sLightClusterView const& view, std::vector<sLight> const& lights, WorkerThreadPool* workerThreadPool);
+
+    int                            GetClusterIndex(int tileX, int tileY, int slice) const;
+    int                            FindClusterIndex(Vec3 const& worldPosition) const;
+    int                            GetClusterOffset(int clusterIndex) const;
+    int                            GetClusterLightCount(int clusterIndex) const;
+    std::vector<uint16_t> const&   GetClusterLightSlots() const;
+    std::vector<int> const&        GetSlotLightIndexes() const;
+    sLightClusterStatistics const& GetStatistics() const;
+
+    Vec3                     GetForward() const;
+    Vec3                     GetLeft() const;
+    Vec3                     GetUp() const;
+    float                    GetTanHalfWidth() const;
+    float                    GetTanHalfHeight() const;
+    float                    GetSliceScale() const;
+    float                    GetFirstSliceFar() const;
+    sLightClusterView const& GetView() const;
+
+private:
+    struct sLightRange
+    {
+        Vec3  m_viewCenter;                 // x right, y up, z forward
+        float m_radius   = 0.f;
+        int   m_minSlice = 0;
+        int   m_maxSlice = -1;              // Below m_minSlice when the light reaches no slice
+    };
+
+    struct sSliceBins
+    {
+        std::vector<int>      m_counts;     // One per cluster in the slice
+        std::vector<int>      m_offsets;    // Within m_slots
+        std::vector<uint16_t> m_slots;
+    };
+
+    void  ComputeLightRange(sLight const& light, sLightRange& out_range) const;
+    bool  ComputeTileRange(sLightRange const& range, float minDepth, float maxDepth, int& out_minX, int& out_maxX, int& out_minY, int& out_maxY) const;
+    void  BinSlice(int slice);
+    int   GetSliceForDepth(float depth) const;
+    float GetSliceNearDepth(int slice) const;
+
+    sLightClusterView m_view;
+    Vec3              m_forward;
+    Vec3              m_left;
+    Vec3              m_up;
+    float             m_tanHalfWidth  = 1.f;
+    float             m_tanHalfHeight = 1.f;
+    float             m_firstSliceFar = 1.f;
+    float             m_sliceScale    = 1.f;    // (LIGHT_CLUSTER_SLICE_COUNT - 1) / ln(far / m_firstSliceFar)
+
+    std::vector<sLightRange> m_lightRanges;     // One per input light
+    std::vector<sLightRange> m_slotRanges;      // One per slot
+    std::vector<int>         m_slotLightIndexes;
+    std::vector<sSliceBins>  m_sliceBins;
+
+    std::vector<int>         m_clusterOffsets;
+    std::vector<int>         m_clusterCounts;
+    std::vector<uint16_t>    m_clusterLightSlots;
+    sLightClusterStatistics  m_statistics;
+};
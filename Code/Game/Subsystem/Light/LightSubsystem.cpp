@@ -5,15 +5,100 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Subsystem/Light/LightSubsystem.hpp"
 
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Engine/Renderer/ConstantBuffer.hpp"
 #include "Engine/Renderer/Light.hpp"
 #include "Engine/Renderer/RenderCommon.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
 #include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/PlayerController.hpp"
+#include "Game/Framework/Profiler.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr LIGHT_STRESS_FIRST_INDEX          = 3;    // Lights before this index are the StartUp defaults
+int constexpr LIGHT_CLUSTER_CONSTANT_SLOT       = 8;    // Game-specific slots b8-b10 in BlinnPhong.hlsl
+int constexpr LIGHT_CLUSTER_INDEX_CONSTANT_SLOT = 9;
+int constexpr LIGHT_CLUSTER_LIGHT_CONSTANT_SLOT = 10;
+
+static_assert(sizeof(sClusterLightConstants) == 64, "sClusterLightConstants must match the shader's Light");
+static_assert(sizeof(sClusterLightConstants) * LIGHT_CLUSTER_MAX_LIGHT_COUNT <= 65536, "Clustered lights must fit one constant buffer");
+static_assert(sizeof(uint16_t) * LIGHT_CLUSTER_MAX_INDEX_COUNT <= 65536, "Cluster light indexes must fit one constant buffer");
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetType(eLightType const type)
+{
+    m_type = type;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetWorldPosition(Vec3 const& worldPosition)
+{
+    m_worldPosition = worldPosition;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetRadius(float const innerRadius,
+                          float const outerRadius)
+{
+    m_innerRadius = innerRadius;
+    m_outerRadius = outerRadius;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetColor(Vec3 const& color)
+{
+    m_color = color;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetIntensity(float const intensity)
+{
+    m_intensity = intensity;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetColorWithIntensity(Vec4 const& colorWithIntensity)
+{
+    m_color     = Vec3(colorWithIntensity.x, colorWithIntensity.y, colorWithIntensity.z);
+    m_intensity = colorWithIntensity.w;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetDirection(Vec3 const& direction)
+{
+    m_direction = direction;
+    return *this;
+}
+
+//----------------------------------------------------------------------------------------------------
+sLight& sLight::SetConeAngles(float const innerConeCos,
+                              float const outerConeCos)
+{
+    m_innerConeCos = innerConeCos;
+    m_outerConeCos = outerConeCos;
+    return *this;
+}
 
 //------------------------------------------------------------------------------------------------
 LightSubsystem::LightSubsystem()
 {
-    // Initialize CBO - you'll need to adapt this to your engine's CBO creation method
 }
 
 LightSubsystem::LightSubsystem(sLightSubsystemConfig const config)
@@ -23,8 +108,17 @@ LightSubsystem::LightSubsystem(sLightSubsystemConfig const config)
 
 void LightSubsystem::StartUp()
 {
-    Light* light1 = new Light();
-    light1->SetType(eLightType::SPOT)
+    g_theEventSystem->SubscribeEventCallbackFunction("light_stress", OnLightStress);
+    g_theEventSystem->SubscribeEventCallbackFunction("light_clustered", OnLightClustered);
+    g_theEventSystem->SubscribeEventCallbackFunction("light_cluster_benchmark", OnLightClusterBenchmark);
+
+    m_workerThreadPool           = new WorkerThreadPool(m_config.m_clusterThreadCount);
+    m_clusterConstantBuffer      = g_theRenderer->CreateConstantBuffer(sizeof(sLightClusterConstants));
+    m_clusterIndexConstantBuffer = g_theRenderer->CreateConstantBuffer(sizeof(uint16_t) * LIGHT_CLUSTER_MAX_INDEX_COUNT);
+    m_clusterLightConstantBuffer = g_theRenderer->CreateConstantBuffer(sizeof(sClusterLightConstants) * LIGHT_CLUSTER_MAX_LIGHT_COUNT);
+
+    sLight light1;
+    light1.SetType(eLightType::SPOT)
           .SetWorldPosition(Vec3(2.f, 2.f, 5.f))
           .SetRadius(0.5f, 15.f)
           .SetColor(Rgba8::CYAN.GetAsVec3())
@@ -32,16 +126,16 @@ void LightSubsystem::StartUp()
           .SetDirection(-Vec3::Z_BASIS)
           .SetConeAngles(CosDegrees(5.f), CosDegrees(25.f));
 
-    Light* light2 = new Light();
-    light2->SetType(eLightType::SPOT)
+    sLight light2;
+    light2.SetType(eLightType::SPOT)
           .SetWorldPosition(Vec3(4, 4, 5))
           .SetRadius(0.5f, 15.f)
           .SetColorWithIntensity(Vec4(1.f, 0.f, 1.f, 8.f))
           .SetDirection(-Vec3::Z_BASIS)
           .SetConeAngles(CosDegrees(5.f), CosDegrees(25.f));
 
-    Light* light3 = new Light();
-    light3->SetType(eLightType::DIRECTIONAL)
+    sLight light3;
+    light3.SetType(eLightType::DIRECTIONAL)
           .SetColor(Rgba8::WHITE.GetAsVec3())
           .SetIntensity(1.f)
           .SetDirection(Vec3(2.f, 1.f, -1.f).GetNormalized());
@@ -52,9 +146,13 @@ void LightSubsystem::StartUp()
     AddLight(light3);
 }
 
+//----------------------------------------------------------------------------------------------------
+/// @brief Binds the default set, which uploads only if a light changed since the last upload. The
+/// Renderer keeps the light constant buffer bound between frames, so skipping the upload is safe.
 void LightSubsystem::BeginFrame()
 {
-    g_theRenderer->SetLightConstants(m_lights, GetLightCount());
+    ResetLightSets();
+    BindLightSet(0);
 }
 
 void LightSubsystem::Update()
@@ -71,39 +169,55 @@ void LightSubsystem::EndFrame()
 
 void LightSubsystem::ShutDown()
 {
-    for (Light* light : m_lights)
-    {
-        GAME_SAFE_RELEASE(light);
-    }
+    ClearLights();
+
+    GAME_SAFE_RELEASE(m_clusterConstantBuffer);
+    GAME_SAFE_RELEASE(m_clusterIndexConstantBuffer);
+    GAME_SAFE_RELEASE(m_clusterLightConstantBuffer);
+    GAME_SAFE_RELEASE(m_workerThreadPool);
 }
 
-void LightSubsystem::AddLight(Light* light)
+//----------------------------------------------------------------------------------------------------
+int LightSubsystem::AddLight(sLight const& light)
 {
-    if (m_lights.size() < MAX_LIGHTS)
-    {
-        if (light == nullptr) return;
-        m_lights.push_back(light);
-    }
+    m_lights.push_back(light);
+    ++m_revision;
+
+    return static_cast<int>(m_lights.size()) - 1;
 }
 
-void LightSubsystem::RemoveLight(int index)
+void LightSubsystem::RemoveLight(int const index)
 {
     if (index >= 0 && index < (int)m_lights.size())
     {
         m_lights.erase(m_lights.begin() + index);
+        ++m_revision;
     }
 }
 
 void LightSubsystem::ClearLights()
 {
     m_lights.clear();
+    ++m_revision;
 }
 
-Light* LightSubsystem::GetLight(int index)
+sLight const* LightSubsystem::GetLight(int const index) const
 {
     if (index >= 0 && index < (int)m_lights.size())
     {
-        return m_lights[index];
+        return &m_lights[index];
+    }
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Mutable access counts as a change: the revision is bumped whether or not the caller edits.
+sLight* LightSubsystem::EditLight(int const index)
+{
+    if (index >= 0 && index < (int)m_lights.size())
+    {
+        ++m_revision;
+        return &m_lights[index];
     }
     return nullptr;
 }
@@ -112,3 +226,478 @@ int LightSubsystem::GetLightCount() const
 {
     return (int)m_lights.size();
 }
+
+//----------------------------------------------------------------------------------------------------
+uint32_t LightSubsystem::GetRevision() const
+{
+    return m_revision;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Up to MAX_LIGHTS lights that can reach worldBounds: directional lights first, then point and
+/// spot lights whose outer radius touches the bounds, brightest and nearest first. Draws with the same
+/// lights share a set id, so the command list can sort and bind them together.
+int LightSubsystem::GetLightSetForBounds(AABB3 const& worldBounds)
+{
+    if (m_config.m_isClustered || static_cast<int>(m_lights.size()) <= MAX_LIGHTS) return 0;
+
+    if (m_lightSetsRevision != m_revision) ResetLightSets();
+
+    m_scratchIndexes.clear();
+    m_scratchScores.resize(m_lights.size());
+
+    for (int lightIndex = 0; lightIndex < static_cast<int>(m_lights.size()); ++lightIndex)
+    {
+        sLight const& light = m_lights[lightIndex];
+
+        if (light.m_type == eLightType::DIRECTIONAL)
+        {
+            m_scratchScores[lightIndex] = FLOAT_MAX;
+            m_scratchIndexes.push_back(lightIndex);
+            continue;
+        }
+
+        Vec3 const nearestPoint(GetClamped(light.m_worldPosition.x, worldBounds.m_mins.x, worldBounds.m_maxs.x),
+                                GetClamped(light.m_worldPosition.y, worldBounds.m_mins.y, worldBounds.m_maxs.y),
+                                GetClamped(light.m_worldPosition.z, worldBounds.m_mins.z, worldBounds.m_maxs.z));
+        float const distanceSquared = (nearestPoint - light.m_worldPosition).GetLengthSquared();
+
+        if (distanceSquared > light.m_outerRadius * light.m_outerRadius) continue;
+
+        m_scratchScores[lightIndex] = light.m_intensity / (1.f + distanceSquared);
+        m_scratchIndexes.push_back(lightIndex);
+    }
+
+    if (static_cast<int>(m_scratchIndexes.size()) > MAX_LIGHTS)
+    {
+        std::partial_sort(m_scratchIndexes.begin(), m_scratchIndexes.begin() + MAX_LIGHTS, m_scratchIndexes.end(), [this](int const a, int const b)
+        {
+            return m_scratchScores[a] > m_scratchScores[b];
+        });
+
+        m_scratchIndexes.resize(MAX_LIGHTS);
+    }
+
+    // Canonical order, so the same lights always compare equal.
+    std::sort(m_scratchIndexes.begin(), m_scratchIndexes.end());
+
+    return FindOrAddLightSet(m_scratchIndexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightSubsystem::GetLightSetForBounds(AABB3 const& localBounds,
+                                         Mat44 const& modelToWorld)
+{
+    if (m_config.m_isClustered || static_cast<int>(m_lights.size()) <= MAX_LIGHTS) return 0;
+
+    return GetLightSetForBounds(TransformBounds(localBounds, modelToWorld));
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightSubsystem::GetLightSetCount() const
+{
+    return m_lightSetCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Uploads lightSetId's lights unless the constant buffer already holds exactly those lights at
+/// the current revision. An id from before the last change falls back to the default set.
+void LightSubsystem::BindLightSet(int const lightSetId)
+{
+    if (m_lightSetsRevision != m_revision) ResetLightSets();
+
+    std::vector<int> const& lightIndexes = m_lightSets[lightSetId > 0 && lightSetId < m_lightSetCount ? lightSetId : 0];
+
+    if (m_boundRevision == m_revision && m_boundLightIndexes == lightIndexes)
+    {
+        RecordRenderLightUpload(false);
+        return;
+    }
+
+    UploadLights(lightIndexes);
+    RecordRenderLightUpload(true);
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightSubsystem::GetUploadCount() const
+{
+    return m_uploadCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Bins the point and spot lights for this camera and uploads the cluster lists through backend.
+/// Skipped when neither the lights nor the camera moved since the last upload. Call before submitting
+/// lit draws.
+void LightSubsystem::BuildLightClusters(Vec3 const&        cameraPosition,
+                                        EulerAngles const& cameraOrientation,
+                                        RenderBackend&     backend)
+{
+    PROFILE_SCOPE("LightSubsystem::BuildLightClusters");
+
+    if (!m_config.m_isClustered) return;
+
+    bool const isViewUnchanged = cameraPosition == m_clusterPosition &&
+                                 cameraOrientation.m_yawDegrees == m_clusterOrientation.m_yawDegrees &&
+                                 cameraOrientation.m_pitchDegrees == m_clusterOrientation.m_pitchDegrees &&
+                                 cameraOrientation.m_rollDegrees == m_clusterOrientation.m_rollDegrees;
+
+    if (isViewUnchanged && m_clusterRevision == m_revision) return;
+
+    sLightClusterView view;
+    view.m_position     = cameraPosition;
+    view.m_orientation  = cameraOrientation;
+    view.m_aspect       = PLAYER_CAMERA_ASPECT;
+    view.m_fovDegrees   = PLAYER_CAMERA_FOV_DEGREES;
+    view.m_nearDistance = PLAYER_CAMERA_NEAR;
+    view.m_farDistance  = PLAYER_CAMERA_FAR;
+
+    m_clusterGrid.Build(view, m_lights, m_workerThreadPool);
+    UploadLightClusters(backend);
+
+    m_clusterPosition    = cameraPosition;
+    m_clusterOrientation = cameraOrientation;
+    m_clusterRevision    = m_revision;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Switching moves the point and spot lights between the light sets and the clusters. Turning
+/// clustering off uploads an empty cluster grid so the shader stops reading stale lists.
+void LightSubsystem::SetClustered(bool const isClustered)
+{
+    if (m_config.m_isClustered == isClustered) return;
+
+    m_config.m_isClustered = isClustered;
+    ++m_revision;
+
+    if (!isClustered)
+    {
+        m_clusterConstants.m_lightCount = 0;
+        g_theRenderer->CopyCPUToGPU(&m_clusterConstants, sizeof(m_clusterConstants), m_clusterConstantBuffer);
+        g_theRenderer->BindConstantBuffer(LIGHT_CLUSTER_CONSTANT_SLOT, m_clusterConstantBuffer);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool LightSubsystem::IsClustered() const
+{
+    return m_config.m_isClustered;
+}
+
+//----------------------------------------------------------------------------------------------------
+LightClusterGrid const& LightSubsystem::GetLightClusterGrid() const
+{
+    return m_clusterGrid;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief light_stress count=16 seed=0
+/// Replaces every light after the StartUp defaults with count random point lights over the board.
+STATIC bool LightSubsystem::OnLightStress(EventArgs& args)
+{
+    int const      lightCount = args.GetValue("count", 16);
+    unsigned const seed       = static_cast<unsigned>(args.GetValue("seed", 0));
+
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> positionDistribution(0.f, 8.f);
+    std::uniform_real_distribution<float> unitDistribution(0.f, 1.f);
+
+    while (g_theLightSubsystem->GetLightCount() > LIGHT_STRESS_FIRST_INDEX)
+    {
+        g_theLightSubsystem->RemoveLight(g_theLightSubsystem->GetLightCount() - 1);
+    }
+
+    for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+    {
+        sLight light;
+        light.SetType(eLightType::POINT)
+             .SetWorldPosition(Vec3(positionDistribution(random), positionDistribution(random), 1.f + unitDistribution(random) * 2.f))
+             .SetRadius(0.25f, 2.f + unitDistribution(random) * 2.f)
+             .SetColorWithIntensity(Vec4(unitDistribution(random), unitDistribution(random), unitDistribution(random), 4.f));
+        g_theLightSubsystem->AddLight(light);
+    }
+
+    if (g_theLightSubsystem->IsClustered())
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LightStress] %d lights, point and spot lights clustered", g_theLightSubsystem->GetLightCount()));
+    }
+    else
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LightStress] %d lights, %d per draw at most", g_theLightSubsystem->GetLightCount(), MAX_LIGHTS));
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief light_clustered enabled=true
+STATIC bool LightSubsystem::OnLightClustered(EventArgs& args)
+{
+    bool const isClustered = args.GetValue("enabled", true);
+
+    g_theLightSubsystem->SetClustered(isClustered);
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LightCluster] Clustered point and spot lights %s", isClustered ? "on" : "off"));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief light_cluster_benchmark count=4096 seed=0 frames=30 threads=0 samples=20000
+/// Bins count random point and spot lights scattered over a 40 x 40 area in front of a fixed camera,
+/// single-threaded and on a pool of threads (0 uses every hardware thread), and reports the average
+/// build time of each. Then checks the result: the pooled grid must equal the single-threaded one, and
+/// for samples random points inside the view, every light whose sphere holds the point must be listed
+/// in the point's cluster. Nothing is drawn or uploaded, and the scene's own lights are untouched.
+STATIC bool LightSubsystem::OnLightClusterBenchmark(EventArgs& args)
+{
+    int const      lightCount  = std::max(1, args.GetValue("count", 4096));
+    unsigned const seed        = static_cast<unsigned>(args.GetValue("seed", 0));
+    int const      frameCount  = std::max(1, args.GetValue("frames", 30));
+    int const      threadCount = args.GetValue("threads", 0);
+    int const      sampleCount = std::max(0, args.GetValue("samples", 20000));
+
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> areaDistribution(-20.f, 20.f);
+    std::uniform_real_distribution<float> unitDistribution(0.f, 1.f);
+    std::vector<sLight>                   lights(lightCount);
+
+    for (sLight& light : lights)
+    {
+        bool const isSpot = unitDistribution(random) < 0.25f;
+
+        light.SetType(isSpot ? eLightType::SPOT : eLightType::POINT)
+             .SetWorldPosition(Vec3(areaDistribution(random), areaDistribution(random), unitDistribution(random) * 4.f))
+             .SetRadius(0.1f, 0.5f + unitDistribution(random) * 2.f)
+             .SetColorWithIntensity(Vec4(unitDistribution(random), unitDistribution(random), unitDistribution(random), 2.f))
+             .SetDirection(-Vec3::Z_BASIS)
+             .SetConeAngles(CosDegrees(10.f), CosDegrees(30.f));
+    }
+
+    sLightClusterView view;
+    view.m_position     = Vec3(-24.f, 0.f, 12.f);
+    view.m_orientation  = EulerAngles(0.f, 25.f, 0.f);
+    view.m_aspect       = PLAYER_CAMERA_ASPECT;
+    view.m_fovDegrees   = PLAYER_CAMERA_FOV_DEGREES;
+    view.m_nearDistance = PLAYER_CAMERA_NEAR;
+    view.m_farDistance  = PLAYER_CAMERA_FAR;
+
+    WorkerThreadPool workerThreadPool(threadCount);
+    LightClusterGrid serialGrid;
+    LightClusterGrid pooledGrid;
+
+    double serialStartTime = GetCurrentTimeSeconds();
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        serialGrid.Build(view, lights, nullptr);
+    }
+
+    double const serialSeconds   = (GetCurrentTimeSeconds() - serialStartTime) / frameCount;
+    double const pooledStartTime = GetCurrentTimeSeconds();
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        pooledGrid.Build(view, lights, &workerThreadPool);
+    }
+
+    double const pooledSeconds = (GetCurrentTimeSeconds() - pooledStartTime) / frameCount;
+
+    // The pooled build must be exactly the single-threaded one.
+    bool isMatching = serialGrid.GetClusterLightSlots() == pooledGrid.GetClusterLightSlots() &&
+                      serialGrid.GetSlotLightIndexes() == pooledGrid.GetSlotLightIndexes();
+
+    for (int clusterIndex = 0; clusterIndex < LIGHT_CLUSTER_COUNT && isMatching; ++clusterIndex)
+    {
+        isMatching = serialGrid.GetClusterOffset(clusterIndex) == pooledGrid.GetClusterOffset(clusterIndex) &&
+                     serialGrid.GetClusterLightCount(clusterIndex) == pooledGrid.GetClusterLightCount(clusterIndex);
+    }
+
+    // Every light reaching a sample point must be in the point's cluster, unless capacity dropped it.
+    sLightClusterStatistics const& statistics   = pooledGrid.GetStatistics();
+    std::vector<int> const&        slotLights   = pooledGrid.GetSlotLightIndexes();
+    std::vector<uint16_t> const&   clusterSlots = pooledGrid.GetClusterLightSlots();
+    std::vector<int>               lightSlots(lightCount, -1);
+    int                            testedCount  = 0;
+    int                            missedCount  = 0;
+
+    for (int slot = 0; slot < static_cast<int>(slotLights.size()); ++slot)
+    {
+        lightSlots[slotLights[slot]] = slot;
+    }
+
+    for (int sample = 0; sample < sampleCount; ++sample)
+    {
+        Vec3 const point(areaDistribution(random), areaDistribution(random), unitDistribution(random) * 4.f);
+        int const  clusterIndex = pooledGrid.FindClusterIndex(point);
+
+        if (clusterIndex < 0) continue;
+
+        ++testedCount;
+
+        int const firstIndex = pooledGrid.GetClusterOffset(clusterIndex);
+        int const lastIndex  = firstIndex + pooledGrid.GetClusterLightCount(clusterIndex);
+
+        for (int lightIndex = 0; lightIndex < lightCount; ++lightIndex)
+        {
+            sLight const& light = lights[lightIndex];
+
+            if ((point - light.m_worldPosition).GetLengthSquared() > light.m_outerRadius * light.m_outerRadius) continue;
+            if (lightSlots[lightIndex] < 0 && statistics.m_droppedCount > 0) continue;
+
+            bool const isListed = lightSlots[lightIndex] >= 0 &&
+                                  std::find(clusterSlots.begin() + firstIndex, clusterSlots.begin() + lastIndex, lightSlots[lightIndex]) != clusterSlots.begin() + lastIndex;
+
+            if (!isListed) ++missedCount;
+        }
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[LightCluster] %d lights: %d clustered, %d outside, %d dropped; %d indexes (%d dropped), at most %d per cluster", lightCount, statistics.m_clusteredCount, statistics.m_outsideCount, statistics.m_droppedCount, statistics.m_indexCount, statistics.m_droppedIndexCount, statistics.m_maxClusterCount));
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[LightCluster] 1 thread %.3f ms, %d threads %.3f ms (%.2fx) over %d frames", serialSeconds * 1000.0, workerThreadPool.GetThreadCount(), pooledSeconds * 1000.0, pooledSeconds > 0.0 ? serialSeconds / pooledSeconds : 0.0, frameCount));
+    g_theDevConsole->AddLine(missedCount == 0 && isMatching ? DevConsole::INFO_MINOR : DevConsole::ERROR, Stringf("[LightCluster] %d points checked, %d lights missed; pooled grid %s the single-threaded grid", testedCount, missedCount, isMatching ? "matches" : "DIFFERS FROM"));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Drops the per-draw sets and rebuilds the default set 0 from the current lights. While
+/// clustered, set 0 holds only the directional lights.
+void LightSubsystem::ResetLightSets()
+{
+    if (m_lightSets.empty()) m_lightSets.resize(1);
+
+    std::vector<int>& defaultSet = m_lightSets[0];
+    defaultSet.clear();
+
+    for (int lightIndex = 0; lightIndex < static_cast<int>(m_lights.size()); ++lightIndex)
+    {
+        if (m_config.m_isClustered && m_lights[lightIndex].m_type != eLightType::DIRECTIONAL) continue;
+
+        defaultSet.push_back(lightIndex);
+    }
+
+    if (static_cast<int>(defaultSet.size()) > MAX_LIGHTS)
+    {
+        std::stable_sort(defaultSet.begin(), defaultSet.end(), [this](int const a, int const b)
+        {
+            bool const isDirectionalA = m_lights[a].m_type == eLightType::DIRECTIONAL;
+            bool const isDirectionalB = m_lights[b].m_type == eLightType::DIRECTIONAL;
+
+            if (isDirectionalA != isDirectionalB) return isDirectionalA;
+
+            return m_lights[a].m_intensity > m_lights[b].m_intensity;
+        });
+
+        defaultSet.resize(MAX_LIGHTS);
+        std::sort(defaultSet.begin(), defaultSet.end());
+    }
+
+    m_lightSetCount     = 1;
+    m_lightSetsRevision = m_revision;
+}
+
+//----------------------------------------------------------------------------------------------------
+int LightSubsystem::FindOrAddLightSet(std::vector<int> const& lightIndexes)
+{
+    for (int lightSetId = 0; lightSetId < m_lightSetCount; ++lightSetId)
+    {
+        if (m_lightSets[lightSetId] == lightIndexes) return lightSetId;
+    }
+
+    // Sets past m_lightSetCount are left over from earlier frames; reuse their storage.
+    if (m_lightSetCount == static_cast<int>(m_lightSets.size())) m_lightSets.emplace_back();
+
+    m_lightSets[m_lightSetCount] = lightIndexes;
+
+    return m_lightSetCount++;
+}
+
+//----------------------------------------------------------------------------------------------------
+void LightSubsystem::UploadLights(std::vector<int> const& lightIndexes)
+{
+    int const lightCount = static_cast<int>(lightIndexes.size());
+
+    m_uploadLights.resize(lightCount);
+    m_uploadLightPointers.resize(lightCount);
+
+    for (int slot = 0; slot < lightCount; ++slot)
+    {
+        sLight const& light = m_lights[lightIndexes[slot]];
+
+        m_uploadLights[slot].SetType(light.m_type)
+                            .SetWorldPosition(light.m_worldPosition)
+                            .SetRadius(light.m_innerRadius, light.m_outerRadius)
+                            .SetColorWithIntensity(Vec4(light.m_color.x, light.m_color.y, light.m_color.z, light.m_intensity))
+                            .SetDirection(light.m_direction)
+                            .SetConeAngles(light.m_innerConeCos, light.m_outerConeCos);
+    }
+
+    // Pointers are taken after the resize, so they stay valid until the next upload.
+    for (int slot = 0; slot < lightCount; ++slot)
+    {
+        m_uploadLightPointers[slot] = &m_uploadLights[slot];
+    }
+
+    g_theRenderer->SetLightConstants(m_uploadLightPointers, lightCount);
+
+    m_boundLightIndexes = lightIndexes;
+    m_boundRevision     = m_revision;
+    ++m_uploadCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Packs the grid into the three cluster constant buffers, copying only the used part of the
+/// index and light buffers.
+void LightSubsystem::UploadLightClusters(RenderBackend& backend)
+{
+    LightClusterGrid const&      grid         = m_clusterGrid;
+    sLightClusterView const&     view         = grid.GetView();
+    std::vector<int> const&      slotLights   = grid.GetSlotLightIndexes();
+    std::vector<uint16_t> const& clusterSlots = grid.GetClusterLightSlots();
+
+    m_clusterConstants.m_cameraPosition = view.m_position;
+    m_clusterConstants.m_tanHalfWidth   = grid.GetTanHalfWidth();
+    m_clusterConstants.m_cameraForward  = grid.GetForward();
+    m_clusterConstants.m_tanHalfHeight  = grid.GetTanHalfHeight();
+    m_clusterConstants.m_cameraLeft     = grid.GetLeft();
+    m_clusterConstants.m_nearDistance   = view.m_nearDistance;
+    m_clusterConstants.m_cameraUp       = grid.GetUp();
+    m_clusterConstants.m_sliceScale     = grid.GetSliceScale();
+    m_clusterConstants.m_firstSliceFar  = grid.GetFirstSliceFar();
+    m_clusterConstants.m_lightCount     = static_cast<int>(slotLights.size());
+
+    for (int clusterIndex = 0; clusterIndex < LIGHT_CLUSTER_COUNT; ++clusterIndex)
+    {
+        m_clusterConstants.m_clusterRecords[clusterIndex] = static_cast<uint32_t>(grid.GetClusterOffset(clusterIndex)) |
+                                                            static_cast<uint32_t>(grid.GetClusterLightCount(clusterIndex)) << 16;
+    }
+
+    m_clusterLights.resize(slotLights.size());
+
+    for (int slot = 0; slot < static_cast<int>(slotLights.size()); ++slot)
+    {
+        sLight const&           light     = m_lights[slotLights[slot]];
+        sClusterLightConstants& constants = m_clusterLights[slot];
+
+        constants.m_colorWithIntensity = Vec4(light.m_color.x, light.m_color.y, light.m_color.z, light.m_intensity);
+        constants.m_worldPosition      = light.m_worldPosition;
+        constants.m_innerRadius        = light.m_innerRadius;
+        constants.m_direction          = light.m_direction;
+        constants.m_outerRadius        = light.m_outerRadius;
+        constants.m_innerConeCos       = light.m_innerConeCos;
+        constants.m_outerConeCos       = light.m_outerConeCos;
+        constants.m_lightType          = static_cast<int>(light.m_type);
+    }
+
+    // Indexes are read as uint4 rows of eight, so round the copy up to a whole row.
+    size_t const indexBytes = ((clusterSlots.size() + 7) / 8) * 16;
+    m_clusterUploadSlots.assign(indexBytes / sizeof(uint16_t), 0);
+    std::copy(clusterSlots.begin(), clusterSlots.end(), m_clusterUploadSlots.begin());
+
+    backend.CopyCPUToGPU(&m_clusterConstants, sizeof(m_clusterConstants), m_clusterConstantBuffer);
+
+    if (indexBytes > 0) backend.CopyCPUToGPU(m_clusterUploadSlots.data(), static_cast<unsigned int>(indexBytes), m_clusterIndexConstantBuffer);
+    if (!m_clusterLights.empty()) backend.CopyCPUToGPU(m_clusterLights.data(), static_cast<unsigned int>(m_clusterLights.size() * sizeof(sClusterLightConstants)), m_clusterLightConstantBuffer);
+
+    backend.BindConstantBuffer(LIGHT_CLUSTER_CONSTANT_SLOT, m_clusterConstantBuffer);
+    backend.BindConstantBuffer(LIGHT_CLUSTER_INDEX_CONSTANT_SLOT, m_clusterIndexConstantBuffer);
+    backend.BindConstantBuffer(LIGHT_CLUSTER_LIGHT_CONSTANT_SLOT, m_clusterLightConstantBuffer);
+}
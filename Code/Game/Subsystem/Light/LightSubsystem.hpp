@@ -4,17 +4,105 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstdint>
 #include <vector>
 
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/EulerAngles.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Math/Vec3.hpp"
+#include "Engine/Math/Vec4.hpp"
+#include "Engine/Renderer/Light.hpp"
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+
 //-Forward-Declaration--------------------------------------------------------------------------------
-struct Light;
+class ConstantBuffer;
+class RenderBackend;
+class WorkerThreadPool;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Game-side description of one light, stored by value in the LightSubsystem. Setters chain like the
+/// Engine's Light; the subsystem converts to Light only for the lights it uploads.
+struct sLight
+{
+    eLightType m_type          = eLightType::POINT;
+    Vec3       m_worldPosition = Vec3::ZERO;
+    Vec3       m_direction     = -Vec3::Z_BASIS;
+    Vec3       m_color         = Vec3(1.f, 1.f, 1.f);
+    float      m_intensity     = 1.f;
+    float      m_innerRadius   = 0.f;
+    float      m_outerRadius   = 1.f;
+    float      m_innerConeCos  = 1.f;       // Cosines of the cone half-angles, as SetConeAngles takes them
+    float      m_outerConeCos  = 0.f;
+
+    sLight& SetType(eLightType type);
+    sLight& SetWorldPosition(Vec3 const& worldPosition);
+    sLight& SetRadius(float innerRadius, float outerRadius);
+    sLight& SetColor(Vec3 const& color);
+    sLight& SetIntensity(float intensity);
+    sLight& SetColorWithIntensity(Vec4 const& colorWithIntensity);
+    sLight& SetDirection(Vec3 const& direction);
+    sLight& SetConeAngles(float innerConeCos, float outerConeCos);
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Mirrors LightClusterConstants (b8). Each record packs a cluster's offset into the index list in
+/// the low 16 bits and its light count in the high 16 bits.
+struct sLightClusterConstants
+{
+    Vec3     m_cameraPosition;
+    float    m_tanHalfWidth  = 1.f;
+    Vec3     m_cameraForward;
+    float    m_tanHalfHeight = 1.f;
+    Vec3     m_cameraLeft;
+    float    m_nearDistance  = 0.1f;
+    Vec3     m_cameraUp;
+    float    m_sliceScale    = 1.f;
+    float    m_firstSliceFar = 1.f;
+    int      m_lightCount    = 0;
+    float    m_padding[2]    = {};
+    uint32_t m_clusterRecords[LIGHT_CLUSTER_COUNT] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Mirrors one element of the shader's Light struct, as stored in LightClusterLightConstants (b10).
+struct sClusterLightConstants
+{
+    Vec4  m_colorWithIntensity;
+    Vec3  m_worldPosition;
+    float m_innerRadius  = 0.f;
+    Vec3  m_direction;
+    float m_outerRadius  = 1.f;
+    float m_innerConeCos = 1.f;
+    float m_outerConeCos = 0.f;
+    int   m_lightType    = 0;
+    float m_padding      = 0.f;
+};
 
 //----------------------------------------------------------------------------------------------------
 struct sLightSubsystemConfig
 {
+    bool m_isClustered        = true;
+    int  m_clusterThreadCount = 0;      // 0 uses every hardware thread
 };
 
 //----------------------------------------------------------------------------------------------------
+/// @brief
+/// Owns every light in the scene in one contiguous array. Any change goes through AddLight, EditLight,
+/// RemoveLight or ClearLights and bumps a revision; the light constant buffer is uploaded only when the
+/// revision or the set of lights to bind differs from what was last uploaded.
+///
+/// The buffer holds MAX_LIGHTS lights. With more lights than that, draws ask GetLightSetForBounds for the
+/// lights that can reach their world bounds, and the RenderCommandList binds each draw's set through
+/// BindLightSet. Set 0 is the frame's default: every light while there are at most MAX_LIGHTS, otherwise
+/// the directional lights and then the brightest others.
+///
+/// While clustered, point and spot lights leave the light constant buffer altogether: BuildLightClusters
+/// bins them into the view's LightClusterGrid on a WorkerThreadPool and uploads the per-cluster light
+/// lists, which BlinnPhong.hlsl walks per pixel. The light constant buffer then holds only directional
+/// lights, so every draw uses set 0.
 class LightSubsystem
 {
 public:
@@ -30,21 +118,62 @@ public:
     void ShutDown();
 
     // Light management
-    void   AddLight(Light* light);
-    void   RemoveLight(int index);
-    void   ClearLights();
-    Light* GetLight(int index);
-    int    GetLightCount() const;
+    int           AddLight(sLight const& light);
+    void          RemoveLight(int index);
+    void          ClearLights();
+    sLight const* GetLight(int index) const;
+    sLight*       EditLight(int index);
+    int           GetLightCount() const;
+    uint32_t      GetRevision() const;
 
+    // Light sets and upload
+    int  GetLightSetForBounds(AABB3 const& worldBounds);
+    int  GetLightSetForBounds(AABB3 const& localBounds, Mat44 const& modelToWorld);
+    int  GetLightSetCount() const;
+    void BindLightSet(int lightSetId);
+    int  GetUploadCount() const;
 
-    // Update and bind
-    void UpdateLightConstants();
-    void BindLightConstants();
+    // Clustered point and spot lights
+    void                    BuildLightClusters(Vec3 const& cameraPosition, EulerAngles const& cameraOrientation, RenderBackend& backend);
+    void                    SetClustered(bool isClustered);
+    bool                    IsClustered() const;
+    LightClusterGrid const& GetLightClusterGrid() const;
+
+    static bool OnLightStress(EventArgs& args);
+    static bool OnLightClustered(EventArgs& args);
+    static bool OnLightClusterBenchmark(EventArgs& args);
 
 private:
-    sLightSubsystemConfig m_config;
-    std::vector<Light*>   m_lights;
+    void ResetLightSets();
+    int  FindOrAddLightSet(std::vector<int> const& lightIndexes);
+    void UploadLights(std::vector<int> const& lightIndexes);
+    void UploadLightClusters(RenderBackend& backend);
+
+    sLightSubsystemConfig         m_config;
+    std::vector<sLight>           m_lights;
+    uint32_t                      m_revision = 0;
+
+    std::vector<std::vector<int>> m_lightSets;              // Rebuilt every frame and on any change
+    int                           m_lightSetCount     = 0;
+    uint32_t                      m_lightSetsRevision = UINT32_MAX;
+    std::vector<int>              m_scratchIndexes;
+    std::vector<float>            m_scratchScores;
+
+    std::vector<int>              m_boundLightIndexes;      // What the constant buffer holds now
+    uint32_t                      m_boundRevision = UINT32_MAX;
+    std::vector<Light>            m_uploadLights;           // Contiguous staging for SetLightConstants
+    std::vector<Light*>           m_uploadLightPointers;
+    int                           m_uploadCount   = 0;
 
-    // LightConstants* m_lightConstants = nullptr;
-    // ConstantBuffer* m_lightCBO = nullptr;
+    LightClusterGrid                    m_clusterGrid;
+    WorkerThreadPool*                   m_workerThreadPool           = nullptr;
+    ConstantBuffer*                     m_clusterConstantBuffer      = nullptr;
+    ConstantBuffer*                     m_clusterIndexConstantBuffer = nullptr;
+    ConstantBuffer*                     m_clusterLightConstantBuffer = nullptr;
+    uint32_t                            m_clusterRevision            = UINT32_MAX;     // Lights and view of the last upload
+    Vec3                                m_clusterPosition;
+    EulerAngles                         m_clusterOrientation;
+    sLightClusterConstants              m_clusterConstants;
+    std::vector<sClusterLightConstants> m_clusterLights;
+    std::vector<uint16_t>               m_clusterUploadSlots;                          // Padded to whole uint4 rows
 };
@@ -0,0 +1,359 @@
+//----------------------------------------------------------------------------------------------------
+// OpeningBookSubsystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/OpeningBook/OpeningBookSubsystem.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <sstream>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Gameplay/Game.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr BOOK_ENTRY_SIZE = 16;
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t ReadBigEndian(uint8_t const* bytes, int const byteCount)
+{
+    uint64_t value = 0;
+
+    for (int i = 0; i < byteCount; ++i)
+    {
+        value = (value << 8) | bytes[i];
+    }
+
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+static void WriteBigEndian(std::ofstream& stream, uint64_t const value, int const byteCount)
+{
+    for (int i = byteCount - 1; i >= 0; --i)
+    {
+        stream.put(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+OpeningBookSubsystem::OpeningBookSubsystem(sOpeningBookSubsystemConfig const& config)
+    : m_config(config)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void OpeningBookSubsystem::StartUp()
+{
+    g_theEventSystem->SubscribeEventCallbackFunction("book_build", OnBookBuild);
+
+    // Keys must be final before the book is probed or built.
+    if (!LoadPolyglotRandom64(m_config.m_random64Path))
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[OpeningBook] No valid Polyglot Random64 table at %s. Third-party books will not match; books from 'book_build' still do.", m_config.m_random64Path.c_str()));
+    }
+
+    if (!LoadBook(m_config.m_bookFilePath.c_str()))
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[OpeningBook] No book at %s. Type 'book_build' to build one from %s.", m_config.m_bookFilePath.c_str(), m_config.m_gameDatabasePath.c_str()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void OpeningBookSubsystem::ShutDown()
+{
+    m_bookFile.Close();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool OpeningBookSubsystem::LoadBook(char const* bookFilePath)
+{
+    if (!m_bookFile.Open(bookFilePath)) return false;
+
+    if (m_bookFile.GetSize() % BOOK_ENTRY_SIZE != 0)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[OpeningBook] %s is not a Polyglot book (size %d).", bookFilePath, static_cast<int>(m_bookFile.GetSize())));
+        m_bookFile.Close();
+        return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool OpeningBookSubsystem::IsLoaded() const
+{
+    return m_bookFile.IsOpen();
+}
+
+//----------------------------------------------------------------------------------------------------
+int OpeningBookSubsystem::GetEntryCount() const
+{
+    return static_cast<int>(m_bookFile.GetSize() / BOOK_ENTRY_SIZE);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Binary search for the first entry with the given key, then collect its run of entries.
+/// @return Number of entries appended to out_entries.
+int OpeningBookSubsystem::FindEntries(uint64_t const key, std::vector<sOpeningBookEntry>& out_entries) const
+{
+    if (!IsLoaded()) return 0;
+
+    int low  = 0;
+    int high = GetEntryCount();
+
+    while (low < high)
+    {
+        int const middle = low + (high - low) / 2;
+
+        if (ReadKey(middle) < key) low = middle + 1;
+        else high = middle;
+    }
+
+    int foundCount = 0;
+
+    for (int entryIndex = low; entryIndex < GetEntryCount() && ReadKey(entryIndex) == key; ++entryIndex)
+    {
+        out_entries.push_back(ReadEntry(entryIndex));
+        ++foundCount;
+    }
+
+    return foundCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Picks one book move for the position, weighted by how often it was played.
+/// @return false once the position is past the book depth, is not in the book, or the chosen book
+/// move is not legal in it.
+bool OpeningBookSubsystem::ProbeMove(sChessPosition const& position,
+                                     sChessMove&           out_move,
+                                     std::mt19937*         random) const
+{
+    if (!IsLoaded()) return false;
+    if (position.GetPly() >= m_config.m_maxBookPly) return false;
+
+    std::vector<sOpeningBookEntry> entries;
+    if (FindEntries(position.GetZobristKey(), entries) == 0) return false;
+
+    int totalWeight = 0;
+
+    for (sOpeningBookEntry const& entry : entries)
+    {
+        totalWeight += entry.m_weight;
+    }
+
+    sOpeningBookEntry const* chosenEntry = &entries.front();
+
+    if (totalWeight > 0 && random != nullptr)
+    {
+        int roll = std::uniform_int_distribution<int>(0, totalWeight - 1)(*random);
+
+        for (sOpeningBookEntry const& entry : entries)
+        {
+            roll -= entry.m_weight;
+
+            if (roll < 0)
+            {
+                chosenEntry = &entry;
+                break;
+            }
+        }
+    }
+
+    out_move = DecodeMove(position, chosenEntry->m_move);
+
+    if (!out_move.IsValid()) return false;
+
+    // A corrupt entry, or another position sharing the key, can name a move that is illegal here.
+    std::vector<sChessMove> legalMoves;
+    GenerateLegalMoves(position, legalMoves);
+
+    return std::find(legalMoves.begin(), legalMoves.end(), out_move) != legalMoves.end();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Polyglot packs to-square in bits 0-5, from-square in bits 6-11 and promotion in bits 12-14.
+/// Castling is stored as king-takes-own-rook, e.g. e1h1 for kingside.
+STATIC uint16_t OpeningBookSubsystem::EncodeMove(sChessPosition const& position,
+                                                 sChessMove const&     move)
+{
+    int toSquare = move.m_toSquare;
+
+    bool const isKing   = position.m_squares[move.m_fromSquare].m_type == ePieceType::KING;
+    int const  fromFile = move.m_fromSquare % CHESS_BOARD_SIZE;
+    int const  toFile   = move.m_toSquare % CHESS_BOARD_SIZE;
+
+    if (isKing && abs(toFile - fromFile) == 2)
+    {
+        toSquare = move.m_toSquare - toFile + (toFile > fromFile ? 7 : 0);
+    }
+
+    int promotion = 0;
+
+    switch (move.m_promoteTo)
+    {
+    case ePieceType::KNIGHT: promotion = 1;
+        break;
+    case ePieceType::BISHOP: promotion = 2;
+        break;
+    case ePieceType::ROOK: promotion = 3;
+        break;
+    case ePieceType::QUEEN: promotion = 4;
+        break;
+    default: break;
+    }
+
+    return static_cast<uint16_t>(toSquare | (move.m_fromSquare << 6) | (promotion << 12));
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sChessMove OpeningBookSubsystem::DecodeMove(sChessPosition const& position,
+                                                   uint16_t const        bookMove)
+{
+    static ePieceType constexpr PROMOTION_TYPES[] = {
+        ePieceType::NONE, ePieceType::KNIGHT, ePieceType::BISHOP, ePieceType::ROOK, ePieceType::QUEEN
+    };
+
+    sChessMove move;
+    move.m_toSquare   = static_cast<int8_t>(bookMove & 0x3F);
+    move.m_fromSquare = static_cast<int8_t>((bookMove >> 6) & 0x3F);
+
+    int const promotion = (bookMove >> 12) & 0x7;
+    if (promotion < 5) move.m_promoteTo = PROMOTION_TYPES[promotion];
+
+    sChessSquare const& moving   = position.m_squares[move.m_fromSquare];
+    sChessSquare const& captured = position.m_squares[move.m_toSquare];
+
+    // King onto its own rook is Polyglot's castling; convert it back to the two-square king move.
+    if (moving.m_type == ePieceType::KING && captured.m_type == ePieceType::ROOK && captured.m_playerId == moving.m_playerId)
+    {
+        int const fromFile = move.m_fromSquare % CHESS_BOARD_SIZE;
+        int const toFile   = move.m_toSquare % CHESS_BOARD_SIZE;
+
+        move.m_toSquare = static_cast<int8_t>(move.m_fromSquare + (toFile > fromFile ? 2 : -2));
+    }
+
+    return move;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Replays every game in the database up to maxPly and writes a sorted Polyglot book.
+/// The database is plain text, one game per line, moves in coordinate notation ("e2e4 e7e5 ...").
+/// Lines starting with '#' or '[' are skipped, as are tokens that are not moves (move numbers, results).
+/// @return Number of book entries written, or -1 if a file could not be opened.
+STATIC int OpeningBookSubsystem::BuildBookFromGameDatabase(char const* gameDatabasePath,
+                                                           char const* bookFilePath,
+                                                           int const   maxPly)
+{
+    std::ifstream gameDatabase(gameDatabasePath);
+    if (!gameDatabase.is_open()) return -1;
+
+    std::map<uint64_t, std::map<uint16_t, uint32_t>> moveCountsByKey;
+    String                                           line;
+
+    while (std::getline(gameDatabase, line))
+    {
+        if (line.empty() || line[0] == '#' || line[0] == '[') continue;
+
+        sChessPosition     position = sChessPosition::GetStartingPosition();
+        std::istringstream tokens(line);
+        String             token;
+
+        while (tokens >> token && position.GetPly() < maxPly)
+        {
+            sChessMove const move = ParseMoveString(token);
+            if (!move.IsValid()) continue;
+
+            // Stop replaying a game as soon as it stops making sense.
+            sChessSquare const& moving = position.m_squares[move.m_fromSquare];
+            if (moving.IsEmpty() || moving.m_playerId != position.m_sideToMove) break;
+
+            ++moveCountsByKey[position.GetZobristKey()][EncodeMove(position, move)];
+            position.ApplyMove(move);
+        }
+    }
+
+    std::ofstream book(bookFilePath, std::ios::binary | std::ios::trunc);
+    if (!book.is_open()) return -1;
+
+    int entryCount = 0;
+
+    for (auto const& [key, moveCounts] : moveCountsByKey)
+    {
+        std::vector<std::pair<uint16_t, uint32_t>> sortedMoves(moveCounts.begin(), moveCounts.end());
+        std::sort(sortedMoves.begin(), sortedMoves.end(), [](auto const& a, auto const& b) { return a.second > b.second; });
+
+        for (auto const& [move, count] : sortedMoves)
+        {
+            WriteBigEndian(book, key, 8);
+            WriteBigEndian(book, move, 2);
+            WriteBigEndian(book, std::min(count, 0xFFFFu), 2);
+            WriteBigEndian(book, 0, 4);
+            ++entryCount;
+        }
+    }
+
+    return entryCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool OpeningBookSubsystem::OnBookBuild(EventArgs& args)
+{
+    sOpeningBookSubsystemConfig const& config = g_theOpeningBookSubsystem->m_config;
+
+    String const gameDatabasePath = args.GetValue("games", config.m_gameDatabasePath);
+    String const bookFilePath     = args.GetValue("out", config.m_bookFilePath);
+    int const    maxPly           = args.GetValue("ply", config.m_maxBookPly);
+
+    // The mapping would keep the old file locked while we overwrite it, and a tournament thread may be reading it.
+    if (bookFilePath == config.m_bookFilePath)
+    {
+        if (g_theGame != nullptr && g_theGame->IsTournamentRunning())
+        {
+            g_theDevConsole->AddLine(DevConsole::WARNING, "[OpeningBook] A tournament is reading the book; build it once the tournament is done.");
+            return false;
+        }
+
+        g_theOpeningBookSubsystem->m_bookFile.Close();
+    }
+
+    int const entryCount = BuildBookFromGameDatabase(gameDatabasePath.c_str(), bookFilePath.c_str(), maxPly);
+
+    if (entryCount < 0)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[OpeningBook] Failed to build %s from %s", bookFilePath.c_str(), gameDatabasePath.c_str()));
+        return false;
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[OpeningBook] Wrote %d entries to %s", entryCount, bookFilePath.c_str()));
+
+    if (bookFilePath == config.m_bookFilePath) g_theOpeningBookSubsystem->LoadBook(bookFilePath.c_str());
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+sOpeningBookEntry OpeningBookSubsystem::ReadEntry(int const entryIndex) const
+{
+    uint8_t const* bytes = m_bookFile.GetData() + static_cast<size_t>(entryIndex) * BOOK_ENTRY_SIZE;
+
+    sOpeningBookEntry entry;
+    entry.m_key    = ReadBigEndian(bytes, 8);
+    entry.m_move   = static_cast<uint16_t>(ReadBigEndian(bytes + 8, 2));
+    entry.m_weight = static_cast<uint16_t>(ReadBigEndian(bytes + 10, 2));
+    entry.m_learn  = static_cast<uint32_t>(ReadBigEndian(bytes + 12, 4));
+
+    return entry;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t OpeningBookSubsystem::ReadKey(int const entryIndex) const
+{
+    return ReadBigEndian(m_bookFile.GetData() + static_cast<size_t>(entryIndex) * BOOK_ENTRY_SIZE, 8);
+}
@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------------------------------
+// OpeningBookSubsystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/MappedFile.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sOpeningBookSubsystemConfig
+{
+    String m_bookFilePath     = "Data/Books/OpeningBook.bin";
+    String m_gameDatabasePath = "Data/Books/GameDatabase.txt";
+    String m_random64Path     = "Data/Books/PolyglotRandom64.txt";   // Polyglot's Random64 table; without it only books from book_build match
+    int    m_maxBookPly       = 20; // First ten moves of each side
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// One Polyglot book record. On disk it is 16 big-endian bytes: key, move, weight, learn.
+struct sOpeningBookEntry
+{
+    uint64_t m_key    = 0;
+    uint16_t m_move   = 0;
+    uint16_t m_weight = 0;
+    uint32_t m_learn  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Memory-maps a Polyglot-format opening book and answers book moves by binary search on the
+/// position key. Nothing is read at startup beyond mapping the file.
+class OpeningBookSubsystem
+{
+public:
+    explicit OpeningBookSubsystem(sOpeningBookSubsystemConfig const& config);
+    ~OpeningBookSubsystem() = default;
+
+    void StartUp();
+    void ShutDown();
+
+    bool LoadBook(char const* bookFilePath);
+    bool IsLoaded() const;
+    int  GetEntryCount() const;
+    int  FindEntries(uint64_t key, std::vector<sOpeningBookEntry>& out_entries) const;
+    bool ProbeMove(sChessPosition const& position, sChessMove& out_move, std::mt19937* random) const;
+
+    static uint16_t   EncodeMove(sChessPosition const& position, sChessMove const& move);
+    static sChessMove DecodeMove(sChessPosition const& position, uint16_t bookMove);
+    static int        BuildBookFromGameDatabase(char const* gameDatabasePath, char const* bookFilePath, int maxPly);
+
+    static bool OnBookBuild(EventArgs& args);
+
+private:
+    sOpeningBookEntry ReadEntry(int entryIndex) const;
+    uint64_t          ReadKey(int entryIndex) const;
+
+    sOpeningBookSubsystemConfig m_config;
+    MappedFile                  m_bookFile;
+};
@@ -0,0 +1,560 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseGenerator.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Tablebase/TablebaseGenerator.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Working state, one byte per position:
+//   0         unresolved (a draw once every pass is done)
+//   1..126    win in N plies
+//   128..254  loss in N - 128 plies
+//   255       invalid index (overlapping pieces, pawn on a back rank, side not to move in check,
+//             or a symmetric duplicate of another index)
+// Distances saturate at MAX_DISTANCE; the result stays exact, only the count stops growing.
+//
+uint8_t constexpr STATE_UNRESOLVED = 0;
+uint8_t constexpr STATE_LOSS_BASE  = 128;
+uint8_t constexpr STATE_INVALID    = 255;
+int constexpr     MAX_DISTANCE     = 126;
+
+uint8_t constexpr WDL_DRAW    = 0;
+uint8_t constexpr WDL_WIN     = 1;
+uint8_t constexpr WDL_LOSS    = 2;
+uint8_t constexpr WDL_INVALID = 3;
+
+//----------------------------------------------------------------------------------------------------
+static bool IsWinState(uint8_t const state) { return state != STATE_UNRESOLVED && state < STATE_LOSS_BASE; }
+static bool IsLossState(uint8_t const state) { return state >= STATE_LOSS_BASE && state != STATE_INVALID; }
+static int  GetStateDistance(uint8_t const state) { return IsWinState(state) ? state : state - STATE_LOSS_BASE; }
+
+static bool IsDoublePawnPush(sChessPosition const& position, sChessMove const& move)
+{
+    return position.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN && std::abs(move.m_toSquare - move.m_fromSquare) == 2 * CHESS_BOARD_SIZE;
+}
+
+static uint8_t MakeWinState(int const distance) { return static_cast<uint8_t>(std::min(distance, MAX_DISTANCE)); }
+static uint8_t MakeLossState(int const distance) { return static_cast<uint8_t>(STATE_LOSS_BASE + std::min(distance, MAX_DISTANCE)); }
+
+//----------------------------------------------------------------------------------------------------
+TablebaseGenerator::TablebaseGenerator(TablebaseSubsystem const& tablebase,
+                                       sTablebaseMaterial const& material,
+                                       WorkerThreadPool&         workerThreadPool)
+    : m_tablebase(tablebase),
+      m_material(material),
+      m_workerThreadPool(workerThreadPool)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void TablebaseGenerator::Generate()
+{
+    uint64_t const stateCount = m_material.m_positionCount * 2;
+
+    m_states = std::vector<std::atomic<uint8_t>>(stateCount);
+
+    SolvePhase(false);
+
+    m_wdl.assign((stateCount + 3) / 4, 0);
+
+    for (uint64_t stateIndex = 0; stateIndex < stateCount; ++stateIndex)
+    {
+        uint8_t const state = m_states[stateIndex].load(std::memory_order_relaxed);
+        uint8_t       wdl   = WDL_DRAW;
+
+        if (state == STATE_INVALID) wdl = WDL_INVALID;
+        else if (IsWinState(state)) wdl = WDL_WIN;
+        else if (IsLossState(state)) wdl = WDL_LOSS;
+
+        m_wdl[stateIndex / 4] |= static_cast<uint8_t>(wdl << ((stateIndex % 4) * 2));
+        m_states[stateIndex].store(STATE_UNRESOLVED, std::memory_order_relaxed);
+    }
+
+    SolvePhase(true);
+
+    m_dtz.assign(stateCount, 0);
+
+    for (uint64_t stateIndex = 0; stateIndex < stateCount; ++stateIndex)
+    {
+        uint8_t const state = m_states[stateIndex].load(std::memory_order_relaxed);
+        if (!IsWinState(state) && !IsLossState(state)) continue;
+
+        m_dtz[stateIndex] = static_cast<uint8_t>(GetStateDistance(state));
+        if (IsWinState(state)) m_longestWin = std::max(m_longestWin, GetStateDistance(state));
+    }
+
+    m_states = std::vector<std::atomic<uint8_t>>();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TablebaseGenerator::WriteFiles(String const& wdlPath,
+                                    String const& dtzPath) const
+{
+    auto const writeFile = [this](String const& path, uint32_t const magic, std::vector<uint8_t> const& data)
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) return false;
+
+        uint64_t const positionCount = m_material.m_positionCount;
+
+        file.write(reinterpret_cast<char const*>(&magic), sizeof(magic));
+        file.write(reinterpret_cast<char const*>(&TABLEBASE_VERSION), sizeof(TABLEBASE_VERSION));
+        file.write(reinterpret_cast<char const*>(&positionCount), sizeof(positionCount));
+        file.write(reinterpret_cast<char const*>(data.data()), static_cast<std::streamsize>(data.size()));
+
+        return file.good();
+    };
+
+    return writeFile(wdlPath, TABLEBASE_WDL_MAGIC, m_wdl) && writeFile(dtzPath, TABLEBASE_DTZ_MAGIC, m_dtz);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t TablebaseGenerator::GetResultCount(eTablebaseResult const result) const
+{
+    uint8_t const wanted = result == eTablebaseResult::WIN ? WDL_WIN : result == eTablebaseResult::LOSS ? WDL_LOSS : WDL_DRAW;
+    uint64_t      count  = 0;
+
+    for (uint64_t stateIndex = 0; stateIndex < m_material.m_positionCount * 2; ++stateIndex)
+    {
+        if (GetPhaseOneWdl(stateIndex) == wanted) ++count;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint64_t TablebaseGenerator::GetInvalidCount() const
+{
+    uint64_t count = 0;
+
+    for (uint64_t stateIndex = 0; stateIndex < m_material.m_positionCount * 2; ++stateIndex)
+    {
+        if (GetPhaseOneWdl(stateIndex) == WDL_INVALID) ++count;
+    }
+
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TablebaseGenerator::GetPassCount() const
+{
+    return m_passCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int TablebaseGenerator::GetLongestWin() const
+{
+    return m_longestWin;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TablebaseGenerator::SolvePhase(bool const arePawnMovesExits)
+{
+    m_arePawnMovesExits = arePawnMovesExits;
+
+    InitializeStates();
+
+    int distance = 0;
+
+    while (true)
+    {
+        uint64_t processedCount = 0;
+        uint64_t assignedCount  = 0;
+
+        RunPass(distance, processedCount, assignedCount);
+        ++m_passCount;
+
+        if (distance < MAX_DISTANCE)
+        {
+            // Layer N + 1 only grows from layer N (exits seed layers 0 and 1), so an empty layer ends it.
+            if (distance >= 1 && processedCount == 0) break;
+            ++distance;
+        }
+        else if (assignedCount == 0)
+        {
+            break;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Marks invalid indexes, mates, and positions decided by a single move out of the table.
+void TablebaseGenerator::InitializeStates()
+{
+    RunParallel([this](uint64_t const beginIndex, uint64_t const endIndex)
+    {
+        std::vector<sChessMove> moves;
+        sChessPosition          position;
+
+        for (uint64_t stateIndex = beginIndex; stateIndex < endIndex; ++stateIndex)
+        {
+            int const      sideToMove = static_cast<int>(stateIndex / m_material.m_positionCount);
+            uint64_t const index      = stateIndex % m_material.m_positionCount;
+
+            // Symmetric duplicates (king on the diagonal, swapped twin pieces) are never probed.
+            if (!m_material.DecodePosition(index, sideToMove, position) ||
+                m_material.EncodePosition(position, false) != index ||
+                IsInCheck(position, 1 - sideToMove))
+            {
+                m_states[stateIndex].store(STATE_INVALID, std::memory_order_relaxed);
+                continue;
+            }
+
+            GenerateLegalMoves(position, moves);
+
+            if (moves.empty())
+            {
+                m_states[stateIndex].store(IsInCheck(position, sideToMove) ? MakeLossState(0) : STATE_UNRESOLVED, std::memory_order_relaxed);
+                continue;
+            }
+
+            bool hasWinningExit  = false;
+            bool isEveryMoveLost = true;
+
+            for (sChessMove const& move : moves)
+            {
+                sChildValue const child = GetChildValue(position, move);
+
+                if (child.m_isExit && child.m_result == eTablebaseResult::LOSS)
+                {
+                    hasWinningExit = true;
+                    break;
+                }
+
+                if (!child.m_isExit || child.m_result != eTablebaseResult::WIN) isEveryMoveLost = false;
+            }
+
+            if (hasWinningExit) m_states[stateIndex].store(MakeWinState(1), std::memory_order_relaxed);
+            else if (isEveryMoveLost) m_states[stateIndex].store(MakeLossState(1), std::memory_order_relaxed);
+        }
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Expands every position decided at `distance`: predecessors of a loss are wins, and
+/// predecessors of a win are losses once all of their moves are known to lose.
+void TablebaseGenerator::RunPass(int const distance,
+                                 uint64_t& out_processedCount,
+                                 uint64_t& out_assignedCount)
+{
+    std::atomic<uint64_t> processedCount = 0;
+    std::atomic<uint64_t> assignedCount  = 0;
+
+    RunParallel([this, distance, &processedCount, &assignedCount](uint64_t const beginIndex, uint64_t const endIndex)
+    {
+        std::vector<sChessMove>     moves;
+        std::vector<sChessPosition> predecessors;
+        std::vector<sChessMove>     predecessorMoves;
+        sChessPosition              position;
+        uint64_t                    localProcessed = 0;
+        uint64_t                    localAssigned  = 0;
+
+        for (uint64_t stateIndex = beginIndex; stateIndex < endIndex; ++stateIndex)
+        {
+            uint8_t const state  = m_states[stateIndex].load(std::memory_order_relaxed);
+            bool const    isWin  = IsWinState(state);
+            bool const    isLoss = IsLossState(state);
+
+            if ((!isWin && !isLoss) || GetStateDistance(state) != distance) continue;
+
+            int const      sideToMove = static_cast<int>(stateIndex / m_material.m_positionCount);
+            uint64_t const index      = stateIndex % m_material.m_positionCount;
+
+            m_material.DecodePosition(index, sideToMove, position);
+            GenerateUnmoves(position, predecessors, predecessorMoves);
+            ++localProcessed;
+
+            for (size_t predecessorIndex = 0; predecessorIndex < predecessors.size(); ++predecessorIndex)
+            {
+                sChessPosition const& predecessor = predecessors[predecessorIndex];
+                sChessMove const&     move        = predecessorMoves[predecessorIndex];
+
+                if (isLoss)
+                {
+                    // A double push is only as lost as the opponent's en passant replies allow.
+                    if (IsDoublePawnPush(predecessor, move) && GetChildValue(predecessor, move).m_result != eTablebaseResult::LOSS) continue;
+
+                    if (TrySetState(predecessor, MakeWinState(distance + 1))) ++localAssigned;
+                }
+                else if (IsLostAtDistance(predecessor, distance, moves))
+                {
+                    if (TrySetState(predecessor, MakeLossState(distance + 1))) ++localAssigned;
+                }
+            }
+        }
+
+        processedCount += localProcessed;
+        assignedCount += localAssigned;
+    });
+
+    out_processedCount = processedCount;
+    out_assignedCount  = assignedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief True when every move of `position` reaches a win for the opponent decided within `distance`.
+/// Wins decided later in the same pass are ignored so layers stay exact across threads.
+bool TablebaseGenerator::IsLostAtDistance(sChessPosition const&    position,
+                                          int const                distance,
+                                          std::vector<sChessMove>& moves) const
+{
+    GenerateLegalMoves(position, moves);
+    if (moves.empty()) return false;
+
+    for (sChessMove const& move : moves)
+    {
+        sChildValue const child = GetChildValue(position, move);
+
+        if (child.m_result != eTablebaseResult::WIN || child.m_distance > distance) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Value of the position after `move`. Moves that leave the table are final (distance 0);
+/// moves inside it return the current working state, UNKNOWN while it is unresolved.
+TablebaseGenerator::sChildValue TablebaseGenerator::GetChildValue(sChessPosition const& position,
+                                                                  sChessMove const&     move) const
+{
+    bool const isPawnMove  = position.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN;
+    bool const isCapture   = IsCaptureMove(position, move);
+    bool const isPromotion = move.m_promoteTo != ePieceType::NONE;
+
+    sChessPosition child = position;
+    child.ApplyMove(move);
+
+    // Only a double push leaves en passant rights; the indexed child stands for the position without them.
+    bool const           canCaptureEnPassant = child.CanCaptureEnPassant();
+    sChessPosition const enPassantChild      = child;
+
+    child.m_enPassantSquare = -1;
+
+    sChildValue value;
+    value.m_isExit = isCapture || isPromotion || (isPawnMove && m_arePawnMovesExits);
+
+    if (isCapture || isPromotion)
+    {
+        value.m_result = m_tablebase.ProbeWdl(child);
+
+        // A missing smaller table should not happen after GenerateTable; score it as a draw.
+        if (value.m_result == eTablebaseResult::UNKNOWN) value.m_result = eTablebaseResult::DRAW;
+
+        return value;
+    }
+
+    uint64_t const stateIndex = child.m_sideToMove * m_material.m_positionCount + m_material.EncodePosition(child, false);
+
+    if (value.m_isExit)
+    {
+        uint8_t const wdl = GetPhaseOneWdl(stateIndex);
+
+        value.m_result = wdl == WDL_WIN ? eTablebaseResult::WIN : wdl == WDL_LOSS ? eTablebaseResult::LOSS : eTablebaseResult::DRAW;
+
+        return canCaptureEnPassant ? GetEnPassantChildValue(enPassantChild, value) : value;
+    }
+
+    uint8_t const state = m_states[stateIndex].load(std::memory_order_relaxed);
+
+    if (IsWinState(state)) value.m_result = eTablebaseResult::WIN;
+    if (IsLossState(state)) value.m_result = eTablebaseResult::LOSS;
+
+    value.m_distance = GetStateDistance(state);
+
+    return canCaptureEnPassant ? GetEnPassantChildValue(enPassantChild, value) : value;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Value of `child`, a double push's result with en passant rights, for the side to move: the better
+/// of indexedValue, the same position without the rights, and the en passant captures, which leave
+/// the table. Winning by one is final. Drawing by one makes the child at least a draw, which is only
+/// final once indexedValue is, so inside the table an unresolved or lost indexedValue stays UNKNOWN.
+TablebaseGenerator::sChildValue TablebaseGenerator::GetEnPassantChildValue(sChessPosition const& child,
+                                                                           sChildValue const&    indexedValue) const
+{
+    std::vector<sChessMove> moves;
+    GenerateLegalMoves(child, moves);
+
+    eTablebaseResult bestResult = eTablebaseResult::UNKNOWN;
+
+    for (sChessMove const& move : moves)
+    {
+        bool const isEnPassant = move.m_toSquare == child.m_enPassantSquare && child.m_squares[move.m_fromSquare].m_type == ePieceType::PAWN;
+        if (!isEnPassant) continue;
+
+        sChessPosition grandchild = child;
+        grandchild.ApplyMove(move);
+
+        eTablebaseResult grandchildResult = m_tablebase.ProbeWdl(grandchild);
+        if (grandchildResult == eTablebaseResult::UNKNOWN) grandchildResult = eTablebaseResult::DRAW;
+
+        eTablebaseResult const result = grandchildResult == eTablebaseResult::WIN ? eTablebaseResult::LOSS : grandchildResult == eTablebaseResult::LOSS ? eTablebaseResult::WIN : eTablebaseResult::DRAW;
+
+        if (bestResult == eTablebaseResult::UNKNOWN || result > bestResult) bestResult = result;
+    }
+
+    if (bestResult == eTablebaseResult::WIN)
+    {
+        sChildValue value;
+        value.m_result = eTablebaseResult::WIN;
+        value.m_isExit = true;
+
+        return value;
+    }
+
+    if (bestResult != eTablebaseResult::DRAW || indexedValue.m_result == eTablebaseResult::WIN) return indexedValue;
+
+    sChildValue value = indexedValue;
+    value.m_result    = indexedValue.m_isExit ? eTablebaseResult::DRAW : eTablebaseResult::UNKNOWN;
+    value.m_distance  = 0;
+
+    return value;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Positions one quiet move earlier: the player who just moved steps a piece back onto an empty
+/// square. Uncaptures and unpromotions lead into bigger tables and are never needed here; pawn
+/// unmoves are skipped in the DTZ phase, where pawn moves leave the table. out_moves holds the move
+/// each predecessor plays to reach position.
+void TablebaseGenerator::GenerateUnmoves(sChessPosition const&        position,
+                                         std::vector<sChessPosition>& out_predecessors,
+                                         std::vector<sChessMove>&     out_moves) const
+{
+    static int constexpr KNIGHT_OFFSETS[8][2] = {{1, 2}, {2, 1}, {2, -1}, {1, -2}, {-1, -2}, {-2, -1}, {-2, 1}, {-1, 2}};
+    static int constexpr KING_OFFSETS[8][2]   = {{1, 0}, {1, 1}, {0, 1}, {-1, 1}, {-1, 0}, {-1, -1}, {0, -1}, {1, -1}};
+
+    out_predecessors.clear();
+    out_moves.clear();
+
+    int const moverId = 1 - position.m_sideToMove;
+
+    auto const addPredecessor = [&](int const fromSquare, int const toSquare)
+    {
+        sChessPosition predecessor        = position;
+        predecessor.m_squares[toSquare]   = predecessor.m_squares[fromSquare];
+        predecessor.m_squares[fromSquare] = sChessSquare();
+        predecessor.m_sideToMove          = static_cast<int8_t>(moverId);
+        predecessor.m_enPassantSquare     = -1;
+
+        out_predecessors.push_back(predecessor);
+        out_moves.push_back({static_cast<int8_t>(toSquare), static_cast<int8_t>(fromSquare), ePieceType::NONE});
+    };
+
+    auto const getOffsetSquare = [](int const square, int const fileStep, int const rankStep)
+    {
+        int const file = square % CHESS_BOARD_SIZE + fileStep;
+        int const rank = square / CHESS_BOARD_SIZE + rankStep;
+
+        return (file < 0 || file >= CHESS_BOARD_SIZE || rank < 0 || rank >= CHESS_BOARD_SIZE) ? -1 : rank * CHESS_BOARD_SIZE + file;
+    };
+
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        sChessSquare const& chessSquare = position.m_squares[square];
+        if (chessSquare.m_playerId != moverId) continue;
+
+        ePieceType const type = chessSquare.m_type;
+
+        if (type == ePieceType::PAWN)
+        {
+            if (m_arePawnMovesExits) continue;
+
+            int const backStep   = moverId == 0 ? -1 : 1;
+            int const pushedRank = moverId == 0 ? 3 : 4;
+            int const oneBack    = getOffsetSquare(square, 0, backStep);
+            int const rank       = oneBack / CHESS_BOARD_SIZE;
+
+            if (oneBack < 0 || rank == 0 || rank == CHESS_BOARD_SIZE - 1 || !position.m_squares[oneBack].IsEmpty()) continue;
+
+            addPredecessor(square, oneBack);
+
+            int const twoBack = getOffsetSquare(square, 0, 2 * backStep);
+
+            if (square / CHESS_BOARD_SIZE == pushedRank && position.m_squares[twoBack].IsEmpty()) addPredecessor(square, twoBack);
+
+            continue;
+        }
+
+        if (type == ePieceType::KING || type == ePieceType::KNIGHT)
+        {
+            auto const& offsets = type == ePieceType::KING ? KING_OFFSETS : KNIGHT_OFFSETS;
+
+            for (auto const& offset : offsets)
+            {
+                int const fromSquare = getOffsetSquare(square, offset[0], offset[1]);
+                if (fromSquare >= 0 && position.m_squares[fromSquare].IsEmpty()) addPredecessor(square, fromSquare);
+            }
+
+            continue;
+        }
+
+        bool const isRookLike   = type == ePieceType::ROOK || type == ePieceType::QUEEN;
+        bool const isBishopLike = type == ePieceType::BISHOP || type == ePieceType::QUEEN;
+
+        for (int fileStep = -1; fileStep <= 1; ++fileStep)
+        {
+            for (int rankStep = -1; rankStep <= 1; ++rankStep)
+            {
+                if (fileStep == 0 && rankStep == 0) continue;
+
+                bool const isDiagonal = fileStep != 0 && rankStep != 0;
+                if ((isDiagonal && !isBishopLike) || (!isDiagonal && !isRookLike)) continue;
+
+                int fromSquare = getOffsetSquare(square, fileStep, rankStep);
+
+                while (fromSquare >= 0 && position.m_squares[fromSquare].IsEmpty())
+                {
+                    addPredecessor(square, fromSquare);
+                    fromSquare = getOffsetSquare(fromSquare, fileStep, rankStep);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Claims an unresolved position. Several threads may reach the same predecessor; the first
+/// compare-and-swap wins and the rest see it resolved.
+bool TablebaseGenerator::TrySetState(sChessPosition const& position,
+                                     uint8_t const         state)
+{
+    uint64_t const index = m_material.EncodePosition(position, false);
+    if (index == TABLEBASE_INVALID_INDEX) return false;
+
+    uint8_t expected = STATE_UNRESOLVED;
+
+    return m_states[position.m_sideToMove * m_material.m_positionCount + index].compare_exchange_strong(expected, state, std::memory_order_relaxed);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint8_t TablebaseGenerator::GetPhaseOneWdl(uint64_t const stateIndex) const
+{
+    return (m_wdl[stateIndex / 4] >> ((stateIndex % 4) * 2)) & 0x3;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Splits every state index (both sides to move) into one contiguous range per pool thread.
+template <typename T_Function>
+void TablebaseGenerator::RunParallel(T_Function const& function)
+{
+    int const      chunkCount = m_workerThreadPool.GetThreadCount();
+    uint64_t const stateCount = m_material.m_positionCount * 2;
+    uint64_t const chunkSize  = (stateCount + chunkCount - 1) / chunkCount;
+
+    m_workerThreadPool.ParallelFor(chunkCount, [&function, stateCount, chunkSize](int const chunkIndex)
+    {
+        uint64_t const beginIndex = std::min(stateCount, chunkSize * chunkIndex);
+        uint64_t const endIndex   = std::min(stateCount, beginIndex + chunkSize);
+
+        function(beginIndex, endIndex);
+    });
+}
@@ -0,0 +1,75 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseGenerator.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "Game/Subsystem/Tablebase/TablebaseMaterial.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class WorkerThreadPool;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Retrograde solver for one material set. Every table reached by a capture or a promotion must
+/// already be open in the TablebaseSubsystem.
+///
+/// Two passes over the same machinery:
+///   1. WDL: pawn moves stay inside the table, captures and promotions probe the smaller tables.
+///   2. DTZ: pawn moves also leave the table (their value comes from pass 1), so the distance
+///      counts plies to the next zeroing move.
+/// Each pass starts from mates and winning exits, then walks unmoves from the newest layer of
+/// results. Layers are split across a WorkerThreadPool; results are written with compare-and-swap.
+///
+/// Positions are indexed without en passant rights, but a double push is scored with the opponent's
+/// en passant captures as extra replies, each a capture into a smaller table.
+class TablebaseGenerator
+{
+public:
+    TablebaseGenerator(TablebaseSubsystem const& tablebase, sTablebaseMaterial const& material, WorkerThreadPool& workerThreadPool);
+    ~TablebaseGenerator() = default;
+
+    void Generate();
+    bool WriteFiles(String const& wdlPath, String const& dtzPath) const;
+
+    uint64_t GetResultCount(eTablebaseResult result) const;
+    uint64_t GetInvalidCount() const;
+    int      GetPassCount() const;
+    int      GetLongestWin() const;
+
+private:
+    struct sChildValue
+    {
+        eTablebaseResult m_result   = eTablebaseResult::UNKNOWN; // For the side to move in the child
+        int              m_distance = 0;
+        bool             m_isExit   = false;
+    };
+
+    void        SolvePhase(bool arePawnMovesExits);
+    void        InitializeStates();
+    void        RunPass(int distance, uint64_t& out_processedCount, uint64_t& out_assignedCount);
+    bool        IsLostAtDistance(sChessPosition const& position, int distance, std::vector<sChessMove>& moves) const;
+    sChildValue GetChildValue(sChessPosition const& position, sChessMove const& move) const;
+    sChildValue GetEnPassantChildValue(sChessPosition const& child, sChildValue const& indexedValue) const;
+    void        GenerateUnmoves(sChessPosition const& position, std::vector<sChessPosition>& out_predecessors, std::vector<sChessMove>& out_moves) const;
+    bool        TrySetState(sChessPosition const& position, uint8_t state);
+    uint8_t     GetPhaseOneWdl(uint64_t stateIndex) const;
+
+    template <typename T_Function>
+    void RunParallel(T_Function const& function);
+
+    TablebaseSubsystem const&         m_tablebase;
+    sTablebaseMaterial                m_material;
+    WorkerThreadPool&                 m_workerThreadPool;
+    bool                              m_arePawnMovesExits = false;
+    std::vector<std::atomic<uint8_t>> m_states;     // Working state of the current phase, side 0 block then side 1 block
+    std::vector<uint8_t>              m_wdl;        // Packed 2-bit results of phase 1
+    std::vector<uint8_t>              m_dtz;        // Distances of phase 2
+    int                               m_passCount  = 0;
+    int                               m_longestWin = 0;
+};
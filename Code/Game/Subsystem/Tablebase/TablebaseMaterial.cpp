@@ -0,0 +1,495 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseMaterial.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Tablebase/TablebaseMaterial.hpp"
+
+#include <algorithm>
+#include <cctype>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int constexpr TRIANGLE_SQUARES[10] = {0, 1, 2, 3, 9, 10, 11, 18, 19, 27};
+static int constexpr PAWNLESS_KING_SLOTS  = 10;
+static int constexpr PAWN_KING_SLOTS      = 32;
+static int constexpr NON_KING_TYPE_COUNT  = 5;
+static int constexpr SIDE_COUNT_CODES     = 1 << (2 * NON_KING_TYPE_COUNT);     // Two bits of count per type
+
+//----------------------------------------------------------------------------------------------------
+/// Order of the non-king pieces inside a side: queen, rook, bishop, knight, pawn.
+static int GetPieceOrder(ePieceType const type)
+{
+    switch (type)
+    {
+    case ePieceType::KING: return 0;
+    case ePieceType::QUEEN: return 1;
+    case ePieceType::ROOK: return 2;
+    case ePieceType::BISHOP: return 3;
+    case ePieceType::KNIGHT: return 4;
+    case ePieceType::PAWN: return 5;
+    case ePieceType::NONE:
+    default: return 6;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static int GetPieceValue(ePieceType const type)
+{
+    switch (type)
+    {
+    case ePieceType::QUEEN: return 9;
+    case ePieceType::ROOK: return 5;
+    case ePieceType::BISHOP:
+    case ePieceType::KNIGHT: return 3;
+    case ePieceType::PAWN: return 1;
+    case ePieceType::KING:
+    case ePieceType::NONE:
+    default: return 0;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static char GetPieceLetter(ePieceType const type)
+{
+    switch (type)
+    {
+    case ePieceType::KING: return 'K';
+    case ePieceType::QUEEN: return 'Q';
+    case ePieceType::ROOK: return 'R';
+    case ePieceType::BISHOP: return 'B';
+    case ePieceType::KNIGHT: return 'N';
+    case ePieceType::PAWN: return 'P';
+    case ePieceType::NONE:
+    default: return '?';
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+static ePieceType GetPieceTypeFromLetter(char const letter)
+{
+    switch (toupper(static_cast<unsigned char>(letter)))
+    {
+    case 'K': return ePieceType::KING;
+    case 'Q': return ePieceType::QUEEN;
+    case 'R': return ePieceType::ROOK;
+    case 'B': return ePieceType::BISHOP;
+    case 'N': return ePieceType::KNIGHT;
+    case 'P': return ePieceType::PAWN;
+    default: return ePieceType::NONE;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// Maps a side's piece counts, two bits per non-king type in GetPieceOrder order, to the index of
+/// that multiset among the TABLEBASE_SIDE_MATERIAL_COUNT of at most three pieces; -1 past that.
+struct sSideMaterialIndexTable
+{
+    sSideMaterialIndexTable()
+    {
+        int nextIndex = 0;
+
+        for (int code = 0; code < SIDE_COUNT_CODES; ++code)
+        {
+            int pieceCount = 0;
+
+            for (int typeIndex = 0; typeIndex < NON_KING_TYPE_COUNT; ++typeIndex)
+            {
+                pieceCount += (code >> (typeIndex * 2)) & 0x3;
+            }
+
+            m_indexes[code] = pieceCount <= TABLEBASE_MAX_PIECE_COUNT - 2 ? nextIndex++ : -1;
+        }
+    }
+
+    int m_indexes[SIDE_COUNT_CODES] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+static int GetSideMaterialIndex(int const (&counts)[NON_KING_TYPE_COUNT])
+{
+    static sSideMaterialIndexTable const s_table;
+
+    int code = 0;
+
+    for (int typeIndex = 0; typeIndex < NON_KING_TYPE_COUNT; ++typeIndex)
+    {
+        if (counts[typeIndex] > 3) return -1;
+
+        code |= counts[typeIndex] << (typeIndex * 2);
+    }
+
+    return s_table.m_indexes[code];
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief True when the second side should be player #0 of the table: more material wins, ties are
+/// broken on the piece letters so every material set has exactly one orientation.
+static bool IsSecondSideStronger(std::vector<ePieceType> const& first,
+                                 std::vector<ePieceType> const& second)
+{
+    int firstValue  = 0;
+    int secondValue = 0;
+
+    for (ePieceType const type : first) firstValue += GetPieceValue(type);
+    for (ePieceType const type : second) secondValue += GetPieceValue(type);
+
+    if (firstValue != secondValue) return secondValue > firstValue;
+    if (first.size() != second.size()) return second.size() > first.size();
+
+    for (size_t i = 0; i < first.size(); ++i)
+    {
+        int const firstOrder  = GetPieceOrder(first[i]);
+        int const secondOrder = GetPieceOrder(second[i]);
+
+        if (firstOrder != secondOrder) return secondOrder < firstOrder;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Builds a material from the two sides' pieces (kings included), flipping them if needed.
+static bool BuildMaterial(std::vector<ePieceType> first,
+                          std::vector<ePieceType> second,
+                          sTablebaseMaterial&     out_material,
+                          bool&                   out_isColorFlipped)
+{
+    auto const byOrder = [](ePieceType const a, ePieceType const b) { return GetPieceOrder(a) < GetPieceOrder(b); };
+
+    std::sort(first.begin(), first.end(), byOrder);
+    std::sort(second.begin(), second.end(), byOrder);
+
+    if (first.empty() || second.empty()) return false;
+    if (first[0] != ePieceType::KING || second[0] != ePieceType::KING) return false;
+    if (first.size() > 1 && first[1] == ePieceType::KING) return false;
+    if (second.size() > 1 && second[1] == ePieceType::KING) return false;
+    if (first.size() + second.size() > TABLEBASE_MAX_PIECE_COUNT) return false;
+
+    out_isColorFlipped = IsSecondSideStronger(first, second);
+    if (out_isColorFlipped) std::swap(first, second);
+
+    sTablebaseMaterial material;
+
+    // Both kings lead the index so the king slot can use the first king's symmetry.
+    material.m_types[0]     = ePieceType::KING;
+    material.m_playerIds[0] = 0;
+    material.m_types[1]     = ePieceType::KING;
+    material.m_playerIds[1] = 1;
+    material.m_pieceCount   = 2;
+
+    for (int playerId = 0; playerId < 2; ++playerId)
+    {
+        std::vector<ePieceType> const& side = playerId == 0 ? first : second;
+
+        for (size_t i = 1; i < side.size(); ++i)
+        {
+            material.m_types[material.m_pieceCount]     = side[i];
+            material.m_playerIds[material.m_pieceCount] = static_cast<int8_t>(playerId);
+            ++material.m_pieceCount;
+
+            if (side[i] == ePieceType::PAWN) material.m_hasPawns = true;
+        }
+    }
+
+    material.m_positionCount = material.m_hasPawns ? PAWN_KING_SLOTS : PAWNLESS_KING_SLOTS;
+
+    for (int i = 1; i < material.m_pieceCount; ++i)
+    {
+        material.m_positionCount *= CHESS_BOARD_SQUARE_COUNT;
+    }
+
+    out_material = material;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Parses "KQvK", "KRPvKR" and so on. The sides may be given in either order.
+STATIC bool sTablebaseMaterial::FromSignature(String const&       signature,
+                                              sTablebaseMaterial& out_material)
+{
+    std::vector<ePieceType> sides[2];
+    int                     sideIndex = 0;
+
+    for (char const letter : signature)
+    {
+        if (letter == 'v' || letter == 'V')
+        {
+            if (++sideIndex > 1) return false;
+            continue;
+        }
+
+        ePieceType const type = GetPieceTypeFromLetter(letter);
+        if (type == ePieceType::NONE) return false;
+
+        sides[sideIndex].push_back(type);
+    }
+
+    if (sideIndex != 1) return false;
+
+    bool isColorFlipped = false;
+
+    return BuildMaterial(sides[0], sides[1], out_material, isColorFlipped);
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool sTablebaseMaterial::FromPosition(sChessPosition const& position,
+                                             sTablebaseMaterial&   out_material,
+                                             bool&                 out_isColorFlipped)
+{
+    std::vector<ePieceType> sides[2];
+
+    for (sChessSquare const& square : position.m_squares)
+    {
+        if (square.IsEmpty()) continue;
+
+        sides[square.m_playerId].push_back(square.m_type);
+    }
+
+    return BuildMaterial(sides[0], sides[1], out_material, out_isColorFlipped);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Material key of the position as it stands, player #0's pieces first. Returns
+/// TABLEBASE_INVALID_MATERIAL_KEY when no table could hold it: too many pieces or not one king each.
+STATIC int sTablebaseMaterial::GetMaterialKey(sChessPosition const& position)
+{
+    int counts[2][NON_KING_TYPE_COUNT] = {};
+    int kingCounts[2]                  = {};
+    int pieceCount                     = 0;
+
+    for (sChessSquare const& square : position.m_squares)
+    {
+        if (square.IsEmpty()) continue;
+        if (++pieceCount > TABLEBASE_MAX_PIECE_COUNT) return TABLEBASE_INVALID_MATERIAL_KEY;
+
+        if (square.m_type == ePieceType::KING) ++kingCounts[square.m_playerId];
+        else ++counts[square.m_playerId][GetPieceOrder(square.m_type) - 1];
+    }
+
+    if (kingCounts[0] != 1 || kingCounts[1] != 1) return TABLEBASE_INVALID_MATERIAL_KEY;
+
+    return GetSideMaterialIndex(counts[0]) * TABLEBASE_SIDE_MATERIAL_COUNT + GetSideMaterialIndex(counts[1]);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Key of the positions that hold this material, with the table's player #0 as the position's
+/// player #1 when isColorFlipped.
+int sTablebaseMaterial::GetMaterialKey(bool const isColorFlipped) const
+{
+    int counts[2][NON_KING_TYPE_COUNT] = {};
+
+    for (int i = 0; i < m_pieceCount; ++i)
+    {
+        if (m_types[i] == ePieceType::KING) continue;
+
+        int const playerId = isColorFlipped ? 1 - m_playerIds[i] : m_playerIds[i];
+        ++counts[playerId][GetPieceOrder(m_types[i]) - 1];
+    }
+
+    return GetSideMaterialIndex(counts[0]) * TABLEBASE_SIDE_MATERIAL_COUNT + GetSideMaterialIndex(counts[1]);
+}
+
+//----------------------------------------------------------------------------------------------------
+String sTablebaseMaterial::GetSignature() const
+{
+    String signature;
+
+    for (int playerId = 0; playerId < 2; ++playerId)
+    {
+        if (playerId == 1) signature += 'v';
+
+        for (int i = 0; i < m_pieceCount; ++i)
+        {
+            if (m_playerIds[i] == playerId) signature += GetPieceLetter(m_types[i]);
+        }
+    }
+
+    return signature;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns TABLEBASE_INVALID_INDEX when the position does not hold exactly this material.
+uint64_t sTablebaseMaterial::EncodePosition(sChessPosition const& position,
+                                            bool const            isColorFlipped) const
+{
+    int  squares[TABLEBASE_MAX_PIECE_COUNT];
+    bool isAssigned[TABLEBASE_MAX_PIECE_COUNT] = {};
+    int  assignedCount                         = 0;
+
+    for (int square = 0; square < CHESS_BOARD_SQUARE_COUNT; ++square)
+    {
+        sChessSquare const& chessSquare = position.m_squares[square];
+        if (chessSquare.IsEmpty()) continue;
+
+        int const playerId    = isColorFlipped ? 1 - chessSquare.m_playerId : chessSquare.m_playerId;
+        int const tableSquare = isColorFlipped ? square ^ 56 : square;
+        int       slot        = 0;
+
+        while (slot < m_pieceCount &&
+            (isAssigned[slot] || m_types[slot] != chessSquare.m_type || m_playerIds[slot] != playerId))
+        {
+            ++slot;
+        }
+
+        if (slot == m_pieceCount) return TABLEBASE_INVALID_INDEX;
+
+        squares[slot]    = tableSquare;
+        isAssigned[slot] = true;
+        ++assignedCount;
+    }
+
+    if (assignedCount != m_pieceCount) return TABLEBASE_INVALID_INDEX;
+
+    // Fold the first king into its canonical region and move every other piece along with it.
+    int const  kingFile   = squares[0] % CHESS_BOARD_SIZE;
+    int const  kingRank   = squares[0] / CHESS_BOARD_SIZE;
+    bool const isFileFlip = kingFile > 3;
+    bool const isRankFlip = !m_hasPawns && kingRank > 3;
+    int const  foldedFile = isFileFlip ? 7 - kingFile : kingFile;
+    int const  foldedRank = isRankFlip ? 7 - kingRank : kingRank;
+    bool       isDiagFlip = !m_hasPawns && foldedRank > foldedFile;
+
+    for (int i = 0; i < m_pieceCount; ++i)
+    {
+        int file = squares[i] % CHESS_BOARD_SIZE;
+        int rank = squares[i] / CHESS_BOARD_SIZE;
+
+        if (isFileFlip) file = 7 - file;
+        if (isRankFlip) rank = 7 - rank;
+
+        squares[i] = rank * CHESS_BOARD_SIZE + file;
+    }
+
+    // A king on the a1-h8 diagonal is symmetric under the diagonal flip, so let the first piece off
+    // the diagonal decide. Every position then has exactly one index.
+    if (!m_hasPawns && foldedRank == foldedFile)
+    {
+        for (int i = 1; i < m_pieceCount; ++i)
+        {
+            int const file = squares[i] % CHESS_BOARD_SIZE;
+            int const rank = squares[i] / CHESS_BOARD_SIZE;
+
+            if (file == rank) continue;
+
+            isDiagFlip = rank > file;
+            break;
+        }
+    }
+
+    if (isDiagFlip)
+    {
+        for (int i = 0; i < m_pieceCount; ++i)
+        {
+            squares[i] = (squares[i] % CHESS_BOARD_SIZE) * CHESS_BOARD_SIZE + squares[i] / CHESS_BOARD_SIZE;
+        }
+    }
+
+    uint64_t index = 0;
+
+    if (m_hasPawns)
+    {
+        index = (squares[0] / CHESS_BOARD_SIZE) * 4 + squares[0] % CHESS_BOARD_SIZE;
+    }
+    else
+    {
+        index = std::find(std::begin(TRIANGLE_SQUARES), std::end(TRIANGLE_SQUARES), squares[0]) - std::begin(TRIANGLE_SQUARES);
+    }
+
+    for (int i = 1; i < m_pieceCount; ++i)
+    {
+        index = index * CHESS_BOARD_SQUARE_COUNT + squares[i];
+    }
+
+    return index;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Returns false for indexes that do not describe a placeable position: two pieces on one
+/// square or a pawn on its first or last rank. Whether the side not to move is in check, and whether
+/// the index is the canonical one for its position, is left to the caller.
+bool sTablebaseMaterial::DecodePosition(uint64_t const  index,
+                                        int const       sideToMove,
+                                        sChessPosition& out_position) const
+{
+    int      squares[TABLEBASE_MAX_PIECE_COUNT];
+    uint64_t remaining = index;
+
+    for (int i = m_pieceCount - 1; i >= 1; --i)
+    {
+        squares[i] = static_cast<int>(remaining % CHESS_BOARD_SQUARE_COUNT);
+        remaining /= CHESS_BOARD_SQUARE_COUNT;
+    }
+
+    int const kingSlot = static_cast<int>(remaining);
+    squares[0]         = m_hasPawns ? (kingSlot / 4) * CHESS_BOARD_SIZE + kingSlot % 4 : TRIANGLE_SQUARES[kingSlot];
+
+    out_position = sChessPosition();
+
+    for (sChessSquare& square : out_position.m_squares)
+    {
+        square = sChessSquare();
+    }
+
+    for (int i = 0; i < m_pieceCount; ++i)
+    {
+        sChessSquare& square = out_position.m_squares[squares[i]];
+        if (!square.IsEmpty()) return false;
+
+        int const rank = squares[i] / CHESS_BOARD_SIZE;
+        if (m_types[i] == ePieceType::PAWN && (rank == 0 || rank == CHESS_BOARD_SIZE - 1)) return false;
+
+        square.m_type     = m_types[i];
+        square.m_playerId = m_playerIds[i];
+    }
+
+    out_position.m_sideToMove     = static_cast<int8_t>(sideToMove);
+    out_position.m_castlingRights = CASTLING_NONE;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Tables reached by a capture or a promotion; the generator needs them before this one.
+void sTablebaseMaterial::GetChildSignatures(std::vector<String>& out_signatures) const
+{
+    out_signatures.clear();
+
+    auto const addChild = [&out_signatures](std::vector<ePieceType> const& first, std::vector<ePieceType> const& second)
+    {
+        if (first.size() + second.size() <= 2) return;
+
+        sTablebaseMaterial child;
+        bool               isColorFlipped = false;
+
+        if (!BuildMaterial(first, second, child, isColorFlipped)) return;
+
+        String const signature = child.GetSignature();
+
+        if (std::find(out_signatures.begin(), out_signatures.end(), signature) == out_signatures.end())
+        {
+            out_signatures.push_back(signature);
+        }
+    };
+
+    for (int i = 2; i < m_pieceCount; ++i)
+    {
+        for (ePieceType const replacement : {ePieceType::NONE, ePieceType::QUEEN, ePieceType::ROOK, ePieceType::BISHOP, ePieceType::KNIGHT})
+        {
+            // NONE removes the piece (a capture); the others promote a pawn.
+            if (replacement != ePieceType::NONE && m_types[i] != ePieceType::PAWN) continue;
+
+            std::vector<ePieceType> sides[2];
+
+            for (int j = 0; j < m_pieceCount; ++j)
+            {
+                ePieceType const type = j == i ? replacement : m_types[j];
+                if (type != ePieceType::NONE) sides[m_playerIds[j]].push_back(type);
+            }
+
+            addChild(sides[0], sides[1]);
+        }
+    }
+}
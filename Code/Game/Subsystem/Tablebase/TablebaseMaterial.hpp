@@ -0,0 +1,49 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseMaterial.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr      TABLEBASE_MAX_PIECE_COUNT      = 5;
+uint64_t constexpr TABLEBASE_INVALID_INDEX        = ~0ull;
+int constexpr      TABLEBASE_SIDE_MATERIAL_COUNT  = 56;     // Multisets of at most three non-king pieces
+int constexpr      TABLEBASE_MATERIAL_KEY_COUNT   = TABLEBASE_SIDE_MATERIAL_COUNT * TABLEBASE_SIDE_MATERIAL_COUNT;
+int constexpr      TABLEBASE_INVALID_MATERIAL_KEY = -1;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// The piece set of one table and its position index. Inside a table the stronger side is always
+/// player #0; positions with the colors the other way round are probed through a color flip.
+///
+/// Index layout: [king slot][second king][piece 3][piece 4][piece 5], one square (0-63) per piece.
+/// Pawnless tables fold the first king into the a1-d1-d4 triangle (10 slots, 8-fold symmetry);
+/// tables with pawns only mirror files, so the first king is folded onto files a-d (32 slots).
+///
+/// A material key packs player #0's and player #1's non-king pieces into one integer below
+/// TABLEBASE_MATERIAL_KEY_COUNT, so a probe finds its table with one pass over the board and one
+/// array read instead of building a signature.
+struct sTablebaseMaterial
+{
+    int        m_pieceCount                           = 0;
+    ePieceType m_types[TABLEBASE_MAX_PIECE_COUNT]     = {};
+    int8_t     m_playerIds[TABLEBASE_MAX_PIECE_COUNT] = {};
+    bool       m_hasPawns                             = false;
+    uint64_t   m_positionCount                        = 0; // Per side to move
+
+    static bool FromSignature(String const& signature, sTablebaseMaterial& out_material);
+    static bool FromPosition(sChessPosition const& position, sTablebaseMaterial& out_material, bool& out_isColorFlipped);
+    static int  GetMaterialKey(sChessPosition const& position);
+
+    String   GetSignature() const;
+    int      GetMaterialKey(bool isColorFlipped) const;
+    uint64_t EncodePosition(sChessPosition const& position, bool isColorFlipped) const;
+    bool     DecodePosition(uint64_t index, int sideToMove, sChessPosition& out_position) const;
+    void     GetChildSignatures(std::vector<String>& out_signatures) const;
+};
@@ -0,0 +1,510 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseSubsystem.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
+
+#include <climits>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <vector>
+
+#include "Engine/Core/DevConsole.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/Time.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+#include "Game/Gameplay/Game.hpp"
+#include "Game/Gameplay/Match.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseGenerator.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static eTablebaseResult GetOppositeResult(eTablebaseResult const result)
+{
+    if (result == eTablebaseResult::WIN) return eTablebaseResult::LOSS;
+    if (result == eTablebaseResult::LOSS) return eTablebaseResult::WIN;
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+static char const* GetResultName(eTablebaseResult const result)
+{
+    switch (result)
+    {
+    case eTablebaseResult::WIN: return "win";
+    case eTablebaseResult::DRAW: return "draw";
+    case eTablebaseResult::LOSS: return "loss";
+    case eTablebaseResult::UNKNOWN:
+    default: return "unknown";
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief A table file is usable when its header matches the material it is named after.
+static bool IsTableFileValid(MappedFile const& file,
+                             uint32_t const    magic,
+                             uint64_t const    positionCount,
+                             uint64_t const    dataSize)
+{
+    if (!file.IsOpen() || file.GetSize() != TABLEBASE_HEADER_SIZE + dataSize) return false;
+
+    uint32_t fileMagic         = 0;
+    uint32_t fileVersion       = 0;
+    uint64_t filePositionCount = 0;
+
+    memcpy(&fileMagic, file.GetData(), sizeof(fileMagic));
+    memcpy(&fileVersion, file.GetData() + 4, sizeof(fileVersion));
+    memcpy(&filePositionCount, file.GetData() + 8, sizeof(filePositionCount));
+
+    return fileMagic == magic && fileVersion == TABLEBASE_VERSION && filePositionCount == positionCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+TablebaseSubsystem::TablebaseSubsystem(sTablebaseSubsystemConfig const& config)
+    : m_config(config)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+void TablebaseSubsystem::StartUp()
+{
+    g_theEventSystem->SubscribeEventCallbackFunction("tb_generate", OnTablebaseGenerate);
+    g_theEventSystem->SubscribeEventCallbackFunction("tb_probe", OnTablebaseProbe);
+
+    int const tableCount = OpenTables();
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[Tablebase] %d tables open from %s. Type 'tb_generate set=KQvK' to build more.", tableCount, m_config.m_tablebaseDirectory.c_str()));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Opens a table the background generation has finished and starts on the next one.
+void TablebaseSubsystem::BeginFrame()
+{
+    if (!m_generationThread.joinable() || !m_isGenerationFinished.load(std::memory_order_acquire)) return;
+
+    FinishGeneration();
+    StartNextGeneration();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Waits for a table that is being solved, since it reads the open tables.
+void TablebaseSubsystem::ShutDown()
+{
+    if (m_generationThread.joinable()) m_generationThread.join();
+
+    m_generationQueue.clear();
+
+    delete m_generatorThreadPool;
+    m_generatorThreadPool = nullptr;
+
+    for (auto& [signature, table] : m_tables)
+    {
+        delete table;
+    }
+
+    m_tables.clear();
+
+    for (sMaterialSlot& slot : m_tablesByMaterialKey)
+    {
+        slot = sMaterialSlot();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Maps every <signature>.wdl/.dtz pair in the tablebase directory.
+/// @return Number of tables open afterwards.
+int TablebaseSubsystem::OpenTables()
+{
+    std::error_code errorCode;
+
+    for (auto const& entry : std::filesystem::directory_iterator(m_config.m_tablebaseDirectory, errorCode))
+    {
+        if (entry.path().extension() != ".wdl") continue;
+
+        OpenTable(entry.path().stem().string());
+    }
+
+    return GetTableCount();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TablebaseSubsystem::OpenTable(String const& signature)
+{
+    if (HasTable(signature)) return true;
+
+    sTablebaseMaterial material;
+    if (!sTablebaseMaterial::FromSignature(signature, material)) return false;
+    if (material.GetSignature() != signature) return false;
+
+    uint64_t const stateCount = material.m_positionCount * 2;
+    sTable*        table      = new sTable();
+    table->m_material         = material;
+
+    table->m_wdlFile.Open(GetTablePath(signature, ".wdl").c_str());
+    table->m_dtzFile.Open(GetTablePath(signature, ".dtz").c_str());
+
+    if (!IsTableFileValid(table->m_wdlFile, TABLEBASE_WDL_MAGIC, material.m_positionCount, (stateCount + 3) / 4) ||
+        !IsTableFileValid(table->m_dtzFile, TABLEBASE_DTZ_MAGIC, material.m_positionCount, stateCount))
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[Tablebase] Ignoring %s: missing or mismatched files.", signature.c_str()));
+        delete table;
+        return false;
+    }
+
+    m_tables[signature] = table;
+
+    // Unflipped last, so a material that is its own mirror image probes without the flip.
+    m_tablesByMaterialKey[material.GetMaterialKey(true)]  = {table, true};
+    m_tablesByMaterialKey[material.GetMaterialKey(false)] = {table, false};
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Unmaps a table so its files can be rewritten.
+void TablebaseSubsystem::CloseTable(String const& signature)
+{
+    auto const found = m_tables.find(signature);
+    if (found == m_tables.end()) return;
+
+    m_tablesByMaterialKey[found->second->m_material.GetMaterialKey(true)]  = sMaterialSlot();
+    m_tablesByMaterialKey[found->second->m_material.GetMaterialKey(false)] = sMaterialSlot();
+
+    delete found->second;
+    m_tables.erase(found);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TablebaseSubsystem::HasTable(String const& signature) const
+{
+    return m_tables.find(signature) != m_tables.end();
+}
+
+//----------------------------------------------------------------------------------------------------
+int TablebaseSubsystem::GetTableCount() const
+{
+    return static_cast<int>(m_tables.size());
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Queues a table and, first, every smaller table a capture or promotion can reach, and starts solving
+/// them in the background. Each table is reported and opened by BeginFrame once it is written.
+/// @return false if the signature is not a valid material, or a generation or tournament is still running.
+bool TablebaseSubsystem::GenerateTable(String const& signature)
+{
+    sTablebaseMaterial material;
+
+    if (!sTablebaseMaterial::FromSignature(signature, material) || material.m_pieceCount < 3)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Tablebase] '%s' is not a 3 to %d piece material such as KQvK or KRPvKR.", signature.c_str(), TABLEBASE_MAX_PIECE_COUNT));
+        return false;
+    }
+
+    if (IsGenerating())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, Stringf("[Tablebase] Still generating %s; wait for it to finish.", m_generationQueue.back().GetSignature().c_str()));
+        return false;
+    }
+
+    // Finished tables are opened while the tournament thread may be probing.
+    if (g_theGame != nullptr && g_theGame->IsTournamentRunning())
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[Tablebase] A tournament is probing the tables; generate once it is done.");
+        return false;
+    }
+
+    if (HasTable(material.GetSignature())) return true;
+
+    QueueGeneration(material);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MINOR, Stringf("[Tablebase] Generating %d table(s) in the background, ending with %s.", static_cast<int>(m_generationQueue.size()), material.GetSignature().c_str()));
+
+    StartNextGeneration();
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TablebaseSubsystem::IsGenerating() const
+{
+    return !m_generationQueue.empty();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief One read of the packed WDL block.
+eTablebaseResult TablebaseSubsystem::ProbeWdl(sChessPosition const& position) const
+{
+    int pieceCount = 0;
+
+    for (sChessSquare const& square : position.m_squares)
+    {
+        if (!square.IsEmpty()) ++pieceCount;
+    }
+
+    if (pieceCount == 2) return eTablebaseResult::DRAW;
+
+    uint64_t      index      = 0;
+    int           sideToMove = 0;
+    sTable const* table      = FindTable(position, index, sideToMove);
+
+    if (table == nullptr || index == TABLEBASE_INVALID_INDEX) return eTablebaseResult::UNKNOWN;
+
+    uint64_t const stateIndex = sideToMove * table->m_material.m_positionCount + index;
+    uint8_t const  packed     = table->m_wdlFile.GetData()[TABLEBASE_HEADER_SIZE + stateIndex / 4];
+
+    switch ((packed >> ((stateIndex % 4) * 2)) & 0x3)
+    {
+    case 0: return eTablebaseResult::DRAW;
+    case 1: return eTablebaseResult::WIN;
+    case 2: return eTablebaseResult::LOSS;
+    default: return eTablebaseResult::UNKNOWN;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Plies to the next zeroing move or mate: positive when the side to move wins, negative when
+/// it loses, 0 for a draw. One WDL read plus one DTZ read.
+bool TablebaseSubsystem::ProbeDtz(sChessPosition const& position,
+                                  int&                  out_dtz) const
+{
+    eTablebaseResult const result = ProbeWdl(position);
+    if (result == eTablebaseResult::UNKNOWN) return false;
+
+    out_dtz = 0;
+    if (result == eTablebaseResult::DRAW) return true;
+
+    uint64_t      index      = 0;
+    int           sideToMove = 0;
+    sTable const* table      = FindTable(position, index, sideToMove);
+    if (table == nullptr) return false;
+
+    uint64_t const stateIndex = sideToMove * table->m_material.m_positionCount + index;
+    int const      distance   = table->m_dtzFile.GetData()[TABLEBASE_HEADER_SIZE + stateIndex];
+
+    out_dtz = result == eTablebaseResult::WIN ? distance : -distance;
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Picks the tablebase-best move: mate, then the fastest zeroing win, then the draw, and when
+/// lost, the longest resistance. Returns false if any reply falls outside the open tables.
+bool TablebaseSubsystem::ChooseMove(sChessPosition const& position,
+                                    sChessMove&           out_move) const
+{
+    if (ProbeWdl(position) == eTablebaseResult::UNKNOWN) return false;
+
+    std::vector<sChessMove> moves;
+    GenerateLegalMoves(position, moves);
+    if (moves.empty()) return false;
+
+    int bestScore = INT_MIN;
+
+    for (sChessMove const& move : moves)
+    {
+        sChessPosition child = position;
+        child.ApplyMove(move);
+
+        eTablebaseResult const result = GetOppositeResult(ProbeWdl(child));
+        if (result == eTablebaseResult::UNKNOWN) return false;
+
+        int childDtz = 0;
+        if (result != eTablebaseResult::DRAW && !ProbeDtz(child, childDtz)) return false;
+
+        int score = 0;
+
+        if (result == eTablebaseResult::WIN)
+        {
+            bool const isMate = IsInCheck(child, child.m_sideToMove) && !HasAnyLegalMove(child);
+
+            if (isMate) score = 300000;
+            else if (IsZeroingMove(position, move)) score = 200000;
+            else score = 100000 - abs(childDtz);
+        }
+        else if (result == eTablebaseResult::LOSS)
+        {
+            score = -100000 + abs(childDtz);
+        }
+
+        if (score > bestScore)
+        {
+            bestScore = score;
+            out_move  = move;
+        }
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+String TablebaseSubsystem::GetTablePath(String const& signature,
+                                        char const*   extension) const
+{
+    return m_config.m_tablebaseDirectory + "/" + signature + extension;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC bool TablebaseSubsystem::OnTablebaseGenerate(EventArgs& args)
+{
+    String const signature = args.GetValue("set", "KQvK");
+
+    return g_theTablebaseSubsystem->GenerateTable(signature);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Prints the tablebase verdict and best move for the current match position.
+STATIC bool TablebaseSubsystem::OnTablebaseProbe(EventArgs& args)
+{
+    UNUSED(args)
+
+    if (g_theGame == nullptr || g_theGame->m_match == nullptr)
+    {
+        g_theDevConsole->AddLine(DevConsole::WARNING, "[Tablebase] No match in progress.");
+        return false;
+    }
+
+    sChessPosition const   position = g_theGame->m_match->GetChessPosition();
+    eTablebaseResult const result   = g_theTablebaseSubsystem->ProbeWdl(position);
+
+    if (result == eTablebaseResult::UNKNOWN)
+    {
+        g_theDevConsole->AddLine(DevConsole::INFO_MINOR, "[Tablebase] Position is not covered by the open tables.");
+        return true;
+    }
+
+    int        dtz = 0;
+    sChessMove bestMove;
+
+    g_theTablebaseSubsystem->ProbeDtz(position, dtz);
+    g_theTablebaseSubsystem->ChooseMove(position, bestMove);
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Tablebase] %s for player #%d, dtz %d, best move %s",
+                                                             GetResultName(result),
+                                                             position.m_sideToMove,
+                                                             dtz,
+                                                             GetMoveString(bestMove).c_str()));
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+TablebaseSubsystem::sTable const* TablebaseSubsystem::FindTable(sChessPosition const& position,
+                                                                uint64_t&             out_index,
+                                                                int&                  out_sideToMove) const
+{
+    if (position.m_castlingRights != CASTLING_NONE || position.CanCaptureEnPassant()) return nullptr;
+
+    int const materialKey = sTablebaseMaterial::GetMaterialKey(position);
+    if (materialKey == TABLEBASE_INVALID_MATERIAL_KEY) return nullptr;
+
+    sMaterialSlot const& slot = m_tablesByMaterialKey[materialKey];
+    if (slot.m_table == nullptr) return nullptr;
+
+    out_index      = slot.m_table->m_material.EncodePosition(position, slot.m_isColorFlipped);
+    out_sideToMove = slot.m_isColorFlipped ? 1 - position.m_sideToMove : position.m_sideToMove;
+
+    return slot.m_table;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Appends the material after every missing table it depends on, each material once.
+void TablebaseSubsystem::QueueGeneration(sTablebaseMaterial const& material)
+{
+    std::vector<String> childSignatures;
+    material.GetChildSignatures(childSignatures);
+
+    for (String const& childSignature : childSignatures)
+    {
+        sTablebaseMaterial childMaterial;
+        if (HasTable(childSignature) || !sTablebaseMaterial::FromSignature(childSignature, childMaterial)) continue;
+
+        QueueGeneration(childMaterial);
+    }
+
+    String const signature = material.GetSignature();
+
+    for (sTablebaseMaterial const& queuedMaterial : m_generationQueue)
+    {
+        if (queuedMaterial.GetSignature() == signature) return;
+    }
+
+    m_generationQueue.push_back(material);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Solves the front of the queue on m_generationThread. The thread only drives the
+/// generator; each pass is spread across m_generatorThreadPool.
+void TablebaseSubsystem::StartNextGeneration()
+{
+    if (m_generationQueue.empty()) return;
+
+    if (m_generatorThreadPool == nullptr) m_generatorThreadPool = new WorkerThreadPool(m_config.m_generatorThreadCount);
+
+    std::error_code errorCode;
+    std::filesystem::create_directories(m_config.m_tablebaseDirectory, errorCode);
+
+    sTablebaseMaterial const material  = m_generationQueue.front();
+    String const             signature = material.GetSignature();
+    String const             wdlPath   = GetTablePath(signature, ".wdl");
+    String const             dtzPath   = GetTablePath(signature, ".dtz");
+
+    m_generationResult = sGenerationResult();
+    m_isGenerationFinished.store(false, std::memory_order_relaxed);
+
+    m_generationThread = std::thread([this, material, wdlPath, dtzPath]()
+    {
+        double const startTime = GetCurrentTimeSeconds();
+
+        TablebaseGenerator generator(*this, material, *m_generatorThreadPool);
+        generator.Generate();
+
+        sGenerationResult& result = m_generationResult;
+        result.m_isWritten        = generator.WriteFiles(wdlPath, dtzPath);
+        result.m_longestWin       = generator.GetLongestWin();
+        result.m_passCount        = generator.GetPassCount();
+        result.m_elapsedSeconds   = GetCurrentTimeSeconds() - startTime;
+
+        for (eTablebaseResult const tableResult : {eTablebaseResult::LOSS, eTablebaseResult::DRAW, eTablebaseResult::WIN})
+        {
+            result.m_resultCounts[static_cast<int>(tableResult)] = generator.GetResultCount(tableResult);
+        }
+
+        m_isGenerationFinished.store(true, std::memory_order_release);
+    });
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Reports and opens the table m_generationThread just wrote. A failure drops the rest of the
+/// queue, since the tables after it may depend on it.
+void TablebaseSubsystem::FinishGeneration()
+{
+    m_generationThread.join();
+
+    String const signature = m_generationQueue.front().GetSignature();
+    m_generationQueue.erase(m_generationQueue.begin());
+
+    sGenerationResult const& result = m_generationResult;
+
+    if (!result.m_isWritten)
+    {
+        g_theDevConsole->AddLine(DevConsole::ERROR, Stringf("[Tablebase] Could not write %s to %s", signature.c_str(), m_config.m_tablebaseDirectory.c_str()));
+        m_generationQueue.clear();
+        return;
+    }
+
+    g_theDevConsole->AddLine(DevConsole::INFO_MAJOR, Stringf("[Tablebase] %s: %llu wins, %llu draws, %llu losses, longest win %d plies, %d passes, %.2f s",
+                                                             signature.c_str(),
+                                                             result.m_resultCounts[static_cast<int>(eTablebaseResult::WIN)],
+                                                             result.m_resultCounts[static_cast<int>(eTablebaseResult::DRAW)],
+                                                             result.m_resultCounts[static_cast<int>(eTablebaseResult::LOSS)],
+                                                             result.m_longestWin,
+                                                             result.m_passCount,
+                                                             result.m_elapsedSeconds));
+
+    if (!OpenTable(signature)) m_generationQueue.clear();
+}
@@ -0,0 +1,122 @@
+//----------------------------------------------------------------------------------------------------
+// TablebaseSubsystem.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include "Engine/Core/EventSystem.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/MappedFile.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseMaterial.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class WorkerThreadPool;
+
+//----------------------------------------------------------------------------------------------------
+uint32_t constexpr TABLEBASE_WDL_MAGIC   = 0x57544344; // "DCTW"
+uint32_t constexpr TABLEBASE_DTZ_MAGIC   = 0x5A544344; // "DCTZ"
+uint32_t constexpr TABLEBASE_VERSION     = 1;
+size_t constexpr   TABLEBASE_HEADER_SIZE = 16;
+
+//----------------------------------------------------------------------------------------------------
+struct sTablebaseSubsystemConfig
+{
+    String m_tablebaseDirectory   = "Data/Tablebases";
+    int    m_generatorThreadCount = 0; // 0 uses every hardware thread
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Game-theoretic value for the side to move.
+enum class eTablebaseResult : int8_t
+{
+    UNKNOWN = -1,
+    LOSS,
+    DRAW,
+    WIN
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Probes memory-mapped endgame tables. Each material set has two files next to each other:
+///   <signature>.wdl : 2 bits per position (draw, win, loss, invalid), one read per probe.
+///   <signature>.dtz : 1 byte per position, plies to the next capture, promotion, pawn move or mate.
+/// Both files start with a 16-byte header (magic, version, positions per side) followed by the
+/// player #0 to move block and then the player #1 to move block.
+///
+/// Tables assume no castling rights and no en passant capture on the move; such positions probe as
+/// UNKNOWN. The generator still scores each double pawn push with the en passant replies it allows.
+///
+/// Generation runs in the background: one table at a time is solved on a WorkerThreadPool, driven
+/// from its own thread, and BeginFrame opens each finished table on the main thread before starting
+/// the next. The open tables never change while a table is being solved, so probes stay lock-free.
+class TablebaseSubsystem
+{
+public:
+    explicit TablebaseSubsystem(sTablebaseSubsystemConfig const& config);
+    ~TablebaseSubsystem() = default;
+
+    void StartUp();
+    void BeginFrame();
+    void ShutDown();
+
+    int  OpenTables();
+    bool OpenTable(String const& signature);
+    void CloseTable(String const& signature);
+    bool HasTable(String const& signature) const;
+    int  GetTableCount() const;
+    bool GenerateTable(String const& signature);
+    bool IsGenerating() const;
+
+    eTablebaseResult ProbeWdl(sChessPosition const& position) const;
+    bool             ProbeDtz(sChessPosition const& position, int& out_dtz) const;
+    bool             ChooseMove(sChessPosition const& position, sChessMove& out_move) const;
+
+    String GetTablePath(String const& signature, char const* extension) const;
+
+    static bool OnTablebaseGenerate(EventArgs& args);
+    static bool OnTablebaseProbe(EventArgs& args);
+
+private:
+    struct sTable
+    {
+        sTablebaseMaterial m_material;
+        MappedFile         m_wdlFile;
+        MappedFile         m_dtzFile;
+    };
+
+    struct sMaterialSlot
+    {
+        sTable* m_table          = nullptr;
+        bool    m_isColorFlipped = false;     // Positions with this key probe the table through a color flip
+    };
+
+    struct sGenerationResult
+    {
+        bool     m_isWritten       = false;
+        uint64_t m_resultCounts[3] = {};     // Indexed by eTablebaseResult
+        int      m_longestWin      = 0;
+        int      m_passCount       = 0;
+        double   m_elapsedSeconds  = 0.0;
+    };
+
+    sTable const* FindTable(sChessPosition const& position, uint64_t& out_index, int& out_sideToMove) const;
+    void          QueueGeneration(sTablebaseMaterial const& material);
+    void          StartNextGeneration();
+    void          FinishGeneration();
+
+    sTablebaseSubsystemConfig       m_config;
+    std::map<String, sTable*>       m_tables;
+    sMaterialSlot                   m_tablesByMaterialKey[TABLEBASE_MATERIAL_KEY_COUNT];
+    std::vector<sTablebaseMaterial> m_generationQueue;                  // Children before the tables that need them
+    WorkerThreadPool*               m_generatorThreadPool  = nullptr;   // Created by the first generation
+    std::thread                     m_generationThread;
+    std::atomic<bool>               m_isGenerationFinished = false;
+    sGenerationResult               m_generationResult;                 // Written by m_generationThread before it sets m_isGenerationFinished
+};
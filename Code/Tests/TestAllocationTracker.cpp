@@ -0,0 +1,176 @@
+//----------------------------------------------------------------------------------------------------
+// TestAllocationTracker.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Framework/AllocationTracker.hpp"
+#include "Game/Framework/FixedTimestep.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Framework/TimerWheel.hpp"
+#include "Game/Framework/TweenSystem.hpp"
+#include "Game/Gameplay/Actor.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr SIMULATED_PIECE_COUNT = 32;
+
+//----------------------------------------------------------------------------------------------------
+// Backends only pass resource pointers through, so the draws stand them in with addresses of these.
+static int s_fakeResources[4];
+
+template <typename T>
+static T* GetFakeResource(int const index)
+{
+    return reinterpret_cast<T*>(&s_fakeResources[index]);
+}
+
+//----------------------------------------------------------------------------------------------------
+class SimulatedPiece : public Actor
+{
+public:
+    SimulatedPiece() : Actor(nullptr) {}
+
+    void Update(float const deltaSeconds) override { UNUSED(deltaSeconds) }
+    void Render() const override {}
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The parts of a MATCH frame that run without a window or a GPU, laid out as Match holds them:
+/// fixed steps of timers and tweens, then culling, then submitting and executing every draw.
+struct sSimulatedMatch
+{
+    std::vector<SimulatedPiece> m_pieces = std::vector<SimulatedPiece>(SIMULATED_PIECE_COUNT);
+    TimerWheel                  m_timerWheel;
+    TweenSystem                 m_tweenSystem;
+    FixedTimestep               m_fixedTimestep;
+    FrustumCuller               m_frustumCuller;
+    RenderCommandList           m_renderCommandList;
+    RecordingRenderBackend      m_backend;
+    int                         m_firedTimerCount = 0;
+    int                         m_movedPieceCount = 0;
+
+    /// @brief Like SchedulePieceForRemoval's timers, each firing schedules the next.
+    void ScheduleTimer()
+    {
+        m_timerWheel.Schedule(0.25f, [this]()
+        {
+            ++m_firedTimerCount;
+            ScheduleTimer();
+        });
+    }
+
+    void RunFrame()
+    {
+        int const stepCount = m_fixedTimestep.Accumulate(1.0 / 60.0);
+
+        for (int stepIndex = 0; stepIndex < stepCount; ++stepIndex)
+        {
+            m_timerWheel.Advance(m_fixedTimestep.GetStepSeconds());
+            m_tweenSystem.Update(m_fixedTimestep.GetStepSeconds());
+
+            // Finished pieces hop back, so a tween starts or ends on most steps.
+            for (Actor* actor : m_tweenSystem.GetFinishedActors())
+            {
+                m_tweenSystem.Start(actor, actor->m_position, Vec3(-actor->m_position.x, actor->m_position.y, 0.f), 0.3f, eTweenCurve::HOP);
+                ++m_movedPieceCount;
+            }
+        }
+
+        m_frustumCuller.Clear();
+
+        for (SimulatedPiece const& piece : m_pieces)
+        {
+            m_frustumCuller.AddBounds(piece.m_position, Vec3(0.25f, 0.25f, 0.5f));
+        }
+
+        m_frustumCuller.Cull(sFrustum::MakePerspective(Vec3(-10.f, 0.f, 5.f), EulerAngles(0.f, 20.f, 0.f), 2.f, 60.f, 0.1f, 100.f));
+
+        for (int pieceIndex = 0; pieceIndex < SIMULATED_PIECE_COUNT; ++pieceIndex)
+        {
+            if (!m_frustumCuller.IsVisible(pieceIndex)) continue;
+
+            sRenderState state;
+            state.m_shader      = GetFakeResource<Shader const>(pieceIndex % 2);
+            state.m_textures[0] = GetFakeResource<Texture const>(2);
+
+            Mat44 modelToWorld;
+            modelToWorld.SetTranslation3D(m_pieces[pieceIndex].m_position);
+
+            m_renderCommandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, modelToWorld, Rgba8::WHITE, GetFakeResource<VertexBuffer>(3), GetFakeResource<IndexBuffer>(3), 36);
+        }
+
+        m_renderCommandList.Execute(m_backend);
+        m_backend.Clear();
+        RenderStatisticsBeginFrame();
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Arms the zero-allocation assert the way assertZeroAllocationFrames does and runs MATCH frames
+/// under it. Any allocation in a checked frame dies in AllocationTrackerBeginFrame.
+TEST_CASE(ArmedZeroAllocationAssertHoldsAcrossSimulatedMatchFrames)
+{
+    sSimulatedMatch match;
+
+    for (int pieceIndex = 0; pieceIndex < SIMULATED_PIECE_COUNT; ++pieceIndex)
+    {
+        SimulatedPiece& piece = match.m_pieces[pieceIndex];
+        piece.m_position      = Vec3(static_cast<float>(pieceIndex % 8), static_cast<float>(pieceIndex / 8), 0.f);
+        match.m_tweenSystem.Start(&piece, piece.m_position, Vec3(-piece.m_position.x, piece.m_position.y, 0.f), 0.1f * static_cast<float>(pieceIndex % 5 + 1), eTweenCurve::HOP);
+    }
+
+    match.ScheduleTimer();
+
+    // Untracked frames first, so every container has grown to its working size, as after a match's opening moves.
+    for (int frameIndex = 0; frameIndex < 60; ++frameIndex)
+    {
+        match.RunFrame();
+    }
+
+    SetAllocationTrackingEnabled(true);
+    SetZeroAllocationAssertEnabled(true);
+    AllocationTrackerBeginFrame();      // The frame that turns them on is never checked
+
+    int const firedTimerCountBefore = match.m_firedTimerCount;
+    int const movedPieceCountBefore = match.m_movedPieceCount;
+
+    for (int frameIndex = 0; frameIndex < 120; ++frameIndex)
+    {
+        match.RunFrame();
+        AllocationTrackerBeginFrame();
+        CHECK(GetLastFrameAllocationStatistics().m_allocationCount == 0);
+    }
+
+    SetZeroAllocationAssertEnabled(false);
+    SetAllocationTrackingEnabled(false);
+    AllocationTrackerBeginFrame();
+
+    // The frames did real work: timers fired and rescheduled, and tweens finished and restarted.
+    CHECK(match.m_firedTimerCount - firedTimerCountBefore >= 7);
+    CHECK(match.m_movedPieceCount - movedPieceCountBefore >= SIMULATED_PIECE_COUNT);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TrackedFrameCountsItsAllocations)
+{
+    SetAllocationTrackingEnabled(true);
+    AllocationTrackerBeginFrame();
+
+    // Called directly, since a new-expression and its delete may be optimized away.
+    void* const block = ::operator new(64);
+    ::operator delete(block);
+
+    AllocationTrackerBeginFrame();
+    SetAllocationTrackingEnabled(false);
+
+    CHECK(GetLastFrameAllocationStatistics().m_allocationCount >= 1);
+    CHECK(GetLastFrameAllocationStatistics().m_freeCount >= 1);
+    CHECK(GetLastFrameAllocationStatistics().m_byteCount >= 64);
+}
@@ -0,0 +1,99 @@
+//----------------------------------------------------------------------------------------------------
+// TestChessRules.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cstdint>
+#include <vector>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+int constexpr PERFT_MAX_DEPTH = 4;
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Leaf count of the legal move tree; any generator bug in castling, en passant, promotion or
+/// pins shows up as a count that differs from the published one.
+static uint64_t Perft(sChessPosition const& position,
+                      int const             depth)
+{
+    static std::vector<sChessMove> s_moveLists[PERFT_MAX_DEPTH + 1];
+
+    std::vector<sChessMove>& moves = s_moveLists[depth];
+    GenerateLegalMoves(position, moves);
+
+    if (depth == 1) return moves.size();
+
+    uint64_t nodeCount = 0;
+
+    for (sChessMove const& move : moves)
+    {
+        sChessPosition child = position;
+        child.ApplyMove(move);
+        nodeCount += Perft(child, depth - 1);
+    }
+
+    return nodeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t Perft(char const* fen,
+                      int const   depth)
+{
+    sChessPosition position;
+    CHECK(ParseFenString(fen, position));
+
+    return Perft(position, depth);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Published counts from the Chess Programming Wiki perft results page.
+TEST_CASE(PerftStartingPosition)
+{
+    CHECK(Perft(sChessPosition::GetStartingPosition(), 1) == 20);
+    CHECK(Perft(sChessPosition::GetStartingPosition(), 2) == 400);
+    CHECK(Perft(sChessPosition::GetStartingPosition(), 3) == 8902);
+    CHECK(Perft(sChessPosition::GetStartingPosition(), 4) == 197281);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PerftKiwipete)
+{
+    char const* fen = "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1";
+
+    CHECK(Perft(fen, 1) == 48);
+    CHECK(Perft(fen, 2) == 2039);
+    CHECK(Perft(fen, 3) == 97862);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PerftEnPassantAndDiscoveredChecks)
+{
+    char const* fen = "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1";
+
+    CHECK(Perft(fen, 1) == 14);
+    CHECK(Perft(fen, 2) == 191);
+    CHECK(Perft(fen, 3) == 2812);
+    CHECK(Perft(fen, 4) == 43238);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PerftPromotionsAndCastling)
+{
+    char const* fen = "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1";
+
+    CHECK(Perft(fen, 1) == 6);
+    CHECK(Perft(fen, 2) == 264);
+    CHECK(Perft(fen, 3) == 9467);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PerftUnderpromotionIntoCheck)
+{
+    char const* fen = "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8";
+
+    CHECK(Perft(fen, 1) == 44);
+    CHECK(Perft(fen, 2) == 1486);
+    CHECK(Perft(fen, 3) == 62379);
+}
@@ -0,0 +1,192 @@
+//----------------------------------------------------------------------------------------------------
+// TestFrustumCuller.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
+#include <random>
+
+#include "Engine/Math/AABB3.hpp"
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Framework/FrustumCuller.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A camera at the origin looking down +x: x forward, y left, z up.
+static sFrustum MakeTestFrustum(float const yawDegrees = 0.f)
+{
+    return sFrustum::MakePerspective(Vec3(0.f, 0.f, 0.f), EulerAngles(yawDegrees, 0.f, 0.f), 2.f, 60.f, 0.1f, 100.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsNear(Vec3 const& a,
+                   Vec3 const& b)
+{
+    return std::fabs(a.x - b.x) < 1e-4f && std::fabs(a.y - b.y) < 1e-4f && std::fabs(a.z - b.z) < 1e-4f;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Largest signed plane distance over the box's eight corners; the box is fully outside the
+/// plane when it is negative. Independent of the culler's center and radius form.
+static float GetMaxCornerDistance(sFrustum const& frustum,
+                                  int const       plane,
+                                  Vec3 const&     center,
+                                  Vec3 const&     halfExtents)
+{
+    float maxDistance = -1e30f;
+
+    for (int corner = 0; corner < 8; ++corner)
+    {
+        Vec3 const position(center.x + ((corner & 1) != 0 ? halfExtents.x : -halfExtents.x),
+                            center.y + ((corner & 2) != 0 ? halfExtents.y : -halfExtents.y),
+                            center.z + ((corner & 4) != 0 ? halfExtents.z : -halfExtents.z));
+
+        maxDistance = std::fmax(maxDistance, DotProduct3D(frustum.m_normals[plane], position) + frustum.m_distances[plane]);
+    }
+
+    return maxDistance;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(BoxesInsideThePlanesAreVisibleAndOutsideAreCulled)
+{
+    FrustumCuller culler;
+    Vec3 const    halfExtents(0.5f, 0.5f, 0.5f);
+
+    int const ahead      = culler.AddBounds(Vec3(10.f, 0.f, 0.f), halfExtents);
+    int const behind     = culler.AddBounds(Vec3(-10.f, 0.f, 0.f), halfExtents);
+    int const pastFar    = culler.AddBounds(Vec3(101.f, 0.f, 0.f), halfExtents);
+    int const acrossFar  = culler.AddBounds(Vec3(100.2f, 0.f, 0.f), halfExtents);
+    int const farLeft    = culler.AddBounds(Vec3(10.f, 30.f, 0.f), halfExtents);
+    int const farAbove   = culler.AddBounds(Vec3(10.f, 0.f, 10.f), halfExtents);
+    int const acrossLeft = culler.AddBounds(Vec3(10.f, 11.8f, 0.f), halfExtents);
+    int const aroundEye  = culler.AddBounds(Vec3(0.f, 0.f, 0.f), Vec3(0.05f, 0.05f, 0.05f));
+    int const beforeNear = culler.AddBounds(Vec3(0.04f, 0.f, 0.f), Vec3(0.05f, 0.05f, 0.05f));
+
+    culler.Cull(MakeTestFrustum());
+
+    CHECK(culler.IsVisible(ahead));
+    CHECK(!culler.IsVisible(behind));
+    CHECK(!culler.IsVisible(pastFar));
+    CHECK(culler.IsVisible(acrossFar));
+    CHECK(!culler.IsVisible(farLeft));
+    CHECK(!culler.IsVisible(farAbove));
+    CHECK(culler.IsVisible(acrossLeft));
+    CHECK(!culler.IsVisible(aroundEye));
+    CHECK(!culler.IsVisible(beforeNear));
+    CHECK(culler.GetVisibleCount() == 3);
+    CHECK(culler.GetCulledCount() == 6);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(FrustumTurnsWithTheCamera)
+{
+    FrustumCuller culler;
+    Vec3 const    halfExtents(0.5f, 0.5f, 0.5f);
+
+    int const alongX = culler.AddBounds(Vec3(10.f, 0.f, 0.f), halfExtents);
+    int const alongY = culler.AddBounds(Vec3(0.f, 10.f, 0.f), halfExtents);
+
+    culler.Cull(MakeTestFrustum(90.f));
+
+    CHECK(!culler.IsVisible(alongX));
+    CHECK(culler.IsVisible(alongY));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Counts that are not a multiple of four run the tail through the scalar path, so every lane
+/// and the remainder must agree with a plain corner test.
+TEST_CASE(EveryLaneMatchesACornerTest)
+{
+    std::mt19937                          random(7);
+    std::uniform_real_distribution<float> position(-60.f, 120.f);
+    std::uniform_real_distribution<float> extent(0.f, 8.f);
+    sFrustum const                        frustum = MakeTestFrustum(30.f);
+
+    for (int const boundsCount : {1, 3, 4, 5, 8, 1003})
+    {
+        FrustumCuller     culler;
+        std::vector<Vec3> centers;
+        std::vector<Vec3> extents;
+
+        for (int index = 0; index < boundsCount; ++index)
+        {
+            centers.emplace_back(position(random), position(random), position(random) * 0.25f);
+            extents.emplace_back(extent(random), extent(random), extent(random));
+            CHECK(culler.AddBounds(centers.back(), extents.back()) == index);
+        }
+
+        culler.Cull(frustum);
+
+        int visibleCount = 0;
+
+        for (int index = 0; index < boundsCount; ++index)
+        {
+            float minMaxDistance = 1e30f;
+
+            for (int plane = 0; plane < FRUSTUM_PLANE_COUNT; ++plane)
+            {
+                minMaxDistance = std::fmin(minMaxDistance, GetMaxCornerDistance(frustum, plane, centers[index], extents[index]));
+            }
+
+            // Boxes touching a plane within rounding may land either way.
+            if (std::fabs(minMaxDistance) > 1e-3f) CHECK(culler.IsVisible(index) == (minMaxDistance >= 0.f));
+            if (culler.IsVisible(index)) ++visibleCount;
+        }
+
+        CHECK(culler.GetBoundsCount() == boundsCount);
+        CHECK(culler.GetVisibleCount() == visibleCount);
+        CHECK(culler.GetVisibleCount() + culler.GetCulledCount() == boundsCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TransformedBoundsEncloseTheRotatedBox)
+{
+    AABB3 const localBounds(Vec3(0.f, 0.f, 0.f), Vec3(2.f, 1.f, 1.f));
+
+    Mat44 quarterTurn = Mat44::MakeTranslation3D(Vec3(10.f, 0.f, 0.f));
+    quarterTurn.AppendZRotation(90.f);
+
+    AABB3 const quarterTurnBounds = TransformBounds(localBounds, quarterTurn);
+
+    CHECK(IsNear(quarterTurnBounds.m_mins, Vec3(9.f, 0.f, 0.f)));
+    CHECK(IsNear(quarterTurnBounds.m_maxs, Vec3(10.f, 2.f, 1.f)));
+
+    Mat44 eighthTurn = Mat44::MakeUniformScale3D(1.f);
+    eighthTurn.AppendZRotation(45.f);
+
+    AABB3 const cubeBounds(Vec3(-0.5f, -0.5f, -0.5f), Vec3(0.5f, 0.5f, 0.5f));
+    AABB3 const eighthTurnBounds = TransformBounds(cubeBounds, eighthTurn);
+    float const halfDiagonal     = std::sqrt(0.5f);
+
+    CHECK(IsNear(eighthTurnBounds.m_mins, Vec3(-halfDiagonal, -halfDiagonal, -0.5f)));
+    CHECK(IsNear(eighthTurnBounds.m_maxs, Vec3(halfDiagonal, halfDiagonal, 0.5f)));
+
+    // AddBounds with a transform stores the same world box.
+    FrustumCuller culler;
+    culler.AddBounds(localBounds, quarterTurn);
+    culler.Cull(MakeTestFrustum());
+    CHECK(culler.IsVisible(0));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(ClearDropsEveryBox)
+{
+    FrustumCuller culler;
+
+    culler.AddBounds(Vec3(10.f, 0.f, 0.f), Vec3(1.f, 1.f, 1.f));
+    culler.AddBounds(Vec3(-10.f, 0.f, 0.f), Vec3(1.f, 1.f, 1.f));
+    culler.Cull(MakeTestFrustum());
+    CHECK(culler.GetVisibleCount() == 1);
+
+    culler.Clear();
+    CHECK(culler.GetBoundsCount() == 0);
+    CHECK(culler.GetVisibleCount() == 0);
+    CHECK(culler.GetCulledCount() == 0);
+    CHECK(culler.AddBounds(Vec3(-10.f, 0.f, 0.f), Vec3(1.f, 1.f, 1.f)) == 0);
+
+    culler.Cull(MakeTestFrustum());
+    CHECK(!culler.IsVisible(0));
+    CHECK(culler.GetCulledCount() == 1);
+}
@@ -0,0 +1,42 @@
+//----------------------------------------------------------------------------------------------------
+// TestHarness.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdio>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Minimal test registry for the Tests console app. Each TEST_CASE registers itself before main runs;
+/// a failing CHECK prints its file, line and expression and marks the case failed but keeps going, so
+/// one run reports every broken expectation.
+using TestFunction = void (*)();
+
+struct sTestCase
+{
+    char const*  m_name     = nullptr;
+    TestFunction m_function = nullptr;
+};
+
+std::vector<sTestCase>& GetTestCases();
+void                    ReportTestFailure(char const* file, int line, char const* expression);
+
+//----------------------------------------------------------------------------------------------------
+struct sTestRegistrar
+{
+    sTestRegistrar(char const* name, TestFunction const function) { GetTestCases().push_back({name, function}); }
+};
+
+//----------------------------------------------------------------------------------------------------
+#define TEST_CASE(name)                                                   \
+    static void name();                                                   \
+    static sTestRegistrar const s_##name##Registrar(#name, &name);        \
+    static void name()
+
+#define CHECK(expression)                                                 \
+    do                                                                    \
+    {                                                                     \
+        if (!(expression)) ReportTestFailure(__FILE__, __LINE__, #expression); \
+    } while (false)
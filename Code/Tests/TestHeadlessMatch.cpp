@@ -0,0 +1,133 @@
+//----------------------------------------------------------------------------------------------------
+// TestHeadlessMatch.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <vector>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/HeadlessMatch.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static bool SubmitMoves(HeadlessMatch& match, std::vector<char const*> const& moveStrings)
+{
+    for (char const* moveString : moveStrings)
+    {
+        if (!match.SubmitMove(ParseMoveString(moveString))) return false;
+    }
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(FenRoundTripsTheStartingPosition)
+{
+    sChessPosition position;
+
+    CHECK(ParseFenString("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", position));
+    CHECK(GetFenString(position) == GetFenString(sChessPosition::GetStartingPosition()));
+    CHECK(position.GetZobristKey() == sChessPosition::GetStartingPosition().GetZobristKey());
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(StartingPositionHasTwentyLegalMoves)
+{
+    std::vector<sChessMove> moves;
+    GenerateLegalMoves(sChessPosition::GetStartingPosition(), moves);
+
+    CHECK(moves.size() == 20);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PinnedPieceCannotLeaveTheKingInCheck)
+{
+    sChessPosition position;
+    CHECK(ParseFenString("4k3/4r3/8/8/8/8/4B3/4K3 w - - 0 1", position));
+
+    CHECK(!IsMoveLegal(position, ParseMoveString("e2d3")));
+    CHECK(IsMoveLegal(position, ParseMoveString("e1d1")));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(CannotCastleThroughCheck)
+{
+    sChessPosition position;
+    CHECK(ParseFenString("4k3/8/8/8/8/8/5r2/4K2R w K - 0 1", position));
+
+    std::vector<sChessMove> moves;
+    GenerateLegalMoves(position, moves);
+
+    CHECK(std::find(moves.begin(), moves.end(), ParseMoveString("e1g1")) == moves.end());
+    CHECK(std::find(moves.begin(), moves.end(), ParseMoveString("h1g1")) != moves.end());
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(FoolsMateEndsInCheckmate)
+{
+    HeadlessMatch match;
+
+    CHECK(SubmitMoves(match, {"f2f3", "e7e5", "g2g4", "d8h4"}));
+    CHECK(match.GetResult() == eMatchResult::WIN_CHECKMATE);
+    CHECK(match.GetWinnerId() == 1);
+    CHECK(!match.SubmitMove(ParseMoveString("a2a3")));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(IllegalMoveIsRejected)
+{
+    HeadlessMatch match;
+
+    CHECK(!match.SubmitMove(ParseMoveString("e2e5")));
+    CHECK(!match.SubmitMove(ParseMoveString("e7e5")));
+    CHECK(match.GetMoveList().empty());
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(KnightShuffleDrawsByThreefoldRepetition)
+{
+    HeadlessMatch match;
+
+    CHECK(SubmitMoves(match, {"g1f3", "g8f6", "f3g1", "f6g8", "g1f3", "g8f6", "f3g1"}));
+    CHECK(!match.IsFinished());
+    CHECK(SubmitMoves(match, {"f6g8"}));
+    CHECK(match.GetResult() == eMatchResult::DRAW_THREEFOLD_REPETITION);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(StalemateAndBareKingsAreDraws)
+{
+    sChessPosition position;
+
+    CHECK(ParseFenString("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", position));
+    CHECK(HeadlessMatch(position).GetResult() == eMatchResult::DRAW_STALEMATE);
+
+    CHECK(ParseFenString("4k3/8/8/8/8/8/8/4KB2 w - - 0 1", position));
+    CHECK(HeadlessMatch(position).GetResult() == eMatchResult::DRAW_INSUFFICIENT_MATERIAL);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(FiftyMoveRuleEndsTheMatch)
+{
+    sChessPosition position;
+    CHECK(ParseFenString("4k3/8/8/8/8/8/8/R3K3 w - - 99 80", position));
+
+    HeadlessMatch match(position);
+
+    CHECK(!match.IsFinished());
+    CHECK(match.SubmitMove(ParseMoveString("a1a2")));
+    CHECK(match.GetResult() == eMatchResult::DRAW_FIFTY_MOVE_RULE);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PawnReachingTheLastRankPromotesToAQueen)
+{
+    sChessPosition position;
+    CHECK(ParseFenString("k7/4P3/8/8/8/8/8/4K3 w - - 0 1", position));
+
+    HeadlessMatch match(position);
+
+    CHECK(match.SubmitMove(ParseMoveString("e7e8")));
+    CHECK(match.GetPosition().m_squares[GetSquareIndexFromName("e8")].m_type == ePieceType::QUEEN);
+}
@@ -0,0 +1,223 @@
+//----------------------------------------------------------------------------------------------------
+// TestLightClusterGrid.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include "Game/Framework/WorkerThreadPool.hpp"
+#include "Game/Subsystem/Light/LightClusterGrid.hpp"
+#include "Game/Subsystem/Light/LightSubsystem.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// A camera at the origin looking down +x with the player camera's projection.
+static sLightClusterView MakeTestView()
+{
+    sLightClusterView view;
+    view.m_position    = Vec3(0.f, 0.f, 0.f);
+    view.m_orientation = EulerAngles(0.f, 0.f, 0.f);
+    view.m_aspect      = 2.f;
+    view.m_fovDegrees  = 60.f;
+    return view;
+}
+
+//----------------------------------------------------------------------------------------------------
+static sLight MakeLight(eLightType const type,
+                        Vec3 const&      worldPosition,
+                        float const      outerRadius)
+{
+    sLight light;
+    light.m_type          = type;
+    light.m_worldPosition = worldPosition;
+    light.m_outerRadius   = outerRadius;
+    return light;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Point and spot lights scattered in front of, beside and behind the camera, plus a
+/// directional light.
+static std::vector<sLight> MakeRandomLights(int const      lightCount,
+                                            unsigned const seed)
+{
+    std::mt19937                          random(seed);
+    std::uniform_real_distribution<float> depth(-20.f, 110.f);
+    std::uniform_real_distribution<float> side(-60.f, 60.f);
+    std::uniform_real_distribution<float> radius(0.5f, 12.f);
+    std::vector<sLight>                   lights;
+
+    lights.push_back(MakeLight(eLightType::DIRECTIONAL, Vec3(0.f, 0.f, 0.f), 1.f));
+
+    for (int lightIndex = 1; lightIndex < lightCount; ++lightIndex)
+    {
+        eLightType const type = lightIndex % 4 == 0 ? eLightType::SPOT : eLightType::POINT;
+        lights.push_back(MakeLight(type, Vec3(depth(random), side(random), side(random) * 0.5f), radius(random)));
+    }
+
+    return lights;
+}
+
+//----------------------------------------------------------------------------------------------------
+static float GetReachRadius(sLight const& light)
+{
+    return light.m_type == eLightType::SPOT ? light.m_outerRadius + LIGHT_SPOT_ORBIT_RADIUS : light.m_outerRadius;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsSlotInCluster(LightClusterGrid const& grid,
+                            int const               clusterIndex,
+                            int const               slot)
+{
+    std::vector<uint16_t> const& slots = grid.GetClusterLightSlots();
+    int const                    first = grid.GetClusterOffset(clusterIndex);
+    int const                    count = grid.GetClusterLightCount(clusterIndex);
+
+    return std::binary_search(slots.begin() + first, slots.begin() + first + count, static_cast<uint16_t>(slot));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Binning is conservative: every light whose sphere holds a point is listed in that point's
+/// cluster, checked by brute force over points all through the view.
+TEST_CASE(EveryLightReachingAPointIsInItsCluster)
+{
+    std::vector<sLight> const lights = MakeRandomLights(400, 3);
+    LightClusterGrid          grid;
+
+    grid.Build(MakeTestView(), lights, nullptr);
+
+    std::vector<int> const&               slotLightIndexes = grid.GetSlotLightIndexes();
+    std::mt19937                          random(5);
+    std::uniform_real_distribution<float> unit(-1.f, 1.f);
+    std::uniform_real_distribution<float> depth(0.1f, 100.f);
+    int                                   checkedCount = 0;
+
+    for (int sample = 0; sample < 4000; ++sample)
+    {
+        // Bias toward the near slices, where clusters are smallest.
+        float const sampleDepth = sample % 2 == 0 ? depth(random) : depth(random) * 0.05f;
+        Vec3 const  position(sampleDepth, unit(random) * sampleDepth * grid.GetTanHalfWidth(), unit(random) * sampleDepth * grid.GetTanHalfHeight());
+        int const   clusterIndex = grid.FindClusterIndex(position);
+
+        if (clusterIndex < 0) continue;
+
+        for (int slot = 0; slot < static_cast<int>(slotLightIndexes.size()); ++slot)
+        {
+            sLight const& light = lights[slotLightIndexes[slot]];
+
+            if ((position - light.m_worldPosition).GetLength() > GetReachRadius(light) * 0.999f) continue;
+
+            CHECK(IsSlotInCluster(grid, clusterIndex, slot));
+            ++checkedCount;
+        }
+    }
+
+    CHECK(checkedCount > 1000);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PooledBuildMatchesSingleThreadedBuild)
+{
+    std::vector<sLight> const lights = MakeRandomLights(700, 7);
+    WorkerThreadPool          workerThreadPool(4);
+    LightClusterGrid          serialGrid;
+    LightClusterGrid          pooledGrid;
+
+    serialGrid.Build(MakeTestView(), lights, nullptr);
+    pooledGrid.Build(MakeTestView(), lights, &workerThreadPool);
+
+    CHECK(pooledGrid.GetSlotLightIndexes() == serialGrid.GetSlotLightIndexes());
+    CHECK(pooledGrid.GetClusterLightSlots() == serialGrid.GetClusterLightSlots());
+
+    for (int clusterIndex = 0; clusterIndex < LIGHT_CLUSTER_COUNT; ++clusterIndex)
+    {
+        CHECK(pooledGrid.GetClusterOffset(clusterIndex) == serialGrid.GetClusterOffset(clusterIndex));
+        CHECK(pooledGrid.GetClusterLightCount(clusterIndex) == serialGrid.GetClusterLightCount(clusterIndex));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SlotsFollowLightOrderAndListsAscend)
+{
+    std::vector<sLight> const lights = MakeRandomLights(500, 11);
+    LightClusterGrid          grid;
+
+    grid.Build(MakeTestView(), lights, nullptr);
+
+    std::vector<int> const&      slotLightIndexes = grid.GetSlotLightIndexes();
+    std::vector<uint16_t> const& slots            = grid.GetClusterLightSlots();
+
+    CHECK(std::is_sorted(slotLightIndexes.begin(), slotLightIndexes.end()));
+    CHECK(std::adjacent_find(slotLightIndexes.begin(), slotLightIndexes.end()) == slotLightIndexes.end());
+
+    for (int const lightIndex : slotLightIndexes)
+    {
+        CHECK(lights[lightIndex].m_type != eLightType::DIRECTIONAL);
+    }
+
+    int totalCount = 0;
+
+    for (int clusterIndex = 0; clusterIndex < LIGHT_CLUSTER_COUNT; ++clusterIndex)
+    {
+        auto const first = slots.begin() + grid.GetClusterOffset(clusterIndex);
+        auto const last  = first + grid.GetClusterLightCount(clusterIndex);
+
+        CHECK(std::adjacent_find(first, last, std::greater_equal<uint16_t>()) == last);
+        CHECK(std::all_of(first, last, [&slotLightIndexes](uint16_t const slot) { return static_cast<size_t>(slot) < slotLightIndexes.size(); }));
+        totalCount += grid.GetClusterLightCount(clusterIndex);
+    }
+
+    // Directional lights are neither clustered nor counted outside.
+    sLightClusterStatistics const& statistics = grid.GetStatistics();
+
+    CHECK(totalCount == statistics.m_indexCount);
+    CHECK(statistics.m_indexCount == static_cast<int>(slots.size()));
+    CHECK(statistics.m_clusteredCount == static_cast<int>(slotLightIndexes.size()));
+    CHECK(statistics.m_clusteredCount + statistics.m_outsideCount == static_cast<int>(lights.size()) - 1);
+    CHECK(statistics.m_droppedCount == 0);
+    CHECK(statistics.m_droppedIndexCount == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(LightsOutsideTheViewReachNoCluster)
+{
+    std::vector<sLight> lights;
+    lights.push_back(MakeLight(eLightType::POINT, Vec3(-10.f, 0.f, 0.f), 5.f));      // Behind the camera
+    lights.push_back(MakeLight(eLightType::POINT, Vec3(120.f, 0.f, 0.f), 5.f));      // Past the far plane
+    lights.push_back(MakeLight(eLightType::POINT, Vec3(10.f, 24.f, 0.f), 5.f));      // Beside the view
+    lights.push_back(MakeLight(eLightType::POINT, Vec3(-3.f, 0.f, 0.f), 5.f));       // Behind, reaching past the near plane
+    lights.push_back(MakeLight(eLightType::SPOT, Vec3(10.f, 24.f, 0.f), 5.f));       // Beside, but its orbit reaches in
+
+    LightClusterGrid grid;
+    grid.Build(MakeTestView(), lights, nullptr);
+
+    CHECK(grid.GetSlotLightIndexes() == std::vector<int>({3, 4}));
+    CHECK(grid.GetStatistics().m_outsideCount == 3);
+    CHECK(grid.GetStatistics().m_clusteredCount == 2);
+
+    int const clusterIndex = grid.FindClusterIndex(Vec3(1.f, 0.f, 0.f));
+    CHECK(clusterIndex >= 0);
+    CHECK(IsSlotInCluster(grid, clusterIndex, 0));
+    CHECK(grid.FindClusterIndex(Vec3(-1.f, 0.f, 0.f)) == -1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(LightsPastTheSlotLimitAreDropped)
+{
+    int constexpr       EXTRA_LIGHT_COUNT = 40;
+    std::vector<sLight> lights;
+
+    for (int lightIndex = 0; lightIndex < LIGHT_CLUSTER_MAX_LIGHT_COUNT + EXTRA_LIGHT_COUNT; ++lightIndex)
+    {
+        lights.push_back(MakeLight(eLightType::POINT, Vec3(20.f + static_cast<float>(lightIndex % 64), 0.f, 0.f), 0.5f));
+    }
+
+    LightClusterGrid grid;
+    grid.Build(MakeTestView(), lights, nullptr);
+
+    CHECK(grid.GetStatistics().m_clusteredCount == LIGHT_CLUSTER_MAX_LIGHT_COUNT);
+    CHECK(grid.GetStatistics().m_droppedCount == EXTRA_LIGHT_COUNT);
+    CHECK(grid.GetSlotLightIndexes().back() == LIGHT_CLUSTER_MAX_LIGHT_COUNT - 1);
+}
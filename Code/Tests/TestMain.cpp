@@ -0,0 +1,53 @@
+//----------------------------------------------------------------------------------------------------
+// TestMain.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cstring>
+
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static int s_failureCount = 0;
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sTestCase>& GetTestCases()
+{
+    static std::vector<sTestCase> s_testCases;
+    return s_testCases;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ReportTestFailure(char const* file, int const line, char const* expression)
+{
+    std::printf("  %s(%d): CHECK(%s) failed\n", file, line, expression);
+    ++s_failureCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Runs every registered case, or only those whose name contains argv[1]. Returns the number
+/// of failed cases, so ctest and build scripts see a non-zero exit on any failure.
+int main(int const argc, char** argv)
+{
+    char const* filter          = argc > 1 ? argv[1] : nullptr;
+    int         failedCaseCount = 0;
+    int         runCaseCount    = 0;
+
+    for (sTestCase const& testCase : GetTestCases())
+    {
+        if (filter != nullptr && std::strstr(testCase.m_name, filter) == nullptr) continue;
+
+        int const failureCountBefore = s_failureCount;
+        testCase.m_function();
+        ++runCaseCount;
+
+        bool const hasFailed = s_failureCount != failureCountBefore;
+        std::printf("[%s] %s\n", hasFailed ? "FAIL" : " OK ", testCase.m_name);
+
+        if (hasFailed) ++failedCaseCount;
+    }
+
+    std::printf("%d of %d test cases passed\n", runCaseCount - failedCaseCount, runCaseCount);
+
+    return failedCaseCount;
+}
@@ -0,0 +1,217 @@
+//----------------------------------------------------------------------------------------------------
+// TestMeshOptimizer.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <array>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "Game/Framework/MeshOptimizer.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The optimizer takes any trivially copyable vertex, so the cases use a position and normal of their
+// own and run without the Engine.
+struct sTestPoint
+{
+    float x = 0.f;
+    float y = 0.f;
+    float z = 0.f;
+
+    bool operator==(sTestPoint const& other) const { return x == other.x && y == other.y && z == other.z; }
+};
+
+struct sTestVertex
+{
+    sTestPoint m_position;
+    sTestPoint m_normal;
+};
+
+typedef std::vector<sTestVertex>        TestVertexList;
+typedef std::vector<unsigned int>       TestIndexList;
+typedef std::tuple<float, float, float> PositionKey;
+typedef std::array<PositionKey, 3>      TriangleKey;
+
+//----------------------------------------------------------------------------------------------------
+static sTestVertex MakeVertex(sTestPoint const& position,
+                              sTestPoint const& normal = sTestPoint{0.f, 0.f, 1.f})
+{
+    sTestVertex vertex;
+    vertex.m_position = position;
+    vertex.m_normal   = normal;
+    return vertex;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief A gridSize by gridSize quad grid with three unshared vertexes per triangle, in shuffled
+/// triangle order, as a mesh straight out of an unindexed bake.
+static void MakeShuffledGrid(int const       gridSize,
+                             unsigned const  seed,
+                             TestVertexList& out_verts,
+                             TestIndexList&  out_indexes)
+{
+    std::vector<std::array<sTestPoint, 3>> triangles;
+
+    for (int y = 0; y < gridSize; ++y)
+    {
+        for (int x = 0; x < gridSize; ++x)
+        {
+            sTestPoint const bottomLeft{static_cast<float>(x), static_cast<float>(y), 0.f};
+            sTestPoint const bottomRight{static_cast<float>(x + 1), static_cast<float>(y), 0.f};
+            sTestPoint const topLeft{static_cast<float>(x), static_cast<float>(y + 1), 0.f};
+            sTestPoint const topRight{static_cast<float>(x + 1), static_cast<float>(y + 1), 0.f};
+
+            triangles.push_back({bottomLeft, bottomRight, topRight});
+            triangles.push_back({bottomLeft, topRight, topLeft});
+        }
+    }
+
+    std::mt19937 random(seed);
+    std::shuffle(triangles.begin(), triangles.end(), random);
+
+    out_verts.clear();
+    out_indexes.clear();
+
+    for (std::array<sTestPoint, 3> const& triangle : triangles)
+    {
+        for (sTestPoint const& position : triangle)
+        {
+            out_indexes.push_back(static_cast<unsigned int>(out_verts.size()));
+            out_verts.push_back(MakeVertex(position));
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Every triangle as its corner positions, rotated to start at the smallest corner so the
+/// winding is kept, then sorted, so two meshes compare equal when they draw the same triangles.
+static std::vector<TriangleKey> GetTriangleKeys(TestVertexList const& verts,
+                                                TestIndexList const&  indexes)
+{
+    std::vector<TriangleKey> keys;
+
+    for (size_t first = 0; first + 2 < indexes.size(); first += 3)
+    {
+        TriangleKey key;
+
+        for (int corner = 0; corner < 3; ++corner)
+        {
+            sTestPoint const& position = verts[indexes[first + corner]].m_position;
+            key[corner]                = PositionKey(position.x, position.y, position.z);
+        }
+
+        std::rotate(key.begin(), std::min_element(key.begin(), key.end()), key.end());
+        keys.push_back(key);
+    }
+
+    std::sort(keys.begin(), keys.end());
+
+    return keys;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(WeldMergesOnlyBitIdenticalVertexes)
+{
+    sTestPoint const a{0.f, 0.f, 0.f};
+    sTestPoint const b{1.f, 0.f, 0.f};
+    sTestPoint const c{1.f, 1.f, 0.f};
+    sTestPoint const d{0.f, 1.f, 0.f};
+
+    // A quad as two unindexed triangles, plus a triangle on the shared corner a with a split normal.
+    TestVertexList verts   = {MakeVertex(a), MakeVertex(b), MakeVertex(c),
+                              MakeVertex(a), MakeVertex(c), MakeVertex(d),
+                              MakeVertex(a, sTestPoint{1.f, 0.f, 0.f}), MakeVertex(d), MakeVertex(c)};
+    TestIndexList  indexes = {0, 1, 2, 3, 4, 5, 6, 7, 8};
+
+    CHECK(WeldVertexes(verts, indexes) == 4);
+    CHECK(verts.size() == 5);
+    CHECK(indexes == TestIndexList({0, 1, 2, 0, 2, 3, 4, 3, 2}));
+    CHECK(verts[4].m_position == a);
+    CHECK((verts[4].m_normal == sTestPoint{1.f, 0.f, 0.f}));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(ACMRCountsFifoCacheMisses)
+{
+    CHECK(ComputeACMR(TestIndexList()) == 0.f);
+    CHECK(ComputeACMR(TestIndexList({0, 1, 2})) == 3.f);
+    CHECK(ComputeACMR(TestIndexList({0, 1, 2, 2, 1, 3})) == 2.f);
+    CHECK(ComputeACMR(TestIndexList({0, 1, 2, 0, 1, 2})) == 1.5f);
+
+    // With three entries, 3 pushes 0 out, and each miss of the last triangle pushes out the next corner.
+    CHECK(ComputeACMR(TestIndexList({0, 1, 2, 1, 2, 3, 0, 1, 2}), 3) == 7.f / 3.f);
+    CHECK(ComputeACMR(TestIndexList({0, 1, 2, 1, 2, 3, 0, 1, 2}), 4) == 4.f / 3.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(VertexFetchRenumbersInFirstUseOrderAndDropsUnused)
+{
+    TestVertexList verts;
+
+    for (int index = 0; index < 6; ++index)
+    {
+        verts.push_back(MakeVertex(sTestPoint{static_cast<float>(index), 0.f, 0.f}));
+    }
+
+    TestIndexList indexes = {5, 2, 4, 4, 2, 0};
+
+    OptimizeVertexFetch(verts, indexes);
+
+    CHECK(indexes == TestIndexList({0, 1, 2, 2, 1, 3}));
+    CHECK(verts.size() == 4);
+    CHECK(verts[0].m_position.x == 5.f);
+    CHECK(verts[1].m_position.x == 2.f);
+    CHECK(verts[2].m_position.x == 4.f);
+    CHECK(verts[3].m_position.x == 0.f);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(OptimizeMeshDrawsTheSameTrianglesWithFewerMisses)
+{
+    int constexpr GRID_SIZE = 24;
+
+    for (unsigned seed = 0; seed < 4; ++seed)
+    {
+        TestVertexList verts;
+        TestIndexList  indexes;
+        MakeShuffledGrid(GRID_SIZE, seed, verts, indexes);
+
+        std::vector<TriangleKey> const trianglesBefore = GetTriangleKeys(verts, indexes);
+        sMeshOptimizationStats const   stats           = OptimizeMesh(verts, indexes);
+
+        CHECK(GetTriangleKeys(verts, indexes) == trianglesBefore);
+        CHECK(stats.m_triangleCount == 2 * GRID_SIZE * GRID_SIZE);
+        CHECK(stats.m_vertexCountBefore == 3 * stats.m_triangleCount);
+        CHECK(stats.m_vertexCountAfter == (GRID_SIZE + 1) * (GRID_SIZE + 1));
+        CHECK(static_cast<int>(verts.size()) == stats.m_vertexCountAfter);
+        CHECK(stats.m_acmrBefore == 3.f);
+        CHECK(stats.m_acmrAfter < 1.f);
+        CHECK(stats.m_acmrAfter == ComputeACMR(indexes));
+
+        // Fetch order: each vertex is first used right after the ones before it.
+        unsigned int nextNewIndex = 0;
+
+        for (unsigned int const index : indexes)
+        {
+            CHECK(index <= nextNewIndex);
+            if (index == nextNewIndex) ++nextNewIndex;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(OptimizeMeshLeavesAnEmptyMeshEmpty)
+{
+    TestVertexList verts;
+    TestIndexList  indexes;
+
+    sMeshOptimizationStats const stats = OptimizeMesh(verts, indexes);
+
+    CHECK(verts.empty());
+    CHECK(indexes.empty());
+    CHECK(stats.m_triangleCount == 0);
+    CHECK(stats.m_acmrAfter == 0.f);
+}
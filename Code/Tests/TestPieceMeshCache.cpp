@@ -0,0 +1,193 @@
+//----------------------------------------------------------------------------------------------------
+// TestPieceMeshCache.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+
+#include "Game/Definition/PieceDefinition.hpp"
+#include "Game/Definition/PieceMeshCache.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// The cache runs without a Renderer or DevConsole here, so its meshes keep only their CPU copies.
+
+//----------------------------------------------------------------------------------------------------
+static String GetTestCachePath()
+{
+    return (std::filesystem::temp_directory_path() / "DaemonChessTestPieceMeshCache.bin").string();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief A pawn-like part list: a box base under a sphere head.
+static std::vector<sPiecePart> MakeTestParts()
+{
+    std::vector<sPiecePart> parts(2);
+
+    parts[0].m_name          = "aabb3";
+    parts[0].m_startPosition = Vec3(-0.2f, -0.2f, 0.f);
+    parts[0].m_endPosition   = Vec3(0.2f, 0.2f, 0.1f);
+    parts[1].m_name          = "sphere";
+    parts[1].m_startPosition = Vec3(0.f, 0.f, 0.4f);
+    parts[1].m_radius        = 0.15f;
+
+    return parts;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Writes one mesh record the way SaveToFile lays it out.
+static void WriteTestMesh(std::ofstream&                   file,
+                          uint64_t const                   key,
+                          uint32_t const                   vertexCount,
+                          std::vector<unsigned int> const& indexes)
+{
+    uint32_t const          indexCount = static_cast<uint32_t>(indexes.size());
+    VertexList_PCUTBN const vertexes(vertexCount);
+
+    file.write(reinterpret_cast<char const*>(&key), sizeof(key));
+    file.write(reinterpret_cast<char const*>(&vertexCount), sizeof(vertexCount));
+    file.write(reinterpret_cast<char const*>(&indexCount), sizeof(indexCount));
+    file.write(reinterpret_cast<char const*>(vertexes.data()), static_cast<std::streamsize>(vertexCount * sizeof(Vertex_PCUTBN)));
+    file.write(reinterpret_cast<char const*>(indexes.data()), static_cast<std::streamsize>(indexCount * sizeof(unsigned int)));
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Feeds screenSizes to SelectPieceMeshLod frame after frame, as PieceBatchRenderer does, and
+/// returns how often the level changed.
+static int CountLodChanges(int&         lod,
+                           float const* screenSizes,
+                           int const    frameCount)
+{
+    int changeCount = 0;
+
+    for (int frame = 0; frame < frameCount; ++frame)
+    {
+        int const nextLod = SelectPieceMeshLod(lod, screenSizes[frame]);
+
+        if (nextLod != lod) ++changeCount;
+        lod = nextLod;
+    }
+
+    return changeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PieceMeshLodHoldsItsLevelInsideTheHysteresisBand)
+{
+    // 0.08 and 0.03 are the thresholds; the band around each is 20% either way.
+    for (int finerLod = 0; finerLod < PIECE_MESH_LOD_COUNT - 1; ++finerLod)
+    {
+        float const threshold = PIECE_MESH_LOD_SCREEN_SIZES[finerLod];
+        float const low       = threshold * (1.f - PIECE_MESH_LOD_HYSTERESIS * 0.5f);
+        float const high      = threshold * (1.f + PIECE_MESH_LOD_HYSTERESIS * 0.5f);
+        float       jitter[64];
+
+        for (int frame = 0; frame < 64; ++frame)
+        {
+            jitter[frame] = frame % 2 == 0 ? low : high;
+        }
+
+        int lod        = finerLod;
+        int coarserLod = finerLod + 1;
+
+        CHECK(CountLodChanges(lod, jitter, 64) == 0);
+        CHECK(lod == finerLod);
+        CHECK(CountLodChanges(coarserLod, jitter, 64) == 0);
+        CHECK(coarserLod == finerLod + 1);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PieceMeshLodSwitchesOncePerThresholdCrossing)
+{
+    // A piece receding past both thresholds, jittering at each, then coming back.
+    float const screenSizes[] = {0.2f, 0.1f, 0.085f, 0.075f, 0.085f, 0.06f, 0.075f, 0.085f, 0.04f, 0.032f, 0.028f,
+                                 0.032f, 0.02f, 0.028f, 0.032f, 0.028f, 0.04f, 0.032f, 0.06f, 0.085f, 0.075f, 0.1f};
+    int         lod           = 0;
+
+    CHECK(CountLodChanges(lod, screenSizes, 8) == 1);           // Down at 0.06
+    CHECK(lod == 1);
+    CHECK(CountLodChanges(lod, screenSizes + 8, 8) == 1);       // Down at 0.02
+    CHECK(lod == 2);
+    CHECK(CountLodChanges(lod, screenSizes + 16, 3) == 1);      // Up at 0.04
+    CHECK(lod == 1);
+    CHECK(CountLodChanges(lod, screenSizes + 19, 3) == 1);      // Up at 0.1
+    CHECK(lod == 0);
+
+    // A jump skips straight across both, and levels out of range are clamped first.
+    CHECK(SelectPieceMeshLod(0, 0.01f) == 2);
+    CHECK(SelectPieceMeshLod(2, 0.5f) == 0);
+    CHECK(SelectPieceMeshLod(-1, 0.075f) == 0);
+    CHECK(SelectPieceMeshLod(PIECE_MESH_LOD_COUNT, 0.028f) == PIECE_MESH_LOD_COUNT - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PieceMeshCacheRoundTripsThroughItsFile)
+{
+    std::vector<sPiecePart> const parts = MakeTestParts();
+    VertexList_PCUTBN             bakedVertexes[2];
+    IndexList                     bakedIndexes[2];
+    float                         bakedRadiuses[2];
+
+    PieceMeshCache::ClearAll();
+
+    for (int lodLevel = 0; lodLevel < 2; ++lodLevel)
+    {
+        sPieceMesh const* mesh  = PieceMeshCache::GetOrCreateMesh(parts, lodLevel);
+        bakedVertexes[lodLevel] = mesh->m_vertexes;
+        bakedIndexes[lodLevel]  = mesh->m_indexes;
+        bakedRadiuses[lodLevel] = mesh->m_boundingRadius;
+        CHECK(!mesh->m_indexes.empty());
+    }
+
+    CHECK(PieceMeshCache::SaveToFile(GetTestCachePath()));
+    CHECK(!PieceMeshCache::SaveToFile(GetTestCachePath()));       // Nothing baked since
+
+    int const bakeCount = PieceMeshCache::GetBakeCount();
+
+    PieceMeshCache::ClearAll();
+    CHECK(PieceMeshCache::LoadFromFile(GetTestCachePath()));
+    CHECK(PieceMeshCache::GetMeshCount() == 2);
+
+    for (int lodLevel = 0; lodLevel < 2; ++lodLevel)
+    {
+        sPieceMesh const* mesh = PieceMeshCache::GetOrCreateMesh(parts, lodLevel);
+
+        CHECK(mesh->m_vertexes.size() == bakedVertexes[lodLevel].size());
+        CHECK(memcmp(mesh->m_vertexes.data(), bakedVertexes[lodLevel].data(), bakedVertexes[lodLevel].size() * sizeof(Vertex_PCUTBN)) == 0);
+        CHECK(mesh->m_indexes == bakedIndexes[lodLevel]);
+        CHECK(mesh->m_indexCount == static_cast<unsigned int>(bakedIndexes[lodLevel].size()));
+        CHECK(mesh->m_boundingRadius == bakedRadiuses[lodLevel]);
+    }
+
+    // Both came from the file, so neither was baked again.
+    CHECK(PieceMeshCache::GetBakeCount() == bakeCount);
+    CHECK(PieceMeshCache::GetMeshCount() == 2);
+
+    PieceMeshCache::ClearAll();
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PieceMeshCacheRejectsIndexesPastTheVertexes)
+{
+    {
+        uint32_t const meshCount = 2;
+        std::ofstream  file(GetTestCachePath(), std::ios::binary | std::ios::trunc);
+
+        file.write(reinterpret_cast<char const*>(&PIECE_MESH_CACHE_MAGIC), sizeof(PIECE_MESH_CACHE_MAGIC));
+        file.write(reinterpret_cast<char const*>(&PIECE_MESH_CACHE_VERSION), sizeof(PIECE_MESH_CACHE_VERSION));
+        file.write(reinterpret_cast<char const*>(&meshCount), sizeof(meshCount));
+        WriteTestMesh(file, 1, 3, {0, 1, 2});
+        WriteTestMesh(file, 2, 3, {0, 1, 3});
+    }
+
+    PieceMeshCache::ClearAll();
+
+    // The damaged mesh is dropped; the one read before it is kept.
+    CHECK(!PieceMeshCache::LoadFromFile(GetTestCachePath()));
+    CHECK(PieceMeshCache::GetMeshCount() == 1);
+
+    PieceMeshCache::ClearAll();
+}
@@ -0,0 +1,201 @@
+//----------------------------------------------------------------------------------------------------
+// TestRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <new>
+
+#include "Engine/Math/Mat44.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Game/Gameplay/Board.hpp"
+#include "Game/Gameplay/HighlightOverlay.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Backends only pass resource pointers through, so the cases stand them in with addresses of these.
+static int s_fakeResources[4];
+
+template <typename T>
+static T* GetFakeResource(int const index)
+{
+    return reinterpret_cast<T*>(&s_fakeResources[index]);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Stands in for the GPU: buffers it creates are fake resources, and everything else is dropped.
+class FakeGpuRenderBackend final : public RenderBackend
+{
+public:
+    void SetModelConstants(Mat44 const&, Rgba8 const&) override {}
+    void SetBlendMode(eBlendMode) override {}
+    void SetRasterizerMode(eRasterizerMode) override {}
+    void SetSamplerMode(eSamplerMode) override {}
+    void SetDepthMode(eDepthMode) override {}
+    void BindTexture(Texture const*, int) override {}
+    void BindShader(Shader const*) override {}
+    void BindLightSet(int) override {}
+    void DrawVertexArray(int, Vertex_PCU const*) override {}
+    void DrawIndexedVertexBuffer(VertexBuffer*, IndexBuffer*, unsigned int) override {}
+    VertexBuffer* CreateVertexBuffer(unsigned int, unsigned int) override { return GetFakeResource<VertexBuffer>(2); }
+    IndexBuffer*  CreateIndexBuffer(unsigned int, unsigned int) override { return GetFakeResource<IndexBuffer>(3); }
+    void CopyCPUToGPU(void const*, unsigned int, VertexBuffer*) override {}
+    void CopyCPUToGPU(void const*, unsigned int, IndexBuffer*) override {}
+    void CopyCPUToGPU(void const*, unsigned int, ConstantBuffer*) override {}
+    void BindConstantBuffer(int, ConstantBuffer const*) override {}
+};
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(RecordingBackendLogsEveryCallAndForwardsIt)
+{
+    RecordingRenderBackend target;
+    RecordingRenderBackend backend(&target);
+
+    backend.BindShader(GetFakeResource<Shader const>(0));
+    backend.BindTexture(GetFakeResource<Texture const>(1), 2);
+    backend.SetBlendMode(eBlendMode::ALPHA);
+    backend.DrawIndexedVertexBuffer(GetFakeResource<VertexBuffer>(2), GetFakeResource<IndexBuffer>(3), 36);
+    backend.DrawIndexedVertexBuffer(GetFakeResource<VertexBuffer>(2), GetFakeResource<IndexBuffer>(3), 12);
+
+    std::vector<sRecordedRenderCall> const& calls = backend.GetCalls();
+
+    CHECK(calls.size() == 5);
+    CHECK(target.GetCalls().size() == 5);
+    CHECK(calls[0].m_call == eRenderCall::BIND_SHADER);
+    CHECK(calls[0].m_resource == GetFakeResource<Shader const>(0));
+    CHECK(calls[1].m_call == eRenderCall::BIND_TEXTURE);
+    CHECK(calls[1].m_value == 2);
+    CHECK(calls[2].m_value == static_cast<int>(eBlendMode::ALPHA));
+    CHECK(calls[4].m_value == 12);
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) == 2);
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_VERTEX_ARRAY) == 0);
+    CHECK(backend.GetCallString(0).find("BindShader") == 0);
+
+    for (int index = 0; index < static_cast<int>(calls.size()); ++index)
+    {
+        CHECK(target.GetCalls()[index].m_call == calls[index].m_call);
+        CHECK(target.GetCalls()[index].m_value == calls[index].m_value);
+    }
+
+    backend.Clear();
+    CHECK(backend.GetCalls().empty());
+    CHECK(target.GetCalls().size() == 5);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(PersistentBufferDrawUploadsNothing)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+
+    RenderStatisticsBeginFrame();
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, sRenderState(), Mat44(), Rgba8::WHITE, GetFakeResource<VertexBuffer>(2), GetFakeResource<IndexBuffer>(3), 384);
+    commandList.Execute(backend);
+    RenderStatisticsBeginFrame();
+
+    sRenderStatistics const& statistics = GetLastFrameRenderStatistics();
+
+    CHECK(statistics.m_drawCount == 1);
+    CHECK(statistics.m_uploadCount == 0);
+    CHECK(statistics.m_bytesUploaded == 0);
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_VERTEX_BUFFER) == 0);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_INDEX_BUFFER) == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(VertexArrayDrawCountsItsUploadBytes)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+    VertexList_PCU const   verts(6);
+
+    RenderStatisticsBeginFrame();
+    commandList.SubmitVertexArray(eRenderLayer::OVERLAY, sRenderState(), Mat44(), Rgba8::WHITE, verts);
+    commandList.SubmitVertexArray(eRenderLayer::OVERLAY, sRenderState(), Mat44(), Rgba8::WHITE, verts);
+    commandList.Execute(backend);
+    RenderStatisticsBeginFrame();
+
+    sRenderStatistics const& statistics = GetLastFrameRenderStatistics();
+
+    CHECK(statistics.m_drawCount == 2);
+    CHECK(statistics.m_uploadCount == 2);
+    CHECK(statistics.m_bytesUploaded == 2 * verts.size() * sizeof(Vertex_PCU));
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_VERTEX_ARRAY) == 2);
+    CHECK(backend.GetCalls().back().m_value == 6);
+
+    // The next frame starts from zero.
+    RenderStatisticsBeginFrame();
+    CHECK(GetLastFrameRenderStatistics().m_drawCount == 0);
+    CHECK(GetLastFrameRenderStatistics().m_bytesUploaded == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Renders two frames of a Board through the recording backend, with no Renderer, light subsystem or
+/// resource subsystem, as a headless host would. The geometry is uploaded once when the Board is built;
+/// each frame only draws from the persistent buffers, so the second frame logs no upload at all.
+TEST_CASE(BoardUploadsOnceAndDrawsFramesWithoutUploads)
+{
+    FakeGpuRenderBackend   gpu;
+    RecordingRenderBackend backend(&gpu);
+
+    // The buffers are fake resources the Board would delete, so it is built in place and never destroyed.
+    alignas(Board) static unsigned char s_boardStorage[sizeof(Board)];
+    Board const* const board = new (s_boardStorage) Board(nullptr, backend);
+
+    VertexList_PCUTBN verts;
+    IndexList         indexes;
+    Board::CreateLocalVertsForSquares(verts, indexes);
+    Board::CreateLocalVertsForBoardFrame(verts, indexes);
+
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_INDEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_INDEX_BUFFER) == 1);
+
+    for (sRecordedRenderCall const& call : backend.GetCalls())
+    {
+        if (call.m_call == eRenderCall::COPY_VERTEX_BUFFER) CHECK(call.m_value == static_cast<int>(verts.size() * sizeof(Vertex_PCUTBN)));
+        if (call.m_call == eRenderCall::COPY_INDEX_BUFFER) CHECK(call.m_value == static_cast<int>(indexes.size() * sizeof(unsigned int)));
+    }
+
+    RenderCommandList commandList;
+
+    for (int frameIndex = 0; frameIndex < 2; ++frameIndex)
+    {
+        backend.Clear();
+        commandList.Clear();
+        RenderStatisticsBeginFrame();
+        board->SubmitDraws(commandList);
+        commandList.Execute(backend);
+        RenderStatisticsBeginFrame();
+
+        sRenderStatistics const& statistics = GetLastFrameRenderStatistics();
+
+        CHECK(statistics.m_drawCount == 1);
+        CHECK(statistics.m_uploadCount == 0);
+        CHECK(statistics.m_bytesUploaded == 0);
+        CHECK(backend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) == 1);
+        CHECK(backend.GetCallCount(eRenderCall::DRAW_VERTEX_ARRAY) == 0);
+        CHECK(backend.GetCallCount(eRenderCall::CREATE_VERTEX_BUFFER) + backend.GetCallCount(eRenderCall::CREATE_INDEX_BUFFER) == 0);
+        CHECK(backend.GetCallCount(eRenderCall::COPY_VERTEX_BUFFER) + backend.GetCallCount(eRenderCall::COPY_INDEX_BUFFER) == 0);
+    }
+
+    CHECK(backend.GetCalls().back().m_value == static_cast<int>(indexes.size()));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(HighlightOverlayCreatesItsBuffersThroughTheBackend)
+{
+    RecordingRenderBackend backend;
+    HighlightOverlay const overlay(backend);
+
+    // The piece wireframe is built up front; the square boxes wait for the first Render.
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_INDEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_INDEX_BUFFER) == 1);
+}
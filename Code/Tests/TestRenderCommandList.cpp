@@ -0,0 +1,185 @@
+//----------------------------------------------------------------------------------------------------
+// TestRenderCommandList.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Math/Mat44.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Framework/RenderStatistics.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Backends only pass resource pointers through, so the cases stand them in with addresses of these.
+static int s_fakeResources[8];
+
+template <typename T>
+static T* GetFakeResource(int const index)
+{
+    return reinterpret_cast<T*>(&s_fakeResources[index]);
+}
+
+//----------------------------------------------------------------------------------------------------
+static sRenderState MakeState(int const shaderIndex,
+                              int const textureIndex)
+{
+    sRenderState state;
+    state.m_shader      = GetFakeResource<Shader const>(shaderIndex);
+    state.m_textures[0] = GetFakeResource<Texture const>(textureIndex);
+    return state;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Submits an indexed draw whose index count tags it, so the recorded draw order can be read back.
+static void SubmitTaggedDraw(RenderCommandList&  commandList,
+                             eRenderLayer const  layer,
+                             sRenderState const& state,
+                             unsigned int const  tag)
+{
+    commandList.SubmitIndexedVertexBuffer(layer, state, Mat44(), Rgba8::WHITE, GetFakeResource<VertexBuffer>(6), GetFakeResource<IndexBuffer>(7), tag);
+}
+
+//----------------------------------------------------------------------------------------------------
+static std::vector<int> GetDrawTags(RecordingRenderBackend const& backend)
+{
+    std::vector<int> tags;
+
+    for (sRecordedRenderCall const& call : backend.GetCalls())
+    {
+        if (call.m_call == eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) tags.push_back(call.m_value);
+    }
+
+    return tags;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(IdenticalStatesBindOnce)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+    sRenderState const     state = MakeState(0, 2);
+
+    for (unsigned int tag = 1; tag <= 3; ++tag)
+    {
+        SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, state, tag);
+    }
+
+    RenderStatisticsBeginFrame();
+    commandList.Execute(backend);
+    RenderStatisticsBeginFrame();
+
+    CHECK(backend.GetCallCount(eRenderCall::BIND_SHADER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::BIND_TEXTURE) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::BIND_LIGHT_SET) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::SET_BLEND_MODE) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::SET_RASTERIZER_MODE) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::SET_SAMPLER_MODE) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::SET_DEPTH_MODE) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::SET_MODEL_CONSTANTS) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) == 3);
+
+    // Each command checks shader, one texture, four modes, light set and model constants.
+    sRenderStatistics const& statistics = GetLastFrameRenderStatistics();
+
+    CHECK(statistics.m_drawCount == 3);
+    CHECK(statistics.m_bindCount == 3);
+    CHECK(statistics.m_stateChangeCount == 5);
+    CHECK(statistics.m_skippedBindCount == 2 * 8);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(OpaqueCommandsGroupByShaderAndTexture)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(1, 3), 1);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(0, 3), 2);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(1, 2), 3);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(0, 3), 4);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(1, 3), 5);
+    commandList.Execute(backend);
+
+    CHECK(backend.GetCallCount(eRenderCall::BIND_SHADER) == 2);
+    CHECK(backend.GetCallCount(eRenderCall::BIND_TEXTURE) == 3);
+    CHECK(GetDrawTags(backend) == std::vector<int>({2, 4, 3, 1, 5}));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(LaterLayersKeepSubmissionOrderAfterOpaque)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+
+    SubmitTaggedDraw(commandList, eRenderLayer::OVERLAY, MakeState(0, 2), 1);
+    SubmitTaggedDraw(commandList, eRenderLayer::TRANSLUCENT, MakeState(1, 3), 2);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(1, 3), 3);
+    SubmitTaggedDraw(commandList, eRenderLayer::TRANSLUCENT, MakeState(0, 2), 4);
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(0, 2), 5);
+    SubmitTaggedDraw(commandList, eRenderLayer::TRANSLUCENT, MakeState(1, 3), 6);
+    commandList.Execute(backend);
+
+    CHECK(GetDrawTags(backend) == std::vector<int>({5, 3, 2, 4, 6, 1}));
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(OnlyUsedTextureSlotsAreBound)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+    sRenderState           state = MakeState(0, 2);
+
+    state.m_textures[1]      = GetFakeResource<Texture const>(3);
+    state.m_textures[2]      = GetFakeResource<Texture const>(4);
+    state.m_textureSlotCount = 2;
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, state, 1);
+    commandList.Execute(backend);
+
+    CHECK(backend.GetCallCount(eRenderCall::BIND_TEXTURE) == 2);
+
+    for (sRecordedRenderCall const& call : backend.GetCalls())
+    {
+        if (call.m_call == eRenderCall::BIND_TEXTURE) CHECK(call.m_value < 2);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(ChangedModelConstantsAndModesAreReissued)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+    sRenderState           state = MakeState(0, 2);
+
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, state, 1);
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, state, Mat44::MakeTranslation3D(Vec3(1.f, 0.f, 0.f)), Rgba8::WHITE, GetFakeResource<VertexBuffer>(6), GetFakeResource<IndexBuffer>(7), 2);
+    state.m_depthMode = eDepthMode::DISABLED;
+    SubmitTaggedDraw(commandList, eRenderLayer::OVERLAY, state, 3);
+    commandList.Execute(backend);
+
+    CHECK(backend.GetCallCount(eRenderCall::SET_MODEL_CONSTANTS) == 3);
+    CHECK(backend.GetCallCount(eRenderCall::SET_DEPTH_MODE) == 2);
+    CHECK(backend.GetCallCount(eRenderCall::SET_BLEND_MODE) == 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(EmptySubmissionsAreDroppedAndExecuteClears)
+{
+    RenderCommandList      commandList;
+    RecordingRenderBackend backend;
+
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, sRenderState(), Mat44(), Rgba8::WHITE, nullptr, GetFakeResource<IndexBuffer>(7), 6);
+    commandList.SubmitIndexedVertexBuffer(eRenderLayer::OPAQUE, sRenderState(), Mat44(), Rgba8::WHITE, GetFakeResource<VertexBuffer>(6), GetFakeResource<IndexBuffer>(7), 0);
+    commandList.SubmitVertexArray(eRenderLayer::OPAQUE, sRenderState(), Mat44(), Rgba8::WHITE, VertexList_PCU());
+    CHECK(commandList.GetCommandCount() == 0);
+
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(0, 2), 1);
+    CHECK(commandList.GetCommandCount() == 1);
+    commandList.Execute(backend);
+    CHECK(commandList.GetCommandCount() == 0);
+
+    // The state cache starts empty on every Execute, so the next frame binds again.
+    SubmitTaggedDraw(commandList, eRenderLayer::OPAQUE, MakeState(0, 2), 1);
+    commandList.Execute(backend);
+    CHECK(backend.GetCallCount(eRenderCall::BIND_SHADER) == 2);
+    CHECK(backend.GetCallCount(eRenderCall::DRAW_INDEXED_VERTEX_BUFFER) == 2);
+}
@@ -0,0 +1,159 @@
+//----------------------------------------------------------------------------------------------------
+// TestSpectatorScene.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Framework/ChessPosition.hpp"
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/RenderBackend.hpp"
+#include "Game/Framework/RenderCommandList.hpp"
+#include "Game/Gameplay/SpectatorScene.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Every case runs without a Renderer, a light subsystem or loaded definitions, as a headless host would,
+// and records into a backend with no target, so every buffer it creates comes back null.
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Submits one overview frame and drops its draws.
+static sSpectatorFrameStatistics const& SubmitOverviewFrame(SpectatorScene&         scene,
+                                                            RecordingRenderBackend& backend)
+{
+    RenderCommandList commandList;
+
+    scene.SubmitDraws(scene.GetOverviewCameraPosition(), scene.GetOverviewCameraOrientation(), commandList, backend);
+
+    return scene.GetFrameStatistics();
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Submits overview frames until no visible board is waiting on the rebuild budget.
+static void CatchUpRebuilds(SpectatorScene&         scene,
+                            RecordingRenderBackend& backend)
+{
+    for (int frame = 0; frame < 64; ++frame)
+    {
+        if (SubmitOverviewFrame(scene, backend).m_staleCount == 0) return;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SpectatorSceneBuildsAndSubmitsHeadless)
+{
+    RecordingRenderBackend backend;
+    SpectatorScene         scene(100, 3, backend);
+
+    CHECK(scene.GetBoardCount() == 100);
+
+    // The shared board mesh is created and uploaded once, through the backend.
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::CREATE_INDEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_VERTEX_BUFFER) == 1);
+    CHECK(backend.GetCallCount(eRenderCall::COPY_INDEX_BUFFER) == 1);
+
+    for (sRecordedRenderCall const& call : backend.GetCalls())
+    {
+        if (call.m_call == eRenderCall::CREATE_VERTEX_BUFFER) CHECK(call.m_resource == nullptr);
+        if (call.m_call == eRenderCall::COPY_VERTEX_BUFFER) CHECK(call.m_value > 0 && call.m_value % static_cast<int>(sizeof(Vertex_PCUTBN)) == 0);
+        if (call.m_call == eRenderCall::COPY_INDEX_BUFFER) CHECK(call.m_value > 0 && call.m_value % static_cast<int>(3 * sizeof(unsigned int)) == 0);
+    }
+
+    RenderCommandList commandList;
+    scene.SubmitDraws(scene.GetOverviewCameraPosition(), scene.GetOverviewCameraOrientation(), commandList, backend);
+
+    // Draws of null buffers are dropped on submission.
+    CHECK(scene.GetFrameStatistics().m_visibleCount > 0);
+    CHECK(commandList.GetCommandCount() == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SpectatorRebuildsAreBudgetedAndResumeWhereTheyStopped)
+{
+    RecordingRenderBackend backend;
+    SpectatorScene         scene(256, 5, backend);
+
+    sSpectatorFrameStatistics const first        = SubmitOverviewFrame(scene, backend);
+    int const                       visibleCount = first.m_visibleCount;
+
+    CHECK(visibleCount > SPECTATOR_MAX_REBUILDS_PER_FRAME);
+    CHECK(first.m_rebuildCount == SPECTATOR_MAX_REBUILDS_PER_FRAME);
+    CHECK(first.m_staleCount == visibleCount - SPECTATOR_MAX_REBUILDS_PER_FRAME);
+
+    // Each visible board is baked exactly once, SPECTATOR_MAX_REBUILDS_PER_FRAME at a time.
+    int totalRebuildCount = first.m_rebuildCount;
+    int frameCount        = 1;
+
+    while (frameCount < 64)
+    {
+        sSpectatorFrameStatistics const& statistics = SubmitOverviewFrame(scene, backend);
+        totalRebuildCount += statistics.m_rebuildCount;
+        ++frameCount;
+
+        CHECK(statistics.m_visibleCount == visibleCount);
+        CHECK(statistics.m_rebuildCount + statistics.m_staleCount == visibleCount - (totalRebuildCount - statistics.m_rebuildCount));
+
+        if (statistics.m_staleCount == 0) break;
+    }
+
+    CHECK(totalRebuildCount == visibleCount);
+    CHECK(frameCount == (visibleCount + SPECTATOR_MAX_REBUILDS_PER_FRAME - 1) / SPECTATOR_MAX_REBUILDS_PER_FRAME);
+
+    // Nothing changed, so nothing is rebaked.
+    sSpectatorFrameStatistics const& settled = SubmitOverviewFrame(scene, backend);
+    CHECK(settled.m_rebuildCount == 0);
+    CHECK(settled.m_staleCount == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SpectatorRebakesOnlyBoardsWhoseSquaresChanged)
+{
+    RecordingRenderBackend backend;
+    SpectatorScene         scene(4, 7, backend);
+
+    CatchUpRebuilds(scene, backend);
+
+    sChessPosition const startPosition = sChessPosition::GetStartingPosition();
+
+    scene.SetBoardPosition(0, startPosition);
+    scene.SetBoardPosition(-1, startPosition);
+    scene.SetBoardPosition(4, startPosition);
+    CHECK(SubmitOverviewFrame(scene, backend).m_rebuildCount == 0);
+
+    std::vector<sChessMove> legalMoves;
+    GenerateLegalMoves(startPosition, legalMoves);
+
+    sChessPosition movedPosition = startPosition;
+    movedPosition.ApplyMove(legalMoves[0]);
+
+    scene.SetBoardPosition(2, movedPosition);
+    CHECK(SubmitOverviewFrame(scene, backend).m_rebuildCount == 1);
+    CHECK(SubmitOverviewFrame(scene, backend).m_rebuildCount == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SpectatorSelfPlayMovesEveryBoardOnceAnInterval)
+{
+    RecordingRenderBackend backend;
+    SpectatorScene         scene(16, 11, backend);
+
+    CatchUpRebuilds(scene, backend);
+
+    // Every board's first move is due within one interval; Update only takes a few steps per call.
+    int const stepCount = static_cast<int>(SPECTATOR_MOVE_INTERVAL_SECONDS / SIMULATION_STEP_SECONDS) + 1;
+
+    for (int step = 0; step < stepCount; ++step)
+    {
+        scene.Update(SIMULATION_STEP_SECONDS);
+    }
+
+    sSpectatorFrameStatistics const& statistics = SubmitOverviewFrame(scene, backend);
+    CHECK(statistics.m_visibleCount > 0);
+    CHECK(statistics.m_rebuildCount == statistics.m_visibleCount);
+
+    // Looking away from the grid culls every board, so none is rebaked or submitted.
+    RenderCommandList commandList;
+    scene.SubmitDraws(scene.GetOverviewCameraPosition(), EulerAngles(-90.f, 0.f, 0.f), commandList, backend);
+    CHECK(scene.GetFrameStatistics().m_visibleCount == 0);
+    CHECK(scene.GetFrameStatistics().m_rebuildCount == 0);
+}
@@ -0,0 +1,111 @@
+//----------------------------------------------------------------------------------------------------
+// TestTablebaseGenerator.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <filesystem>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/WorkerThreadPool.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseGenerator.hpp"
+#include "Game/Subsystem/Tablebase/TablebaseSubsystem.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Solves KPvK and every table it promotes into, children first as GenerateTable queues them,
+/// into a scratch directory, once for all the cases.
+static TablebaseSubsystem const& GetTestTablebase()
+{
+    static TablebaseSubsystem* s_tablebase = []()
+    {
+        sTablebaseSubsystemConfig config;
+        config.m_tablebaseDirectory = (std::filesystem::temp_directory_path() / "DaemonChessTestTablebases").string();
+
+        std::error_code errorCode;
+        std::filesystem::create_directories(config.m_tablebaseDirectory, errorCode);
+
+        TablebaseSubsystem* tablebase = new TablebaseSubsystem(config);
+        WorkerThreadPool    workerThreadPool(4);
+
+        for (char const* signature : {"KQvK", "KRvK", "KBvK", "KNvK", "KPvK"})
+        {
+            sTablebaseMaterial material;
+            CHECK(sTablebaseMaterial::FromSignature(signature, material));
+
+            TablebaseGenerator generator(*tablebase, material, workerThreadPool);
+            generator.Generate();
+
+            tablebase->CloseTable(signature);
+            CHECK(generator.WriteFiles(tablebase->GetTablePath(signature, ".wdl"), tablebase->GetTablePath(signature, ".dtz")));
+            CHECK(tablebase->OpenTable(signature));
+        }
+
+        return tablebase;
+    }();
+
+    return *s_tablebase;
+}
+
+//----------------------------------------------------------------------------------------------------
+static eTablebaseResult ProbeWdl(char const* fen)
+{
+    sChessPosition position;
+    CHECK(ParseFenString(fen, position));
+
+    return GetTestTablebase().ProbeWdl(position);
+}
+
+//----------------------------------------------------------------------------------------------------
+static int ProbeDtz(char const* fen)
+{
+    sChessPosition position;
+    CHECK(ParseFenString(fen, position));
+
+    int dtz = 0;
+    CHECK(GetTestTablebase().ProbeDtz(position, dtz));
+
+    return dtz;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TablebaseKRvKMatchesKnownPositions)
+{
+    // Rh8 mates at once, and the mate itself is lost with nothing left to play.
+    CHECK(ProbeWdl("k7/8/1K6/8/8/8/8/7R w - - 0 1") == eTablebaseResult::WIN);
+    CHECK(ProbeDtz("k7/8/1K6/8/8/8/8/7R w - - 0 1") == 1);
+    CHECK(ProbeWdl("k6R/8/1K6/8/8/8/8/8 b - - 0 1") == eTablebaseResult::LOSS);
+    CHECK(ProbeDtz("k6R/8/1K6/8/8/8/8/8 b - - 0 1") == 0);
+
+    // Every other position with the rook safe is won, in at most sixteen moves.
+    CHECK(ProbeWdl("8/8/8/3k4/8/8/8/R3K3 w - - 0 1") == eTablebaseResult::WIN);
+    CHECK(ProbeWdl("8/8/8/3k4/8/8/8/R3K3 b - - 0 1") == eTablebaseResult::LOSS);
+    CHECK(ProbeDtz("8/8/8/3k4/8/8/8/R3K3 w - - 0 1") <= 31);
+
+    // The defender takes the undefended rook.
+    CHECK(ProbeWdl("k7/1R6/8/8/8/8/8/K7 b - - 0 1") == eTablebaseResult::DRAW);
+    CHECK(ProbeDtz("k7/1R6/8/8/8/8/8/K7 b - - 0 1") == 0);
+
+    // Black's rook through a color flip.
+    CHECK(ProbeWdl("K7/8/1k6/8/8/8/8/7r b - - 0 1") == eTablebaseResult::WIN);
+    CHECK(ProbeDtz("K7/8/1k6/8/8/8/8/7r b - - 0 1") == 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TablebaseKPvKMatchesKnownPositions)
+{
+    // The king on the sixth in front of its pawn wins whoever is to move.
+    CHECK(ProbeWdl("4k3/8/4K3/4P3/8/8/8/8 w - - 0 1") == eTablebaseResult::WIN);
+    CHECK(ProbeWdl("4k3/8/4K3/4P3/8/8/8/8 b - - 0 1") == eTablebaseResult::LOSS);
+
+    // A pawn outside the defending king's square runs through; a6-a7 is the zeroing move.
+    CHECK(ProbeWdl("7k/8/P7/8/8/8/8/7K b - - 0 1") == eTablebaseResult::LOSS);
+    CHECK(ProbeWdl("7k/8/P7/8/8/8/8/7K w - - 0 1") == eTablebaseResult::WIN);
+    CHECK(ProbeDtz("7k/8/P7/8/8/8/8/7K w - - 0 1") == 1);
+
+    // The defender in the rook pawn's corner draws, and so does one that takes the pawn.
+    CHECK(ProbeWdl("k7/8/8/8/P7/8/8/1K6 w - - 0 1") == eTablebaseResult::DRAW);
+    CHECK(ProbeWdl("8/8/8/8/3kP3/8/8/7K b - - 0 1") == eTablebaseResult::DRAW);
+
+    // Positions with castling rights are not in the tables.
+    CHECK(ProbeWdl("4k3/8/4K3/4P3/8/8/8/7R w K - 0 1") == eTablebaseResult::UNKNOWN);
+}
@@ -0,0 +1,142 @@
+//----------------------------------------------------------------------------------------------------
+// TestTimerWheel.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "Game/Framework/TimerWheel.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+/// @brief The tick Schedule puts a timer on, by the same rounding.
+static uint64_t GetDueTick(TimerWheel const& wheel,
+                           float const       delaySeconds)
+{
+    uint64_t const delayTicks = static_cast<uint64_t>(std::ceil(static_cast<double>(delaySeconds) * TIMER_WHEEL_TICKS_PER_SECOND));
+
+    return wheel.GetCurrentTick() + std::max<uint64_t>(delayTicks, 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TimerFiresOnceAfterItsDelay)
+{
+    TimerWheel wheel;
+    int        fireCount = 0;
+
+    sTimerHandle const handle = wheel.Schedule(0.5f, [&fireCount]() { ++fireCount; });
+
+    CHECK(wheel.IsScheduled(handle));
+    wheel.Advance(0.45f);
+    CHECK(fireCount == 0);
+    wheel.Advance(0.1f);
+    CHECK(fireCount == 1);
+    CHECK(!wheel.IsScheduled(handle));
+    wheel.Advance(10.f);
+    CHECK(fireCount == 1);
+    CHECK(wheel.GetScheduledCount() == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(CancelledTimerNeverFiresAndItsHandleGoesStale)
+{
+    TimerWheel wheel;
+    int        fireCount = 0;
+
+    sTimerHandle const cancelled = wheel.Schedule(1.f, [&fireCount]() { ++fireCount; });
+
+    CHECK(wheel.Cancel(cancelled));
+    CHECK(!wheel.Cancel(cancelled));
+
+    // The freed slot is reused; the old handle must not reach the new timer.
+    sTimerHandle const reused = wheel.Schedule(1.f, [&fireCount]() { fireCount += 10; });
+
+    CHECK(reused.m_index == cancelled.m_index);
+    CHECK(!wheel.IsScheduled(cancelled));
+    CHECK(!wheel.Cancel(cancelled));
+
+    wheel.Advance(2.f);
+    CHECK(fireCount == 10);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TimersOnEveryLevelFireOnTheirDueTick)
+{
+    TimerWheel            wheel;
+    std::mt19937          random(7);
+    std::vector<uint64_t> dueTicks;
+    std::vector<uint64_t> firedTicks;
+
+    // Up to an hour reaches level 3, so every cascade path is taken.
+    std::uniform_real_distribution<float> delayDistribution(0.f, 3600.f);
+
+    for (int timerIndex = 0; timerIndex < 2000; ++timerIndex)
+    {
+        float const delaySeconds = timerIndex < 64 ? static_cast<float>(timerIndex) / 120.f : delayDistribution(random);
+
+        dueTicks.push_back(GetDueTick(wheel, delaySeconds));
+        wheel.Schedule(delaySeconds, [&wheel, &firedTicks, timerIndex]()
+        {
+            firedTicks[timerIndex] = wheel.GetCurrentTick();
+        });
+    }
+
+    firedTicks.assign(dueTicks.size(), 0);
+
+    while (wheel.GetScheduledCount() > 0)
+    {
+        wheel.Advance(1.f);
+    }
+
+    CHECK(firedTicks == dueTicks);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(CallbackCanScheduleAndCancelTimers)
+{
+    TimerWheel   wheel;
+    int          chainCount = 0;
+    int          fireCount  = 0;
+    sTimerHandle victim     = wheel.Schedule(0.25f, [&fireCount]() { ++fireCount; });
+
+    std::function<void()> chain = [&wheel, &chain, &chainCount]()
+    {
+        if (++chainCount < 5) wheel.Schedule(0.f, chain);
+    };
+
+    wheel.Schedule(0.125f, [&wheel, &victim, &chain]()
+    {
+        wheel.Cancel(victim);
+        wheel.Schedule(0.f, chain);
+    });
+
+    // A zero delay still waits a tick, so each link of the chain runs on its own tick.
+    wheel.Advance(0.125f + 2.5f / 120.f);
+    CHECK(chainCount == 2);
+
+    wheel.Advance(1.f);
+    CHECK(chainCount == 5);
+    CHECK(fireCount == 0);
+    CHECK(wheel.GetScheduledCount() == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(ClearDropsEveryTimer)
+{
+    TimerWheel wheel;
+    int        fireCount = 0;
+
+    sTimerHandle const handle = wheel.Schedule(100.f, [&fireCount]() { ++fireCount; });
+    wheel.Schedule(0.1f, [&fireCount]() { ++fireCount; });
+
+    wheel.Clear();
+
+    CHECK(!wheel.IsScheduled(handle));
+    CHECK(wheel.GetScheduledCount() == 0);
+
+    wheel.Advance(200.f);
+    CHECK(fireCount == 0);
+}
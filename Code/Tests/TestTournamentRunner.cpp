@@ -0,0 +1,167 @@
+//----------------------------------------------------------------------------------------------------
+// TestTournamentRunner.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <cmath>
+#include <set>
+#include <vector>
+
+#include "Game/Framework/ChessRules.hpp"
+#include "Game/Framework/MoveSearch.hpp"
+#include "Game/Framework/TournamentRunner.hpp"
+#include "Tests/TestHarness.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static sTournamentConfig GetTestConfig(int const openingCount)
+{
+    sTournamentConfig config;
+    config.m_candidate.m_searchDepth = 1;
+    config.m_baseline.m_searchDepth  = 1;
+    config.m_openings.assign(openingCount, sChessPosition::GetStartingPosition());
+    config.m_threadCount             = 2;
+    config.m_maxPly                  = 40;
+    config.m_pgnPath                 = "";
+
+    return config;
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SearchBreaksTiesWithTheRandomEngine)
+{
+    sAIControllerConfig config;
+    config.m_searchDepth = 1;
+
+    std::set<int> chosenMoves;
+
+    for (unsigned seed = 0; seed < 16; ++seed)
+    {
+        std::mt19937 random(seed);
+        sChessMove   move;
+
+        CHECK(SearchBestMove(config, sChessPosition::GetStartingPosition(), move, &random));
+        chosenMoves.insert(move.m_fromSquare * 64 + move.m_toSquare);
+    }
+
+    // Every opening move scores level at depth 1, so a fixed choice would mean the ties are ignored.
+    CHECK(chosenMoves.size() > 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(SearchStillPrefersTheBetterMove)
+{
+    sChessPosition position;
+    CHECK(ParseFenString("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1", position));
+
+    sAIControllerConfig config;
+    config.m_searchDepth = 2;
+
+    for (unsigned seed = 0; seed < 8; ++seed)
+    {
+        std::mt19937 random(seed);
+        sChessMove   move;
+
+        CHECK(SearchBestMove(config, position, move, &random));
+        CHECK(move == ParseMoveString("d1d5"));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+TEST_CASE(TournamentGamesDifferButRepeatForASeed)
+{
+    sTournamentConfig config = GetTestConfig(4);
+    config.m_maxGameCount    = 8;
+
+    sTournamentResult const first  = TournamentRunner(config).Run();
+    sTournamentResult const second = TournamentRunner(config).Run();
+
+    CHECK(first.m_gameCount == 8);
+    CHECK(first.m_totalPly == second.m_totalPly);
+    CHECK(first.m_winCount == second.m_winCount);
+    CHECK(first.m_lossCount == second.m_lossCount);
+
+    sTournamentConfig reseeded = config;
+    reseeded.m_seed            = 1000;
+
+    CHECK(TournamentRunner(reseeded).Run().m_totalPly != first.m_totalPly);
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Three openings are cycled past their six games, up to m_maxGameCount.
+TEST_CASE(TournamentCyclesOpeningsUntilMaxGameCount)
+{
+    sTournamentConfig config = GetTestConfig(3);
+    config.m_maxGameCount    = 10;
+    config.m_alpha           = 1e-9;     // Keeps the SPRT from stopping the run early
+    config.m_beta            = 1e-9;
+
+    CHECK(TournamentRunner(config).Run().m_gameCount == 10);
+    CHECK(TournamentRunner(GetTestConfig(0)).Run().m_gameCount == 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+static sTournamentResult GetStatistics(int const winCount,
+                                       int const drawCount,
+                                       int const lossCount)
+{
+    sTournamentConfig config;
+    config.m_elo0  = 0.0;
+    config.m_elo1  = 5.0;
+    config.m_alpha = 0.05;
+    config.m_beta  = 0.05;
+
+    sTournamentResult result;
+    result.m_gameCount = winCount + drawCount + lossCount;
+    result.m_winCount  = winCount;
+    result.m_drawCount = drawCount;
+    result.m_lossCount = lossCount;
+
+    TournamentRunner(config).UpdateStatistics(result);
+
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+static bool IsNear(double const value,
+                   double const expected)
+{
+    return std::fabs(value - expected) < 1e-3;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief Elo, its interval and the LLR against hand-computed values for elo0 = 0, elo1 = 5 and
+/// alpha = beta = 0.05, whose bounds are -/+2.944.
+TEST_CASE(TournamentStatisticsMatchKnownCounts)
+{
+    sTournamentResult const even = GetStatistics(30, 40, 30);
+    CHECK(IsNear(even.m_elo, 0.0));
+    CHECK(IsNear(even.m_eloError, 53.159));
+    CHECK(IsNear(even.m_llr, -0.017256));
+    CHECK(IsNear(even.m_lowerBound, -2.944439));
+    CHECK(IsNear(even.m_upperBound, 2.944439));
+    CHECK(even.m_decision == eSprtDecision::CONTINUE);
+
+    // A score of 0.7 is +147.2 Elo; ten times the games tighten the interval and multiply the LLR by ten.
+    sTournamentResult const ahead = GetStatistics(60, 20, 20);
+    CHECK(IsNear(ahead.m_elo, 147.191));
+    CHECK(IsNear(ahead.m_eloError, 66.015));
+    CHECK(IsNear(ahead.m_llr, 0.883207));
+    CHECK(ahead.m_decision == eSprtDecision::CONTINUE);
+
+    sTournamentResult const aheadLonger = GetStatistics(600, 200, 200);
+    CHECK(IsNear(aheadLonger.m_elo, 147.191));
+    CHECK(IsNear(aheadLonger.m_eloError, 20.544));
+    CHECK(IsNear(aheadLonger.m_llr, 8.832073));
+    CHECK(aheadLonger.m_decision == eSprtDecision::ACCEPT_H1);
+
+    sTournamentResult const behind = GetStatistics(120, 240, 240);
+    CHECK(IsNear(behind.m_elo, -70.437));
+    CHECK(behind.m_llr < behind.m_lowerBound);
+    CHECK(behind.m_decision == eSprtDecision::ACCEPT_H0);
+
+    // Every game drawn leaves no variance, so the LLR stays 0 and nothing is decided.
+    sTournamentResult const drawn = GetStatistics(0, 50, 0);
+    CHECK(IsNear(drawn.m_elo, 0.0));
+    CHECK(IsNear(drawn.m_llr, 0.0));
+    CHECK(drawn.m_decision == eSprtDecision::CONTINUE);
+}
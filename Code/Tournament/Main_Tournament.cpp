@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------------------------------
+// Main_Tournament.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <string>
+
+#include "Game/Framework/TournamentRunner.hpp"
+
+//----------------------------------------------------------------------------------------------------
+typedef std::map<std::string, std::string> ArgumentMap;
+
+//----------------------------------------------------------------------------------------------------
+static std::string GetArgument(ArgumentMap const& arguments, char const* key, char const* defaultValue)
+{
+    auto const found = arguments.find(key);
+
+    return found != arguments.end() ? found->second : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+static int GetArgument(ArgumentMap const& arguments, char const* key, int const defaultValue)
+{
+    auto const found = arguments.find(key);
+
+    return found != arguments.end() ? std::atoi(found->second.c_str()) : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+static double GetArgument(ArgumentMap const& arguments, char const* key, double const defaultValue)
+{
+    auto const found = arguments.find(key);
+
+    return found != arguments.end() ? std::atof(found->second.c_str()) : defaultValue;
+}
+
+//----------------------------------------------------------------------------------------------------
+/// @brief
+/// Tournament openings=Data/Openings/Openings.epd games=1000 threads=0 seed=0 candidateDepth=3 baselineDepth=2 base=10 increment=0.1 maxPly=400 elo0=0 elo1=5 alpha=0.05 beta=0.05 pgn=Tournament.pgn
+/// The tournament DevConsole command without the window: plays the candidate search depth against
+/// the baseline on every core and prints the score, Elo, SPRT verdict and throughput. There is no
+/// opening book or tablebase here, so both sides only search. Exits 1 if the suite cannot be loaded.
+int main(int const argc, char** argv)
+{
+    ArgumentMap arguments;
+
+    for (int argIndex = 1; argIndex < argc; ++argIndex)
+    {
+        std::string const argument = argv[argIndex];
+        size_t const      equals   = argument.find('=');
+
+        if (equals != std::string::npos) arguments[argument.substr(0, equals)] = argument.substr(equals + 1);
+    }
+
+    sTournamentConfig config;
+    config.m_candidate.m_name        = "Candidate";
+    config.m_candidate.m_searchDepth = GetArgument(arguments, "candidateDepth", 3);
+    config.m_baseline.m_name         = "Baseline";
+    config.m_baseline.m_searchDepth  = GetArgument(arguments, "baselineDepth", 2);
+    config.m_maxGameCount            = std::max(2, GetArgument(arguments, "games", 1000));
+    config.m_threadCount             = GetArgument(arguments, "threads", 0);
+    config.m_maxPly                  = GetArgument(arguments, "maxPly", 400);
+    config.m_baseSeconds             = GetArgument(arguments, "base", 10.0);
+    config.m_incrementSeconds        = GetArgument(arguments, "increment", 0.1);
+    config.m_elo0                    = GetArgument(arguments, "elo0", 0.0);
+    config.m_elo1                    = GetArgument(arguments, "elo1", 5.0);
+    config.m_alpha                   = GetArgument(arguments, "alpha", 0.05);
+    config.m_beta                    = GetArgument(arguments, "beta", 0.05);
+    config.m_seed                    = static_cast<unsigned>(GetArgument(arguments, "seed", 0));
+    config.m_pgnPath                 = GetArgument(arguments, "pgn", "Tournament.pgn");
+
+    std::string const openingsPath = GetArgument(arguments, "openings", "Data/Openings/Openings.epd");
+
+    if (!TournamentRunner::LoadOpeningSuite(openingsPath, config.m_openings) || config.m_openings.empty())
+    {
+        std::printf("[Tournament] No FEN or EPD positions in %s; a tournament needs an opening suite.\n", openingsPath.c_str());
+        return 1;
+    }
+
+    TournamentRunner        runner(config);
+    sTournamentResult const result = runner.Run();
+
+    char const* decision = "undecided";
+    if (result.m_decision == eSprtDecision::ACCEPT_H1) decision = "H1 accepted";
+    else if (result.m_decision == eSprtDecision::ACCEPT_H0) decision = "H0 accepted";
+
+    double const gamesPerHour = result.m_elapsedSeconds > 0.0 ? result.m_gameCount * 3600.0 / result.m_elapsedSeconds : 0.0;
+
+    std::printf("[Tournament] %d games, +%d =%d -%d, Elo %+.1f +/- %.1f, LLR %.2f [%.2f, %.2f] %s\n",
+                result.m_gameCount, result.m_winCount, result.m_drawCount, result.m_lossCount, result.m_elo, result.m_eloError, result.m_llr, result.m_lowerBound, result.m_upperBound, decision);
+    std::printf("  %zu openings, %d threads, %.2f s: %.0f games/h, %.0f games/h per core, %.1f plies/game\n",
+                config.m_openings.size(), result.m_threadCount, result.m_elapsedSeconds, gamesPerHour, gamesPerHour / std::max(1, result.m_threadCount), static_cast<double>(result.m_totalPly) / std::max(1, result.m_gameCount));
+
+    for (int terminationIndex = 0; terminationIndex < TOURNAMENT_TERMINATION_COUNT; ++terminationIndex)
+    {
+        char const* label = TournamentRunner::GetTerminationString(static_cast<eTournamentTermination>(terminationIndex));
+        std::printf("  %-32s %d\n", label, result.m_terminationCounts[terminationIndex]);
+    }
+
+    return 0;
+}
@@ -169,6 +169,47 @@ cbuffer ModelConstants : register(b4)
 	float4		c_modelTint;		// Uniform Vec4 model tint (including alpha) to multiply against diffuse texel & vertex color
 };
 
+//----------------------------------------------------------------------------------------------------
+// Clustered point and spot lights, built on the CPU by the LightSubsystem each frame.
+// Must match LIGHT_CLUSTER_* in LightClusterGrid.hpp.
+//----------------------------------------------------------------------------------------------------
+#define LIGHT_CLUSTER_TILE_COUNT_X		16
+#define LIGHT_CLUSTER_TILE_COUNT_Y		8
+#define LIGHT_CLUSTER_SLICE_COUNT		24
+#define LIGHT_CLUSTER_COUNT				(LIGHT_CLUSTER_TILE_COUNT_X * LIGHT_CLUSTER_TILE_COUNT_Y * LIGHT_CLUSTER_SLICE_COUNT)
+#define LIGHT_CLUSTER_MAX_LIGHT_COUNT	1024
+#define LIGHT_CLUSTER_MAX_INDEX_COUNT	32768
+#define LIGHT_SPOT_ORBIT_RADIUS			5.0
+
+//----------------------------------------------------------------------------------------------------
+cbuffer LightClusterConstants : register(b8)
+{
+	float3	c_clusterCameraPosition;
+	float	c_clusterTanHalfWidth;
+	float3	c_clusterCameraForward;
+	float	c_clusterTanHalfHeight;
+	float3	c_clusterCameraLeft;
+	float	c_clusterNearDistance;
+	float3	c_clusterCameraUp;
+	float	c_clusterSliceScale;		// (LIGHT_CLUSTER_SLICE_COUNT - 1) / ln(far / c_clusterFirstSliceFar)
+	float	c_clusterFirstSliceFar;		// Slice 0 spans the near plane to here; later slices are exponential
+	int		c_clusterLightCount;		// 0 when clustering is off
+	float2	EMPTY_PADDING_B8;
+	uint4	c_clusterRecords[LIGHT_CLUSTER_COUNT / 4];	// Per cluster: offset in the low 16 bits, count in the high 16
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer LightClusterIndexConstants : register(b9)
+{
+	uint4	c_clusterLightIndexes[LIGHT_CLUSTER_MAX_INDEX_COUNT / 8];	// 16-bit indexes into c_clusterLightArray, two per uint
+};
+
+//----------------------------------------------------------------------------------------------------
+cbuffer LightClusterLightConstants : register(b10)
+{
+	Light	c_clusterLightArray[LIGHT_CLUSTER_MAX_LIGHT_COUNT];
+};
+
 
 //----------------------------------------------------------------------------------------------------
 // TEXTURE and SAMPLER constants
@@ -453,6 +494,47 @@ void CalculateSpotLight(
 	}
 }
 
+//----------------------------------------------------------------------------------------------------
+// Spot lights circle their authored position over time, whichever path lights them
+float3 GetOrbitingSpotLightPosition( float3 worldPosition )
+{
+	float angle = 0.5 * c_time;
+
+	return float3(
+		cos(angle) * LIGHT_SPOT_ORBIT_RADIUS + worldPosition.x,
+		sin(angle) * LIGHT_SPOT_ORBIT_RADIUS + worldPosition.y,
+		worldPosition.z
+	);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Finds the cluster holding worldPos the same way LightClusterGrid::FindClusterIndex does
+uint GetLightClusterIndex( float3 worldPos )
+{
+	float3 displacement = worldPos - c_clusterCameraPosition;
+	float depth = max( dot( displacement, c_clusterCameraForward ), c_clusterNearDistance );
+	float u = -dot( displacement, c_clusterCameraLeft ) / ( depth * c_clusterTanHalfWidth );
+	float v = dot( displacement, c_clusterCameraUp ) / ( depth * c_clusterTanHalfHeight );
+
+	uint tileX = (uint) clamp( floor( ( u + 1.0 ) * 0.5 * LIGHT_CLUSTER_TILE_COUNT_X ), 0, LIGHT_CLUSTER_TILE_COUNT_X - 1 );
+	uint tileY = (uint) clamp( floor( ( v + 1.0 ) * 0.5 * LIGHT_CLUSTER_TILE_COUNT_Y ), 0, LIGHT_CLUSTER_TILE_COUNT_Y - 1 );
+	uint slice = 0;
+
+	if( depth >= c_clusterFirstSliceFar )
+	{
+		slice = (uint) clamp( 1.0 + floor( log( depth / c_clusterFirstSliceFar ) * c_clusterSliceScale ), 0, LIGHT_CLUSTER_SLICE_COUNT - 1 );
+	}
+
+	return ( slice * LIGHT_CLUSTER_TILE_COUNT_Y + tileY ) * LIGHT_CLUSTER_TILE_COUNT_X + tileX;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint GetClusterLightIndex( uint listIndex )
+{
+	uint packedPair = c_clusterLightIndexes[ listIndex >> 3 ][ ( listIndex >> 1 ) & 3 ];
+	return ( packedPair >> ( ( listIndex & 1 ) * 16 ) ) & 0xFFFF;
+}
+
 //----------------------------------------------------------------------------------------------------
 // PIXEL SHADER (PS)
 //
@@ -571,14 +653,7 @@ float4 PixelMain( VertexOutPixelIn input ) : SV_Target0
 		}
 		else if (light.lightType == 2) // Spot light
 		{
-			float radius = 5.0;
-			float angle = 0.5 * c_time;
-
-			light.worldPosition = float3(
-				cos(angle) * radius+light.worldPosition.x,
-				sin(angle) * radius+light.worldPosition.y,
-				light.worldPosition.z
-			);
+			light.worldPosition = GetOrbitingSpotLightPosition( light.worldPosition );
 
 			CalculateSpotLight(
 				light,
@@ -594,6 +669,30 @@ float4 PixelMain( VertexOutPixelIn input ) : SV_Target0
 		}
 	}
 
+	// Add the clustered point and spot lights that can reach this pixel
+	if( c_clusterLightCount > 0 )
+	{
+		uint clusterIndex = GetLightClusterIndex( input.v_worldPos );
+		uint clusterRecord = c_clusterRecords[ clusterIndex >> 2 ][ clusterIndex & 3 ];
+		uint firstIndex = clusterRecord & 0xFFFF;
+		uint lightCount = clusterRecord >> 16;
+
+		for( uint listIndex = firstIndex; listIndex < firstIndex + lightCount; listIndex++ )
+		{
+			Light light = c_clusterLightArray[ GetClusterLightIndex( listIndex ) ];
+
+			if( light.lightType == 1 )
+			{
+				CalculatePointLight( light, input.v_worldPos, finalNormal, viewDirection, diffuseColor.rgb, specularStrength, specularPower, diffuseLighting, specularLighting );
+			}
+			else
+			{
+				light.worldPosition = GetOrbitingSpotLightPosition( light.worldPosition );
+				CalculateSpotLight( light, input.v_worldPos, finalNormal, viewDirection, diffuseColor.rgb, specularStrength, specularPower, diffuseLighting, specularLighting );
+			}
+		}
+	}
+
 	// Add emissive contribution
 	float3 emissiveLighting = diffuseColor.rgb * emissiveStrength;
 